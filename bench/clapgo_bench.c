@@ -0,0 +1,779 @@
+// Headless offline benchmark host for ClapGo plugins.
+//
+// Loads a .clap through its real entry point (clap_entry -> init ->
+// factory -> create_plugin) and drives process() as fast as it can with
+// scripted event streams, then reports throughput, the per-block latency
+// distribution and Go allocation/GC counters as JSON, one run per
+// scenario.
+//
+//   clapgo-bench examples/synth/build/synth.clap --scenario mpe,sysex
+//       --rate 48000 --block 256 --seconds 10 --output synth.json
+//
+// The host is single-threaded: it plays both the main and the audio
+// thread, delivering on_main_thread callbacks between blocks.
+
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L // clock_gettime
+#endif
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "../include/clap/include/clap/clap.h"
+#include "../src/c/runtime_stats.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#if defined(_WIN32) || defined(_WIN64)
+    #include <windows.h>
+    typedef HMODULE bench_library_t;
+    #define bench_dlopen(path) LoadLibraryA(path)
+    #define bench_dlsym(lib, name) ((void*)GetProcAddress((lib), (name)))
+    #define bench_dlclose(lib) FreeLibrary(lib)
+#else
+    #include <dlfcn.h>
+    typedef void* bench_library_t;
+    #define bench_dlopen(path) dlopen((path), RTLD_NOW | RTLD_LOCAL)
+    #define bench_dlsym(lib, name) dlsym((lib), (name))
+    #define bench_dlclose(lib) dlclose(lib)
+#endif
+
+#define BENCH_MAX_EVENTS 4096
+#define BENCH_MAX_CHANNELS 8
+#define BENCH_MAX_PARAMS 256
+#define BENCH_MAX_NOTES 16
+#define BENCH_SYSEX_SIZE 128
+#define BENCH_SYSEX_BURST 8
+
+// Scenarios, combinable on the command line
+enum {
+    SCENARIO_SILENCE    = 1 << 0, // no events: the plugin's idle cost
+    SCENARIO_AUTOMATION = 1 << 1, // every parameter moves every few samples
+    SCENARIO_MPE        = 1 << 2, // per-channel chords with note expressions
+    SCENARIO_SYSEX      = 1 << 3, // bursts of sysex at the start of each block
+};
+
+static const struct { const char* name; int flag; } s_scenarios[] = {
+    { "silence", SCENARIO_SILENCE },
+    { "automation", SCENARIO_AUTOMATION },
+    { "mpe", SCENARIO_MPE },
+    { "sysex", SCENARIO_SYSEX },
+};
+#define SCENARIO_COUNT (sizeof(s_scenarios) / sizeof(s_scenarios[0]))
+
+typedef struct bench_options {
+    const char* plugin_path;
+    const char* plugin_id;    // NULL: the factory's first plugin
+    const char* output_path;  // NULL: stdout
+    double sample_rate;
+    uint32_t block_size;
+    double seconds;
+    uint32_t warmup_blocks;
+    uint32_t automation_interval; // samples between automation points
+    int scenarios;                // bitmask, one run per bit
+    bool verbose;
+} bench_options_t;
+
+// One event of any kind the scenarios produce
+typedef union bench_event {
+    clap_event_header_t header;
+    clap_event_note_t note;
+    clap_event_note_expression_t expression;
+    clap_event_param_value_t param;
+    clap_event_midi_sysex_t sysex;
+} bench_event_t;
+
+typedef struct bench_event_list {
+    bench_event_t events[BENCH_MAX_EVENTS];
+    uint32_t count;
+    uint64_t dropped; // events that did not fit in a block
+} bench_event_list_t;
+
+typedef struct bench_note {
+    int32_t note_id;
+    int16_t channel;
+    int16_t key;
+    int64_t off_time; // absolute sample of the note off
+} bench_note_t;
+
+typedef struct bench_state {
+    const bench_options_t* options;
+    const clap_plugin_t* plugin;
+    const clap_plugin_params_t* params;
+
+    clap_param_info_t param_info[BENCH_MAX_PARAMS];
+    uint32_t param_count;
+    uint32_t next_param;
+
+    bench_note_t notes[BENCH_MAX_NOTES];
+    uint32_t note_count;
+    int32_t next_note_id;
+    int64_t next_chord;
+
+    bench_event_list_t input;
+    uint64_t output_events;
+
+    bool callback_requested;
+    bool in_process;
+    uint64_t log_messages;
+} bench_state_t;
+
+static bench_state_t s_state;
+static uint8_t s_sysex[BENCH_SYSEX_SIZE];
+
+static uint64_t bench_now_ns(void) {
+#if defined(_WIN32) || defined(_WIN64)
+    static LARGE_INTEGER frequency;
+    LARGE_INTEGER counter;
+    if (frequency.QuadPart == 0) QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (uint64_t)((double)counter.QuadPart * 1e9 / (double)frequency.QuadPart);
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+// Host side
+
+static void host_log(const clap_host_t* host, clap_log_severity severity, const char* msg) {
+    (void)host;
+    s_state.log_messages++;
+    if (s_state.options->verbose || severity >= CLAP_LOG_ERROR) {
+        fprintf(stderr, "[plugin %d] %s\n", (int)severity, msg);
+    }
+}
+
+static bool host_is_main_thread(const clap_host_t* host) {
+    (void)host;
+    return !s_state.in_process;
+}
+
+static bool host_is_audio_thread(const clap_host_t* host) {
+    (void)host;
+    return s_state.in_process;
+}
+
+static void host_params_rescan(const clap_host_t* host, clap_param_rescan_flags flags) {
+    (void)host; (void)flags;
+}
+
+static void host_params_clear(const clap_host_t* host, clap_id param_id, clap_param_clear_flags flags) {
+    (void)host; (void)param_id; (void)flags;
+}
+
+static void host_params_request_flush(const clap_host_t* host) {
+    (void)host;
+}
+
+static const clap_host_log_t s_host_log = { host_log };
+static const clap_host_thread_check_t s_host_thread_check = { host_is_main_thread, host_is_audio_thread };
+static const clap_host_params_t s_host_params = {
+    host_params_rescan, host_params_clear, host_params_request_flush
+};
+
+static const void* host_get_extension(const clap_host_t* host, const char* id) {
+    (void)host;
+    if (strcmp(id, CLAP_EXT_LOG) == 0) return &s_host_log;
+    if (strcmp(id, CLAP_EXT_THREAD_CHECK) == 0) return &s_host_thread_check;
+    if (strcmp(id, CLAP_EXT_PARAMS) == 0) return &s_host_params;
+    return NULL;
+}
+
+static void host_request_restart(const clap_host_t* host) { (void)host; }
+static void host_request_process(const clap_host_t* host) { (void)host; }
+
+static void host_request_callback(const clap_host_t* host) {
+    (void)host;
+    s_state.callback_requested = true;
+}
+
+static const clap_host_t s_host = {
+    .clap_version = CLAP_VERSION_INIT,
+    .host_data = &s_state,
+    .name = "clapgo-bench",
+    .vendor = "ClapGo",
+    .url = "https://github.com/justyntemme/clapgo",
+    .version = "0.1.0",
+    .get_extension = host_get_extension,
+    .request_restart = host_request_restart,
+    .request_process = host_request_process,
+    .request_callback = host_request_callback,
+};
+
+// Event lists
+
+static uint32_t input_size(const clap_input_events_t* list) {
+    return ((const bench_event_list_t*)list->ctx)->count;
+}
+
+static const clap_event_header_t* input_get(const clap_input_events_t* list, uint32_t index) {
+    const bench_event_list_t* events = (const bench_event_list_t*)list->ctx;
+    return index < events->count ? &events->events[index].header : NULL;
+}
+
+static bool output_try_push(const clap_output_events_t* list, const clap_event_header_t* event) {
+    (void)list; (void)event;
+    s_state.output_events++;
+    return true;
+}
+
+static bench_event_t* push_event(bench_event_list_t* list, uint16_t type, uint32_t size, uint32_t time) {
+    if (list->count >= BENCH_MAX_EVENTS) {
+        list->dropped++;
+        return NULL;
+    }
+    bench_event_t* event = &list->events[list->count++];
+    memset(event, 0, sizeof(*event));
+    event->header.size = size;
+    event->header.time = time;
+    event->header.space_id = CLAP_CORE_EVENT_SPACE_ID;
+    event->header.type = type;
+    return event;
+}
+
+static int compare_event_time(const void* a, const void* b) {
+    const bench_event_t* x = (const bench_event_t*)a;
+    const bench_event_t* y = (const bench_event_t*)b;
+    return (x->header.time > y->header.time) - (x->header.time < y->header.time);
+}
+
+// Insertion sort: stable, and event lists arrive almost sorted
+static void sort_events(bench_event_list_t* list) {
+    for (uint32_t i = 1; i < list->count; i++) {
+        bench_event_t event = list->events[i];
+        uint32_t j = i;
+        while (j > 0 && compare_event_time(&list->events[j - 1], &event) > 0) {
+            list->events[j] = list->events[j - 1];
+            j--;
+        }
+        list->events[j] = event;
+    }
+}
+
+// Scenario generators: each appends this block's events
+
+static void generate_automation(bench_state_t* state, int64_t block_start, uint32_t frames) {
+    if (state->param_count == 0) return;
+    uint32_t interval = state->options->automation_interval;
+
+    for (uint32_t t = 0; t < frames; t += interval) {
+        const clap_param_info_t* info = &state->param_info[state->next_param];
+        state->next_param = (state->next_param + 1) % state->param_count;
+
+        // A slow sine sweep over the full range, different per parameter
+        double phase = (double)(block_start + t) / state->options->sample_rate + info->id * 0.37;
+        double position = 0.5 + 0.5 * sin(phase * 2.0 * M_PI * 0.5);
+        double value = info->min_value + position * (info->max_value - info->min_value);
+        if (info->flags & CLAP_PARAM_IS_STEPPED) value = floor(value + 0.5);
+
+        bench_event_t* event = push_event(&state->input, CLAP_EVENT_PARAM_VALUE, sizeof(clap_event_param_value_t), t);
+        if (!event) return;
+        event->param.param_id = info->id;
+        event->param.cookie = info->cookie;
+        event->param.note_id = -1;
+        event->param.port_index = -1;
+        event->param.channel = -1;
+        event->param.key = -1;
+        event->param.value = value;
+    }
+}
+
+static void push_note(bench_state_t* state, uint16_t type, const bench_note_t* note, uint32_t time) {
+    bench_event_t* event = push_event(&state->input, type, sizeof(clap_event_note_t), time);
+    if (!event) return;
+    event->note.note_id = note->note_id;
+    event->note.port_index = 0;
+    event->note.channel = note->channel;
+    event->note.key = note->key;
+    event->note.velocity = 0.8;
+}
+
+static void push_expression(bench_state_t* state, const bench_note_t* note, int32_t expression_id,
+                            double value, uint32_t time) {
+    bench_event_t* event = push_event(&state->input, CLAP_EVENT_NOTE_EXPRESSION,
+                                      sizeof(clap_event_note_expression_t), time);
+    if (!event) return;
+    event->expression.expression_id = expression_id;
+    event->expression.note_id = note->note_id;
+    event->expression.port_index = 0;
+    event->expression.channel = note->channel;
+    event->expression.key = note->key;
+    event->expression.value = value;
+}
+
+// MPE-style: a four-note chord every half second, one note per channel,
+// each held for 400 ms with tuning and pressure moving twice per block
+static void generate_mpe(bench_state_t* state, int64_t block_start, uint32_t frames) {
+    static const int16_t chord[4] = { 48, 55, 60, 64 };
+    int64_t block_end = block_start + frames;
+    double rate = state->options->sample_rate;
+
+    // Releases due in this block
+    for (uint32_t i = 0; i < state->note_count;) {
+        bench_note_t* note = &state->notes[i];
+        if (note->off_time < block_end) {
+            push_note(state, CLAP_EVENT_NOTE_OFF, note, (uint32_t)(note->off_time - block_start));
+            state->notes[i] = state->notes[--state->note_count];
+        } else {
+            i++;
+        }
+    }
+
+    // Chords starting in this block
+    while (state->next_chord < block_end) {
+        uint32_t time = (uint32_t)(state->next_chord - block_start);
+        for (int16_t i = 0; i < 4 && state->note_count < BENCH_MAX_NOTES; i++) {
+            bench_note_t* note = &state->notes[state->note_count++];
+            note->note_id = state->next_note_id++;
+            note->channel = (int16_t)(1 + i);
+            note->key = chord[i];
+            note->off_time = state->next_chord + (int64_t)(0.4 * rate);
+            push_note(state, CLAP_EVENT_NOTE_ON, note, time);
+        }
+        state->next_chord += (int64_t)(0.5 * rate);
+    }
+
+    // Expression on every held note
+    for (uint32_t i = 0; i < state->note_count; i++) {
+        const bench_note_t* note = &state->notes[i];
+        for (uint32_t t = 0; t < frames; t += frames / 2 + 1) {
+            double phase = (double)(block_start + t) / rate;
+            push_expression(state, note, CLAP_NOTE_EXPRESSION_TUNING, 0.25 * sin(phase * 2.0 * M_PI * 5.0), t);
+            push_expression(state, note, CLAP_NOTE_EXPRESSION_PRESSURE, 0.5 + 0.5 * sin(phase * 2.0 * M_PI), t);
+        }
+    }
+}
+
+static void generate_sysex(bench_state_t* state, uint32_t frames) {
+    for (uint32_t i = 0; i < BENCH_SYSEX_BURST; i++) {
+        uint32_t time = (i * frames) / (BENCH_SYSEX_BURST * 4); // packed into the first quarter
+        bench_event_t* event = push_event(&state->input, CLAP_EVENT_MIDI_SYSEX, sizeof(clap_event_midi_sysex_t), time);
+        if (!event) return;
+        event->sysex.port_index = 0;
+        event->sysex.buffer = s_sysex;
+        event->sysex.size = BENCH_SYSEX_SIZE;
+    }
+}
+
+// Results
+
+typedef struct bench_result {
+    const char* scenario;
+    uint64_t blocks;
+    uint64_t input_events;
+    uint64_t output_events;
+    uint64_t dropped_events;
+    uint64_t overruns;
+    uint64_t process_errors;
+    double wall_seconds;
+    double realtime_factor;
+    double mean_ns, p50_ns, p90_ns, p99_ns, p999_ns, max_ns;
+    double deadline_ns;
+    bool has_go_stats;
+    clapgo_runtime_stats_t go_before, go_after;
+} bench_result_t;
+
+static int compare_u64(const void* a, const void* b) {
+    uint64_t x = *(const uint64_t*)a, y = *(const uint64_t*)b;
+    return (x > y) - (x < y);
+}
+
+static double percentile(const uint64_t* sorted, uint64_t count, double q) {
+    uint64_t index = (uint64_t)(q * (double)(count - 1) + 0.5);
+    return (double)sorted[index];
+}
+
+static bool query_params(bench_state_t* state) {
+    state->params = (const clap_plugin_params_t*)state->plugin->get_extension(state->plugin, CLAP_EXT_PARAMS);
+    state->param_count = 0;
+    if (!state->params || !state->params->count || !state->params->get_info) return true;
+
+    uint32_t count = state->params->count(state->plugin);
+    for (uint32_t i = 0; i < count && state->param_count < BENCH_MAX_PARAMS; i++) {
+        clap_param_info_t* info = &state->param_info[state->param_count];
+        if (!state->params->get_info(state->plugin, i, info)) continue;
+        if (info->flags & CLAP_PARAM_IS_READONLY) continue;
+        state->param_count++;
+    }
+    return true;
+}
+
+static void query_ports(const clap_plugin_t* plugin, bool is_input, uint32_t* channels) {
+    const clap_plugin_audio_ports_t* ports =
+        (const clap_plugin_audio_ports_t*)plugin->get_extension(plugin, CLAP_EXT_AUDIO_PORTS);
+    *channels = 0;
+    if (!ports || !ports->count || !ports->get || ports->count(plugin, is_input) == 0) {
+        // No audio ports extension: assume stereo out, nothing in
+        *channels = is_input ? 0 : 2;
+        return;
+    }
+    clap_audio_port_info_t info;
+    memset(&info, 0, sizeof(info));
+    if (ports->get(plugin, 0, is_input, &info)) {
+        *channels = info.channel_count < BENCH_MAX_CHANNELS ? info.channel_count : BENCH_MAX_CHANNELS;
+    }
+}
+
+static bool run_scenario(bench_state_t* state, clapgo_runtime_stats_fn go_stats, int scenario,
+                         const char* name, bench_result_t* result) {
+    const bench_options_t* options = state->options;
+    const clap_plugin_t* plugin = state->plugin;
+    uint32_t frames = options->block_size;
+
+    memset(result, 0, sizeof(*result));
+    result->scenario = name;
+
+    uint32_t in_channels, out_channels;
+    query_ports(plugin, true, &in_channels);
+    query_ports(plugin, false, &out_channels);
+
+    // Audio buffers: inputs carry a quiet sine so effects have work to do
+    float* storage = calloc((size_t)(in_channels + out_channels) * frames, sizeof(float));
+    float* in_data[BENCH_MAX_CHANNELS];
+    float* out_data[BENCH_MAX_CHANNELS];
+    if (!storage) return false;
+    for (uint32_t c = 0; c < in_channels; c++) {
+        in_data[c] = storage + (size_t)c * frames;
+    }
+    for (uint32_t c = 0; c < out_channels; c++) {
+        out_data[c] = storage + (size_t)(in_channels + c) * frames;
+    }
+
+    clap_audio_buffer_t in_buffer = { .data32 = in_data, .channel_count = in_channels };
+    clap_audio_buffer_t out_buffer = { .data32 = out_data, .channel_count = out_channels };
+    clap_input_events_t in_events = { .ctx = &state->input, .size = input_size, .get = input_get };
+    clap_output_events_t out_events = { .ctx = state, .try_push = output_try_push };
+    clap_process_t process = {
+        .frames_count = frames,
+        .audio_inputs = in_channels ? &in_buffer : NULL,
+        .audio_inputs_count = in_channels ? 1 : 0,
+        .audio_outputs = out_channels ? &out_buffer : NULL,
+        .audio_outputs_count = out_channels ? 1 : 0,
+        .in_events = &in_events,
+        .out_events = &out_events,
+    };
+
+    uint64_t measured = (uint64_t)(options->seconds * options->sample_rate / frames);
+    if (measured == 0) measured = 1;
+    uint64_t* block_ns = malloc(measured * sizeof(uint64_t));
+    if (!block_ns) {
+        free(storage);
+        return false;
+    }
+
+    state->note_count = 0;
+    state->next_chord = 0;
+    state->next_param = 0;
+    state->output_events = 0;
+    state->input.dropped = 0;
+    plugin->reset(plugin);
+
+    uint64_t total = options->warmup_blocks + measured;
+    uint64_t wall = 0;
+    result->deadline_ns = (double)frames / options->sample_rate * 1e9;
+
+    for (uint64_t block = 0; block < total; block++) {
+        bool timed = block >= options->warmup_blocks;
+        int64_t block_start = (int64_t)(block * frames);
+
+        if (timed && block == options->warmup_blocks && go_stats) {
+            go_stats(0, &result->go_before);
+            result->has_go_stats = true;
+        }
+
+        // Build this block's input outside the timed region
+        for (uint32_t c = 0; c < in_channels; c++) {
+            for (uint32_t i = 0; i < frames; i++) {
+                in_data[c][i] = 0.25f * (float)sin((double)(block_start + i) * 2.0 * M_PI * 220.0 / options->sample_rate);
+            }
+        }
+        state->input.count = 0;
+        if (scenario & SCENARIO_AUTOMATION) generate_automation(state, block_start, frames);
+        if (scenario & SCENARIO_MPE) generate_mpe(state, block_start, frames);
+        if (scenario & SCENARIO_SYSEX) generate_sysex(state, frames);
+        sort_events(&state->input);
+
+        process.steady_time = block_start;
+
+        state->in_process = true;
+        uint64_t start = bench_now_ns();
+        clap_process_status status = plugin->process(plugin, &process);
+        uint64_t elapsed = bench_now_ns() - start;
+        state->in_process = false;
+
+        if (status == CLAP_PROCESS_ERROR) result->process_errors++;
+
+        if (timed) {
+            uint64_t index = block - options->warmup_blocks;
+            block_ns[index] = elapsed;
+            wall += elapsed;
+            result->input_events += state->input.count;
+            if ((double)elapsed > result->deadline_ns) result->overruns++;
+        }
+
+        // The host is its own main thread: honour callbacks between blocks
+        if (state->callback_requested) {
+            state->callback_requested = false;
+            plugin->on_main_thread(plugin);
+        }
+    }
+
+    if (result->has_go_stats) {
+        go_stats(result->go_before.num_gc, &result->go_after);
+    }
+
+    result->blocks = measured;
+    result->output_events = state->output_events;
+    result->dropped_events = state->input.dropped;
+    result->wall_seconds = (double)wall / 1e9;
+    result->realtime_factor = wall > 0 ? ((double)measured * frames / options->sample_rate) / result->wall_seconds : 0;
+
+    qsort(block_ns, measured, sizeof(uint64_t), compare_u64);
+    result->mean_ns = (double)wall / (double)measured;
+    result->p50_ns = percentile(block_ns, measured, 0.50);
+    result->p90_ns = percentile(block_ns, measured, 0.90);
+    result->p99_ns = percentile(block_ns, measured, 0.99);
+    result->p999_ns = percentile(block_ns, measured, 0.999);
+    result->max_ns = (double)block_ns[measured - 1];
+
+    free(block_ns);
+    free(storage);
+    return true;
+}
+
+static void json_string(FILE* out, const char* s) {
+    fputc('"', out);
+    for (; s && *s; s++) {
+        unsigned char c = (unsigned char)*s;
+        if (c == '"' || c == '\\') {
+            fprintf(out, "\\%c", c);
+        } else if (c < 0x20) {
+            fprintf(out, "\\u%04x", c);
+        } else {
+            fputc(c, out);
+        }
+    }
+    fputc('"', out);
+}
+
+static void write_json(FILE* out, const bench_options_t* options, const clap_plugin_descriptor_t* desc,
+                       const bench_result_t* results, uint32_t count) {
+    fprintf(out, "{\n  \"host\": \"clapgo-bench\",\n  \"plugin_path\": ");
+    json_string(out, options->plugin_path);
+    fprintf(out, ",\n  \"plugin_id\": ");
+    json_string(out, desc->id);
+    fprintf(out, ",\n  \"plugin_version\": ");
+    json_string(out, desc->version);
+    fprintf(out, ",\n  \"sample_rate\": %.0f,\n  \"block_size\": %u,\n  \"runs\": [",
+            options->sample_rate, options->block_size);
+
+    for (uint32_t i = 0; i < count; i++) {
+        const bench_result_t* r = &results[i];
+        fprintf(out, "%s\n    {\n      \"scenario\": ", i ? "," : "");
+        json_string(out, r->scenario);
+        fprintf(out, ",\n      \"blocks\": %llu,\n", (unsigned long long)r->blocks);
+        fprintf(out, "      \"input_events\": %llu,\n", (unsigned long long)r->input_events);
+        fprintf(out, "      \"output_events\": %llu,\n", (unsigned long long)r->output_events);
+        fprintf(out, "      \"dropped_events\": %llu,\n", (unsigned long long)r->dropped_events);
+        fprintf(out, "      \"process_errors\": %llu,\n", (unsigned long long)r->process_errors);
+        fprintf(out, "      \"wall_seconds\": %.6f,\n", r->wall_seconds);
+        fprintf(out, "      \"realtime_factor\": %.2f,\n", r->realtime_factor);
+        fprintf(out, "      \"deadline_ns\": %.0f,\n", r->deadline_ns);
+        fprintf(out, "      \"overruns\": %llu,\n", (unsigned long long)r->overruns);
+        fprintf(out, "      \"block_ns\": { \"mean\": %.0f, \"p50\": %.0f, \"p90\": %.0f, "
+                     "\"p99\": %.0f, \"p999\": %.0f, \"max\": %.0f },\n",
+                r->mean_ns, r->p50_ns, r->p90_ns, r->p99_ns, r->p999_ns, r->max_ns);
+        if (r->has_go_stats) {
+            const clapgo_runtime_stats_t* a = &r->go_before;
+            const clapgo_runtime_stats_t* b = &r->go_after;
+            fprintf(out, "      \"go\": { \"mallocs\": %llu, \"alloc_bytes\": %llu, \"gc_cycles\": %u, "
+                         "\"gc_pause_total_ns\": %llu, \"gc_pause_max_ns\": %llu, \"heap_bytes\": %llu }\n",
+                    (unsigned long long)(b->mallocs - a->mallocs),
+                    (unsigned long long)(b->total_alloc_bytes - a->total_alloc_bytes),
+                    b->num_gc - a->num_gc,
+                    (unsigned long long)(b->pause_total_ns - a->pause_total_ns),
+                    (unsigned long long)b->pause_max_ns,
+                    (unsigned long long)b->heap_alloc_bytes);
+        } else {
+            fprintf(out, "      \"go\": null\n");
+        }
+        fprintf(out, "    }");
+    }
+    fprintf(out, "\n  ]\n}\n");
+}
+
+static void usage(const char* program) {
+    fprintf(stderr,
+        "usage: %s <plugin.clap> [options]\n"
+        "  --id <plugin-id>        plugin to load (default: the first)\n"
+        "  --rate <hz>             sample rate (default 48000)\n"
+        "  --block <frames>        block size (default 256)\n"
+        "  --seconds <s>           measured audio per run (default 10)\n"
+        "  --warmup <blocks>       untimed blocks before each run (default 100)\n"
+        "  --interval <frames>     samples between automation points (default 16)\n"
+        "  --scenario <list>       comma-separated: silence,automation,mpe,sysex,all\n"
+        "                          (default all; each name is its own run)\n"
+        "  --output <file>         write JSON here instead of stdout\n"
+        "  --verbose               print plugin log messages\n",
+        program);
+}
+
+static int parse_scenarios(const char* list) {
+    int scenarios = 0;
+    char buffer[256];
+    snprintf(buffer, sizeof(buffer), "%s", list);
+    for (char* name = strtok(buffer, ","); name; name = strtok(NULL, ",")) {
+        if (strcmp(name, "all") == 0) {
+            for (size_t i = 0; i < SCENARIO_COUNT; i++) scenarios |= s_scenarios[i].flag;
+            continue;
+        }
+        bool found = false;
+        for (size_t i = 0; i < SCENARIO_COUNT; i++) {
+            if (strcmp(name, s_scenarios[i].name) == 0) {
+                scenarios |= s_scenarios[i].flag;
+                found = true;
+            }
+        }
+        if (!found) {
+            fprintf(stderr, "Error: unknown scenario '%s'\n", name);
+            return -1;
+        }
+    }
+    return scenarios;
+}
+
+static bool parse_options(int argc, char** argv, bench_options_t* options) {
+    *options = (bench_options_t){
+        .sample_rate = 48000.0,
+        .block_size = 256,
+        .seconds = 10.0,
+        .warmup_blocks = 100,
+        .automation_interval = 16,
+        .scenarios = SCENARIO_SILENCE | SCENARIO_AUTOMATION | SCENARIO_MPE | SCENARIO_SYSEX,
+    };
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : NULL;
+        if (strcmp(arg, "--verbose") == 0) {
+            options->verbose = true;
+        } else if (arg[0] != '-') {
+            options->plugin_path = arg;
+        } else if (!value) {
+            fprintf(stderr, "Error: %s needs a value\n", arg);
+            return false;
+        } else {
+            i++;
+            if (strcmp(arg, "--id") == 0) options->plugin_id = value;
+            else if (strcmp(arg, "--rate") == 0) options->sample_rate = atof(value);
+            else if (strcmp(arg, "--block") == 0) options->block_size = (uint32_t)atoi(value);
+            else if (strcmp(arg, "--seconds") == 0) options->seconds = atof(value);
+            else if (strcmp(arg, "--warmup") == 0) options->warmup_blocks = (uint32_t)atoi(value);
+            else if (strcmp(arg, "--interval") == 0) options->automation_interval = (uint32_t)atoi(value);
+            else if (strcmp(arg, "--output") == 0) options->output_path = value;
+            else if (strcmp(arg, "--scenario") == 0) {
+                options->scenarios = parse_scenarios(value);
+                if (options->scenarios <= 0) return false;
+            } else {
+                fprintf(stderr, "Error: unknown option %s\n", arg);
+                return false;
+            }
+        }
+    }
+
+    if (!options->plugin_path || options->sample_rate <= 0 || options->block_size == 0 ||
+        options->seconds <= 0 || options->automation_interval == 0) {
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    bench_options_t options;
+    if (!parse_options(argc, argv, &options)) {
+        usage(argv[0]);
+        return 2;
+    }
+    s_state.options = &options;
+    for (size_t i = 0; i < sizeof(s_sysex); i++) s_sysex[i] = (uint8_t)(i & 0x7f);
+    s_sysex[0] = 0xf0;
+    s_sysex[sizeof(s_sysex) - 1] = 0xf7;
+
+    bench_library_t library = bench_dlopen(options.plugin_path);
+    if (!library) {
+        fprintf(stderr, "Error: cannot load %s\n", options.plugin_path);
+        return 1;
+    }
+
+    const clap_plugin_entry_t* entry = (const clap_plugin_entry_t*)bench_dlsym(library, "clap_entry");
+    clapgo_runtime_stats_fn go_stats = (clapgo_runtime_stats_fn)bench_dlsym(library, CLAPGO_RUNTIME_STATS_SYMBOL);
+    if (!entry || !entry->init(options.plugin_path)) {
+        fprintf(stderr, "Error: %s has no usable clap_entry\n", options.plugin_path);
+        bench_dlclose(library);
+        return 1;
+    }
+
+    int status = 1;
+    const clap_plugin_factory_t* factory = (const clap_plugin_factory_t*)entry->get_factory(CLAP_PLUGIN_FACTORY_ID);
+    if (!factory || factory->get_plugin_count(factory) == 0) {
+        fprintf(stderr, "Error: no plugin factory\n");
+        goto deinit;
+    }
+
+    const char* plugin_id = options.plugin_id;
+    if (!plugin_id) plugin_id = factory->get_plugin_descriptor(factory, 0)->id;
+
+    const clap_plugin_t* plugin = factory->create_plugin(factory, &s_host, plugin_id);
+    if (!plugin || !plugin->init(plugin)) {
+        fprintf(stderr, "Error: cannot create plugin %s\n", plugin_id);
+        if (plugin) plugin->destroy(plugin);
+        goto deinit;
+    }
+    s_state.plugin = plugin;
+    query_params(&s_state);
+
+    if (!plugin->activate(plugin, options.sample_rate, options.block_size, options.block_size) ||
+        !plugin->start_processing(plugin)) {
+        fprintf(stderr, "Error: cannot activate plugin %s\n", plugin_id);
+        plugin->destroy(plugin);
+        goto deinit;
+    }
+
+    bench_result_t results[SCENARIO_COUNT];
+    uint32_t result_count = 0;
+    for (size_t i = 0; i < SCENARIO_COUNT; i++) {
+        if (!(options.scenarios & s_scenarios[i].flag)) continue;
+        if (!run_scenario(&s_state, go_stats, s_scenarios[i].flag, s_scenarios[i].name, &results[result_count])) {
+            fprintf(stderr, "Error: out of memory running %s\n", s_scenarios[i].name);
+            break;
+        }
+        result_count++;
+    }
+
+    plugin->stop_processing(plugin);
+    plugin->deactivate(plugin);
+    if (s_state.callback_requested) plugin->on_main_thread(plugin);
+
+    FILE* out = options.output_path ? fopen(options.output_path, "w") : stdout;
+    if (out) {
+        write_json(out, &options, plugin->desc, results, result_count);
+        if (out != stdout) fclose(out);
+        status = result_count > 0 ? 0 : 1;
+    } else {
+        fprintf(stderr, "Error: cannot write %s\n", options.output_path);
+    }
+
+    plugin->destroy(plugin);
+
+deinit:
+    entry->deinit();
+    bench_dlclose(library);
+    return status;
+}
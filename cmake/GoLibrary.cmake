@@ -73,6 +73,41 @@ function(add_go_library TARGET_NAME)
     set(${TARGET_NAME}_INTERFACE ${TARGET_NAME}_interface PARENT_SCOPE)
 endfunction()
 
+# Function to place a plugin's JSON manifest next to it and compile the
+# binary manifest cache, which the bridge maps instead of parsing the JSON
+function(add_clap_manifest TARGET_NAME)
+    cmake_parse_arguments(ARG "" "MANIFEST" "" ${ARGN})
+    
+    if(NOT ARG_MANIFEST)
+        set(ARG_MANIFEST ${CMAKE_CURRENT_SOURCE_DIR}/${TARGET_NAME}.json)
+    endif()
+    
+    set(OUTPUT_JSON "${CMAKE_CURRENT_BINARY_DIR}/${TARGET_NAME}.json")
+    set(OUTPUT_CACHE "${CMAKE_CURRENT_BINARY_DIR}/${TARGET_NAME}.manifest.bin")
+    
+    # The cache layout is defined by the generator and pkg/manifest
+    file(GLOB MANIFEST_TOOL_SOURCES
+        ${CMAKE_SOURCE_DIR}/cmd/generate-manifest/*.go
+        ${CMAKE_SOURCE_DIR}/pkg/manifest/*.go
+    )
+    
+    add_custom_command(
+        OUTPUT ${OUTPUT_JSON} ${OUTPUT_CACHE}
+        COMMAND ${CMAKE_COMMAND} -E copy ${ARG_MANIFEST} ${OUTPUT_JSON}
+        COMMAND ${CMAKE_COMMAND} -E env
+                GOPATH=${CMAKE_BINARY_DIR}/go
+                ${GO_EXECUTABLE} run ./cmd/generate-manifest
+                -compile ${OUTPUT_JSON}
+                -cache-output ${OUTPUT_CACHE}
+        DEPENDS ${ARG_MANIFEST} ${MANIFEST_TOOL_SOURCES}
+        WORKING_DIRECTORY ${CMAKE_SOURCE_DIR}
+        COMMENT "Compiling manifest cache for ${TARGET_NAME}"
+    )
+    
+    add_custom_target(${TARGET_NAME}-manifest ALL DEPENDS ${OUTPUT_JSON} ${OUTPUT_CACHE})
+    add_dependencies(${TARGET_NAME} ${TARGET_NAME}-manifest)
+endfunction()
+
 # Function to create a CLAP plugin
 function(add_clap_plugin TARGET_NAME)
     cmake_parse_arguments(ARG "" "" "SOURCES;LINK_LIBRARIES" ${ARGN})
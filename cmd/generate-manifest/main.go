@@ -4,9 +4,11 @@ package main
 
 import (
 	"bufio"
+	"bytes"
 	"encoding/json"
 	"flag"
 	"fmt"
+	"go/format"
 	"os"
 	"path/filepath"
 	"strings"
@@ -39,6 +41,11 @@ var (
 	// Interactive mode
 	interactive       = flag.Bool("interactive", false, "Interactive plugin creation wizard")
 	
+	// Manifest cache flags
+	writeCache        = flag.Bool("cache", true, "Also write the binary manifest cache the bridge loads without parsing JSON")
+	compileManifest   = flag.String("compile", "", "Compile an existing JSON manifest into its binary cache and exit")
+	cacheOutput       = flag.String("cache-output", "", "Output path for -compile (default: next to the JSON manifest)")
+	
 	// Platform detection
 	platform          = flag.String("platform", detectPlatform(), "Platform (linux, macos, or windows)")
 )
@@ -341,9 +348,26 @@ func getPluginExtensions(pluginType string) []manifest.Extension {
 	return extensions
 }
 
+// writeManifestCache compiles the JSON manifest at jsonPath into its binary
+// cache, exiting on failure
+func writeManifestCache(jsonPath, cachePath string) {
+	cachePath, err := manifest.CompileCache(jsonPath, cachePath)
+	if err != nil {
+		fmt.Printf("Error writing manifest cache: %v\n", err)
+		os.Exit(1)
+	}
+	fmt.Printf("Manifest cache written to %s\n", cachePath)
+}
+
 func main() {
 	flag.Parse()
 	
+	// Compile an existing manifest, as the build does for the examples
+	if *compileManifest != "" {
+		writeManifestCache(*compileManifest, *cacheOutput)
+		return
+	}
+	
 	// Run interactive wizard if requested
 	if *interactive {
 		runInteractiveWizard()
@@ -424,6 +448,10 @@ func main() {
 	
 	fmt.Printf("Manifest file written to %s\n", outputPath)
 	
+	if *writeCache {
+		writeManifestCache(outputPath, "")
+	}
+	
 	// Generate code files if requested
 	if *generateCode && *outputDir != "" {
 		err = generatePluginCode(*outputDir, manifest, *pluginType, *libName)
@@ -453,7 +481,9 @@ func generatePluginCode(dir string, m manifest.Manifest, pluginType, libName str
 		PluginDescription: m.Plugin.Description,
 		PluginVersion: m.Plugin.Version,
 		PluginURL:    m.Plugin.URL,
+		Supported:    generatedExtensions(m.Extensions),
 	}
+	data.AudioInput, data.AudioOutput, data.NoteInput, data.NoteOutput = pluginPorts(pluginType)
 	
 	// Generate exports_generated.go
 	err := generateFile(filepath.Join(dir, "exports_generated.go"), exportsTemplate, data)
@@ -505,6 +535,73 @@ type TemplateData struct {
 	PluginDescription string
 	PluginVersion string
 	PluginURL    string
+	
+	// Manifest extensions the exports template emits exports for
+	Supported    map[string]bool
+	
+	// Ports the plugin skeleton declares
+	AudioInput   bool
+	AudioOutput  bool
+	NoteInput    bool
+	NoteOutput   bool
+}
+
+// Has reports whether the generated exports implement an extension
+func (d TemplateData) Has(id string) bool {
+	return d.Supported[id]
+}
+
+// exportedExtensions are the extensions exportsTemplate can generate. The
+// bridge derives its supports flags from the exports a library has, so
+// generating only the manifest's leaves the rest unsupported at no cost.
+var exportedExtensions = map[string]bool{
+	"clap.params":          true,
+	"clap.state":           true,
+	"clap.audio-ports":     true,
+	"clap.note-ports":      true,
+	"clap.latency":         true,
+	"clap.tail":            true,
+	"clap.timer-support":   true,
+	"clap.track-info":      true,
+	"clap.remote-controls": true,
+}
+
+// hostExtensions are manifest entries for extensions the plugin uses from
+// the host, which need no exports
+var hostExtensions = map[string]bool{
+	"clap.log":          true,
+	"clap.thread-check": true,
+}
+
+// generatedExtensions picks the supported manifest extensions that get
+// generated exports, and points out the ones left to hand-written code
+func generatedExtensions(extensions []manifest.Extension) map[string]bool {
+	generated := make(map[string]bool)
+	for _, ext := range extensions {
+		if !ext.Supported || hostExtensions[ext.ID] {
+			continue
+		}
+		if exportedExtensions[ext.ID] {
+			generated[ext.ID] = true
+		} else {
+			fmt.Printf("Note: no generated exports for %s; implement them by hand if the plugin provides it\n", ext.ID)
+		}
+	}
+	return generated
+}
+
+// pluginPorts returns the audio and note ports a plugin type starts with
+func pluginPorts(pluginType string) (audioIn, audioOut, noteIn, noteOut bool) {
+	switch pluginType {
+	case "instrument":
+		return false, true, true, false
+	case "note-effect":
+		return false, false, true, true
+	case "note-detector":
+		return true, false, false, true
+	default:
+		return true, true, false, false
+	}
 }
 
 func generatePresetScaffolding(dir string, data TemplateData) error {
@@ -655,13 +752,16 @@ func generateFile(path, tmplStr string, data interface{}) error {
 		return err
 	}
 	
-	file, err := os.Create(path)
-	if err != nil {
+	var buf bytes.Buffer
+	if err := tmpl.Execute(&buf, data); err != nil {
 		return err
 	}
-	defer file.Close()
 	
-	return tmpl.Execute(file, data)
+	source, err := format.Source(buf.Bytes())
+	if err != nil {
+		return fmt.Errorf("formatting %s: %w", path, err)
+	}
+	return os.WriteFile(path, source, 0644)
 }
 
 func toCamelCase(s string) string {
@@ -675,62 +775,41 @@ func toCamelCase(s string) string {
 }
 
 const exportsTemplate = `// Code generated by clapgo-generate. DO NOT EDIT.
-// This file contains all CGO exports required by the CLAP plugin API.
-// All plugin lifecycle and extension callbacks are handled here.
+// This file contains the CGO exports the C bridge calls for {{.StructName}}.
+// ClapGo_CreatePlugin pins each instance and hands the bridge its address,
+// which go_plugin_data_t keeps and passes back to every export, so the
+// calls below dispatch on *{{.StructName}} without a handle lookup. Only the
+// extensions the manifest supports are exported; the bridge probes the
+// export set once, so a missing extension costs nothing per instance.
 package main
 
 // #cgo CFLAGS: -I../../include/clap/include
 // #include "../../include/clap/include/clap/clap.h"
 // #include <stdlib.h>
-//
-// // Helper functions for CLAP event handling
-// static inline uint32_t clap_input_events_size_helper(const clap_input_events_t* events) {
-//     if (events && events->size) {
-//         return events->size(events);
-//     }
-//     return 0;
-// }
-//
-// static inline const clap_event_header_t* clap_input_events_get_helper(const clap_input_events_t* events, uint32_t index) {
-//     if (events && events->get) {
-//         return events->get(events, index);
-//     }
-//     return NULL;
-// }
 import "C"
 import (
-	"fmt"
-	"runtime/cgo"
 	"unsafe"
-	
-	"github.com/justyntemme/clapgo/pkg/api"
+{{if or (.Has "clap.audio-ports") (.Has "clap.note-ports")}}
+	"github.com/justyntemme/clapgo/pkg/audio"
+{{- end}}
+{{- if .Has "clap.remote-controls"}}
+	"github.com/justyntemme/clapgo/pkg/controls"
+{{- end}}
+	"github.com/justyntemme/clapgo/pkg/plugin"
+	"github.com/justyntemme/clapgo/pkg/thread"
 )
 
-// Global plugin instance
-var {{.PluginVarName}} *{{.StructName}}
-
-func init() {
-	fmt.Println("Initializing {{.PluginName}} plugin")
-	{{.PluginVarName}} = New{{.StructName}}()
-	fmt.Printf("{{.PluginName}} plugin initialized: %s (%s)\n", {{.PluginVarName}}.GetPluginInfo().Name, {{.PluginVarName}}.GetPluginInfo().ID)
-}
-
-// Standardized export functions for manifest system
+// Pinned instances the C bridge dispatches on directly
+var instances plugin.Instances[{{.StructName}}]
 
 //export ClapGo_CreatePlugin
-func ClapGo_CreatePlugin(host unsafe.Pointer, pluginID *C.char) unsafe.Pointer {
-	id := C.GoString(pluginID)
-	fmt.Printf("{{.PluginName}} plugin - ClapGo_CreatePlugin with ID: %s\n", id)
-	
-	if id == PluginID {
-		// Create a CGO handle to safely pass the Go object to C
-		handle := cgo.NewHandle({{.PluginVarName}})
-		fmt.Printf("Created plugin instance: %s\n", id)
-		return unsafe.Pointer(handle)
+func ClapGo_CreatePlugin(host unsafe.Pointer, pluginID *C.char) uintptr {
+	if C.GoString(pluginID) != PluginID {
+		return 0
 	}
-	
-	fmt.Printf("Error: Unknown plugin ID: %s\n", id)
-	return nil
+	p := New{{.StructName}}()
+	p.InitWithHost(host)
+	return instances.Add(p)
 }
 
 //export ClapGo_GetVersion
@@ -749,283 +828,229 @@ func ClapGo_GetVersion(major, minor, patch *C.uint32_t) C.bool {
 
 //export ClapGo_GetPluginID
 func ClapGo_GetPluginID(pluginID *C.char) *C.char {
-	return C.CString({{.PluginVarName}}.GetPluginID())
+	return C.CString(PluginID)
 }
 
 //export ClapGo_GetPluginName
 func ClapGo_GetPluginName(pluginID *C.char) *C.char {
-	return C.CString({{.PluginVarName}}.GetPluginInfo().Name)
+	return C.CString(PluginName)
 }
 
 //export ClapGo_GetPluginVendor
 func ClapGo_GetPluginVendor(pluginID *C.char) *C.char {
-	return C.CString({{.PluginVarName}}.GetPluginInfo().Vendor)
+	return C.CString(PluginVendor)
 }
 
 //export ClapGo_GetPluginVersion
 func ClapGo_GetPluginVersion(pluginID *C.char) *C.char {
-	return C.CString({{.PluginVarName}}.GetPluginInfo().Version)
+	return C.CString(PluginVersion)
 }
 
 //export ClapGo_GetPluginDescription
 func ClapGo_GetPluginDescription(pluginID *C.char) *C.char {
-	return C.CString({{.PluginVarName}}.GetPluginInfo().Description)
+	return C.CString(PluginDescription)
 }
 
+// The bridge never calls the exports below without an instance
+
 //export ClapGo_PluginInit
 func ClapGo_PluginInit(plugin unsafe.Pointer) C.bool {
-	if plugin == nil {
-		return C.bool(false)
-	}
-	p := cgo.Handle(plugin).Value().(*{{.StructName}})
-	return C.bool(p.Init())
+	return C.bool(instances.Get(plugin).Init())
 }
 
 //export ClapGo_PluginDestroy
 func ClapGo_PluginDestroy(plugin unsafe.Pointer) {
-	if plugin == nil {
-		return
-	}
-	handle := cgo.Handle(plugin)
-	p := handle.Value().(*{{.StructName}})
-	p.Destroy()
-	handle.Delete()
+	instances.Get(plugin).Destroy()
+	instances.Remove(plugin)
 }
 
 //export ClapGo_PluginActivate
 func ClapGo_PluginActivate(plugin unsafe.Pointer, sampleRate C.double, minFrames, maxFrames C.uint32_t) C.bool {
-	if plugin == nil {
-		return C.bool(false)
-	}
-	p := cgo.Handle(plugin).Value().(*{{.StructName}})
-	return C.bool(p.Activate(float64(sampleRate), uint32(minFrames), uint32(maxFrames)))
+	return C.bool(instances.Get(plugin).Activate(float64(sampleRate), uint32(minFrames), uint32(maxFrames)))
 }
 
 //export ClapGo_PluginDeactivate
 func ClapGo_PluginDeactivate(plugin unsafe.Pointer) {
-	if plugin == nil {
-		return
-	}
-	p := cgo.Handle(plugin).Value().(*{{.StructName}})
-	p.Deactivate()
+	instances.Get(plugin).Deactivate()
 }
 
 //export ClapGo_PluginStartProcessing
 func ClapGo_PluginStartProcessing(plugin unsafe.Pointer) C.bool {
-	if plugin == nil {
-		return C.bool(false)
-	}
-	p := cgo.Handle(plugin).Value().(*{{.StructName}})
-	return C.bool(p.StartProcessing())
+	thread.MarkAudioThread()
+	defer thread.UnmarkAudioThread()
+	return C.bool(instances.Get(plugin).StartProcessing())
 }
 
 //export ClapGo_PluginStopProcessing
 func ClapGo_PluginStopProcessing(plugin unsafe.Pointer) {
-	if plugin == nil {
-		return
-	}
-	p := cgo.Handle(plugin).Value().(*{{.StructName}})
-	p.StopProcessing()
+	thread.MarkAudioThread()
+	defer thread.UnmarkAudioThread()
+	instances.Get(plugin).StopProcessing()
 }
 
 //export ClapGo_PluginReset
 func ClapGo_PluginReset(plugin unsafe.Pointer) {
-	if plugin == nil {
-		return
-	}
-	p := cgo.Handle(plugin).Value().(*{{.StructName}})
-	p.Reset()
+	instances.Get(plugin).Reset()
 }
 
 //export ClapGo_PluginProcess
 func ClapGo_PluginProcess(plugin unsafe.Pointer, process unsafe.Pointer) C.int32_t {
-	if plugin == nil || process == nil {
-		return C.int32_t(api.ProcessError)
-	}
-	
-	handle := cgo.Handle(plugin)
-	p := handle.Value().(*{{.StructName}})
-	
-	// Convert the C clap_process_t to Go parameters
-	cProcess := (*C.clap_process_t)(process)
-	
-	// Extract steady time and frame count
-	steadyTime := int64(cProcess.steady_time)
-	framesCount := uint32(cProcess.frames_count)
-	
-	// Convert audio buffers using our abstraction - NO MORE MANUAL CONVERSION!
-	audioIn := api.ConvertFromCBuffers(unsafe.Pointer(cProcess.audio_inputs), uint32(cProcess.audio_inputs_count), framesCount)
-	audioOut := api.ConvertFromCBuffers(unsafe.Pointer(cProcess.audio_outputs), uint32(cProcess.audio_outputs_count), framesCount)
-	
-	// Create event handler using the new abstraction - NO MORE MANUAL EVENT HANDLING!
-	eventHandler := api.NewEventProcessor(
-		unsafe.Pointer(cProcess.in_events),
-		unsafe.Pointer(cProcess.out_events),
-	)
-	
-	// Call the actual Go process method
-	result := p.Process(steadyTime, framesCount, audioIn, audioOut, eventHandler)
-	
-	return C.int32_t(result)
+	thread.MarkAudioThread()
+	defer thread.UnmarkAudioThread()
+	return C.int32_t(instances.Get(plugin).ProcessWithHandle(process))
 }
 
 //export ClapGo_PluginGetExtension
 func ClapGo_PluginGetExtension(plugin unsafe.Pointer, id *C.char) unsafe.Pointer {
-	if plugin == nil {
-		return nil
-	}
-	p := cgo.Handle(plugin).Value().(*{{.StructName}})
-	extID := C.GoString(id)
-	return p.GetExtension(extID)
+	return instances.Get(plugin).GetExtension(C.GoString(id))
 }
 
 //export ClapGo_PluginOnMainThread
 func ClapGo_PluginOnMainThread(plugin unsafe.Pointer) {
-	if plugin == nil {
-		return
-	}
-	p := cgo.Handle(plugin).Value().(*{{.StructName}})
-	p.OnMainThread()
+	instances.Get(plugin).OnMainThread()
 }
-
+{{if .Has "clap.params"}}
 //export ClapGo_PluginParamsCount
 func ClapGo_PluginParamsCount(plugin unsafe.Pointer) C.uint32_t {
-	if plugin == nil {
-		return 0
-	}
-	p := cgo.Handle(plugin).Value().(*{{.StructName}})
-	return C.uint32_t(p.paramManager.GetParameterCount())
+	return C.uint32_t(instances.Get(plugin).ParamManager.Count())
 }
 
 //export ClapGo_PluginParamsGetInfo
 func ClapGo_PluginParamsGetInfo(plugin unsafe.Pointer, index C.uint32_t, info unsafe.Pointer) C.bool {
-	if plugin == nil || info == nil {
-		return C.bool(false)
-	}
-	p := cgo.Handle(plugin).Value().(*{{.StructName}})
-	
-	// Get parameter info from manager
-	paramInfo, err := p.paramManager.GetParameterInfoByIndex(uint32(index))
-	if err != nil {
-		return C.bool(false)
-	}
-	
-	// Convert to C struct
-	cInfo := (*C.clap_param_info_t)(info)
-	cInfo.id = C.clap_id(paramInfo.ID)
-	cInfo.flags = C.CLAP_PARAM_IS_AUTOMATABLE | C.CLAP_PARAM_IS_MODULATABLE
-	cInfo.cookie = nil
-	
-	// Copy name
-	nameBytes := []byte(paramInfo.Name)
-	if len(nameBytes) >= C.CLAP_NAME_SIZE {
-		nameBytes = nameBytes[:C.CLAP_NAME_SIZE-1]
-	}
-	for i, b := range nameBytes {
-		cInfo.name[i] = C.char(b)
-	}
-	cInfo.name[len(nameBytes)] = 0
-	
-	// Clear module path
-	cInfo.module[0] = 0
-	
-	// Set range
-	cInfo.min_value = C.double(paramInfo.MinValue)
-	cInfo.max_value = C.double(paramInfo.MaxValue)
-	cInfo.default_value = C.double(paramInfo.DefaultValue)
-	
-	return C.bool(true)
+	return C.bool(instances.Get(plugin).GetParamInfo(uint32(index), info) == nil)
 }
 
 //export ClapGo_PluginParamsGetValue
 func ClapGo_PluginParamsGetValue(plugin unsafe.Pointer, paramID C.uint32_t, value *C.double) C.bool {
-	if plugin == nil || value == nil {
-		return C.bool(false)
-	}
-	p := cgo.Handle(plugin).Value().(*{{.StructName}})
-	
-	// Get current value from parameter manager
-	val := p.paramManager.GetParameterValue(uint32(paramID))
-	*value = C.double(val)
-	return C.bool(true)
+	return C.bool(instances.Get(plugin).GetParamValue(uint32(paramID), unsafe.Pointer(value)))
 }
 
 //export ClapGo_PluginParamsValueToText
 func ClapGo_PluginParamsValueToText(plugin unsafe.Pointer, paramID C.uint32_t, value C.double, buffer *C.char, size C.uint32_t) C.bool {
-	if plugin == nil || buffer == nil || size == 0 {
-		return C.bool(false)
-	}
-	
-	// TODO: Format parameter value as text based on parameter type
-	// For now, just use a simple format
-	text := fmt.Sprintf("%.2f", float64(value))
-	
-	// Copy to C buffer
-	textBytes := []byte(text)
-	maxLen := int(size) - 1
-	if len(textBytes) > maxLen {
-		textBytes = textBytes[:maxLen]
-	}
-	
-	cBuffer := (*[1 << 30]C.char)(unsafe.Pointer(buffer))
-	for i, b := range textBytes {
-		cBuffer[i] = C.char(b)
-	}
-	cBuffer[len(textBytes)] = 0
-	
-	return C.bool(true)
+	return C.bool(instances.Get(plugin).ParamValueToText(uint32(paramID), float64(value), unsafe.Pointer(buffer), uint32(size)))
 }
 
 //export ClapGo_PluginParamsTextToValue
 func ClapGo_PluginParamsTextToValue(plugin unsafe.Pointer, paramID C.uint32_t, text *C.char, value *C.double) C.bool {
-	if plugin == nil || text == nil || value == nil {
-		return C.bool(false)
-	}
-	
-	// Convert text to Go string
-	goText := C.GoString(text)
-	
-	// Parse the value
-	var val float64
-	if _, err := fmt.Sscanf(goText, "%f", &val); err == nil {
-		*value = C.double(val)
-		return C.bool(true)
-	}
-	
-	return C.bool(false)
+	return C.bool(instances.Get(plugin).ParamTextToValue(uint32(paramID), C.GoString(text), unsafe.Pointer(value)))
 }
 
 //export ClapGo_PluginParamsFlush
 func ClapGo_PluginParamsFlush(plugin unsafe.Pointer, inEvents unsafe.Pointer, outEvents unsafe.Pointer) {
-	if plugin == nil {
-		return
-	}
-	p := cgo.Handle(plugin).Value().(*{{.StructName}})
-	
-	// Process events using our abstraction
-	if inEvents != nil {
-		eventHandler := api.NewEventProcessor(inEvents, outEvents)
-		p.processEvents(eventHandler, 0)
-	}
+	instances.Get(plugin).ParamsFlush(inEvents, outEvents)
 }
-
+{{end}}
+{{- if .Has "clap.state"}}
 //export ClapGo_PluginStateSave
 func ClapGo_PluginStateSave(plugin unsafe.Pointer, stream unsafe.Pointer) C.bool {
-	if plugin == nil || stream == nil {
-		return C.bool(false)
-	}
-	p := cgo.Handle(plugin).Value().(*{{.StructName}})
-	return C.bool(p.SaveState(stream))
+	return C.bool(instances.Get(plugin).SaveState(stream) == nil)
 }
 
 //export ClapGo_PluginStateLoad
 func ClapGo_PluginStateLoad(plugin unsafe.Pointer, stream unsafe.Pointer) C.bool {
-	if plugin == nil || stream == nil {
-		return C.bool(false)
+	return C.bool(instances.Get(plugin).LoadState(stream) == nil)
+}
+{{end}}
+{{- if .Has "clap.audio-ports"}}
+//export ClapGo_PluginAudioPortsCount
+func ClapGo_PluginAudioPortsCount(plugin unsafe.Pointer, isInput C.bool) C.uint32_t {
+	return C.uint32_t(instances.Get(plugin).GetAudioPortCount(bool(isInput)))
+}
+
+//export ClapGo_PluginAudioPortsGet
+func ClapGo_PluginAudioPortsGet(plugin unsafe.Pointer, index C.uint32_t, isInput C.bool, info unsafe.Pointer) C.bool {
+	if info == nil {
+		return false
+	}
+	port := instances.Get(plugin).GetAudioPortInfo(uint32(index), bool(isInput))
+	if port.ID == audio.InvalidID {
+		return false
+	}
+	audio.PortInfoToC(port, info)
+	return true
+}
+{{end}}
+{{- if .Has "clap.note-ports"}}
+//export ClapGo_PluginNotePortsCount
+func ClapGo_PluginNotePortsCount(plugin unsafe.Pointer, isInput C.bool) C.uint32_t {
+	ports := instances.Get(plugin).GetNotePortManager()
+	if isInput {
+		return C.uint32_t(ports.GetInputPortCount())
+	}
+	return C.uint32_t(ports.GetOutputPortCount())
+}
+
+//export ClapGo_PluginNotePortsGet
+func ClapGo_PluginNotePortsGet(plugin unsafe.Pointer, index C.uint32_t, isInput C.bool, info unsafe.Pointer) C.bool {
+	if info == nil {
+		return false
+	}
+	ports := instances.Get(plugin).GetNotePortManager()
+	var port *audio.NotePortInfo
+	if isInput {
+		port = ports.GetInputPort(uint32(index))
+	} else {
+		port = ports.GetOutputPort(uint32(index))
+	}
+	if port == nil {
+		return false
+	}
+
+	cInfo := (*C.clap_note_port_info_t)(info)
+	cInfo.id = C.clap_id(port.ID)
+	cInfo.supported_dialects = C.uint32_t(port.SupportedDialects)
+	cInfo.preferred_dialect = C.uint32_t(port.PreferredDialect)
+	name := []byte(port.Name)
+	if len(name) >= C.CLAP_NAME_SIZE {
+		name = name[:C.CLAP_NAME_SIZE-1]
+	}
+	for i, b := range name {
+		cInfo.name[i] = C.char(b)
+	}
+	cInfo.name[len(name)] = 0
+	return true
+}
+{{end}}
+{{- if .Has "clap.latency"}}
+//export ClapGo_PluginLatencyGet
+func ClapGo_PluginLatencyGet(plugin unsafe.Pointer) C.uint32_t {
+	return C.uint32_t(instances.Get(plugin).GetLatency())
+}
+{{end}}
+{{- if .Has "clap.tail"}}
+//export ClapGo_PluginTailGet
+func ClapGo_PluginTailGet(plugin unsafe.Pointer) C.uint32_t {
+	return C.uint32_t(instances.Get(plugin).GetTail())
+}
+{{end}}
+{{- if .Has "clap.timer-support"}}
+//export ClapGo_PluginOnTimer
+func ClapGo_PluginOnTimer(plugin unsafe.Pointer, timerID C.uint64_t) {
+	instances.Get(plugin).OnTimer(uint64(timerID))
+}
+{{end}}
+{{- if .Has "clap.track-info"}}
+//export ClapGo_PluginTrackInfoChanged
+func ClapGo_PluginTrackInfoChanged(plugin unsafe.Pointer) {
+	instances.Get(plugin).OnTrackInfoChanged()
+}
+{{end}}
+{{- if .Has "clap.remote-controls"}}
+//export ClapGo_PluginRemoteControlsCount
+func ClapGo_PluginRemoteControlsCount(plugin unsafe.Pointer) C.uint32_t {
+	return C.uint32_t(instances.Get(plugin).GetRemoteControlsPageCount())
+}
+
+//export ClapGo_PluginRemoteControlsGet
+func ClapGo_PluginRemoteControlsGet(plugin unsafe.Pointer, pageIndex C.uint32_t, cPage unsafe.Pointer) C.bool {
+	page, ok := instances.Get(plugin).GetRemoteControlsPage(uint32(pageIndex))
+	if !ok || cPage == nil {
+		return false
 	}
-	p := cgo.Handle(plugin).Value().(*{{.StructName}})
-	return C.bool(p.LoadState(stream))
+	controls.RemoteControlsPageToC(page, cPage)
+	return true
 }
+{{end -}}
 `
 
 const extensionsTemplate = `// Code generated by clapgo-generate. DO NOT EDIT.
@@ -1061,6 +1086,8 @@ const (
 	PluginVendor  = "{{.PluginVendor}}"
 	PluginVersion = "1.0.0"
 	PluginURL     = "https://github.com/justyntemme/clapgo"
+	
+	PluginDescription = "{{.PluginDescription}}"
 )
 
 // Plugin features
@@ -1263,492 +1290,204 @@ const (
 
 const pluginTemplate = `package main
 
+// #include "../../include/clap/include/clap/clap.h"
+import "C"
 import (
-	"math"
-	// "sync/atomic" // Uncomment when using atomic parameter storage
 	"unsafe"
-	
-	"github.com/justyntemme/clapgo/pkg/api"
+
+	"github.com/justyntemme/clapgo/pkg/audio"
+	"github.com/justyntemme/clapgo/pkg/event"
+	"github.com/justyntemme/clapgo/pkg/param"
+	"github.com/justyntemme/clapgo/pkg/plugin"
+	"github.com/justyntemme/clapgo/pkg/process"
 )
 
-// {{.StructName}} implements a {{.PluginType}} plugin.
+// {{.StructName}} implements a {{.PluginType}} plugin. The generated exports
+// call its methods directly; PluginBase provides the ones not written here.
 type {{.StructName}} struct {
-	// Plugin state
-	sampleRate   float64
-	isActivated  bool
-	isProcessing bool
-	host         unsafe.Pointer
-	
-	// Parameters with atomic storage for thread safety
-	// TODO: Add your parameters here with atomic storage
-	// Example: gain int64 // atomic storage for gain value
-	
-	// Parameter management using our new abstraction
-	paramManager *api.ParameterManager
-{{if eq .PluginType "instrument"}}
-	activeVoices int32  // atomic counter for active voices
-{{end}}
+	*plugin.PluginBase
+	*audio.MultiPortProvider
+
+	// Parameters registered from ParameterMetadata, with atomic storage
+	params *param.ParameterBinder
+
+	notePorts *audio.NotePortManager
+
+	// Channel views sized at activation and re-bound every block
+	inputViews  *audio.BufferViews
+	outputViews *audio.BufferViews
+
+	// Event processor reused across blocks
+	events *event.Processor
 }
 
-// New{{.StructName}} creates a new instance of the plugin
+// New{{.StructName}} creates an instance for ClapGo_CreatePlugin
 func New{{.StructName}}() *{{.StructName}} {
-	plugin := &{{.StructName}}{
-		sampleRate:   44100.0,
-		isActivated:  false,
-		isProcessing: false,
-		paramManager: api.NewParameterManager(),
-	}
-	
-	// TODO: Set default parameter values atomically
-	// Example: atomic.StoreInt64(&plugin.gain, int64(floatToBits(1.0)))
-	
-	// TODO: Register parameters using our new abstraction
-	// Example: plugin.paramManager.RegisterParameter(api.CreateFloatParameter(0, "Gain", 0.0, 2.0, 1.0))
-	
-	return plugin
+	p := &{{.StructName}}{
+		PluginBase: plugin.NewPluginBase(plugin.Info{
+			ID:          PluginID,
+			Name:        PluginName,
+			Vendor:      PluginVendor,
+			URL:         PluginURL,
+			Version:     PluginVersion,
+			Description: PluginDescription,
+			Manual:      PluginURL,
+			Support:     PluginURL + "/issues",
+			Features:    PluginFeatures,
+		}),
+		MultiPortProvider: &audio.MultiPortProvider{},
+		notePorts:         audio.NewNotePortManager(),
+	}
+{{if .AudioInput}}
+	p.InputPorts = []audio.PortInfo{audio.CreateStereoPort(0, "Stereo Input", true)}
+{{- end}}
+{{- if .AudioOutput}}
+	p.OutputPorts = []audio.PortInfo{audio.CreateStereoPort(0, "Stereo Output", true)}
+{{- end}}
+{{- if .NoteInput}}
+	p.notePorts.AddInputPort(audio.CreateDefaultInstrumentPort())
+{{- end}}
+{{- if .NoteOutput}}
+	p.notePorts.AddOutputPort(audio.CreateDefaultInstrumentPort())
+{{- end}}
+
+	p.params = param.NewParameterBinder(p.ParamManager)
+	for _, info := range ParameterMetadata {
+		p.params.BindLinear(info.ID, info.Name, info.MinValue, info.MaxValue, info.DefaultValue)
+	}
+
+	return p
 }
 
 // Init initializes the plugin
 func (p *{{.StructName}}) Init() bool {
-	// TODO: Initialize plugin resources
+	if err := p.PluginBase.CommonInit(); err != nil {
+		return false
+	}
+
+	// Process ends every block with ParamManager.EndBlock
+	if err := p.PluginBase.EnableParamChangeQueue(); err != nil {
+		return false
+	}
+
+	// Index the bindings for lock-free audio-thread parameter access
+	p.params.Freeze()
 	return true
 }
 
 // Destroy cleans up plugin resources
 func (p *{{.StructName}}) Destroy() {
-	// TODO: Clean up any allocated resources
+	p.PluginBase.CommonDestroy()
 }
 
 // Activate prepares the plugin for processing
 func (p *{{.StructName}}) Activate(sampleRate float64, minFrames, maxFrames uint32) bool {
-	p.sampleRate = sampleRate
-	p.isActivated = true
-	// TODO: Prepare for processing at the given sample rate
+	if err := p.PluginBase.CommonActivate(sampleRate, minFrames, maxFrames); err != nil {
+		return false
+	}
+
+	// Size the buffer views once so the process call never allocates
+	p.inputViews = audio.NewPortBufferViews(p.MultiPortProvider, true, maxFrames)
+	p.outputViews = audio.NewPortBufferViews(p.MultiPortProvider, false, maxFrames)
+	p.ParamManager.PrepareSmoothers(sampleRate, maxFrames)
+
+	if p.events == nil {
+		p.events = event.NewProcessor(nil, nil)
+		event.SetupPoolLogging(p.events, p.Logger)
+	}
 	return true
 }
 
 // Deactivate stops the plugin from processing
 func (p *{{.StructName}}) Deactivate() {
-	p.isActivated = false
+	p.PluginBase.CommonDeactivate()
 }
 
 // StartProcessing begins audio processing
 func (p *{{.StructName}}) StartProcessing() bool {
-	if !p.isActivated {
-		return false
-	}
-	p.isProcessing = true
-	return true
+	return p.PluginBase.CommonStartProcessing() == nil
 }
 
 // StopProcessing ends audio processing
 func (p *{{.StructName}}) StopProcessing() {
-	p.isProcessing = false
+	p.PluginBase.CommonStopProcessing()
 }
 
 // Reset resets the plugin state
 func (p *{{.StructName}}) Reset() {
-	// TODO: Reset plugin state to defaults
+	p.PluginBase.CommonReset()
+	p.ParamManager.ResetSmoothers()
+	// TODO: Clear delay lines, envelopes and other DSP state
 }
 
-// Process processes audio data using the new abstractions
-func (p *{{.StructName}}) Process(steadyTime int64, framesCount uint32, audioIn, audioOut [][]float32, events api.EventHandler) int {
-	// Check if we're in a valid state for processing
-	if !p.isActivated || !p.isProcessing {
-		return api.ProcessError
+// ProcessWithHandle processes a block straight from the clap_process_t
+// [audio-thread]
+func (p *{{.StructName}}) ProcessWithHandle(processPtr unsafe.Pointer) int {
+	if processPtr == nil || !p.IsActivated || !p.IsProcessing || p.events == nil {
+		return process.ProcessError
 	}
-	
-	// Process events using our new abstraction
-	if events != nil {
-		p.processEvents(events, framesCount)
-	}
-	
-	// TODO: Get current parameter values atomically
-	// Example: gainBits := atomic.LoadInt64(&p.gain)
-	// Example: gain := floatFromBits(uint64(gainBits))
-	
-{{if eq .PluginType "instrument"}}
-	// TODO: Process MIDI events and generate audio
-	// Example:
-	// - Handle note on/off events
-	// - Update voice states
-	// - Generate audio for active voices
-	// - Mix to output
-{{else if or (eq .PluginType "audio-effect") (eq .PluginType "utility")}}
-	// If no audio inputs or outputs, nothing to do
-	if len(audioIn) == 0 || len(audioOut) == 0 {
-		return api.ProcessContinue
-	}
-	
-	// Get the number of channels (use min of input and output)
-	numChannels := len(audioIn)
-	if len(audioOut) < numChannels {
-		numChannels = len(audioOut)
-	}
-	
-	// TODO: Process audio - apply your effect to each sample
-	// Example:
-	// for ch := 0; ch < numChannels; ch++ {
-	//     inChannel := audioIn[ch]
-	//     outChannel := audioOut[ch]
-	//     
-	//     // Make sure we have enough buffer space
-	//     if len(inChannel) < int(framesCount) || len(outChannel) < int(framesCount) {
-	//         continue // Skip this channel if buffer is too small
-	//     }
-	//     
-	//     // Apply effect to each sample
-	//     for i := uint32(0); i < framesCount; i++ {
-	//         outChannel[i] = inChannel[i] * float32(gain)
-	//     }
-	// }
-	// }
-{{else if eq .PluginType "note-effect"}}
-	// TODO: Process MIDI events
-	// Example:
-	// events := p.eventHandler.GetNoteEvents()
-	// for _, event := range events {
-	//     // Transform or generate MIDI events
-	//     p.eventHandler.SendNoteEvent(transformedEvent)
-	// }
-{{else if eq .PluginType "analyzer"}}
-	// TODO: Analyze audio and update metering/display data
-	// Example:
-	// for ch := 0; ch < audio.ChannelCount; ch++ {
-	//     level := calculateRMS(audio.Input[ch])
-	//     p.updateMeter(ch, level)
-	// }
-{{else if eq .PluginType "note-detector"}}
-	// TODO: Analyze audio and generate MIDI events
-	// Example:
-	// pitch := p.detectPitch(audio.Input[0])
-	// if pitch.Confidence > 0.8 {
-	//     note := p.frequencyToMIDI(pitch.Frequency)
-	//     p.eventHandler.SendNoteOn(note, 100)
-	// }
-{{end}}
-	
-	return api.ProcessContinue
-}
 
-// processEvents handles all incoming events using our new EventHandler abstraction
-func (p *{{.StructName}}) processEvents(events api.EventHandler, frameCount uint32) {
-	if events == nil {
-		return
-	}
-	
-	// Process each event using our abstraction
-	eventCount := events.GetInputEventCount()
-	for i := uint32(0); i < eventCount; i++ {
-		event := events.GetInputEvent(i)
-		if event == nil {
-			continue
-		}
-		
-		// Handle parameter events using our abstraction
-		switch event.Type {
-		case api.EventTypeParamValue:
-			if paramEvent, ok := event.Data.(api.ParamEvent); ok {
-				p.handleParameterChange(paramEvent)
-			}
-		}
-	}
-}
+	cProcess := (*C.clap_process_t)(processPtr)
+	framesCount := uint32(cProcess.frames_count)
+	audioIn := p.inputViews.Bind(unsafe.Pointer(cProcess.audio_inputs), uint32(cProcess.audio_inputs_count), framesCount)
+	audioOut := p.outputViews.Bind(unsafe.Pointer(cProcess.audio_outputs), uint32(cProcess.audio_outputs_count), framesCount)
 
-// handleParameterChange processes a parameter change event
-func (p *{{.StructName}}) handleParameterChange(paramEvent api.ParamEvent) {
-	// TODO: Handle parameter changes based on ID
-	// Example:
-	// switch paramEvent.ParamID {
-	// case 0: // Gain parameter
-	//     value := paramEvent.Value
-	//     // Clamp value to valid range
-	//     if value < 0.0 {
-	//         value = 0.0
-	//     }
-	//     if value > 2.0 {
-	//         value = 2.0
-	//     }
-	//     atomic.StoreInt64(&p.gain, int64(floatToBits(value)))
-	//     
-	//     // Update parameter manager
-	//     p.paramManager.SetParameterValue(paramEvent.ParamID, value)
-	// }
-}
-
-// GetPluginInfo returns information about the plugin
-func (p *{{.StructName}}) GetPluginInfo() api.PluginInfo {
-	return api.PluginInfo{
-		ID:          PluginID,
-		Name:        PluginName,
-		Vendor:      PluginVendor,
-		URL:         PluginURL,
-		ManualURL:   PluginURL,
-		SupportURL:  PluginURL + "/issues",
-		Version:     PluginVersion,
-		Description: "{{.PluginName}} - A {{.PluginType}} plugin",
-		Features:    PluginFeatures,
-	}
-}
-
-// OnMainThread is called on the main thread
-func (p *{{.StructName}}) OnMainThread() {
-	// TODO: Handle main thread operations if needed
-}
-
-// GetPluginID returns the plugin ID
-func (p *{{.StructName}}) GetPluginID() string {
-	return PluginID
-}
-
-// SaveState saves the plugin state to a stream
-func (p *{{.StructName}}) SaveState(stream unsafe.Pointer) bool {
-	out := api.NewOutputStream(stream)
-	
-	// Write state version
-	if err := out.WriteUint32(1); err != nil {
-		return false
-	}
-	
-	// Write parameter count
-	paramCount := p.paramManager.GetParameterCount()
-	if err := out.WriteUint32(paramCount); err != nil {
-		return false
-	}
-	
-	// Write each parameter ID and value
-	for i := uint32(0); i < paramCount; i++ {
-		info, err := p.paramManager.GetParameterInfoByIndex(i)
-		if err != nil {
-			return false
-		}
-		
-		// Write parameter ID
-		if err := out.WriteUint32(info.ID); err != nil {
-			return false
-		}
-		
-		// Write parameter value
-		value := p.paramManager.GetParameterValue(info.ID)
-		if err := out.WriteFloat64(value); err != nil {
-			return false
-		}
-	}
-	
-	return true
-}
+	p.events.Bind(unsafe.Pointer(cProcess.in_events), unsafe.Pointer(cProcess.out_events))
+	p.events.ProcessAll(p)
+	p.events.Unbind()
 
-// LoadState loads the plugin state from a stream
-func (p *{{.StructName}}) LoadState(stream unsafe.Pointer) bool {
-	in := api.NewInputStream(stream)
-	
-	// Read state version
-	version, err := in.ReadUint32()
-	if err != nil || version != 1 {
-		return false
-	}
-	
-	// Read parameter count
-	paramCount, err := in.ReadUint32()
-	if err != nil {
-		return false
+{{- if eq .PluginType "instrument"}}
+
+	// TODO: Render the active voices into audioOut
+	_ = audioIn
+	for _, channel := range audioOut {
+		clear(channel)
 	}
-	
-	// Read each parameter ID and value
-	for i := uint32(0); i < paramCount; i++ {
-		// Read parameter ID
-		paramID, err := in.ReadUint32()
-		if err != nil {
-			return false
-		}
-		
-		// Read parameter value
-		value, err := in.ReadFloat64()
-		if err != nil {
-			return false
+{{- else}}
+
+	// TODO: Process audioIn into audioOut; this passes it through
+	for ch, channel := range audioOut {
+		if ch < len(audioIn) {
+			copy(channel, audioIn[ch])
+		} else {
+			clear(channel)
 		}
-		
-		// Set parameter value
-		p.paramManager.SetParameterValue(paramID, value)
-		
-		// TODO: Update internal state if needed
-		// Example:
-		// if paramID == 0 {
-		//     atomic.StoreInt64(&p.gain, int64(floatToBits(value)))
-		// }
 	}
-	
-	return true
-}
-
-// Helper functions for atomic float64 operations
-// Uncomment these when using atomic parameter storage:
-// func floatToBits(f float64) uint64 {
-// 	return *(*uint64)(unsafe.Pointer(&f))
-// }
-// 
-// func floatFromBits(b uint64) float64 {
-// 	return *(*float64)(unsafe.Pointer(&b))
-// }
-
-{{if or (eq .PluginType "audio-effect") (eq .PluginType "utility")}}
-// GetLatency returns the plugin's processing latency in samples.
-func (p *{{.StructName}}) GetLatency() uint32 {
-	// TODO: Return your plugin's latency
-	// This is used for delay compensation in the DAW
-	return 0
-}
+{{- end}}
 
-// GetTail returns the plugin's tail length in samples.
-func (p *{{.StructName}}) GetTail() uint32 {
-	// TODO: Return how long the plugin produces output after input stops
-	// Important for reverbs, delays, etc.
-	return 0
+	// Have the host schedule main-thread notification of published changes
+	p.ParamManager.EndBlock()
+	return process.ProcessContinue
 }
-{{end}}
 
-{{if eq .PluginType "instrument"}}
-// Voice represents a single synthesizer voice (example)
-type Voice struct {
-	// TODO: Add voice state here
-}
-
-// handleNoteOn processes a note on event.
-func (p *{{.StructName}}) handleNoteOn(key int, velocity float64) {
-	// TODO: Implement note on handling
-	// Example:
-	// voice := p.allocateVoice()
-	// if voice != nil {
-	//     voice.start(key, velocity)
-	// }
-}
-
-// handleNoteOff processes a note off event.
-func (p *{{.StructName}}) handleNoteOff(key int) {
-	// TODO: Implement note off handling
-	// Example:
-	// for _, voice := range p.voices {
-	//     if voice.active && voice.note == key {
-	//         voice.release()
-	//     }
-	// }
-}
-
-// GetVoiceInfo returns information about the instrument's voice capabilities.
-func (p *{{.StructName}}) GetVoiceInfo() api.VoiceInfo {
-	activeVoices := atomic.LoadInt32(&p.activeVoices)
-	return api.VoiceInfo{
-		VoiceCount:       uint32(activeVoices),
-		VoiceCapacity:    MaxVoices,
-		Flags:            api.VoiceInfoSupportsStereo,
-	}
-}
-
-// allocateVoice finds a free voice for a new note.
-func (p *{{.StructName}}) allocateVoice() *Voice {
-	// TODO: Implement voice allocation
-	// Find a free voice or steal the oldest one
-	return nil
-}
-{{end}}
-
-// DSP Helper Functions & Examples
-// ==============================
-// The following functions provide common DSP algorithms you can use as starting points:
-
-{{if eq .PluginType "audio-effect"}}
-// Example: Simple low-pass filter
-func lowPassFilter(input, cutoff, sampleRate float64, state *float64) float64 {
-	rc := 1.0 / (cutoff * 2.0 * math.Pi)
-	dt := 1.0 / sampleRate
-	alpha := dt / (rc + dt)
-	*state = *state + alpha*(input-*state)
-	return *state
+// HandleParamValue applies parameter events (implements event.Handler)
+// [audio-thread]
+func (p *{{.StructName}}) HandleParamValue(paramEvent *event.ParamValueEvent, time uint32) {
+	p.params.HandleParamValue(paramEvent.ParamID, paramEvent.Value)
 }
 
-// Example: dB to linear conversion
-func dbToLinear(db float64) float64 {
-	return math.Pow(10.0, db/20.0)
-}
-
-// Example: Simple delay line
-type DelayLine struct {
-	buffer []float64
-	index  int
-}
-
-func newDelayLine(maxDelay int) *DelayLine {
-	return &DelayLine{
-		buffer: make([]float64, maxDelay),
-		index:  0,
-	}
-}
-
-func (d *DelayLine) process(input float64, delaySamples int) float64 {
-	// Read from delay line
-	readIndex := (d.index - delaySamples + len(d.buffer)) % len(d.buffer)
-	output := d.buffer[readIndex]
-	
-	// Write to delay line
-	d.buffer[d.index] = input
-	d.index = (d.index + 1) % len(d.buffer)
-	
-	return output
-}
-{{end}}
-
-{{if eq .PluginType "instrument"}}
-// Example: Basic oscillator
-func generateOscillator(phase float64, waveform int) float64 {
-	switch waveform {
-	case 0: // Sine
-		return math.Sin(2 * math.Pi * phase)
-	case 1: // Sawtooth
-		return 2*phase - 1
-	case 2: // Square
-		if phase < 0.5 {
-			return 1.0
-		}
-		return -1.0
-	case 3: // Triangle
-		if phase < 0.5 {
-			return 4*phase - 1
+// SaveState writes every parameter's value
+func (p *{{.StructName}}) SaveState(stream unsafe.Pointer) error {
+	values := make(map[uint32]float64, p.ParamManager.Count())
+	for i := uint32(0); i < p.ParamManager.Count(); i++ {
+		if info, err := p.ParamManager.GetInfoByIndex(i); err == nil {
+			values[info.ID] = p.ParamManager.Get(info.ID)
 		}
-		return 3 - 4*phase
-	default:
-		return 0.0
 	}
+	return p.SaveStateWithParams(stream, values)
 }
 
-// Example: Note to frequency conversion
-func noteToFrequency(note int) float64 {
-	return 440.0 * math.Pow(2.0, float64(note-69)/12.0)
-}
-{{end}}
-
-{{if eq .PluginType "utility"}}
-// Example: dB to linear conversion
-func dbToLinear(db float64) float64 {
-	return math.Pow(10.0, db/20.0)
-}
-
-// Example: Linear to dB conversion  
-func linearToDb(linear float64) float64 {
-	if linear <= 0 {
-		return -96.0 // Minimum dB
-	}
-	return 20.0 * math.Log10(linear)
+// LoadState restores what SaveState wrote
+func (p *{{.StructName}}) LoadState(stream unsafe.Pointer) error {
+	return p.LoadStateWithCallback(stream, func(id uint32, value float64) {
+		p.params.SetParamValue(id, value)
+	})
 }
 
-// Example: RMS level calculation
-func calculateRMS(samples []float64) float64 {
-	sum := 0.0
-	for _, sample := range samples {
-		sum += sample * sample
-	}
-	return math.Sqrt(sum / float64(len(samples)))
+// GetNotePortManager returns the note ports the note-ports exports report
+func (p *{{.StructName}}) GetNotePortManager() *audio.NotePortManager {
+	return p.notePorts
 }
-{{end}}
 
 func main() {
 	// This is not called when used as a plugin,
@@ -5,7 +5,6 @@ package main
 // #include <stdlib.h>
 import "C"
 import (
-	"runtime/cgo"
 	"unsafe"
 	
 	"github.com/justyntemme/clapgo/pkg/audio"
@@ -13,11 +12,17 @@ import (
 )
 
 //export ClapGo_CreatePlugin
-func ClapGo_CreatePlugin(host unsafe.Pointer, pluginID *C.char) unsafe.Pointer {
-	if C.GoString(pluginID) == PluginID {
-		return unsafe.Pointer(gainPlugin.CreateWithHost(host))
+func ClapGo_CreatePlugin(host unsafe.Pointer, pluginID *C.char) uintptr {
+	return createPlugin(host, C.GoString(pluginID))
+}
+
+// createPlugin is ClapGo_CreatePlugin with the ID already converted, so
+// tests create instances the way the bridge does
+func createPlugin(host unsafe.Pointer, pluginID string) uintptr {
+	if pluginID == PluginID {
+		return gainPlugin.CreateWithHost(host)
 	}
-	return nil
+	return 0
 }
 
 //export ClapGo_GetVersion
@@ -65,8 +70,8 @@ func ClapGo_PluginDestroy(plugin unsafe.Pointer) {
 		p.Destroy()
 		// Unregister from audio ports provider
 		audio.UnregisterPortsProvider(plugin)
-		// Delete the handle to free the Go object
-		cgo.Handle(plugin).Delete()
+		// Unpin the instance
+		instances.Remove(plugin)
 	}
 }
 
@@ -161,7 +166,35 @@ func ClapGo_PluginStateLoad(plugin unsafe.Pointer, stream unsafe.Pointer) C.bool
 	return C.bool(err == nil)
 }
 
+//export ClapGo_PluginAudioPortsCount
+func ClapGo_PluginAudioPortsCount(plugin unsafe.Pointer, isInput C.bool) C.uint32_t {
+	return C.uint32_t(getPlugin(plugin).GetAudioPortCount(bool(isInput)))
+}
 
+//export ClapGo_PluginAudioPortsGet
+func ClapGo_PluginAudioPortsGet(plugin unsafe.Pointer, index C.uint32_t, isInput C.bool, info unsafe.Pointer) C.bool {
+	if info == nil {
+		return false
+	}
+	port := getPlugin(plugin).GetAudioPortInfo(uint32(index), bool(isInput))
+	if port.ID == audio.InvalidID {
+		return false
+	}
+	// Input and output process in place as one pair
+	port.InPlacePair = 0
+	audio.PortInfoToC(port, info)
+	return true
+}
+
+
+
+//export ClapGo_PluginTelemetry
+func ClapGo_PluginTelemetry(plugin unsafe.Pointer) unsafe.Pointer {
+	if p := getPlugin(plugin); p != nil && p.telemetry != nil {
+		return p.telemetry.Pointer()
+	}
+	return nil
+}
 
 //export ClapGo_PluginLatencyGet
 func ClapGo_PluginLatencyGet(plugin unsafe.Pointer) uint32 {
@@ -4,13 +4,13 @@ package main
 import "C"
 import (
 	"fmt"
-	"runtime/cgo"
 	"unsafe"
 	
 	"github.com/justyntemme/clapgo/pkg/audio"
 	"github.com/justyntemme/clapgo/pkg/controls"
 	"github.com/justyntemme/clapgo/pkg/event"
 	"github.com/justyntemme/clapgo/pkg/extension"
+	hostpkg "github.com/justyntemme/clapgo/pkg/host"
 	"github.com/justyntemme/clapgo/pkg/param"
 	"github.com/justyntemme/clapgo/pkg/plugin"
 	"github.com/justyntemme/clapgo/pkg/process"
@@ -21,6 +21,9 @@ import (
 var (
 	gainPlugin *GainPlugin
 	
+	// Pinned instances the C bridge dispatches on directly
+	instances plugin.Instances[GainPlugin]
+	
 	pluginInfo = plugin.Info{
 		ID:          PluginID,
 		Name:        PluginName,
@@ -42,7 +45,7 @@ func getPlugin(plugin unsafe.Pointer) *GainPlugin {
 	if plugin == nil {
 		return &GainPlugin{}
 	}
-	return cgo.Handle(plugin).Value().(*GainPlugin)
+	return instances.Get(plugin)
 }
 
 type GainPlugin struct {
@@ -57,8 +60,26 @@ type GainPlugin struct {
 	// Direct parameter access
 	gain *param.AtomicFloat64
 	
+	// Ramps gain changes so automation doesn't zipper
+	gainSmoother *param.Smoother
+	
 	// Extension bundle for host integration
 	extensions *extension.ExtensionBundle
+	
+	// Channel views sized at activation and re-bound every block
+	inputViews  *audio.BufferViews
+	outputViews *audio.BufferViews
+	
+	// Event processor reused across blocks so its pool statistics accumulate
+	events *event.Processor
+	
+	// Output meters and scope for the GUI bridge
+	telemetry *audio.Telemetry
+	
+	// Audio-thread log formats, written to the PluginBase log ring
+	logGainChanged    hostpkg.LogFormat
+	logUnknownParam   hostpkg.LogFormat
+	logInvalidBuffers hostpkg.LogFormat
 }
 
 
@@ -69,20 +90,25 @@ func NewGainPlugin() *GainPlugin {
 		SurroundSupport:    audio.NewStereoSurroundSupport(),
 	}
 	
+	// Process64 runs 64-bit hosts without conversion; one sample size for
+	// both sides keeps it to the two kernels
+	p.StereoPortProvider.Flags = audio.PortFlagSupports64Bit | audio.PortFlagRequiresCC
+	
 	// Create parameter binder for automatic registration + atomic storage
 	p.params = param.NewParameterBinder(p.ParamManager)
 	
 	// Bind gain parameter - this creates atomic storage AND registers with manager
 	p.gain = p.params.BindPercentage(ParamGain, "Gain", 100.0) // Default 100% (0dB)
+	p.gainSmoother, _ = p.params.Smooth(ParamGain, param.SmoothingLinear, param.DefaultSmoothingTime)
 	
 	return p
 }
 
-func (p *GainPlugin) CreateWithHost(host unsafe.Pointer) cgo.Handle {
+func (p *GainPlugin) CreateWithHost(host unsafe.Pointer) uintptr {
 	p.PluginBase.InitWithHost(host)
-	handle := cgo.NewHandle(p)
-	audio.RegisterPortsProvider(unsafe.Pointer(handle), p)
-	return handle
+	instance := instances.Add(p)
+	audio.RegisterPortsProvider(unsafe.Pointer(p), p)
+	return instance
 }
 
 // Init initializes the plugin
@@ -93,9 +119,25 @@ func (p *GainPlugin) Init() bool {
 		return false
 	}
 	
+	// Gain changes made on the audio thread reach listeners via OnMainThread;
+	// Process ends every block with ParamManager.EndBlock
+	if err := p.PluginBase.EnableParamChangeQueue(); err != nil {
+		return false
+	}
+	
+	// Index the bindings for lock-free audio-thread parameter access
+	p.params.Freeze()
+	
+	// Messages the audio thread may log; formatted later on the main thread
+	p.logGainChanged = p.LogRing.Register(hostpkg.SeverityDebug, "Gain changed to %.1f%% (%.2f dB)")
+	p.logUnknownParam = p.LogRing.Register(hostpkg.SeverityWarning, "Unknown parameter ID: %d")
+	p.logInvalidBuffers = p.LogRing.Register(hostpkg.SeverityError, "Invalid audio buffers")
+	
 	// Initialize extension bundle for host integration
 	p.extensions = extension.NewExtensionBundle(p.Host, PluginName)
 	
+	p.telemetry = audio.NewTelemetry(2) // Activate sets the sample rate
+	
 	if p.extensions != nil {
 		p.extensions.LogInfo("Gain plugin initialized")
 	}
@@ -107,6 +149,10 @@ func (p *GainPlugin) Init() bool {
 func (p *GainPlugin) Destroy() {
 	// Use framework's common cleanup
 	p.PluginBase.CommonDestroy()
+	
+	if p.telemetry != nil {
+		p.telemetry.Free()
+	}
 }
 
 
@@ -140,6 +186,20 @@ func (p *GainPlugin) Activate(sampleRate float64, minFrames, maxFrames uint32) b
 		return false
 	}
 	
+	// Size the buffer views once so the process call never allocates
+	p.inputViews = audio.NewPortBufferViews(p.StereoPortProvider, true, maxFrames)
+	p.outputViews = audio.NewPortBufferViews(p.StereoPortProvider, false, maxFrames)
+	
+	// Size the smoothing ramps for the largest block
+	p.ParamManager.PrepareSmoothers(sampleRate, maxFrames)
+	p.telemetry.SetSampleRate(sampleRate)
+	
+	// Create the event processor once; each block only rebinds its queues
+	if p.events == nil {
+		p.events = event.NewProcessor(nil, nil)
+		event.SetupPoolLogging(p.events, p.Logger)
+	}
+	
 	return true
 }
 
@@ -155,6 +215,7 @@ func (p *GainPlugin) Reset() {
 	
 	// Reset plugin-specific state
 	p.gain.Store(1.0)
+	p.ParamManager.ResetSmoothers()
 }
 
 func (p *GainPlugin) Process(steadyTime int64, framesCount uint32, audioIn, audioOut [][]float32, events *event.Processor) int {
@@ -167,24 +228,87 @@ func (p *GainPlugin) Process(steadyTime int64, framesCount uint32, audioIn, audi
 	if events != nil {
 		events.ProcessAll(p)
 	}
-	
-	// Get current gain value atomically
-	gain := float32(p.gain.Load())
+	p.Profiler.Mark(process.StageEvents)
 	
 	// Validate buffers
 	if !audio.ValidateBuffers(audioOut, audioIn) {
-		if p.extensions != nil {
-			p.extensions.LogError("Invalid audio buffers")
-		}
+		p.LogRing.Log(p.logInvalidBuffers)
 		return process.ProcessError
 	}
 	
-	// Apply gain using framework utility
-	audio.ProcessStereo(audioIn, audioOut, func(sample float32) float32 {
-		return sample * gain
-	})
+	// Constant input needs no kernel; silent input lets the host sleep us
+	settled := p.gainSmoother.Process(framesCount)
+	if p.propagateConstant(settled) {
+		p.Profiler.Mark(process.StageDSP)
+		return p.Tail.Status(p.inputViews.IsSilent(), framesCount)
+	}
+	p.outputViews.ClearConstant()
+	
+	// Settled gain takes the constant-gain kernel; changes are ramped
+	if settled {
+		audio.ProcessWithGain(audioOut, audioIn, float32(p.gainSmoother.Value()))
+	} else {
+		audio.ProcessWithGainRamp(audioOut, audioIn, p.gainSmoother.Ramp())
+	}
+	p.Profiler.Mark(process.StageDSP)
 	
-	return process.ProcessContinue
+	return p.Tail.Status(false, framesCount)
+}
+
+// Process64 is Process for hosts that hand over double-precision buffers
+func (p *GainPlugin) Process64(steadyTime int64, framesCount uint32, audioIn, audioOut [][]float64, events *event.Processor) int {
+	if !p.IsActivated || !p.IsProcessing {
+		return process.ProcessError
+	}
+	
+	if events != nil {
+		events.ProcessAll(p)
+	}
+	p.Profiler.Mark(process.StageEvents)
+	
+	if !audio.ValidateBuffers(audioOut, audioIn) {
+		p.LogRing.Log(p.logInvalidBuffers)
+		return process.ProcessError
+	}
+	
+	settled := p.gainSmoother.Process(framesCount)
+	if p.propagateConstant(settled) {
+		p.Profiler.Mark(process.StageDSP)
+		return p.Tail.Status(p.inputViews.IsSilent(), framesCount)
+	}
+	p.outputViews.ClearConstant()
+	
+	if settled {
+		audio.ProcessWithGain64(audioOut, audioIn, p.gainSmoother.Value())
+	} else {
+		audio.ProcessWithGainRamp64(audioOut, audioIn, p.gainSmoother.Ramp())
+	}
+	p.Profiler.Mark(process.StageDSP)
+	
+	return p.Tail.Status(false, framesCount)
+}
+
+// propagateConstant handles a block whose inputs the host flagged
+// constant: each output is the input value times the gain, written and
+// flagged constant for the next plugin. A ramping gain only qualifies on
+// silent input, which it cannot change. It reads the bound views, so it
+// returns false when the channel layouts differ.
+// [audio-thread]
+func (p *GainPlugin) propagateConstant(settled bool) bool {
+	in, out := p.inputViews, p.outputViews
+	if in.ChannelCount() != out.ChannelCount() || !in.AllConstant() {
+		return false
+	}
+	if !settled && !in.IsSilent() {
+		return false
+	}
+	
+	gain := p.gainSmoother.Value()
+	for ch := 0; ch < out.ChannelCount(); ch++ {
+		value, _ := in.ConstantValue(ch)
+		out.FillConstant(ch, value*gain)
+	}
+	return true
 }
 
 
@@ -192,24 +316,23 @@ func (p *GainPlugin) Process(steadyTime int64, framesCount uint32, audioIn, audi
 func (p *GainPlugin) HandleParamValue(paramEvent *event.ParamValueEvent, time uint32) {
 	// Use parameter binder for automatic handling
 	if p.params.HandleParamValue(paramEvent.ParamID, paramEvent.Value) {
-		// Successfully handled by binder - log the change
-		if p.extensions != nil && paramEvent.ParamID == ParamGain {
+		// Successfully handled by binder - log the change through the ring,
+		// since this runs on the audio thread
+		if paramEvent.ParamID == ParamGain {
 			value := p.gain.Load()
 			db := audio.LinearToDb(value)
-			p.extensions.LogDebug(fmt.Sprintf("Gain changed to %.1f%% (%.2f dB)", value*100, db))
+			p.LogRing.Log(p.logGainChanged, hostpkg.FloatArg(value*100), hostpkg.FloatArg(db))
 		}
 		return
 	}
 	
 	// Fallback for unknown parameters (shouldn't happen in this plugin)
-	if p.extensions != nil {
-		p.extensions.LogWarning(fmt.Sprintf("Unknown parameter ID: %d", paramEvent.ParamID))
-	}
+	p.LogRing.Log(p.logUnknownParam, hostpkg.IntArg(int64(paramEvent.ParamID)))
 }
 
 
 func (p *GainPlugin) ProcessWithHandle(processPtr unsafe.Pointer) int {
-	if processPtr == nil {
+	if processPtr == nil || p.inputViews == nil || p.outputViews == nil || p.events == nil {
 		return process.ProcessError
 	}
 	
@@ -218,19 +341,39 @@ func (p *GainPlugin) ProcessWithHandle(processPtr unsafe.Pointer) int {
 	steadyTime := int64(cProcess.steady_time)
 	framesCount := uint32(cProcess.frames_count)
 	
-	audioIn := audio.ConvertFromCBuffers(unsafe.Pointer(cProcess.audio_inputs), uint32(cProcess.audio_inputs_count), framesCount)
-	audioOut := audio.ConvertFromCBuffers(unsafe.Pointer(cProcess.audio_outputs), uint32(cProcess.audio_outputs_count), framesCount)
+	audioIn := p.inputViews.Bind(unsafe.Pointer(cProcess.audio_inputs), uint32(cProcess.audio_inputs_count), framesCount)
+	audioOut := p.outputViews.Bind(unsafe.Pointer(cProcess.audio_outputs), uint32(cProcess.audio_outputs_count), framesCount)
 	
-	eventHandler := event.NewProcessor(
-		unsafe.Pointer(cProcess.in_events),
-		unsafe.Pointer(cProcess.out_events),
-	)
+	p.Profiler.Begin()
+	p.events.Bind(unsafe.Pointer(cProcess.in_events), unsafe.Pointer(cProcess.out_events))
+	
+	var result int
+	if p.outputViews.Is64() {
+		result = p.Process64(steadyTime, framesCount, p.inputViews.Channels64(), p.outputViews.Channels64(), p.events)
+	} else {
+		result = p.Process(steadyTime, framesCount, audioIn, audioOut, p.events)
+	}
 	
-	event.SetupPoolLogging(eventHandler, p.Logger)
+	// Meter what the host receives
+	if result != process.ProcessError {
+		if p.outputViews.Is64() {
+			p.telemetry.Measure64(steadyTime, p.outputViews.Channels64())
+		} else {
+			p.telemetry.Measure(steadyTime, audioOut)
+		}
+		if result == process.ProcessSleep {
+			// Sleeping may end the calls; show the silence now
+			p.telemetry.Flush()
+		}
+		p.Profiler.Mark(process.StageOutput)
+	}
 	
-	result := p.Process(steadyTime, framesCount, audioIn, audioOut, eventHandler)
+	p.events.Unbind()
+	p.Profiler.End(framesCount, p.SampleRate)
+	p.PoolDiagnostics.LogPoolDiagnostics(p.events, 1000)
 	
-	p.PoolDiagnostics.LogPoolDiagnostics(eventHandler, 1000)
+	// Have the host schedule main-thread notification of published changes
+	p.ParamManager.EndBlock()
 	
 	return result
 }
@@ -253,10 +396,22 @@ func (p *GainPlugin) GetParamValue(paramID uint32, value *C.double) bool {
 
 
 func (p *GainPlugin) ParamsFlush(inEvents, outEvents unsafe.Pointer) {
-	if inEvents != nil {
-		eventHandler := event.NewProcessor(inEvents, outEvents)
-		eventHandler.ProcessAll(p)
+	if inEvents == nil {
+		return
 	}
+	
+	// Flush never runs concurrently with process, so the long-lived
+	// processor can be reused when the plugin has been activated
+	if p.events == nil {
+		event.NewProcessor(inEvents, outEvents).ProcessAll(p)
+		p.ParamManager.EndBlock()
+		return
+	}
+	
+	p.events.Bind(inEvents, outEvents)
+	p.events.ProcessAll(p)
+	p.events.Unbind()
+	p.ParamManager.EndBlock()
 }
 
 // Parameter text formatting is handled automatically by PluginBase
@@ -313,7 +468,7 @@ func (p *GainPlugin) LoadState(stream unsafe.Pointer) error {
 	return p.LoadStateWithCallback(stream, func(id uint32, value float64) {
 		if id == ParamGain {
 			// Use parameter binder for consistent handling
-			p.params.HandleParamValue(id, value)
+			p.params.SetParamValue(id, value)
 			
 			if p.extensions != nil {
 				p.extensions.LogDebug(fmt.Sprintf("Loaded gain value: %.1f%%", value*100))
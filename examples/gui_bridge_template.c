@@ -11,6 +11,7 @@
 #include <stdbool.h>
 #include "../src/c/plugin.h"
 #include "../include/clap/include/clap/ext/gui.h"
+#include "../src/c/telemetry.h"
 
 // Forward declarations of Go functions
 extern bool GoGUICreated(void* plugin);
@@ -22,7 +23,16 @@ extern bool GoGUIHasGUI(void* plugin);
 extern bool GoGUIGetPreferredAPI(void* plugin, const char** api, bool* is_floating);
 extern bool GoSetGUIExtensionPointer(void* plugin, void* ext_ptr);
 
-// TODO: Define your GUI framework specific data types and structures here
+// Provided by the bridge; NULL when the plugin publishes no telemetry
+extern clapgo_telemetry_t* clapgo_plugin_get_telemetry(const clap_plugin_t* plugin);
+
+// Per-instance GUI state, kept in go_plugin_data_t's gui_state from create
+// to destroy.
+// TODO: Add your GUI framework specific data (window, widgets, ...) here
+typedef struct clapgo_gui_state {
+    clapgo_telemetry_t* telemetry;      // NULL when the plugin publishes none
+    clapgo_telemetry_reader_t reader;
+} clapgo_gui_state_t;
 
 // Forward declaration of GUI extension structure
 static const clap_plugin_gui_t clapgo_gui_extension;
@@ -86,12 +96,25 @@ static bool clapgo_gui_create(const clap_plugin_t* plugin, const char* api, bool
     go_plugin_data_t* data = (go_plugin_data_t*)plugin->plugin_data;
     if (!data || !data->go_instance) return false;
     
+    clapgo_gui_state_t* gui = calloc(1, sizeof(clapgo_gui_state_t));
+    if (!gui) return false;
+    
+    // The telemetry block lives from init to destroy, so it is resolved
+    // once here rather than through Go on every frame
+    gui->telemetry = clapgo_plugin_get_telemetry(plugin);
+    gui->reader = (clapgo_telemetry_reader_t)CLAPGO_TELEMETRY_READER_INIT;
+    
     // TODO: Initialize your GUI framework here
     // 1. Create a window or attach to the parent window
     // 2. Set up your GUI widgets, etc.
     
     // Notify the Go side that GUI is created
-    return GoGUICreated(data->go_instance);
+    if (!GoGUICreated(data->go_instance)) {
+        free(gui);
+        return false;
+    }
+    data->gui_state = gui;
+    return true;
 }
 
 /**
@@ -104,6 +127,10 @@ static void clapgo_gui_destroy(const clap_plugin_t* plugin) {
     if (!data) return;
     
     // TODO: Clean up your GUI framework resources here
+    // (stop the frame timer before the state goes away)
+    
+    free(data->gui_state);
+    data->gui_state = NULL;
     
     // Notify the Go side that GUI is destroyed
     if (data->go_instance) {
@@ -262,6 +289,26 @@ static bool clapgo_gui_hide(const clap_plugin_t* plugin) {
     return GoGUIHidden(data->go_instance);
 }
 
+/**
+ * Draw the plugin's meters. Call it from your GUI's frame timer with the
+ * state create stored in go_plugin_data_t's gui_state. It reads shared
+ * memory only: no call into Go, and the audio thread is never blocked
+ * however slowly the GUI runs.
+ */
+void clapgo_gui_draw_telemetry(clapgo_gui_state_t* gui) {
+    if (!gui || !gui->telemetry) return;
+    
+    const clapgo_telemetry_frame_t* frame = clapgo_telemetry_read(gui->telemetry, &gui->reader);
+    if (frame->sequence == 0) return; // nothing published yet
+    
+    for (uint32_t ch = 0; ch < frame->channel_count; ch++) {
+        // TODO: Draw frame->peak[ch] and frame->rms[ch], and the scope row
+        // frame->scope[ch][0 .. frame->scope_count), oldest point first
+    }
+    
+    // TODO: Light the keys set in frame->keys; frame->active_voices voices sound
+}
+
 /**
  * Define the GUI extension structure with all the function pointers.
  */
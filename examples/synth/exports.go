@@ -24,11 +24,9 @@ import (
 	"encoding/json"
 	"fmt"
 	"math"
-	"runtime/cgo"
 	"unsafe"
 
 	"github.com/justyntemme/clapgo/pkg/audio"
-	"github.com/justyntemme/clapgo/pkg/event"
 	"github.com/justyntemme/clapgo/pkg/extension"
 	hostpkg "github.com/justyntemme/clapgo/pkg/host"
 	"github.com/justyntemme/clapgo/pkg/process"
@@ -43,7 +41,7 @@ func ClapGo_PluginLatencyGet(plugin unsafe.Pointer) C.uint32_t {
 	if plugin == nil {
 		return 0
 	}
-	p := cgo.Handle(plugin).Value().(*SynthPlugin)
+	p := instances.Get(plugin)
 	return C.uint32_t(p.GetLatency())
 }
 
@@ -52,7 +50,7 @@ func ClapGo_PluginTailGet(plugin unsafe.Pointer) C.uint32_t {
 	if plugin == nil {
 		return 0
 	}
-	p := cgo.Handle(plugin).Value().(*SynthPlugin)
+	p := instances.Get(plugin)
 	return C.uint32_t(p.GetTail())
 }
 
@@ -61,7 +59,7 @@ func ClapGo_PluginOnTimer(plugin unsafe.Pointer, timerID C.uint64_t) {
 	if plugin == nil {
 		return
 	}
-	p := cgo.Handle(plugin).Value().(*SynthPlugin)
+	p := instances.Get(plugin)
 	p.OnTimer(uint64(timerID))
 }
 
@@ -75,7 +73,7 @@ func ClapGo_PluginTrackInfoChanged(plugin unsafe.Pointer) {
 	if plugin == nil {
 		return
 	}
-	p := cgo.Handle(plugin).Value().(*SynthPlugin)
+	p := instances.Get(plugin)
 	p.OnTrackInfoChanged()
 }
 
@@ -86,10 +84,23 @@ func ClapGo_PluginTuningChanged(plugin unsafe.Pointer) {
 	if plugin == nil {
 		return
 	}
-	p := cgo.Handle(plugin).Value().(*SynthPlugin)
+	p := instances.Get(plugin)
 	p.OnTuningChanged()
 }
 
+// Thread Pool Extension Export
+
+//export ClapGo_PluginThreadPoolExec
+func ClapGo_PluginThreadPoolExec(plugin unsafe.Pointer, taskIndex C.uint32_t) {
+	if plugin == nil {
+		return
+	}
+	p := instances.Get(plugin)
+	if p.voiceRenderer != nil {
+		p.voiceRenderer.Exec(uint32(taskIndex))
+	}
+}
+
 // Note Name Extension Exports
 
 //export ClapGo_PluginNoteNameCount
@@ -97,8 +108,6 @@ func ClapGo_PluginNoteNameCount(plugin unsafe.Pointer) C.uint32_t {
 	if plugin == nil {
 		return 0
 	}
-	_ = cgo.Handle(plugin).Value().(*SynthPlugin)
-
 	// Synth provides note names for all MIDI notes
 	return C.uint32_t(128) // All MIDI notes
 }
@@ -108,8 +117,6 @@ func ClapGo_PluginNoteNameGet(plugin unsafe.Pointer, index C.uint32_t, noteName
 	if plugin == nil || noteName == nil || index >= 128 {
 		return C.bool(false)
 	}
-	_ = cgo.Handle(plugin).Value().(*SynthPlugin)
-
 	// Get standard note name for this index
 	noteNames := extension.StandardNoteNames()
 	if int(index) >= len(noteNames) {
@@ -125,9 +132,14 @@ func ClapGo_PluginNoteNameGet(plugin unsafe.Pointer, index C.uint32_t, noteName
 // Standardized exports for manifest system
 
 //export ClapGo_CreatePlugin
-func ClapGo_CreatePlugin(host unsafe.Pointer, pluginID *C.char) unsafe.Pointer {
-	id := C.GoString(pluginID)
-	if id == PluginID {
+func ClapGo_CreatePlugin(host unsafe.Pointer, pluginID *C.char) uintptr {
+	return createPlugin(host, C.GoString(pluginID))
+}
+
+// createPlugin is ClapGo_CreatePlugin with the ID already converted, so
+// tests create instances the way the bridge does
+func createPlugin(host unsafe.Pointer, pluginID string) uintptr {
+	if pluginID == PluginID {
 		// Store the host pointer and create utilities
 		synthPlugin.Host = host
 		synthPlugin.Logger = hostpkg.NewLogger(host)
@@ -137,10 +149,9 @@ func ClapGo_CreatePlugin(host unsafe.Pointer, pluginID *C.char) unsafe.Pointer {
 			synthPlugin.Logger.Info("Creating synth plugin instance")
 		}
 
-		handle := cgo.NewHandle(synthPlugin)
-		return unsafe.Pointer(handle)
+		return instances.Add(synthPlugin)
 	}
-	return nil
+	return 0
 }
 
 //export ClapGo_GetVersion
@@ -187,7 +198,7 @@ func ClapGo_PluginInit(plugin unsafe.Pointer) C.bool {
 	if plugin == nil {
 		return C.bool(false)
 	}
-	p := cgo.Handle(plugin).Value().(*SynthPlugin)
+	p := instances.Get(plugin)
 	if p.Init() {
 		// Register as voice info provider after successful init
 		// Voice info provider registration moved to extension system
@@ -201,12 +212,11 @@ func ClapGo_PluginDestroy(plugin unsafe.Pointer) {
 	if plugin == nil {
 		return
 	}
-	handle := cgo.Handle(plugin)
-	p := handle.Value().(*SynthPlugin)
+	p := instances.Get(plugin)
 	// Unregister voice info provider before destroying
 	// Voice info provider unregistration moved to extension system
 	p.Destroy()
-	handle.Delete()
+	instances.Remove(plugin)
 }
 
 //export ClapGo_PluginActivate
@@ -214,7 +224,7 @@ func ClapGo_PluginActivate(plugin unsafe.Pointer, sampleRate C.double, minFrames
 	if plugin == nil {
 		return C.bool(false)
 	}
-	p := cgo.Handle(plugin).Value().(*SynthPlugin)
+	p := instances.Get(plugin)
 	return C.bool(p.Activate(float64(sampleRate), uint32(minFrames), uint32(maxFrames)))
 }
 
@@ -223,7 +233,7 @@ func ClapGo_PluginDeactivate(plugin unsafe.Pointer) {
 	if plugin == nil {
 		return
 	}
-	p := cgo.Handle(plugin).Value().(*SynthPlugin)
+	p := instances.Get(plugin)
 	p.Deactivate()
 }
 
@@ -232,7 +242,7 @@ func ClapGo_PluginStartProcessing(plugin unsafe.Pointer) C.bool {
 	if plugin == nil {
 		return C.bool(false)
 	}
-	p := cgo.Handle(plugin).Value().(*SynthPlugin)
+	p := instances.Get(plugin)
 	return C.bool(p.StartProcessing())
 }
 
@@ -241,7 +251,7 @@ func ClapGo_PluginStopProcessing(plugin unsafe.Pointer) {
 	if plugin == nil {
 		return
 	}
-	p := cgo.Handle(plugin).Value().(*SynthPlugin)
+	p := instances.Get(plugin)
 	p.StopProcessing()
 }
 
@@ -250,7 +260,7 @@ func ClapGo_PluginReset(plugin unsafe.Pointer) {
 	if plugin == nil {
 		return
 	}
-	p := cgo.Handle(plugin).Value().(*SynthPlugin)
+	p := instances.Get(plugin)
 	p.Reset()
 }
 
@@ -264,8 +274,10 @@ func ClapGo_PluginProcess(plugin unsafe.Pointer, processPtr unsafe.Pointer) C.in
 		return C.int32_t(process.ProcessError)
 	}
 
-	handle := cgo.Handle(plugin)
-	p := handle.Value().(*SynthPlugin)
+	p := instances.Get(plugin)
+	if p.inputViews == nil || p.outputViews == nil || p.events == nil {
+		return C.int32_t(process.ProcessError)
+	}
 
 	// Convert the C clap_process_t to Go parameters
 	cProcess := (*C.clap_process_t)(processPtr)
@@ -274,36 +286,63 @@ func ClapGo_PluginProcess(plugin unsafe.Pointer, processPtr unsafe.Pointer) C.in
 	steadyTime := int64(cProcess.steady_time)
 	framesCount := uint32(cProcess.frames_count)
 
-	// Convert audio buffers using our abstraction - NO MORE MANUAL CONVERSION!
-	audioIn := audio.ConvertFromCBuffers(unsafe.Pointer(cProcess.audio_inputs), uint32(cProcess.audio_inputs_count), framesCount)
-	audioOut := audio.ConvertFromCBuffers(unsafe.Pointer(cProcess.audio_outputs), uint32(cProcess.audio_outputs_count), framesCount)
+	p.Profiler.Begin()
+
+	// Re-point the activation-sized views at this block's host buffers
+	audioIn := p.inputViews.Bind(unsafe.Pointer(cProcess.audio_inputs), uint32(cProcess.audio_inputs_count), framesCount)
+	audioOut := p.outputViews.Bind(unsafe.Pointer(cProcess.audio_outputs), uint32(cProcess.audio_outputs_count), framesCount)
 
-	// Create event handler using the new abstraction - NO MORE MANUAL EVENT HANDLING!
-	eventHandler := event.NewEventProcessor(
-		unsafe.Pointer(cProcess.in_events),
-		unsafe.Pointer(cProcess.out_events),
-	)
+	// Bind this block's event queues to the processor created at activation
+	p.events.Bind(unsafe.Pointer(cProcess.in_events), unsafe.Pointer(cProcess.out_events))
 
 	// Setup event pool logging
 	// TODO: Update when logger types are unified
 
 	// Call the actual Go process method
-	result := p.Process(steadyTime, framesCount, audioIn, audioOut, eventHandler)
+	result := p.Process(steadyTime, framesCount, audioIn, audioOut, p.events)
+
+	// Meter what the host receives, with the voices that made it
+	if result != process.ProcessError && len(audioOut) > 0 {
+		p.telemetry.CaptureVoices(p.voiceManager)
+		p.telemetry.Measure(steadyTime, audioOut)
+		if result == process.ProcessSleep {
+			// Sleeping may end the calls; show the silence now
+			p.telemetry.Flush()
+		}
+		p.Profiler.Mark(process.StageOutput)
+	}
+	p.events.Unbind()
+	p.Profiler.End(framesCount, p.SampleRate)
+
+	// Have the host schedule main-thread notification of published changes
+	p.ParamManager.EndBlock()
 
 	// Log event pool diagnostics periodically (every 1000 calls)
 	if p.poolDiagnostics != nil {
-		p.poolDiagnostics.LogPoolDiagnostics(eventHandler, 1000)
+		p.poolDiagnostics.LogPoolDiagnostics(p.events, 1000)
 	}
 
 	return C.int32_t(result)
 }
 
+//export ClapGo_PluginTelemetry
+func ClapGo_PluginTelemetry(plugin unsafe.Pointer) unsafe.Pointer {
+	if plugin == nil {
+		return nil
+	}
+	p := instances.Get(plugin)
+	if p.telemetry == nil {
+		return nil
+	}
+	return p.telemetry.Pointer()
+}
+
 //export ClapGo_PluginGetExtension
 func ClapGo_PluginGetExtension(plugin unsafe.Pointer, id *C.char) unsafe.Pointer {
 	if plugin == nil {
 		return nil
 	}
-	p := cgo.Handle(plugin).Value().(*SynthPlugin)
+	p := instances.Get(plugin)
 	extID := C.GoString(id)
 	return p.GetExtension(extID)
 }
@@ -313,7 +352,7 @@ func ClapGo_PluginOnMainThread(plugin unsafe.Pointer) {
 	if plugin == nil {
 		return
 	}
-	p := cgo.Handle(plugin).Value().(*SynthPlugin)
+	p := instances.Get(plugin)
 	p.OnMainThread()
 }
 
@@ -322,7 +361,7 @@ func ClapGo_PluginParamsCount(plugin unsafe.Pointer) C.uint32_t {
 	if plugin == nil {
 		return 0
 	}
-	p := cgo.Handle(plugin).Value().(*SynthPlugin)
+	p := instances.Get(plugin)
 	return C.uint32_t(p.ParamManager.Count())
 }
 
@@ -331,7 +370,7 @@ func ClapGo_PluginParamsGetInfo(plugin unsafe.Pointer, index C.uint32_t, info un
 	if plugin == nil || info == nil {
 		return C.bool(false)
 	}
-	p := cgo.Handle(plugin).Value().(*SynthPlugin)
+	p := instances.Get(plugin)
 	err := p.GetParamInfo(uint32(index), info)
 	return C.bool(err == nil)
 }
@@ -341,7 +380,7 @@ func ClapGo_PluginParamsGetValue(plugin unsafe.Pointer, paramID C.uint32_t, valu
 	if plugin == nil || value == nil {
 		return C.bool(false)
 	}
-	p := cgo.Handle(plugin).Value().(*SynthPlugin)
+	p := instances.Get(plugin)
 	return C.bool(p.GetParamValue(uint32(paramID), unsafe.Pointer(value)))
 }
 
@@ -350,7 +389,7 @@ func ClapGo_PluginParamsValueToText(plugin unsafe.Pointer, paramID C.uint32_t, v
 	if plugin == nil {
 		return C.bool(false)
 	}
-	p := cgo.Handle(plugin).Value().(*SynthPlugin)
+	p := instances.Get(plugin)
 	return C.bool(p.ParamValueToText(uint32(paramID), float64(value), unsafe.Pointer(buffer), uint32(size)))
 }
 
@@ -359,7 +398,7 @@ func ClapGo_PluginParamsTextToValue(plugin unsafe.Pointer, paramID C.uint32_t, t
 	if plugin == nil || text == nil || value == nil {
 		return C.bool(false)
 	}
-	p := cgo.Handle(plugin).Value().(*SynthPlugin)
+	p := instances.Get(plugin)
 	return C.bool(p.ParamTextToValue(uint32(paramID), C.GoString(text), unsafe.Pointer(value)))
 }
 
@@ -368,7 +407,7 @@ func ClapGo_PluginParamsFlush(plugin unsafe.Pointer, inEvents unsafe.Pointer, ou
 	if plugin == nil {
 		return
 	}
-	p := cgo.Handle(plugin).Value().(*SynthPlugin)
+	p := instances.Get(plugin)
 	p.ParamsFlush(inEvents, outEvents)
 }
 
@@ -377,9 +416,9 @@ func ClapGo_PluginStateSave(plugin unsafe.Pointer, stream unsafe.Pointer) C.bool
 	if plugin == nil || stream == nil {
 		return C.bool(false)
 	}
-	p := cgo.Handle(plugin).Value().(*SynthPlugin)
+	p := instances.Get(plugin)
 
-	out := state.NewClapOutputStream(stream)
+	out := state.NewBufferedClapOutputStream(stream)
 
 	// Write state version
 	if err := out.WriteUint32(1); err != nil {
@@ -422,7 +461,12 @@ func ClapGo_PluginStateSave(plugin unsafe.Pointer, stream unsafe.Pointer) C.bool
 	if err := out.WriteUint32(uint32(len(jsonData))); err != nil {
 		return false
 	}
-	if _, err := out.Write(jsonData); err != nil {
+	if err := out.WriteBytes(jsonData); err != nil {
+		return false
+	}
+
+	// The stream is buffered; this is where the host sees the data
+	if err := out.Flush(); err != nil {
 		return false
 	}
 
@@ -434,7 +478,7 @@ func ClapGo_PluginNotePortsCount(plugin unsafe.Pointer, isInput C.bool) C.uint32
 	if plugin == nil {
 		return 0
 	}
-	p := cgo.Handle(plugin).Value().(*SynthPlugin)
+	p := instances.Get(plugin)
 
 	// Plugin implements note ports extension directly
 	npm := p.GetNotePortManager()
@@ -454,7 +498,7 @@ func ClapGo_PluginNotePortsGet(plugin unsafe.Pointer, index C.uint32_t, isInput
 		return false
 	}
 
-	p := cgo.Handle(plugin).Value().(*SynthPlugin)
+	p := instances.Get(plugin)
 
 	// Plugin implements note ports extension directly
 	npm := p.GetNotePortManager()
@@ -500,7 +544,7 @@ func ClapGo_PluginStateLoad(plugin unsafe.Pointer, stream unsafe.Pointer) C.bool
 	if plugin == nil || stream == nil {
 		return C.bool(false)
 	}
-	p := cgo.Handle(plugin).Value().(*SynthPlugin)
+	p := instances.Get(plugin)
 
 	in := state.NewClapInputStream(stream)
 
@@ -554,8 +598,8 @@ func ClapGo_PluginStateLoad(plugin unsafe.Pointer, stream unsafe.Pointer) C.bool
 	}
 
 	if jsonLength > 0 {
-		jsonData := make([]byte, jsonLength)
-		if _, err := in.Read(jsonData); err != nil {
+		jsonData, err := in.ReadBytes(int(jsonLength))
+		if err != nil {
 			return false
 		}
 
@@ -575,7 +619,7 @@ func ClapGo_PluginStateSaveWithContext(plugin unsafe.Pointer, stream unsafe.Poin
 	if plugin == nil || stream == nil {
 		return C.bool(false)
 	}
-	p := cgo.Handle(plugin).Value().(*SynthPlugin)
+	p := instances.Get(plugin)
 
 	// Log the context type
 	if p.Logger != nil {
@@ -598,7 +642,7 @@ func ClapGo_PluginStateLoadWithContext(plugin unsafe.Pointer, stream unsafe.Poin
 	if plugin == nil || stream == nil {
 		return C.bool(false)
 	}
-	p := cgo.Handle(plugin).Value().(*SynthPlugin)
+	p := instances.Get(plugin)
 
 	// Log the context type
 	if p.Logger != nil {
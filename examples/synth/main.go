@@ -41,6 +41,9 @@ import (
 // Export Go plugin functionality
 var (
 	synthPlugin *SynthPlugin
+
+	// Pinned instances the C bridge dispatches on directly
+	instances plugin.Instances[SynthPlugin]
 )
 
 func init() {
@@ -74,6 +77,14 @@ type SynthPlugin struct {
 	resonance  *param.AtomicFloat64
 	filterType *param.AtomicFloat64
 
+	// Ramps master volume changes so automation doesn't zipper
+	volumeSmoother *param.Smoother
+
+	// ADSR last pushed to the voices, so envelopes are only updated when a
+	// parameter moved
+	voiceADSR    [4]float64
+	voiceADSRSet bool
+
 	// Debug counter for periodic logging
 	debugFrameCounter uint64
 
@@ -86,8 +97,34 @@ type SynthPlugin struct {
 	// Extension bundle for host integration
 	extensions *extension.ExtensionBundle
 
+	// Audio-thread log format, written to the PluginBase log ring
+	logTransportToggle hostpkg.LogFormat
+
 	// Event pool diagnostics
 	poolDiagnostics *event.Diagnostics
+
+	// Channel views sized at activation and re-bound every block
+	inputViews  *audio.BufferViews
+	outputViews *audio.BufferViews
+
+	// Event processor reused across blocks so its pool statistics accumulate
+	events *event.EventProcessor
+
+	// Multi-threaded voice rendering, enabled when the host has a thread pool
+	voiceRenderer *audio.ParallelVoiceRenderer
+
+	// Sub-block rendering: events are applied at their sample offset
+	scheduler    *audio.SubBlockScheduler
+	eventHandler event.Handler
+	renderFunc   audio.SegmentFunc
+	blockOutput  [][]float32           // output channels of the block being rendered
+	blockEvents  *event.EventProcessor // note end events of the block go here
+
+	// Output meters, scope and sounding keys for the GUI bridge
+	telemetry *audio.Telemetry
+
+	// Why the cutoff is not tabulated, reported once the host logger exists
+	cutoffMapperErr error
 }
 
 // TransportInfo holds host transport information
@@ -147,13 +184,21 @@ func NewSynthPlugin() *SynthPlugin {
 	plugin.sustain = plugin.params.BindPercentage(5, "Sustain", 70.0)
 	plugin.release = plugin.params.BindADSR(6, "Release", 5.0, 0.3)      // Max 5s, default 300ms
 	plugin.cutoff = plugin.params.BindCutoffLog(7, "Filter Cutoff", 0.5) // 0.5 maps to ~400Hz
+	// A table that misses its error bound leaves the exact mapper bound
+	plugin.cutoffMapperErr = plugin.params.CompileMapper(7, param.CompileOptions{Interpolation: param.InterpolationCubic})
 	plugin.resonance = plugin.params.BindResonance(8, "Filter Resonance", 0.5)
 	plugin.filterType = plugin.params.BindChoice(9, "Filter Type",
 		[]string{"Lowpass", "Highpass", "Bandpass", "Notch"}, 0)
+	plugin.volumeSmoother, _ = plugin.params.Smooth(1, param.SmoothingOnePole, 0.01)
 
 	// Configure note port for instrument
 	plugin.notePortManager.AddInputPort(audio.CreateDefaultInstrumentPort())
 
+	// Build the sub-block rendering pieces once so Process never allocates them
+	plugin.scheduler = audio.NewSubBlockScheduler(audio.DefaultMinSegment)
+	plugin.eventHandler = plugin.midiProcessor.NewHandler(plugin)
+	plugin.renderFunc = plugin.renderSegment
+
 	return plugin
 }
 
@@ -162,8 +207,26 @@ func (p *SynthPlugin) Init() bool {
 	// Mark this as main thread for debug builds
 	thread.DebugSetMainThread()
 
+	// Registration is complete; parameter access is lock-free from here
+	p.params.Freeze()
+	requestCallback := func() {
+		hostpkg.RequestCallback(p.Host)
+	}
+	p.ParamManager.EnableChangeQueue(requestCallback)
+
+	// MIDI callbacks run on the audio thread, so they log through the ring
+	p.LogRing = hostpkg.NewLogRing(hostpkg.NewLogger(p.Host), hostpkg.DefaultLogRingSize, requestCallback)
+	p.logTransportToggle = p.LogRing.Register(hostpkg.SeverityInfo, "Transport toggle play requested via C0")
+	p.Profiler.EnableFromEnv(p.LogRing)
+
 	// Initialize all extensions in one call
 	p.extensions = extension.NewExtensionBundle(p.Host, PluginName)
+	if p.cutoffMapperErr != nil {
+		p.extensions.LogWarning(fmt.Sprintf("Filter cutoff uses the exact mapper: %v", p.cutoffMapperErr))
+	}
+
+	// Notes are tuned through the cache, so build it now
+	p.extensions.EnableTuning()
 
 	// Set up custom MIDI callbacks
 	p.midiProcessor.SetCallbacks(
@@ -172,7 +235,7 @@ func (p *SynthPlugin) Init() bool {
 			// Special transport control: C0 (MIDI note 24) toggles play/pause
 			if key == 24 {
 				if p.extensions.RequestTogglePlay() {
-					p.extensions.LogInfo("Transport toggle play requested via C0")
+					p.LogRing.Log(p.logTransportToggle)
 				}
 			}
 		},
@@ -182,17 +245,30 @@ func (p *SynthPlugin) Init() bool {
 			switch cc {
 			case 7: // Volume CC
 				// Update the master volume parameter
-				p.volume.UpdateWithManager(value, p.ParamManager, 1)
+				p.volume.PublishWithManager(value, p.ParamManager, 1)
 			case 74: // Filter cutoff CC (commonly used for brightness)
 				// CC value (0-1) directly maps to logarithmic cutoff parameter
 				// The logarithmic mapping is handled automatically by the parameter binding
-				p.cutoff.UpdateWithManager(value, p.ParamManager, 7)
+				p.cutoff.PublishWithManager(value, p.ParamManager, 7)
 			}
 		},
 		nil, // onPitchBend
 		nil, // onPolyPressure
 	)
 
+	// Tell the host when a voice it started with a note ID stops sounding
+	p.voiceManager.SetVoiceEndHandler(p.sendNoteEnd)
+
+	// Spread voices over the host's thread pool for large patches. Without
+	// one the synth renders serially, so the renderer is kept only when it
+	// is installed; Activate and Deactivate start and stop nothing otherwise.
+	if renderer := audio.NewParallelVoiceRenderer(p.voiceManager, p.Host, 0); renderer.UsesHostPool() {
+		p.voiceRenderer = renderer
+		p.oscillator.SetParallelRenderer(renderer)
+	}
+
+	p.telemetry = audio.NewTelemetry(2) // Activate sets the sample rate
+
 	p.extensions.LogDebug("Synth plugin initialized")
 
 	// TODO: Initialize context menu provider with param.Manager support
@@ -212,7 +288,7 @@ func (p *SynthPlugin) Init() bool {
 	}
 
 	// Register as voice info provider
-	// Note: The plugin pointer is the cgo.Handle value returned by CreatePlugin
+	// Note: The plugin pointer is the instance address returned by CreatePlugin
 	// We can't access it here, so registration will happen externally
 
 	return true
@@ -221,6 +297,9 @@ func (p *SynthPlugin) Init() bool {
 // Destroy cleans up plugin resources
 func (p *SynthPlugin) Destroy() {
 	// Cleanup is handled externally
+	if p.telemetry != nil {
+		p.telemetry.Free()
+	}
 }
 
 // Activate prepares the plugin for processing
@@ -230,8 +309,25 @@ func (p *SynthPlugin) Activate(sampleRate float64, minFrames, maxFrames uint32)
 
 	// Update voice manager and filter sample rate
 	p.voiceManager.SetSampleRate(sampleRate)
+	p.voiceManager.SetMaxFrames(maxFrames)
+	p.telemetry.SetSampleRate(sampleRate)
+	if p.voiceRenderer != nil {
+		p.voiceRenderer.SetMaxFrames(maxFrames)
+		p.voiceRenderer.Start()
+	}
 	p.filter.SetSampleRate(sampleRate)
 	p.filter.Reset() // Ensure clean state
+	p.ParamManager.PrepareSmoothers(sampleRate, maxFrames)
+
+	// Size the buffer views once so the process call never allocates.
+	// The synth has no audio inputs and a single stereo output.
+	p.inputViews = audio.NewBufferViews(0, maxFrames)
+	p.outputViews = audio.NewBufferViews(2, maxFrames)
+
+	// Create the event processor once; each block only rebinds its queues
+	if p.events == nil {
+		p.events = event.NewEventProcessor(nil, nil)
+	}
 
 	p.extensions.LogInfo(fmt.Sprintf("Synth activated at %.0f Hz, buffer size %d-%d", sampleRate, minFrames, maxFrames))
 
@@ -241,6 +337,9 @@ func (p *SynthPlugin) Activate(sampleRate float64, minFrames, maxFrames uint32)
 // Deactivate stops the plugin from processing
 func (p *SynthPlugin) Deactivate() {
 	p.IsActivated = false
+	if p.voiceRenderer != nil {
+		p.voiceRenderer.Stop()
+	}
 }
 
 // StartProcessing begins audio processing
@@ -261,6 +360,7 @@ func (p *SynthPlugin) StopProcessing() {
 func (p *SynthPlugin) Reset() {
 	// Reset voice manager
 	p.voiceManager.Reset()
+	p.ParamManager.ResetSmoothers()
 }
 
 // Process processes audio data using the new abstractions
@@ -270,18 +370,68 @@ func (p *SynthPlugin) Process(steadyTime int64, framesCount uint32, audioIn, aud
 		return process.ProcessError
 	}
 
-	// Process events using our new abstraction
+	// If no outputs, just keep the voice state in sync with the events
+	if len(audioOut) == 0 {
+		if events != nil {
+			p.processEventHandler(events, framesCount)
+		}
+		return process.ProcessContinue
+	}
+
+	// Split the block at event times so notes and parameter changes start on
+	// the sample the host scheduled them for
+	var batch *event.Batch
 	if events != nil {
-		p.processEventHandler(events, framesCount)
+		batch = events.Gather()
 	}
+	p.Profiler.Mark(process.StageEvents)
 
-	// If no outputs, nothing to do
-	if len(audioOut) == 0 {
-		return process.ProcessContinue
+	// Nothing sounding and nothing arriving: the block is silence, so skip
+	// rendering it and flag the outputs constant for whatever follows
+	if p.voiceManager.GetActiveVoiceCount() == 0 && (batch == nil || batch.Len() == 0) {
+		for ch := 0; ch < p.outputViews.ChannelCount(); ch++ {
+			p.outputViews.FillConstant(ch, 0)
+		}
+		p.Profiler.Mark(process.StageDSP)
+		return process.ProcessSleep
 	}
+	p.outputViews.ClearConstant()
+
+	// Events inside the block are dispatched between segments, so their
+	// handling is timed as part of the DSP stage
+	p.blockOutput, p.blockEvents = audioOut, events
+	// Blocks denser than one gather window are paged in as the scheduler
+	// reaches them, so late note-offs still release their voices
+	p.scheduler.RunPaged(events, batch, p.eventHandler, framesCount, p.renderFunc)
+	p.blockOutput, p.blockEvents = nil, nil
+	p.Profiler.Mark(process.StageDSP)
+
+	p.Profiler.Mark(process.StageOutput)
+
+	// Return appropriate status
+	if p.voiceManager.GetActiveVoiceCount() == 0 {
+		return process.ProcessSleep
+	}
+
+	return process.ProcessContinue
+}
+
+// sendNoteEnd tells the host a voice finished, was stolen or was choked, so
+// it can release the note ID
+// [audio-thread]
+func (p *SynthPlugin) sendNoteEnd(voice *audio.Voice) {
+	if voice.NoteID >= 0 && p.blockEvents != nil {
+		endEvent := event.CreateNoteEndEvent(0, voice.NoteID, -1, voice.Channel, voice.Key)
+		p.blockEvents.PushOutputEvent(endEvent)
+	}
+}
+
+// renderSegment renders frames [start, end) of the current block with the
+// parameter values in effect at start
+func (p *SynthPlugin) renderSegment(start, end uint32) {
+	frameCount := end - start
 
 	// Get current parameter values atomically
-	volume := p.volume.Load()
 	waveform := int(p.waveform.Load())
 	attack := p.attack.Load()
 	decay := p.decay.Load()
@@ -291,10 +441,13 @@ func (p *SynthPlugin) Process(steadyTime int64, framesCount uint32, audioIn, aud
 	resonance := p.resonance.Load()
 	filterType := int(p.filterType.Load())
 
-	// Update envelope parameters for all voices
-	p.voiceManager.ApplyToAllVoices(func(voice *audio.Voice) {
-		voice.Envelope.SetADSR(attack, decay, sustain, release)
+	// Update envelope parameters for all voices when one changed
+	if adsr := [4]float64{attack, decay, sustain, release}; !p.voiceADSRSet || adsr != p.voiceADSR {
+		p.voiceManager.SetEnvelope(attack, decay, sustain, release)
+		p.voiceADSR, p.voiceADSRSet = adsr, true
+	}
 
+	p.voiceManager.ApplyToAllVoices(func(voice *audio.Voice) {
 		// Apply tuning if available
 		if voice.TuningID != 0 {
 			voice.Frequency = p.extensions.ApplyTuning(
@@ -319,34 +472,24 @@ func (p *SynthPlugin) Process(steadyTime int64, framesCount uint32, audioIn, aud
 	p.filter.SetResonance(qFactor)
 
 	// Generate audio using PolyphonicOscillator
-	output := p.oscillator.Process(framesCount)
+	output := p.oscillator.Process(frameCount)
 
 	// Apply filter processing - SelectableFilter handles type switching and safety automatically
 	p.filter.ProcessBuffer(output)
 
-	// Apply master volume and copy to all output channels
-	numChannels := len(audioOut)
-	for ch := 0; ch < numChannels; ch++ {
-		for i := uint32(0); i < framesCount && i < uint32(len(output)); i++ {
-			audioOut[ch][i] = output[i] * float32(volume)
+	// Apply master volume and copy to all output channels; the volume is
+	// only ramped while it is moving
+	if p.volumeSmoother.Process(frameCount) {
+		volume := float32(p.volumeSmoother.Value())
+		for _, channel := range p.blockOutput {
+			audio.ApplyGainToChannel(channel[start:end], output, volume)
 		}
-	}
-
-	// Check for finished voices and send note end events
-	p.voiceManager.ApplyToAllVoices(func(voice *audio.Voice) {
-		if !voice.Envelope.IsActive() && voice.NoteID >= 0 && events != nil {
-			endEvent := event.CreateNoteEndEvent(0, voice.NoteID, -1, voice.Channel, voice.Key)
-			events.PushOutputEvent(endEvent)
-			voice.IsActive = false
+	} else {
+		ramp := p.volumeSmoother.Ramp()
+		for _, channel := range p.blockOutput {
+			audio.ApplyGainRampToChannel(channel[start:end], output, ramp)
 		}
-	})
-
-	// Return appropriate status
-	if p.voiceManager.GetActiveVoiceCount() == 0 {
-		return process.ProcessSleep
 	}
-
-	return process.ProcessContinue
 }
 
 // processEventHandler handles all incoming events using our new EventHandler abstraction
@@ -405,11 +548,22 @@ func (p *SynthPlugin) ParamTextToValue(paramID uint32, text string, value unsafe
 
 // ParamsFlush overrides base to use processEventHandler
 func (p *SynthPlugin) ParamsFlush(inEvents, outEvents unsafe.Pointer) {
-	// Process events using our abstraction
-	if inEvents != nil {
-		eventHandler := event.NewEventProcessor(inEvents, outEvents)
-		p.processEventHandler(eventHandler, 0)
+	if inEvents == nil {
+		return
 	}
+
+	// Flush never runs concurrently with process, so the long-lived
+	// processor can be reused when the plugin has been activated
+	if p.events == nil {
+		p.processEventHandler(event.NewEventProcessor(inEvents, outEvents), 0)
+		p.ParamManager.EndBlock()
+		return
+	}
+
+	p.events.Bind(inEvents, outEvents)
+	p.processEventHandler(p.events, 0)
+	p.events.Unbind()
+	p.ParamManager.EndBlock()
 }
 
 // HandleParamValue handles parameter value changes
@@ -488,7 +642,9 @@ func (p *SynthPlugin) GetPluginInfo() manifest.PluginInfo {
 
 // OnMainThread is called on the main thread
 func (p *SynthPlugin) OnMainThread() {
-	// Nothing to do
+	// Deliver parameter changes published by the audio thread
+	p.ParamManager.DispatchChanges()
+	p.LogRing.Flush()
 }
 
 // GetPluginID returns the plugin ID
@@ -539,6 +695,7 @@ func (p *SynthPlugin) OnTimer(timerID uint64) {
 	// Synth doesn't currently use timers
 	// Could be used for UI updates, voice status monitoring, etc.
 	p.extensions.LogDebug(fmt.Sprintf("Timer %d fired", timerID))
+	p.LogRing.Flush()
 }
 
 // OnTrackInfoChanged is called when the track information changes
@@ -586,6 +743,7 @@ func (p *SynthPlugin) OnTuningChanged() {
 	}
 
 	p.extensions.LogInfo("Tuning pool changed, refreshing available tunings")
+	p.extensions.RefreshTuning()
 
 	// Log all available tunings
 	tunings := p.extensions.GetAvailableTunings()
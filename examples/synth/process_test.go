@@ -0,0 +1,50 @@
+package main
+
+import (
+	"testing"
+
+	"github.com/justyntemme/clapgo/internal/clapfake"
+	"github.com/justyntemme/clapgo/pkg/process"
+)
+
+// TestProcessAllocs drives the whole process entry point the bridge calls,
+// from binding the host's buffers and events to metering the output, and
+// expects it not to allocate once the plugin is active
+func TestProcessAllocs(t *testing.T) {
+	handle := createPlugin(nil, PluginID)
+	if handle == 0 {
+		t.Fatal("create failed")
+	}
+	plugin := clapfake.Pointer(handle)
+	defer ClapGo_PluginDestroy(plugin)
+	if !ClapGo_PluginInit(plugin) {
+		t.Fatal("init failed")
+	}
+	if !ClapGo_PluginActivate(plugin, 48000, 32, 512) {
+		t.Fatal("activate failed")
+	}
+	defer ClapGo_PluginDeactivate(plugin)
+	if !ClapGo_PluginStartProcessing(plugin) {
+		t.Fatal("start processing failed")
+	}
+	defer ClapGo_PluginStopProcessing(plugin)
+
+	for _, events := range []int{0, 16, 256} {
+		list := clapfake.NewEventList(events, 512, 4)
+		block := clapfake.NewProcess(0, 2, 512, list)
+		if status := ClapGo_PluginProcess(plugin, block.Pointer()); status == process.ProcessError {
+			t.Fatalf("events=%d: process failed", events)
+		}
+
+		allocs := testing.AllocsPerRun(100, func() {
+			ClapGo_PluginProcess(plugin, block.Pointer())
+			block.Advance()
+		})
+		if allocs != 0 {
+			t.Errorf("events=%d: %.1f allocs per block, want 0", events, allocs)
+		}
+
+		block.Free()
+		list.Free()
+	}
+}
@@ -0,0 +1,231 @@
+// Package clapfake builds the C structures a CLAP host hands a plugin, in C
+// memory, so tests and benchmarks drive the framework exactly as a host
+// would. cgo is not available in _test.go files, which is why these live in
+// a package of their own.
+package clapfake
+
+// #include "../../include/clap/include/clap/clap.h"
+// #include <stdlib.h>
+// #include <string.h>
+//
+// // Synthetic CLAP event lists
+// typedef union fake_event {
+//     clap_event_header_t header;
+//     clap_event_note_t note;
+//     clap_event_param_value_t param;
+//     clap_event_midi_t midi;
+// } fake_event_t;
+//
+// typedef struct fake_list {
+//     clap_input_events_t in;
+//     clap_output_events_t out;
+//     fake_event_t* events;
+//     uint32_t count;
+//     uint64_t pushed;
+// } fake_list_t;
+//
+// static uint32_t fake_size(const clap_input_events_t* list) {
+//     return ((const fake_list_t*)list->ctx)->count;
+// }
+//
+// static const clap_event_header_t* fake_get(const clap_input_events_t* list, uint32_t index) {
+//     const fake_list_t* l = (const fake_list_t*)list->ctx;
+//     return index < l->count ? &l->events[index].header : NULL;
+// }
+//
+// static bool fake_try_push(const clap_output_events_t* list, const clap_event_header_t* event) {
+//     (void)event;
+//     ((fake_list_t*)list->ctx)->pushed++;
+//     return true;
+// }
+//
+// // A block's worth of mixed traffic spread evenly over frames: parameter
+// // changes, note on/off pairs and MIDI CCs in rotation
+// static fake_list_t* fake_list_new(uint32_t count, uint32_t frames, uint32_t param_count) {
+//     fake_list_t* l = (fake_list_t*)calloc(1, sizeof(fake_list_t));
+//     l->events = (fake_event_t*)calloc(count ? count : 1, sizeof(fake_event_t));
+//     l->count = count;
+//     l->in.ctx = l;
+//     l->in.size = fake_size;
+//     l->in.get = fake_get;
+//     l->out.ctx = l;
+//     l->out.try_push = fake_try_push;
+//
+//     for (uint32_t i = 0; i < count; i++) {
+//         fake_event_t* e = &l->events[i];
+//         e->header.time = (uint32_t)((uint64_t)i * frames / count);
+//         e->header.space_id = CLAP_CORE_EVENT_SPACE_ID;
+//         switch (i % 4) {
+//         case 0:
+//             e->header.type = CLAP_EVENT_PARAM_VALUE;
+//             e->header.size = sizeof(clap_event_param_value_t);
+//             e->param.param_id = param_count ? i % param_count : 0;
+//             e->param.note_id = -1;
+//             e->param.port_index = -1;
+//             e->param.channel = -1;
+//             e->param.key = -1;
+//             e->param.value = (double)(i % 100) / 100.0;
+//             break;
+//         case 1:
+//         case 2:
+//             e->header.type = (i % 4 == 1) ? CLAP_EVENT_NOTE_ON : CLAP_EVENT_NOTE_OFF;
+//             e->header.size = sizeof(clap_event_note_t);
+//             e->note.note_id = (int32_t)(i / 4);
+//             e->note.channel = 0;
+//             e->note.key = (int16_t)(36 + (i / 4) % 48);
+//             e->note.velocity = 0.8;
+//             break;
+//         default:
+//             e->header.type = CLAP_EVENT_MIDI;
+//             e->header.size = sizeof(clap_event_midi_t);
+//             e->midi.data[0] = 0xB0;
+//             e->midi.data[1] = 74;
+//             e->midi.data[2] = (uint8_t)(i & 0x7f);
+//             break;
+//         }
+//     }
+//     return l;
+// }
+//
+// static void fake_list_free(fake_list_t* l) {
+//     if (l) {
+//         free(l->events);
+//         free(l);
+//     }
+// }
+//
+// // One clap_process_t with a single stereo-or-wider port on each side
+// typedef struct fake_process {
+//     clap_process_t process;
+//     clap_audio_buffer_t inputs;
+//     clap_audio_buffer_t outputs;
+//     float** in_channels;
+//     float** out_channels;
+// } fake_process_t;
+//
+// static float** fake_channels_new(uint32_t channels, uint32_t frames) {
+//     float** data = (float**)calloc(channels ? channels : 1, sizeof(float*));
+//     for (uint32_t ch = 0; ch < channels; ch++) {
+//         data[ch] = (float*)calloc(frames ? frames : 1, sizeof(float));
+//         // A deterministic ramp, so processing has something non-silent
+//         for (uint32_t i = 0; i < frames; i++) {
+//             data[ch][i] = (float)((int32_t)(i % 64) - 32) / 64.0f;
+//         }
+//     }
+//     return data;
+// }
+//
+// static void fake_channels_free(float** data, uint32_t channels) {
+//     if (!data) return;
+//     for (uint32_t ch = 0; ch < channels; ch++) free(data[ch]);
+//     free(data);
+// }
+//
+// static fake_process_t* fake_process_new(uint32_t in_channels, uint32_t out_channels, uint32_t frames,
+//                                         const clap_input_events_t* in_events,
+//                                         const clap_output_events_t* out_events) {
+//     fake_process_t* p = (fake_process_t*)calloc(1, sizeof(fake_process_t));
+//     p->in_channels = fake_channels_new(in_channels, frames);
+//     p->out_channels = fake_channels_new(out_channels, frames);
+//     p->inputs.data32 = p->in_channels;
+//     p->inputs.channel_count = in_channels;
+//     p->outputs.data32 = p->out_channels;
+//     p->outputs.channel_count = out_channels;
+//
+//     p->process.steady_time = 0;
+//     p->process.frames_count = frames;
+//     p->process.audio_inputs = in_channels ? &p->inputs : NULL;
+//     p->process.audio_inputs_count = in_channels ? 1 : 0;
+//     p->process.audio_outputs = out_channels ? &p->outputs : NULL;
+//     p->process.audio_outputs_count = out_channels ? 1 : 0;
+//     p->process.in_events = in_events;
+//     p->process.out_events = out_events;
+//     return p;
+// }
+//
+// static void fake_process_free(fake_process_t* p) {
+//     if (!p) return;
+//     fake_channels_free(p->in_channels, p->inputs.channel_count);
+//     fake_channels_free(p->out_channels, p->outputs.channel_count);
+//     free(p);
+// }
+//
+// // The bridge keeps what ClapGo_CreatePlugin returns as a void*
+// static void* fake_pointer(uintptr_t value) { return (void*)value; }
+import "C"
+import (
+	"unsafe"
+)
+
+// EventList is a synthetic clap_input_events_t/clap_output_events_t pair.
+// Output events are counted and discarded.
+type EventList struct {
+	c *C.fake_list_t
+}
+
+// NewEventList returns count events spread evenly over frames, rotating
+// through parameter values for paramCount parameters, note on/off pairs and
+// MIDI CCs. Free it when done.
+func NewEventList(count int, frames uint32, paramCount int) *EventList {
+	return &EventList{c: C.fake_list_new(C.uint32_t(count), C.uint32_t(frames), C.uint32_t(paramCount))}
+}
+
+// In returns the list as a clap_input_events_t pointer
+func (l *EventList) In() unsafe.Pointer {
+	return unsafe.Pointer(&l.c.in)
+}
+
+// Out returns the list as a clap_output_events_t pointer
+func (l *EventList) Out() unsafe.Pointer {
+	return unsafe.Pointer(&l.c.out)
+}
+
+// Pushed returns the number of events pushed to Out so far
+func (l *EventList) Pushed() uint64 {
+	return uint64(l.c.pushed)
+}
+
+// Free releases the list's C memory
+func (l *EventList) Free() {
+	C.fake_list_free(l.c)
+	l.c = nil
+}
+
+// Process is a synthetic clap_process_t with one input and one output port
+// of 32-bit audio, filled with a ramp.
+type Process struct {
+	c *C.fake_process_t
+}
+
+// NewProcess returns a process block of frames frames. events may be nil
+// for a block without events. Free it when done.
+func NewProcess(inChannels, outChannels, frames uint32, events *EventList) *Process {
+	var in *C.clap_input_events_t
+	var out *C.clap_output_events_t
+	if events != nil {
+		in, out = &events.c.in, &events.c.out
+	}
+	return &Process{c: C.fake_process_new(C.uint32_t(inChannels), C.uint32_t(outChannels), C.uint32_t(frames), in, out)}
+}
+
+// Pointer returns the block as a clap_process_t pointer
+func (p *Process) Pointer() unsafe.Pointer {
+	return unsafe.Pointer(&p.c.process)
+}
+
+// Advance moves steady_time on by one block, as a host does between calls
+func (p *Process) Advance() {
+	p.c.process.steady_time += C.int64_t(p.c.process.frames_count)
+}
+
+// Free releases the block's C memory
+func (p *Process) Free() {
+	C.fake_process_free(p.c)
+	p.c = nil
+}
+
+// Pointer converts what ClapGo_CreatePlugin returned into the void* the
+// bridge passes back to every export
+func Pointer(value uintptr) unsafe.Pointer {
+	return C.fake_pointer(C.uintptr_t(value))
+}
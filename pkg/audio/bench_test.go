@@ -0,0 +1,450 @@
+package audio_test
+
+import (
+	"fmt"
+	"math"
+	"runtime"
+	"testing"
+
+	"github.com/justyntemme/clapgo/pkg/audio"
+)
+
+const (
+	benchSampleRate = 48000.0
+	benchFrames     = 512 // block size every benchmark renders
+)
+
+var voiceCounts = []int{8, 32, 128}
+
+// newBenchVoices returns a manager with n sustaining saw voices
+func newBenchVoices(n int) (*audio.VoiceManager, *audio.PolyphonicOscillator) {
+	vm := audio.NewVoiceManager(n, benchSampleRate)
+	vm.SetMaxFrames(benchFrames)
+	for i := 0; i < n; i++ {
+		vm.AllocateVoice(int32(i), 0, int16(24+i%96), 0.8)
+	}
+	osc := audio.NewPolyphonicOscillator(vm)
+	osc.SetWaveform(audio.WaveformSaw)
+	return vm, osc
+}
+
+// forVoiceCounts runs fn as one sub-benchmark per voice count
+func forVoiceCounts(b *testing.B, fn func(b *testing.B, n int)) {
+	for _, n := range voiceCounts {
+		b.Run(fmt.Sprintf("voices=%d", n), func(b *testing.B) {
+			b.ReportAllocs()
+			fn(b, n)
+		})
+	}
+}
+
+// noteBurst plays an eight-note chord stab on a full manager, so every note
+// on steals, then releases it
+func noteBurst(vm *audio.VoiceManager, next *int32) {
+	base := *next
+	for k := int32(0); k < 8; k++ {
+		vm.AllocateVoice(base+k, 0, int16(36+(base+k)%72), 0.8)
+	}
+	for k := int32(0); k < 8; k++ {
+		vm.ReleaseNote(base+k, 0, int16(36+(base+k)%72))
+	}
+	*next = (base + 8) & 0xffff
+}
+
+func BenchmarkNoteBurst(b *testing.B) {
+	forVoiceCounts(b, func(b *testing.B, n int) {
+		vm, _ := newBenchVoices(n)
+		next := int32(n)
+
+		b.ResetTimer()
+		for i := 0; i < b.N; i++ {
+			noteBurst(vm, &next)
+		}
+		b.ReportMetric(float64(b.Elapsed().Nanoseconds())/float64(b.N*16), "ns/event")
+	})
+}
+
+func BenchmarkRenderVoices(b *testing.B) {
+	forVoiceCounts(b, func(b *testing.B, n int) { benchRenderVoices(b, n, false) })
+}
+
+func BenchmarkRenderVoicesParallel(b *testing.B) {
+	forVoiceCounts(b, func(b *testing.B, n int) { benchRenderVoices(b, n, true) })
+}
+
+func benchRenderVoices(b *testing.B, n int, parallel bool) {
+	vm, osc := newBenchVoices(n)
+	if parallel {
+		renderer := audio.NewParallelVoiceRenderer(vm, nil, 0)
+		renderer.SetMaxFrames(benchFrames)
+		renderer.Start()
+		defer renderer.Stop()
+		osc.SetParallelRenderer(renderer)
+	}
+
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		osc.Process(benchFrames)
+	}
+	b.ReportMetric(float64(b.Elapsed().Nanoseconds())/float64(b.N*n), "ns/voice")
+}
+
+// BenchmarkProcessVoices is the allocating callback API, kept as the
+// baseline RenderVoices is measured against
+func BenchmarkProcessVoices(b *testing.B) {
+	forVoiceCounts(b, func(b *testing.B, n int) {
+		vm, _ := newBenchVoices(n)
+		b.ResetTimer()
+		for i := 0; i < b.N; i++ {
+			vm.ProcessVoices(benchFrames, func(voice *audio.Voice, frames uint32) []float32 {
+				out := make([]float32, frames)
+				for j := range out {
+					out[j] = float32(audio.GenerateWaveformSample(voice.Phase, audio.WaveformSaw))
+					voice.Phase = audio.AdvancePhase(voice.Phase, voice.Frequency, benchSampleRate)
+				}
+				return out
+			})
+		}
+		b.ReportMetric(float64(b.Elapsed().Nanoseconds())/float64(b.N*n), "ns/voice")
+	})
+}
+
+// newBenchBatch returns n saw voices spread over the same range as
+// newBenchVoices, in the layout RenderBatch takes
+func newBenchBatch(n int) *audio.WavetableVoices {
+	batch := &audio.WavetableVoices{
+		Phase: make([]uint32, n),
+		Inc:   make([]uint32, n),
+		Gain:  make([]float32, n),
+	}
+	for i := 0; i < n; i++ {
+		batch.Inc[i] = audio.PhaseIncrement(audio.NoteToFrequency(24+i%96), benchSampleRate)
+		batch.Gain[i] = 0.8
+	}
+	return batch
+}
+
+func BenchmarkWavetableBatch(b *testing.B) {
+	forVoiceCounts(b, func(b *testing.B, n int) {
+		table := audio.GetWavetable(audio.WaveformSaw)
+		batch := newBenchBatch(n)
+		mix := make([]float32, benchFrames)
+
+		b.ResetTimer()
+		for i := 0; i < b.N; i++ {
+			clear(mix)
+			table.RenderBatch(batch, mix)
+		}
+		b.ReportMetric(float64(b.Elapsed().Nanoseconds())/float64(b.N*n), "ns/voice")
+	})
+}
+
+// benchSignal returns a deterministic full-scale test signal
+func benchSignal(frames int) []float32 {
+	signal := make([]float32, frames)
+	for i := range signal {
+		signal[i] = float32(math.Sin(float64(i)*0.05) + 0.25*math.Sin(float64(i)*0.73))
+	}
+	return signal
+}
+
+func newBenchBuffer() audio.Buffer {
+	buf := audio.NewBuffer(2, benchFrames)
+	signal := benchSignal(benchFrames)
+	for ch := range buf {
+		copy(buf[ch], signal)
+	}
+	return buf
+}
+
+func newBenchBuffer64() [][]float64 {
+	signal := benchSignal(benchFrames)
+	buf := make([][]float64, 2)
+	for ch := range buf {
+		buf[ch] = make([]float64, benchFrames)
+		for i, v := range signal {
+			buf[ch][i] = float64(v)
+		}
+	}
+	return buf
+}
+
+func BenchmarkSelectableFilter(b *testing.B) {
+	b.Run("type=lowpass", func(b *testing.B) { benchFilter(b, audio.FilterLowpass, false) })
+	b.Run("type=bandpass", func(b *testing.B) { benchFilter(b, audio.FilterBandpass, false) })
+	b.Run("type=lowpass/safe", func(b *testing.B) { benchFilter(b, audio.FilterLowpass, true) })
+}
+
+func benchFilter(b *testing.B, filterType audio.FilterType, safe bool) {
+	f := audio.NewSelectableFilter(benchSampleRate, safe)
+	f.SetType(filterType)
+	f.SetFrequency(1200)
+	f.SetResonance(0.7)
+	signal := benchSignal(benchFrames)
+	buf := make([]float32, benchFrames)
+
+	b.ReportAllocs()
+	b.SetBytes(benchFrames * 4)
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		copy(buf, signal)
+		f.ProcessBuffer(buf)
+	}
+}
+
+// BenchmarkFilterBank filters one block per lane, as per-voice filters
+// would, with the native kernel and the Go fallback
+func BenchmarkFilterBank(b *testing.B) {
+	for _, run := range []struct {
+		lanes  int
+		native bool
+	}{{2, true}, {32, true}, {32, false}} {
+		impl := "go"
+		if run.native {
+			impl = "native"
+		}
+		lanes := run.lanes
+		b.Run(fmt.Sprintf("lanes=%d/%s", lanes, impl), func(b *testing.B) {
+			audio.SetNativeKernels(run.native)
+			defer audio.SetNativeKernels(true)
+			fb := audio.NewFilterBank(lanes, benchSampleRate, true)
+			for lane := 0; lane < lanes; lane++ {
+				fb.SetFrequency(lane, 400+float64(lane)*150)
+				fb.SetResonance(lane, 0.7)
+			}
+			signal := benchSignal(benchFrames)
+			bufs := make([][]float32, lanes)
+			for lane := range bufs {
+				bufs[lane] = make([]float32, benchFrames)
+			}
+
+			b.ReportAllocs()
+			b.SetBytes(int64(lanes) * benchFrames * 4)
+			b.ResetTimer()
+			for i := 0; i < b.N; i++ {
+				for _, buf := range bufs {
+					copy(buf, signal)
+				}
+				fb.Process(bufs)
+			}
+		})
+	}
+}
+
+// BenchmarkADSREnvelope renders one block of envelope per op, retriggering
+// so every stage is covered
+func BenchmarkADSREnvelope(b *testing.B) {
+	b.Run("sample", func(b *testing.B) {
+		env := audio.NewADSREnvelope(benchSampleRate)
+		env.SetADSR(0.005, 0.05, 0.6, 0.02)
+		env.Trigger()
+
+		var sink float64
+		b.ReportAllocs()
+		b.ResetTimer()
+		for i := 0; i < b.N; i++ {
+			retrigger(env, i)
+			for j := 0; j < benchFrames; j++ {
+				sink += env.Process()
+			}
+		}
+		_ = sink
+	})
+	b.Run("block", func(b *testing.B) {
+		env := audio.NewADSREnvelope(benchSampleRate)
+		env.SetADSR(0.005, 0.05, 0.6, 0.02)
+		env.Trigger()
+		block := make([]float32, benchFrames)
+
+		b.ReportAllocs()
+		b.ResetTimer()
+		for i := 0; i < b.N; i++ {
+			retrigger(env, i)
+			env.ProcessBlock(block)
+		}
+	})
+}
+
+// retrigger restarts the envelope every 16 blocks and releases it after 12
+func retrigger(env *audio.ADSREnvelope, block int) {
+	switch block % 16 {
+	case 0:
+		env.Trigger()
+	case 12:
+		env.Release()
+	}
+}
+
+func BenchmarkKernels(b *testing.B) {
+	for _, native := range []bool{true, false} {
+		impl := "go"
+		if native {
+			impl = "native"
+		}
+		// Gain alternates between halving and doubling so the signal neither
+		// decays into denormals nor grows without bound
+		gain := float32(0.5)
+		b.Run("ApplyGain/"+impl, func(b *testing.B) {
+			benchKernel(b, native, func(buf, _ audio.Buffer) {
+				audio.ApplyGain(buf, gain)
+				gain = 1 / gain
+			})
+		})
+		b.Run("Mix/"+impl, func(b *testing.B) {
+			benchKernel(b, native, func(dst, src audio.Buffer) { audio.Mix(dst, src, 0.001) })
+		})
+		b.Run("GetPeak/"+impl, func(b *testing.B) {
+			benchKernel(b, native, func(buf, _ audio.Buffer) { audio.GetPeak(buf) })
+		})
+		b.Run("GetRMS/"+impl, func(b *testing.B) {
+			benchKernel(b, native, func(buf, _ audio.Buffer) { audio.GetRMS(buf) })
+		})
+	}
+}
+
+func benchKernel(b *testing.B, native bool, kernel func(dst, src audio.Buffer)) {
+	audio.SetNativeKernels(native)
+	defer audio.SetNativeKernels(true)
+	dst, src := newBenchBuffer(), newBenchBuffer()
+
+	b.ReportAllocs()
+	b.SetBytes(2 * benchFrames * 4)
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		kernel(dst, src)
+	}
+}
+
+// BenchmarkTelemetry is the metering a plugin adds to each stereo block,
+// publishing a frame every few blocks
+func BenchmarkTelemetry(b *testing.B) {
+	telemetry := audio.NewTelemetry(2)
+	telemetry.SetSampleRate(benchSampleRate)
+	defer telemetry.Free()
+	buf := newBenchBuffer()
+
+	b.ReportAllocs()
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		telemetry.Measure(int64(i)*benchFrames, buf)
+	}
+}
+
+// BenchmarkProcessWithGain64 runs the double-precision gain path; converted
+// measures what a 64-bit host paid before, narrowing to float32 and
+// widening back around the float32 kernel
+func BenchmarkProcessWithGain64(b *testing.B) {
+	b.Run("native", func(b *testing.B) { benchGain64(b, false) })
+	b.Run("converted", func(b *testing.B) { benchGain64(b, true) })
+}
+
+func benchGain64(b *testing.B, converted bool) {
+	in, out := newBenchBuffer64(), newBenchBuffer64()
+	in32, out32 := newBenchBuffer(), newBenchBuffer()
+
+	b.ReportAllocs()
+	b.SetBytes(2 * benchFrames * 8)
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		if !converted {
+			audio.ProcessWithGain64(out, in, 0.5)
+			continue
+		}
+		for ch := range in {
+			for j, v := range in[ch] {
+				in32[ch][j] = float32(v)
+			}
+		}
+		audio.ProcessWithGain(out32, in32, 0.5)
+		for ch := range out {
+			for j, v := range out32[ch] {
+				out[ch][j] = float64(v)
+			}
+		}
+	}
+}
+
+// TestAudioThreadAllocs checks that the voice and DSP paths the audio thread
+// takes never allocate once warmed up
+func TestAudioThreadAllocs(t *testing.T) {
+	type check struct {
+		name string
+		fn   func()
+	}
+	var checks []check
+
+	for _, n := range voiceCounts {
+		_, osc := newBenchVoices(n)
+		checks = append(checks, check{fmt.Sprintf("RenderVoices/voices=%d", n), func() { osc.Process(benchFrames) }})
+	}
+	table := audio.GetWavetable(audio.WaveformSaw)
+	batch := newBenchBatch(voiceCounts[len(voiceCounts)-1])
+	mix := make([]float32, benchFrames)
+	vm, _ := newBenchVoices(voiceCounts[len(voiceCounts)-1])
+	next := int32(0)
+
+	f := audio.NewSelectableFilter(benchSampleRate, true)
+	filterBuf := benchSignal(benchFrames)
+	bank := audio.NewFilterBank(8, benchSampleRate, true)
+	bankBufs := make([][]float32, 8)
+	for lane := range bankBufs {
+		bankBufs[lane] = benchSignal(benchFrames)
+	}
+	env := audio.NewADSREnvelope(benchSampleRate)
+	env.Trigger()
+	envBlock := make([]float32, benchFrames)
+	dst, src := newBenchBuffer(), newBenchBuffer()
+	dst64, src64 := newBenchBuffer64(), newBenchBuffer64()
+	telemetry := audio.NewTelemetry(2)
+	telemetry.SetSampleRate(benchSampleRate)
+	defer telemetry.Free()
+
+	checks = append(checks,
+		check{"WavetableBatch", func() { table.RenderBatch(batch, mix) }},
+		check{"NoteBurst", func() { noteBurst(vm, &next) }},
+		check{"SelectableFilter", func() { f.ProcessBuffer(filterBuf) }},
+		check{"FilterBank", func() { bank.Process(bankBufs) }},
+		check{"ADSREnvelope", func() {
+			for j := 0; j < benchFrames; j++ {
+				env.Process()
+			}
+		}},
+		check{"ADSREnvelope/block", func() { env.ProcessBlock(envBlock) }},
+		check{"ApplyGain", func() { audio.ApplyGain(dst, 1) }},
+		check{"Mix", func() { audio.Mix(dst, src, 0.001) }},
+		check{"GetPeak", func() { audio.GetPeak(dst) }},
+		check{"GetRMS", func() { audio.GetRMS(dst) }},
+		check{"ProcessWithGain64", func() { audio.ProcessWithGain64(dst64, src64, 1) }},
+		check{"Telemetry", func() { telemetry.Measure(0, dst) }},
+	)
+
+	for _, c := range checks {
+		if allocs := testing.AllocsPerRun(100, c.fn); allocs != 0 {
+			t.Errorf("%s: %.1f allocs per run, want 0", c.name, allocs)
+		}
+	}
+}
+
+// TestParallelRenderStopped checks that a renderer whose fallback pool was
+// never started renders on the calling thread, without spawning workers,
+// and mixes the same block as serial rendering
+func TestParallelRenderStopped(t *testing.T) {
+	const n = 32
+	_, serial := newBenchVoices(n)
+	vm, osc := newBenchVoices(n)
+	renderer := audio.NewParallelVoiceRenderer(vm, nil, 0)
+	renderer.SetMaxFrames(benchFrames)
+	osc.SetParallelRenderer(renderer)
+
+	goroutines := runtime.NumGoroutine()
+	want := serial.Process(benchFrames)
+	got := osc.Process(benchFrames)
+	if now := runtime.NumGoroutine(); now != goroutines {
+		t.Errorf("rendering started %d goroutines, want 0", now-goroutines)
+	}
+	for i := range want {
+		if got[i] != want[i] {
+			t.Fatalf("sample %d = %v, want %v", i, got[i], want[i])
+		}
+	}
+}
@@ -104,9 +104,7 @@ func CopyMono(dst Buffer, src []float32) error {
 // ApplyGain applies a gain factor to the buffer
 func ApplyGain(buf Buffer, gain float32) {
 	for ch := range buf {
-		for i := range buf[ch] {
-			buf[ch][i] *= gain
-		}
+		scaleChannel(buf[ch], buf[ch], gain)
 	}
 }
 
@@ -118,9 +116,8 @@ func ApplyGainRange(buf Buffer, gain float32, start, end int) error {
 	}
 	
 	for ch := range buf {
-		for i := start; i < end; i++ {
-			buf[ch][i] *= gain
-		}
+		block := buf[ch][start:end]
+		scaleChannel(block, block, gain)
 	}
 	
 	return nil
@@ -137,9 +134,7 @@ func Mix(dst, src Buffer, gain float32) error {
 	}
 	
 	for ch := range dst {
-		for i := range dst[ch] {
-			dst[ch][i] += src[ch][i] * gain
-		}
+		mixChannel(dst[ch], src[ch], gain)
 	}
 	
 	return nil
@@ -151,11 +146,8 @@ func GetPeak(buf Buffer) float32 {
 	var peak float32
 	
 	for ch := range buf {
-		for i := range buf[ch] {
-			abs := float32(math.Abs(float64(buf[ch][i])))
-			if abs > peak {
-				peak = abs
-			}
+		if p := peakChannel(buf[ch]); p > peak {
+			peak = p
 		}
 	}
 	
@@ -168,11 +160,8 @@ func GetRMS(buf Buffer) float32 {
 	totalSamples := 0
 	
 	for ch := range buf {
-		for i := range buf[ch] {
-			val := float64(buf[ch][i])
-			sum += val * val
-			totalSamples++
-		}
+		sum += sumSquaresChannel(buf[ch])
+		totalSamples += len(buf[ch])
 	}
 	
 	if totalSamples == 0 {
@@ -252,9 +241,7 @@ func (ab *AudioBuffer) Clear() {
 // ApplyGain applies gain to all channels in the buffer
 func (ab *AudioBuffer) ApplyGain(gain float32) {
 	for ch := range ab.channels {
-		for i := range ab.channels[ch] {
-			ab.channels[ch][i] *= gain
-		}
+		scaleChannel(ab.channels[ch], ab.channels[ch], gain)
 	}
 }
 
@@ -271,9 +258,7 @@ func (ab *AudioBuffer) Mix(src *AudioBuffer, gain float32) {
 	}
 	
 	for ch := 0; ch < minChannels; ch++ {
-		for i := uint32(0); i < minFrames; i++ {
-			ab.channels[ch][i] += src.channels[ch][i] * gain
-		}
+		mixChannel(ab.channels[ch][:minFrames], src.channels[ch][:minFrames], gain)
 	}
 }
 
@@ -283,33 +268,17 @@ func (ab *AudioBuffer) GetPeakLevel(channel int) float32 {
 		return 0.0
 	}
 	
-	var peak float32 = 0.0
-	for _, sample := range ab.channels[channel] {
-		if abs := float32(sample); abs > peak {
-			if sample < 0 {
-				abs = -sample
-			} else {
-				abs = sample
-			}
-			peak = abs
-		}
-	}
-	
-	return peak
+	return peakChannel(ab.channels[channel])
 }
 
 // GetRMSLevel returns the RMS level for a channel
 func (ab *AudioBuffer) GetRMSLevel(channel int) float32 {
-	if channel >= len(ab.channels) {
+	if channel >= len(ab.channels) || len(ab.channels[channel]) == 0 {
 		return 0.0
 	}
 	
-	var sum float64 = 0.0
-	for _, sample := range ab.channels[channel] {
-		sum += float64(sample) * float64(sample)
-	}
-	
-	return float32(sum / float64(len(ab.channels[channel])))
+	sum := sumSquaresChannel(ab.channels[channel])
+	return float32(math.Sqrt(sum / float64(len(ab.channels[channel]))))
 }
 
 // IsSilent returns true if the buffer contains only silence (or near-silence)
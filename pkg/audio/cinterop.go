@@ -7,7 +7,9 @@ import (
 )
 
 // ConvertFromCBuffers converts C audio buffers to Go Buffer
-// This hides all unsafe pointer arithmetic from plugin developers
+// This hides all unsafe pointer arithmetic from plugin developers.
+// It allocates a new channel slice on every call; audio-thread code should
+// use a BufferViews created at activation instead.
 func ConvertFromCBuffers(cBuffers unsafe.Pointer, bufferCount uint32, frameCount uint32) [][]float32 {
 	if cBuffers == nil || bufferCount == 0 {
 		return nil
@@ -39,8 +41,267 @@ func ConvertFromCBuffers(cBuffers unsafe.Pointer, bufferCount uint32, frameCount
 				}
 			}
 		}
-		// Note: 64-bit double buffers could be handled here if needed
+		// 64-bit buffers are returned by ConvertFromCBuffers64
 	}
 	
 	return result
-}
\ No newline at end of file
+}
+
+// ConvertFromCBuffers64 is ConvertFromCBuffers for the ports the host
+// handed double-precision data. It allocates like ConvertFromCBuffers.
+func ConvertFromCBuffers64(cBuffers unsafe.Pointer, bufferCount uint32, frameCount uint32) [][]float64 {
+	if cBuffers == nil || bufferCount == 0 {
+		return nil
+	}
+
+	buffers := (*[1024]C.clap_audio_buffer_t)(cBuffers)[:bufferCount:bufferCount]
+
+	result := make([][]float64, 0)
+
+	for i := range buffers {
+		buffer := &buffers[i]
+		if buffer.data64 == nil {
+			continue
+		}
+
+		channelCount := uint32(buffer.channel_count)
+		channels := (*[64]*C.double)(unsafe.Pointer(buffer.data64))[:channelCount:channelCount]
+		for _, ch := range channels {
+			if ch != nil {
+				result = append(result, (*[1048576]float64)(unsafe.Pointer(ch))[:frameCount:frameCount])
+			}
+		}
+	}
+
+	return result
+}
+
+// BufferViews holds pre-sized channel slice headers for one side (inputs or
+// outputs) of a process call. It is created once from the port layout and
+// max_frames, then re-pointed at the host's channel pointers on every block
+// without touching the heap.
+type BufferViews struct {
+	channels   [][]float32
+	channels64 [][]float64
+	refs       []channelRef // host buffer of each bound channel, in order
+	maxFrames  uint32
+}
+
+// channelRef locates a bound channel in Channels or Channels64 and its bit
+// in the host buffer's constant_mask. The buffers live in host memory for
+// the block.
+type channelRef struct {
+	buffer *C.clap_audio_buffer_t
+	bit    uint64
+	index  int // into channels, or channels64 when is64
+	is64   bool
+}
+
+// NewBufferViews creates views for up to maxChannels channels of at most
+// maxFrames samples each. Call it from Activate, never from the audio thread.
+func NewBufferViews(maxChannels uint32, maxFrames uint32) *BufferViews {
+	return &BufferViews{
+		channels:   make([][]float32, 0, maxChannels),
+		channels64: make([][]float64, 0, maxChannels),
+		refs:       make([]channelRef, 0, maxChannels),
+		maxFrames:  maxFrames,
+	}
+}
+
+// NewPortBufferViews creates views sized for every channel the provider
+// declares on the given side.
+func NewPortBufferViews(provider PortsProvider, isInput bool, maxFrames uint32) *BufferViews {
+	return NewBufferViews(PortChannelCount(provider, isInput), maxFrames)
+}
+
+// PortChannelCount returns the total channel count across all ports on one side.
+func PortChannelCount(provider PortsProvider, isInput bool) uint32 {
+	if provider == nil {
+		return 0
+	}
+
+	total := uint32(0)
+	count := provider.GetAudioPortCount(isInput)
+	for i := uint32(0); i < count; i++ {
+		info := provider.GetAudioPortInfo(i, isInput)
+		if info.ID != InvalidID {
+			total += info.ChannelCount
+		}
+	}
+	return total
+}
+
+// Bind re-points the views at the host's buffers for this block and returns
+// the 32-bit channels. Ports that only carry data64 are exposed through
+// Channels64; see Is64. The returned slice is only valid until the next
+// Bind.
+// [audio-thread]
+func (v *BufferViews) Bind(cBuffers unsafe.Pointer, bufferCount uint32, frameCount uint32) [][]float32 {
+	v.channels = v.channels[:0]
+	v.channels64 = v.channels64[:0]
+	v.refs = v.refs[:0]
+
+	if cBuffers == nil || bufferCount == 0 {
+		return v.channels
+	}
+
+	// Hosts must not exceed max_frames; clamp rather than read past the
+	// region the plugin was activated for.
+	if v.maxFrames > 0 && frameCount > v.maxFrames {
+		frameCount = v.maxFrames
+	}
+
+	buffers := (*[1024]C.clap_audio_buffer_t)(cBuffers)[:bufferCount:bufferCount]
+
+	for i := range buffers {
+		buffer := &buffers[i]
+		channelCount := uint32(buffer.channel_count)
+
+		if buffer.data32 != nil {
+			channels := (*[64]*C.float)(unsafe.Pointer(buffer.data32))[:channelCount:channelCount]
+			for bit, ch := range channels {
+				if ch != nil {
+					// Appending within capacity only rewrites a slice header.
+					// Capacity is exceeded only if the port layout changed
+					// without a reactivation.
+					v.channels = append(v.channels, (*[1048576]float32)(unsafe.Pointer(ch))[:frameCount:frameCount])
+					v.refs = append(v.refs, channelRef{buffer, 1 << bit, len(v.channels) - 1, false})
+				}
+			}
+		} else if buffer.data64 != nil {
+			channels := (*[64]*C.double)(unsafe.Pointer(buffer.data64))[:channelCount:channelCount]
+			for bit, ch := range channels {
+				if ch != nil {
+					v.channels64 = append(v.channels64, (*[1048576]float64)(unsafe.Pointer(ch))[:frameCount:frameCount])
+					v.refs = append(v.refs, channelRef{buffer, 1 << bit, len(v.channels64) - 1, true})
+				}
+			}
+		}
+	}
+
+	return v.channels
+}
+
+// Channels returns the 32-bit channels bound by the last call to Bind.
+func (v *BufferViews) Channels() [][]float32 {
+	return v.channels
+}
+
+// Channels64 returns the 64-bit channels bound by the last call to Bind.
+func (v *BufferViews) Channels64() [][]float64 {
+	return v.channels64
+}
+
+// Is64 reports whether the last Bind found only 64-bit channels, which is
+// how a host that honours PortFlagSupports64Bit hands over double-precision
+// audio. A plugin with a Process64 path should take it then, rather than
+// reading the empty 32-bit channels.
+// [audio-thread]
+func (v *BufferViews) Is64() bool {
+	return len(v.channels64) > 0 && len(v.channels) == 0
+}
+
+// ChannelCount returns how many channels the last Bind found, at either
+// precision. The constant-mask methods below index channels in port order
+// across both precisions; with ports of one precision that is the index
+// into Channels or Channels64.
+func (v *BufferViews) ChannelCount() int {
+	return len(v.refs)
+}
+
+// IsConstant reports whether the host flagged channel ch as holding one
+// value for the whole block
+// [audio-thread]
+func (v *BufferViews) IsConstant(ch int) bool {
+	ref := &v.refs[ch]
+	return uint64(ref.buffer.constant_mask)&ref.bit != 0
+}
+
+// AllConstant reports whether at least one channel is bound and the host
+// flagged every one as constant
+// [audio-thread]
+func (v *BufferViews) AllConstant() bool {
+	for ch := range v.refs {
+		if !v.IsConstant(ch) {
+			return false
+		}
+	}
+	return len(v.refs) > 0
+}
+
+// IsSilent reports whether every channel is flagged constant at zero, or
+// no channel is bound at all. It trusts the host's flags and only reads
+// the first sample of each channel.
+// [audio-thread]
+func (v *BufferViews) IsSilent() bool {
+	for ch := range v.refs {
+		if value, ok := v.ConstantValue(ch); !ok || value != 0 {
+			return false
+		}
+	}
+	return true
+}
+
+// ConstantValue returns the value of channel ch when the host flagged it
+// constant
+// [audio-thread]
+func (v *BufferViews) ConstantValue(ch int) (float64, bool) {
+	if !v.IsConstant(ch) {
+		return 0, false
+	}
+	ref := &v.refs[ch]
+	if ref.is64 {
+		if samples := v.channels64[ref.index]; len(samples) > 0 {
+			return samples[0], true
+		}
+	} else if samples := v.channels[ref.index]; len(samples) > 0 {
+		return float64(samples[0]), true
+	}
+	return 0, true
+}
+
+// FillConstant writes value to every sample of output channel ch and flags
+// it constant, so the next plugin in the chain can skip it too
+// [audio-thread]
+func (v *BufferViews) FillConstant(ch int, value float64) {
+	ref := &v.refs[ch]
+	if ref.is64 {
+		samples := v.channels64[ref.index]
+		for i := range samples {
+			samples[i] = value
+		}
+	} else {
+		samples := v.channels[ref.index]
+		fill := float32(value)
+		for i := range samples {
+			samples[i] = fill
+		}
+	}
+	v.SetConstant(ch, true)
+}
+
+// SetConstant sets or clears channel ch's bit in the host's constant_mask.
+// Output masks are the plugin's to write: set them for channels it fills
+// with one value, and clear them after rendering anything else.
+// [audio-thread]
+func (v *BufferViews) SetConstant(ch int, constant bool) {
+	ref := &v.refs[ch]
+	if constant {
+		ref.buffer.constant_mask |= C.uint64_t(ref.bit)
+	} else {
+		ref.buffer.constant_mask &^= C.uint64_t(ref.bit)
+	}
+}
+
+// ClearConstant clears every bound channel's constant bit
+// [audio-thread]
+func (v *BufferViews) ClearConstant() {
+	for ch := range v.refs {
+		v.SetConstant(ch, false)
+	}
+}
+
+// MaxFrames returns the frame capacity the views were created for.
+func (v *BufferViews) MaxFrames() uint32 {
+	return v.maxFrames
+}
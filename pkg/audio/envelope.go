@@ -31,6 +31,14 @@ type ADSREnvelope struct {
 	
 	// Configuration
 	SampleRate float64
+	
+	// Per-sample steps for ProcessBlock, derived from the times and sample
+	// rate they were computed for
+	coeffSource  [4]float64
+	sampleTime   float64
+	attackStep   float64
+	decayStep    float64
+	releaseStep  float64
 }
 
 // NewADSREnvelope creates a new ADSR envelope with default values
@@ -127,6 +135,194 @@ func (env *ADSREnvelope) Process() float64 {
 	return env.CurrentValue
 }
 
+// updateCoefficients recomputes the ProcessBlock steps, only when a time or
+// the sample rate changed since they were last computed
+func (env *ADSREnvelope) updateCoefficients() {
+	source := [4]float64{env.Attack, env.Decay, env.ReleaseTime, env.SampleRate}
+	if source == env.coeffSource && env.sampleTime != 0 {
+		return
+	}
+	env.coeffSource = source
+	env.sampleTime = 1.0 / env.SampleRate
+	env.attackStep, env.decayStep, env.releaseStep = 0, 0, 0
+	if env.Attack > 0 {
+		env.attackStep = env.sampleTime / env.Attack
+	}
+	if env.Decay > 0 {
+		env.decayStep = env.sampleTime / env.Decay
+	}
+	if env.ReleaseTime > 0 {
+		env.releaseStep = env.sampleTime / env.ReleaseTime
+	}
+}
+
+// ProcessBlock renders len(dst) samples of the envelope into dst, the values
+// Process would return one call at a time. Each stage is rendered as a
+// whole segment: a closed-form ramp for attack, decay and release and a
+// constant fill for sustain and idle, with the stage only switched at
+// segment boundaries.
+// [audio-thread]
+func (env *ADSREnvelope) ProcessBlock(dst []float32) {
+	env.updateCoefficients()
+	for len(dst) > 0 {
+		dst = dst[env.renderSegment(dst, 1, false):]
+	}
+}
+
+// ApplyBlock multiplies dst in place by the envelope times gain and
+// advances it by len(dst) samples, sparing voices a separate envelope
+// buffer. A sustained note costs one gain kernel per block.
+// [audio-thread]
+func (env *ADSREnvelope) ApplyBlock(dst []float32, gain float32) {
+	env.updateCoefficients()
+	for len(dst) > 0 {
+		dst = dst[env.renderSegment(dst, gain, true):]
+	}
+}
+
+// rampLength is the number of samples a ramp of step per sample from
+// progress takes to reach 1, the sample that does being the boundary
+func rampLength(progress, step float64) int {
+	remaining := math.Ceil((1.0 - progress) / step)
+	if remaining <= 0 {
+		return 0
+	}
+	if remaining > math.MaxInt32 {
+		return math.MaxInt32
+	}
+	return int(remaining)
+}
+
+// renderSegment renders the current stage up to its end or the end of dst,
+// writing or multiplying in the envelope times gain, and returns the
+// number of samples consumed. A stage boundary consumes one sample, which
+// takes the value Process gives it.
+func (env *ADSREnvelope) renderSegment(dst []float32, gain float32, multiply bool) int {
+	switch env.Stage {
+	case EnvelopeStageAttack:
+		if env.attackStep == 0 {
+			return env.boundary(dst, 1.0, EnvelopeStageDecay, gain, multiply)
+		}
+		// value = time / attack
+		progress := env.TimeInStage / env.Attack
+		n := min(rampLength(progress, env.attackStep), len(dst))
+		env.renderLinear(dst[:n], progress, env.attackStep, gain, multiply)
+		if n == len(dst) {
+			return n
+		}
+		return n + env.boundary(dst[n:], 1.0, EnvelopeStageDecay, gain, multiply)
+		
+	case EnvelopeStageDecay:
+		if env.decayStep == 0 {
+			return env.boundary(dst, env.Sustain, EnvelopeStageSustain, gain, multiply)
+		}
+		// value = 1 - progress * (1 - sustain)
+		progress := env.TimeInStage / env.Decay
+		depth := 1.0 - env.Sustain
+		n := min(rampLength(progress, env.decayStep), len(dst))
+		env.renderLinear(dst[:n], 1.0-progress*depth, -env.decayStep*depth, gain, multiply)
+		if n == len(dst) {
+			return n
+		}
+		return n + env.boundary(dst[n:], env.Sustain, EnvelopeStageSustain, gain, multiply)
+		
+	case EnvelopeStageSustain:
+		env.CurrentValue = env.Sustain
+		env.fill(dst, float32(env.Sustain)*gain, multiply)
+		return len(dst)
+		
+	case EnvelopeStageRelease:
+		if env.releaseStep == 0 {
+			return env.boundary(dst, 0, EnvelopeStageIdle, gain, multiply)
+		}
+		// value = release level * (1 - progress)^2
+		progress := env.TimeInStage / env.ReleaseTime
+		n := min(rampLength(progress, env.releaseStep), len(dst))
+		env.renderRelease(dst[:n], 1.0-progress, gain, multiply)
+		if n == len(dst) {
+			return n
+		}
+		return n + env.boundary(dst[n:], 0, EnvelopeStageIdle, gain, multiply)
+		
+	default:
+		env.CurrentValue = 0
+		env.fill(dst, 0, multiply)
+		return len(dst)
+	}
+}
+
+// renderLinear renders the ramp start + i*slope over dst and advances the
+// time in stage past it
+func (env *ADSREnvelope) renderLinear(dst []float32, start, slope float64, gain float32, multiply bool) {
+	if len(dst) == 0 {
+		return
+	}
+	g := float64(gain)
+	if multiply {
+		for i := range dst {
+			dst[i] *= float32((start + float64(i)*slope) * g)
+		}
+	} else {
+		for i := range dst {
+			dst[i] = float32((start + float64(i)*slope) * g)
+		}
+	}
+	env.CurrentValue = start + float64(len(dst)-1)*slope
+	env.TimeInStage += float64(len(dst)) * env.sampleTime
+}
+
+// renderRelease renders the release curve level * x^2 over dst, x falling
+// linearly from remaining, and advances the time in stage past it
+func (env *ADSREnvelope) renderRelease(dst []float32, remaining float64, gain float32, multiply bool) {
+	if len(dst) == 0 {
+		return
+	}
+	level := env.ReleaseLevel * float64(gain)
+	step := env.releaseStep
+	if multiply {
+		for i := range dst {
+			x := remaining - float64(i)*step
+			dst[i] *= float32(level * x * x)
+		}
+	} else {
+		for i := range dst {
+			x := remaining - float64(i)*step
+			dst[i] = float32(level * x * x)
+		}
+	}
+	x := remaining - float64(len(dst)-1)*step
+	env.CurrentValue = env.ReleaseLevel * x * x
+	env.TimeInStage += float64(len(dst)) * env.sampleTime
+}
+
+// boundary renders the one sample that ends a stage at value and enters next
+func (env *ADSREnvelope) boundary(dst []float32, value float64, next EnvelopeStage, gain float32, multiply bool) int {
+	if multiply {
+		dst[0] *= float32(value) * gain
+	} else {
+		dst[0] = float32(value) * gain
+	}
+	env.CurrentValue = value
+	env.Stage = next
+	env.TimeInStage = 0
+	return 1
+}
+
+// fill writes or multiplies in a constant
+func (env *ADSREnvelope) fill(dst []float32, value float32, multiply bool) {
+	if !multiply {
+		for i := range dst {
+			dst[i] = value
+		}
+	} else if value == 0 {
+		for i := range dst {
+			dst[i] = 0
+		}
+	} else {
+		scaleChannel(dst, dst, value)
+	}
+}
+
 // IsActive returns true if the envelope is currently generating a non-zero value
 func (env *ADSREnvelope) IsActive() bool {
 	return env.Stage != EnvelopeStageIdle
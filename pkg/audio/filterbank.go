@@ -0,0 +1,441 @@
+package audio
+
+import (
+	"math"
+)
+
+// The block filter engine behind SelectableFilter.ProcessBuffer and
+// FilterBank. It runs the same state variable filter as
+// StateVariableFilter.Process, but a block at a time:
+//   - the filter type is resolved once per block into output mix weights,
+//   - the tuning and damping coefficients ramp linearly across the block
+//     from the last block's values, so cutoff changes do not zipper,
+//   - NaN/Inf and denormal handling is done on the state at the end of the
+//     block rather than on every sample,
+//   - FilterBank runs eight independent filters at once in the native
+//     vector kernel, one per lane (kernels_native.go), and interleaves four
+//     or two in Go otherwise, so the serial dependency of one filter no
+//     longer bounds throughput.
+
+// svfSoftClipLevel is where the state soft clipping of Process kicks in
+const svfSoftClipLevel = 10.0
+
+// svfDenormalLevel is the state magnitude below which it is flushed to
+// zero at the end of a block, far below audibility
+const svfDenormalLevel = 1e-20
+
+// svfCoefficients returns the tuning and damping coefficients
+// StateVariableFilter.Process derives from frequency and resonance
+func svfCoefficients(frequency, resonance, sampleRate float64) (tuning, damping float64) {
+	tuning = 2.0 * math.Sin(math.Pi*frequency/sampleRate)
+	if tuning > 1.5 {
+		tuning = 1.5
+	}
+	return tuning, 2.0 / resonance
+}
+
+// svfSoftClip applies Process's soft clipping to a state value
+func svfSoftClip(x float64) float64 {
+	if x > svfSoftClipLevel || x < -svfSoftClipLevel {
+		return svfSoftClipLevel * math.Tanh(x/svfSoftClipLevel)
+	}
+	return x
+}
+
+// svfMix holds the weights that select a filter type's output from the
+// lowpass, highpass and bandpass signals
+type svfMix struct {
+	lowpass, highpass, bandpass float64
+}
+
+// svfMixFor returns the mix for filterType; ok is false for bypass and
+// unknown types, which leave the signal untouched
+func svfMixFor(filterType FilterType) (mix svfMix, ok bool) {
+	switch filterType {
+	case FilterLowpass:
+		return svfMix{lowpass: 1}, true
+	case FilterHighpass:
+		return svfMix{highpass: 1}, true
+	case FilterBandpass:
+		return svfMix{bandpass: 1}, true
+	case FilterNotch:
+		return svfMix{lowpass: 1, highpass: 1}, true
+	default:
+		return svfMix{}, false
+	}
+}
+
+// svfRamp tracks one filter's coefficients between blocks
+type svfRamp struct {
+	tuning, damping float64 // in effect at the end of the last block
+
+	// Target, recomputed only when its inputs change
+	source                      [3]float64
+	targetTuning, targetDamping float64
+	started                     bool
+}
+
+// next returns the coefficients at the start and the per-sample steps for
+// a block of n samples ending on the target for frequency and resonance
+func (r *svfRamp) next(frequency, resonance, sampleRate float64, n int) (tuning, damping, tuningStep, dampingStep float64) {
+	if source := [3]float64{frequency, resonance, sampleRate}; source != r.source || !r.started {
+		r.source = source
+		r.targetTuning, r.targetDamping = svfCoefficients(frequency, resonance, sampleRate)
+	}
+	if !r.started {
+		// Nothing to glide from on the first block
+		r.tuning, r.damping = r.targetTuning, r.targetDamping
+		r.started = true
+	}
+
+	tuning, damping = r.tuning, r.damping
+	if n > 0 && (tuning != r.targetTuning || damping != r.targetDamping) {
+		tuningStep = (r.targetTuning - tuning) / float64(n)
+		dampingStep = (r.targetDamping - damping) / float64(n)
+	}
+	r.tuning, r.damping = r.targetTuning, r.targetDamping
+	return tuning, damping, tuningStep, dampingStep
+}
+
+// svfLane is the state of one filter in a block kernel
+type svfLane struct {
+	lowpass, bandpass float64
+}
+
+// settle flushes denormal state and reports whether the state blew up
+func (s *svfLane) settle() (nan, inf bool) {
+	if math.IsNaN(s.lowpass) || math.IsNaN(s.bandpass) {
+		return true, false
+	}
+	if math.IsInf(s.lowpass, 0) || math.IsInf(s.bandpass, 0) {
+		return false, true
+	}
+	if math.Abs(s.lowpass) < svfDenormalLevel {
+		s.lowpass = 0
+	}
+	if math.Abs(s.bandpass) < svfDenormalLevel {
+		s.bandpass = 0
+	}
+	return false, false
+}
+
+// svfBlock filters buf in place with coefficients ramping from
+// (tuning, damping) by the given steps per sample
+func svfBlock(s *svfLane, buf []float32, mix svfMix, tuning, damping, tuningStep, dampingStep float64) {
+	lp, bp := s.lowpass, s.bandpass
+	for i := range buf {
+		tuning += tuningStep
+		damping += dampingStep
+
+		hp := float64(buf[i]) - lp - damping*bp
+		bp = svfSoftClip(tuning*hp + bp)
+		lp = svfSoftClip(tuning*bp + lp)
+		buf[i] = float32(mix.lowpass*lp + mix.highpass*hp + mix.bandpass*bp)
+	}
+	s.lowpass, s.bandpass = lp, bp
+}
+
+// svfBlock2 is svfBlock for two independent filters, as for a stereo pair.
+// Both buffers must be the same length.
+func svfBlock2(s *[2]svfLane, a, b []float32, mix svfMix, tuning, damping, tuningStep, dampingStep *[2]float64) {
+	b = b[:len(a)]
+	lp0, bp0 := s[0].lowpass, s[0].bandpass
+	lp1, bp1 := s[1].lowpass, s[1].bandpass
+	t0, t1 := tuning[0], tuning[1]
+	d0, d1 := damping[0], damping[1]
+	for i := range a {
+		t0 += tuningStep[0]
+		t1 += tuningStep[1]
+		d0 += dampingStep[0]
+		d1 += dampingStep[1]
+
+		hp0 := float64(a[i]) - lp0 - d0*bp0
+		hp1 := float64(b[i]) - lp1 - d1*bp1
+		bp0 = svfSoftClip(t0*hp0 + bp0)
+		bp1 = svfSoftClip(t1*hp1 + bp1)
+		lp0 = svfSoftClip(t0*bp0 + lp0)
+		lp1 = svfSoftClip(t1*bp1 + lp1)
+		a[i] = float32(mix.lowpass*lp0 + mix.highpass*hp0 + mix.bandpass*bp0)
+		b[i] = float32(mix.lowpass*lp1 + mix.highpass*hp1 + mix.bandpass*bp1)
+	}
+	s[0].lowpass, s[0].bandpass = lp0, bp0
+	s[1].lowpass, s[1].bandpass = lp1, bp1
+}
+
+// svfBlock4 is svfBlock for four independent filters, as for a group of
+// voices; two of them are the Go fallback of svfBlock8. All buffers must be
+// the same length.
+func svfBlock4(s *[4]svfLane, bufs *[4][]float32, mix svfMix, tuning, damping, tuningStep, dampingStep *[4]float64) {
+	a := bufs[0]
+	b := bufs[1][:len(a)]
+	c := bufs[2][:len(a)]
+	d := bufs[3][:len(a)]
+	lp0, bp0 := s[0].lowpass, s[0].bandpass
+	lp1, bp1 := s[1].lowpass, s[1].bandpass
+	lp2, bp2 := s[2].lowpass, s[2].bandpass
+	lp3, bp3 := s[3].lowpass, s[3].bandpass
+	t0, t1, t2, t3 := tuning[0], tuning[1], tuning[2], tuning[3]
+	d0, d1, d2, d3 := damping[0], damping[1], damping[2], damping[3]
+	ts0, ts1, ts2, ts3 := tuningStep[0], tuningStep[1], tuningStep[2], tuningStep[3]
+	ds0, ds1, ds2, ds3 := dampingStep[0], dampingStep[1], dampingStep[2], dampingStep[3]
+	for i := range a {
+		t0 += ts0
+		t1 += ts1
+		t2 += ts2
+		t3 += ts3
+		d0 += ds0
+		d1 += ds1
+		d2 += ds2
+		d3 += ds3
+
+		hp0 := float64(a[i]) - lp0 - d0*bp0
+		hp1 := float64(b[i]) - lp1 - d1*bp1
+		hp2 := float64(c[i]) - lp2 - d2*bp2
+		hp3 := float64(d[i]) - lp3 - d3*bp3
+		bp0 = svfSoftClip(t0*hp0 + bp0)
+		bp1 = svfSoftClip(t1*hp1 + bp1)
+		bp2 = svfSoftClip(t2*hp2 + bp2)
+		bp3 = svfSoftClip(t3*hp3 + bp3)
+		lp0 = svfSoftClip(t0*bp0 + lp0)
+		lp1 = svfSoftClip(t1*bp1 + lp1)
+		lp2 = svfSoftClip(t2*bp2 + lp2)
+		lp3 = svfSoftClip(t3*bp3 + lp3)
+		a[i] = float32(mix.lowpass*lp0 + mix.highpass*hp0 + mix.bandpass*bp0)
+		b[i] = float32(mix.lowpass*lp1 + mix.highpass*hp1 + mix.bandpass*bp1)
+		c[i] = float32(mix.lowpass*lp2 + mix.highpass*hp2 + mix.bandpass*bp2)
+		d[i] = float32(mix.lowpass*lp3 + mix.highpass*hp3 + mix.bandpass*bp3)
+	}
+	s[0].lowpass, s[0].bandpass = lp0, bp0
+	s[1].lowpass, s[1].bandpass = lp1, bp1
+	s[2].lowpass, s[2].bandpass = lp2, bp2
+	s[3].lowpass, s[3].bandpass = lp3, bp3
+}
+
+// svfKernelArgs is what nativeSVF8 reads and updates for a group of eight
+// lanes. It lives in the bank so the cgo call does not allocate.
+type svfKernelArgs struct {
+	state [16]float64 // lowpass of each lane, then bandpass
+	ramp  [32]float64 // tuning, damping, tuning step, damping step
+	mix   [3]float64  // lowpass, highpass, bandpass
+}
+
+// svfBlock8 is svfBlock for eight independent filters in the native vector
+// kernel. The kernel leaves soft clipping to Go: it stops at the first
+// sample that needs it and svfBlock4 finishes the block from there. args is
+// the kernel's scratch.
+func svfBlock8(s *[8]svfLane, bufs *[8][]float32, mix svfMix, tuning, damping, tuningStep, dampingStep *[8]float64, args *svfKernelArgs) {
+	for i := 0; i < 8; i++ {
+		args.state[i], args.state[8+i] = s[i].lowpass, s[i].bandpass
+		args.ramp[i], args.ramp[8+i] = tuning[i], damping[i]
+		args.ramp[16+i], args.ramp[24+i] = tuningStep[i], dampingStep[i]
+	}
+	args.mix = [3]float64{mix.lowpass, mix.highpass, mix.bandpass}
+
+	done := nativeSVF8(bufs, args)
+
+	var reached, reachedDamping [8]float64
+	for i := 0; i < 8; i++ {
+		s[i] = svfLane{lowpass: args.state[i], bandpass: args.state[8+i]}
+		reached[i], reachedDamping[i] = args.ramp[i], args.ramp[8+i]
+	}
+	if done == len(bufs[0]) {
+		return
+	}
+	var tail [8][]float32
+	for i := range tail {
+		tail[i] = bufs[i][done:]
+	}
+	for i := 0; i < 8; i += 4 {
+		svfBlock4((*[4]svfLane)(s[i:]), (*[4][]float32)(tail[i:]), mix,
+			(*[4]float64)(reached[i:]), (*[4]float64)(reachedDamping[i:]),
+			(*[4]float64)(tuningStep[i:]), (*[4]float64)(dampingStep[i:]))
+	}
+}
+
+// FilterBank runs several state variable filters of one type side by side,
+// one lane per channel or voice, each with its own cutoff and resonance.
+// Lanes are processed eight at a time in the native vector kernel for
+// blocks of at least NativeKernelMinFrames, otherwise four or two at a time. Configure it
+// outside the audio thread where possible; setters are cheap but not
+// synchronized.
+type FilterBank struct {
+	sampleRate float64
+	filterType FilterType
+	safeMode   bool
+
+	frequency []float64
+	resonance []float64
+	ramps     []svfRamp
+	state     []svfLane
+	native    svfKernelArgs
+
+	// Statistics; a reset lane counts once per block
+	nanCount   uint64
+	infCount   uint64
+	resetCount uint64
+}
+
+// NewFilterBank creates a bank of lanes lowpass filters at 1 kHz
+func NewFilterBank(lanes int, sampleRate float64, safeMode bool) *FilterBank {
+	fb := &FilterBank{
+		sampleRate: sampleRate,
+		filterType: FilterLowpass,
+		safeMode:   safeMode,
+		frequency:  make([]float64, lanes),
+		resonance:  make([]float64, lanes),
+		ramps:      make([]svfRamp, lanes),
+		state:      make([]svfLane, lanes),
+	}
+	for i := range fb.frequency {
+		fb.frequency[i] = 1000.0
+		fb.resonance[i] = 1.0
+	}
+	return fb
+}
+
+// Lanes returns the number of filters in the bank
+func (fb *FilterBank) Lanes() int {
+	return len(fb.state)
+}
+
+// SetType sets the filter type of every lane
+func (fb *FilterBank) SetType(filterType FilterType) {
+	fb.filterType = filterType
+}
+
+// SetFrequency sets a lane's cutoff in Hz; the change glides over the next block
+func (fb *FilterBank) SetFrequency(lane int, freq float64) {
+	fb.frequency[lane] = Clamp(freq, 20.0, fb.sampleRate*0.45)
+}
+
+// SetResonance sets a lane's resonance (Q factor)
+func (fb *FilterBank) SetResonance(lane int, q float64) {
+	fb.resonance[lane] = Clamp(q, 0.5, 20.0)
+}
+
+// SetSampleRate changes the sample rate, keeping each lane's settings
+func (fb *FilterBank) SetSampleRate(sampleRate float64) {
+	fb.sampleRate = sampleRate
+	for lane := range fb.frequency {
+		fb.frequency[lane] = Clamp(fb.frequency[lane], 20.0, sampleRate*0.45)
+		fb.ramps[lane] = svfRamp{}
+	}
+	fb.Reset()
+}
+
+// ResetLane clears one lane's state, as for a voice starting a new note.
+// Its coefficients jump to the current settings rather than gliding.
+func (fb *FilterBank) ResetLane(lane int) {
+	fb.state[lane] = svfLane{}
+	fb.ramps[lane].started = false
+}
+
+// Reset clears every lane's state
+func (fb *FilterBank) Reset() {
+	for lane := range fb.state {
+		fb.state[lane] = svfLane{}
+	}
+}
+
+// Process filters lane i's signal in buffers[i] in place. It handles up to
+// Lanes() buffers, which must all be the same length; a nil buffer skips
+// its lane without advancing it.
+// [audio-thread]
+func (fb *FilterBank) Process(buffers [][]float32) {
+	mix, ok := svfMixFor(fb.filterType)
+	if !ok {
+		return
+	}
+	n := len(buffers)
+	if n > len(fb.state) {
+		n = len(fb.state)
+	}
+
+	var group [8][]float32
+	var lanes [8]int
+	count := 0
+	for lane := 0; lane < n; lane++ {
+		if buffers[lane] == nil {
+			continue
+		}
+		group[count] = buffers[lane]
+		lanes[count] = lane
+		count++
+		if count == 8 {
+			fb.processGroup(&group, &lanes, count, mix)
+			count = 0
+		}
+	}
+	if count > 0 {
+		fb.processGroup(&group, &lanes, count, mix)
+	}
+}
+
+// processGroup runs up to eight lanes through the widest kernels that fit
+func (fb *FilterBank) processGroup(group *[8][]float32, lanes *[8]int, count int, mix svfMix) {
+	frames := len(group[0])
+	var tuning, damping, tuningStep, dampingStep [8]float64
+	for i := 0; i < count; i++ {
+		lane := lanes[i]
+		tuning[i], damping[i], tuningStep[i], dampingStep[i] =
+			fb.ramps[lane].next(fb.frequency[lane], fb.resonance[lane], fb.sampleRate, frames)
+	}
+
+	i := 0
+	if count == 8 && useNative(frames) {
+		var state [8]svfLane
+		for j := range state {
+			state[j] = fb.state[lanes[j]]
+		}
+		svfBlock8(&state, group, mix, &tuning, &damping, &tuningStep, &dampingStep, &fb.native)
+		for j := range state {
+			fb.state[lanes[j]] = state[j]
+		}
+		i = 8
+	}
+	for ; i+4 <= count; i += 4 {
+		state := [4]svfLane{fb.state[lanes[i]], fb.state[lanes[i+1]], fb.state[lanes[i+2]], fb.state[lanes[i+3]]}
+		svfBlock4(&state, (*[4][]float32)(group[i:]), mix,
+			(*[4]float64)(tuning[i:]), (*[4]float64)(damping[i:]),
+			(*[4]float64)(tuningStep[i:]), (*[4]float64)(dampingStep[i:]))
+		for j := 0; j < 4; j++ {
+			fb.state[lanes[i+j]] = state[j]
+		}
+	}
+	for ; i+2 <= count; i += 2 {
+		state := [2]svfLane{fb.state[lanes[i]], fb.state[lanes[i+1]]}
+		svfBlock2(&state, group[i], group[i+1], mix,
+			(*[2]float64)(tuning[i:]), (*[2]float64)(damping[i:]),
+			(*[2]float64)(tuningStep[i:]), (*[2]float64)(dampingStep[i:]))
+		fb.state[lanes[i]], fb.state[lanes[i+1]] = state[0], state[1]
+	}
+	if i < count {
+		svfBlock(&fb.state[lanes[i]], group[i], mix, tuning[i], damping[i], tuningStep[i], dampingStep[i])
+	}
+
+	for i := 0; i < count; i++ {
+		lane := lanes[i]
+		nan, inf := fb.state[lane].settle()
+		if (nan || inf) && fb.safeMode {
+			if nan {
+				fb.nanCount++
+			} else {
+				fb.infCount++
+			}
+			fb.resetCount++
+			fb.state[lane] = svfLane{}
+			clear(group[i])
+		}
+	}
+}
+
+// GetStatistics returns the bank's NaN/Inf statistics
+func (fb *FilterBank) GetStatistics() FilterStatistics {
+	return FilterStatistics{
+		NaNCount:   fb.nanCount,
+		InfCount:   fb.infCount,
+		ResetCount: fb.resetCount,
+		SafeMode:   fb.safeMode,
+		FilterType: fb.filterType,
+	}
+}
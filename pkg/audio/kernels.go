@@ -0,0 +1,282 @@
+package audio
+
+import (
+	"fmt"
+	"math"
+	"sync/atomic"
+)
+
+// NativeKernelMinFrames is the buffer length from which the SIMD kernels are
+// used. Below it the cost of the cgo call outweighs the gain, so the unrolled
+// Go loops run instead.
+const NativeKernelMinFrames = 128
+
+// nativeKernelsEnabled selects the SIMD kernels for long buffers
+var nativeKernelsEnabled atomic.Bool
+
+func init() {
+	nativeKernelsEnabled.Store(true)
+}
+
+// SetNativeKernels enables or disables the SIMD buffer kernels. With them
+// disabled every buffer operation uses the pure-Go path.
+func SetNativeKernels(enabled bool) {
+	nativeKernelsEnabled.Store(enabled)
+}
+
+// KernelISA returns the instruction set used by the buffer kernels:
+// "avx2", "sse2", "neon", "generic", or "go" when native kernels are disabled
+func KernelISA() string {
+	if !nativeKernelsEnabled.Load() {
+		return "go"
+	}
+	return nativeKernelISA
+}
+
+func useNative(n int) bool {
+	return n >= NativeKernelMinFrames && nativeKernelsEnabled.Load()
+}
+
+// scaleChannel writes src*gain to dst; both must have the same length
+func scaleChannel(dst, src []float32, gain float32) {
+	if len(dst) == 0 {
+		return
+	}
+	if useNative(len(dst)) {
+		nativeScale(dst, src, gain)
+		return
+	}
+	scaleGo(dst, src, gain)
+}
+
+// mixChannel adds src*gain to dst; both must have the same length
+func mixChannel(dst, src []float32, gain float32) {
+	if len(dst) == 0 {
+		return
+	}
+	if useNative(len(dst)) {
+		nativeMix(dst, src, gain)
+		return
+	}
+	mixGo(dst, src, gain)
+}
+
+// peakChannel returns the largest absolute sample value
+func peakChannel(src []float32) float32 {
+	if len(src) == 0 {
+		return 0
+	}
+	if useNative(len(src)) {
+		return nativePeak(src)
+	}
+	return peakGo(src)
+}
+
+// sumSquaresChannel returns the sum of squared samples in double precision
+func sumSquaresChannel(src []float32) float64 {
+	if len(src) == 0 {
+		return 0
+	}
+	if useNative(len(src)) {
+		return nativeSumSquares(src)
+	}
+	return sumSquaresGo(src)
+}
+
+// Pure-Go kernels. Reslicing to a fixed-size window lets the compiler drop
+// the bounds checks inside the unrolled body.
+
+func scaleGo(dst, src []float32, gain float32) {
+	src = src[:len(dst)]
+	i := 0
+	for ; i+4 <= len(dst); i += 4 {
+		d := dst[i : i+4 : i+4]
+		s := src[i : i+4 : i+4]
+		d[0] = s[0] * gain
+		d[1] = s[1] * gain
+		d[2] = s[2] * gain
+		d[3] = s[3] * gain
+	}
+	for ; i < len(dst); i++ {
+		dst[i] = src[i] * gain
+	}
+}
+
+// mixGo rounds each product before the add. The explicit conversions stop
+// the compiler fusing them into FMA, as it does on arm64, so the result
+// matches the native kernel, which is compiled with contraction off.
+func mixGo(dst, src []float32, gain float32) {
+	src = src[:len(dst)]
+	i := 0
+	for ; i+4 <= len(dst); i += 4 {
+		d := dst[i : i+4 : i+4]
+		s := src[i : i+4 : i+4]
+		d[0] += float32(s[0] * gain)
+		d[1] += float32(s[1] * gain)
+		d[2] += float32(s[2] * gain)
+		d[3] += float32(s[3] * gain)
+	}
+	for ; i < len(dst); i++ {
+		dst[i] += float32(src[i] * gain)
+	}
+}
+
+func peakGo(src []float32) float32 {
+	var p0, p1, p2, p3 float32
+	i := 0
+	for ; i+4 <= len(src); i += 4 {
+		s := src[i : i+4 : i+4]
+		if a := abs32(s[0]); a > p0 {
+			p0 = a
+		}
+		if a := abs32(s[1]); a > p1 {
+			p1 = a
+		}
+		if a := abs32(s[2]); a > p2 {
+			p2 = a
+		}
+		if a := abs32(s[3]); a > p3 {
+			p3 = a
+		}
+	}
+	for ; i < len(src); i++ {
+		if a := abs32(src[i]); a > p0 {
+			p0 = a
+		}
+	}
+	if p1 > p0 {
+		p0 = p1
+	}
+	if p3 > p2 {
+		p2 = p3
+	}
+	if p2 > p0 {
+		p0 = p2
+	}
+	return p0
+}
+
+func sumSquaresGo(src []float32) float64 {
+	var s0, s1, s2, s3 float64
+	i := 0
+	for ; i+4 <= len(src); i += 4 {
+		s := src[i : i+4 : i+4]
+		v0, v1, v2, v3 := float64(s[0]), float64(s[1]), float64(s[2]), float64(s[3])
+		s0 += v0 * v0
+		s1 += v1 * v1
+		s2 += v2 * v2
+		s3 += v3 * v3
+	}
+	for ; i < len(src); i++ {
+		v := float64(src[i])
+		s0 += v * v
+	}
+	return (s0 + s1) + (s2 + s3)
+}
+
+// abs32 clears the sign bit without a float64 round trip
+func abs32(x float32) float32 {
+	return math.Float32frombits(math.Float32bits(x) &^ (1 << 31))
+}
+
+// VerifyKernels runs the native kernels against the pure-Go kernels on
+// deterministic test signals and reports the first mismatch. Gain and mix
+// must match exactly; peak exactly; sum of squares and the filters within
+// rounding.
+func VerifyKernels() error {
+	for _, n := range []int{NativeKernelMinFrames, NativeKernelMinFrames + 3, 1021, 4096} {
+		src := make([]float32, n)
+		seed := uint32(0x12345678)
+		for i := range src {
+			seed = seed*1664525 + 1013904223
+			src[i] = float32(int32(seed))/float32(math.MaxInt32)
+		}
+
+		goOut := make([]float32, n)
+		nativeOut := make([]float32, n)
+
+		scaleGo(goOut, src, 0.7071)
+		nativeScale(nativeOut, src, 0.7071)
+		if i := firstDifference(goOut, nativeOut); i >= 0 {
+			return fmt.Errorf("scale kernel differs at %d of %d: %g != %g", i, n, nativeOut[i], goOut[i])
+		}
+
+		mixGo(goOut, src, -0.25)
+		nativeMix(nativeOut, src, -0.25)
+		if i := firstDifference(goOut, nativeOut); i >= 0 {
+			return fmt.Errorf("mix kernel differs at %d of %d: %g != %g", i, n, nativeOut[i], goOut[i])
+		}
+
+		if a, b := peakGo(src), nativePeak(src); a != b {
+			return fmt.Errorf("peak kernel differs for %d frames: %g != %g", n, b, a)
+		}
+
+		a, b := sumSquaresGo(src), nativeSumSquares(src)
+		if math.Abs(a-b) > 1e-9*math.Max(1, a) {
+			return fmt.Errorf("sum of squares kernel differs for %d frames: %g != %g", n, b, a)
+		}
+
+		if err := verifySVF8(src); err != nil {
+			return err
+		}
+	}
+	return nil
+}
+
+// verifySVF8 filters src through eight lanes with different cutoffs,
+// resonances and gliding coefficients, the last four driven into soft
+// clipping, and checks svfBlock8 against two svfBlock4 runs
+func verifySVF8(src []float32) error {
+	var goBufs, nativeBufs [8][]float32
+	var lanes [8]svfLane
+	var nativeLanes [8]svfLane
+	var args svfKernelArgs
+	var tuning, damping, tuningStep, dampingStep [8]float64
+	for lane := range goBufs {
+		gain := float32(1 + 7*(lane/4))
+		goBufs[lane] = make([]float32, len(src))
+		nativeBufs[lane] = make([]float32, len(src))
+		for i, sample := range src {
+			goBufs[lane][i] = sample * gain
+		}
+		copy(nativeBufs[lane], goBufs[lane])
+
+		resonance := 0.7 + 2.5*float64(lane)
+		t, d := svfCoefficients(200*float64(lane+1), resonance, 48000)
+		t2, d2 := svfCoefficients(300*float64(lane+1), resonance, 48000)
+		tuning[lane], damping[lane] = t, d
+		tuningStep[lane] = (t2 - t) / float64(len(src))
+		dampingStep[lane] = (d2 - d) / float64(len(src))
+		lanes[lane] = svfLane{lowpass: 0.1 * float64(lane), bandpass: -0.05}
+	}
+	nativeLanes = lanes
+	mix := svfMix{lowpass: 1, highpass: 0.5, bandpass: 0.25}
+
+	svfBlock8(&nativeLanes, &nativeBufs, mix, &tuning, &damping, &tuningStep, &dampingStep, &args)
+	for i := 0; i < 8; i += 4 {
+		svfBlock4((*[4]svfLane)(lanes[i:]), (*[4][]float32)(goBufs[i:]), mix,
+			(*[4]float64)(tuning[i:]), (*[4]float64)(damping[i:]),
+			(*[4]float64)(tuningStep[i:]), (*[4]float64)(dampingStep[i:]))
+	}
+
+	for lane := range goBufs {
+		for i, want := range goBufs[lane] {
+			if got := nativeBufs[lane][i]; math.Abs(float64(got-want)) > 1e-5*math.Max(1, math.Abs(float64(want))) {
+				return fmt.Errorf("filter kernel lane %d differs at %d of %d: %g != %g", lane, i, len(src), got, want)
+			}
+		}
+		if got, want := nativeLanes[lane].lowpass, lanes[lane].lowpass; math.Abs(got-want) > 1e-9*math.Max(1, math.Abs(want)) {
+			return fmt.Errorf("filter kernel lane %d ends with lowpass %g, want %g", lane, got, want)
+		}
+	}
+	return nil
+}
+
+func firstDifference(a, b []float32) int {
+	for i := range a {
+		if a[i] != b[i] {
+			return i
+		}
+	}
+	return -1
+}
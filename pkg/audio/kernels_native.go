@@ -0,0 +1,226 @@
+package audio
+
+// #include <stdint.h>
+// #include <string.h>
+//
+// // SIMD buffer kernels written with GCC/Clang vector extensions, which
+// // lower to SSE/AVX on amd64 and NEON on arm64. On x86 ELF targets the
+// // kernels are cloned for AVX2 and the loader picks a clone at runtime from
+// // the CPU's features.
+// #if defined(__x86_64__) && defined(__ELF__) && (defined(__clang__) || defined(__GNUC__))
+// #define CLAPGO_KERNEL __attribute__((target_clones("avx2", "default")))
+// #else
+// #define CLAPGO_KERNEL
+// #endif
+//
+// typedef float clapgo_v8f __attribute__((vector_size(32)));
+// typedef int32_t clapgo_v8i __attribute__((vector_size(32)));
+// typedef double clapgo_v4d __attribute__((vector_size(32)));
+// typedef float clapgo_v4f __attribute__((vector_size(16)));
+// typedef int64_t clapgo_v4l __attribute__((vector_size(32)));
+//
+// // No FMA contraction, so the kernels round exactly like the Go fallback
+// #if defined(__clang__)
+// #pragma clang fp contract(off)
+// #elif defined(__GNUC__)
+// #pragma GCC optimize("fp-contract=off")
+// #endif
+//
+// // Unaligned vector access; macros so vector values never cross a call ABI
+// #define CLAPGO_LOAD(v, p) memcpy(&(v), (p), sizeof(v))
+// #define CLAPGO_STORE(p, v) memcpy((p), &(v), sizeof(v))
+//
+// CLAPGO_KERNEL static void clapgo_kernel_scale(float* dst, const float* src, uint32_t n, float gain) {
+//     uint32_t i = 0;
+//     clapgo_v8f g = {gain, gain, gain, gain, gain, gain, gain, gain};
+//     for (; i + 8 <= n; i += 8) {
+//         clapgo_v8f v;
+//         CLAPGO_LOAD(v, src + i);
+//         v *= g;
+//         CLAPGO_STORE(dst + i, v);
+//     }
+//     for (; i < n; ++i) dst[i] = src[i] * gain;
+// }
+//
+// CLAPGO_KERNEL static void clapgo_kernel_mix(float* dst, const float* src, uint32_t n, float gain) {
+//     uint32_t i = 0;
+//     clapgo_v8f g = {gain, gain, gain, gain, gain, gain, gain, gain};
+//     for (; i + 8 <= n; i += 8) {
+//         clapgo_v8f d, v;
+//         CLAPGO_LOAD(d, dst + i);
+//         CLAPGO_LOAD(v, src + i);
+//         d += v * g;
+//         CLAPGO_STORE(dst + i, d);
+//     }
+//     for (; i < n; ++i) dst[i] += src[i] * gain;
+// }
+//
+// CLAPGO_KERNEL static float clapgo_kernel_peak(const float* src, uint32_t n) {
+//     uint32_t i = 0;
+//     clapgo_v8f peak = {0};
+//     const clapgo_v8i abs_mask = {0x7fffffff, 0x7fffffff, 0x7fffffff, 0x7fffffff,
+//                                  0x7fffffff, 0x7fffffff, 0x7fffffff, 0x7fffffff};
+//     for (; i + 8 <= n; i += 8) {
+//         clapgo_v8i bits;
+//         CLAPGO_LOAD(bits, src + i);
+//         clapgo_v8f v = (clapgo_v8f)(bits & abs_mask);
+//         clapgo_v8i greater = v > peak;
+//         peak = (clapgo_v8f)(((clapgo_v8i)v & greater) | ((clapgo_v8i)peak & ~greater));
+//     }
+//     float result = 0.0f;
+//     for (int lane = 0; lane < 8; ++lane) if (peak[lane] > result) result = peak[lane];
+//     for (; i < n; ++i) {
+//         float v = src[i] < 0.0f ? -src[i] : src[i];
+//         if (v > result) result = v;
+//     }
+//     return result;
+// }
+//
+// CLAPGO_KERNEL static double clapgo_kernel_sum_squares(const float* src, uint32_t n) {
+//     uint32_t i = 0;
+//     clapgo_v4d lo = {0}, hi = {0};
+//     for (; i + 8 <= n; i += 8) {
+//         clapgo_v4f a, b;
+//         CLAPGO_LOAD(a, src + i);
+//         CLAPGO_LOAD(b, src + i + 4);
+//         clapgo_v4d da = __builtin_convertvector(a, clapgo_v4d);
+//         clapgo_v4d db = __builtin_convertvector(b, clapgo_v4d);
+//         lo += da * da;
+//         hi += db * db;
+//     }
+//     clapgo_v4d sum = lo + hi;
+//     double result = sum[0] + sum[1] + sum[2] + sum[3];
+//     for (; i < n; ++i) result += (double)src[i] * (double)src[i];
+//     return result;
+// }
+//
+// // Eight state variable filters of filterbank.go, one per vector lane, as
+// // two independent vectors of four so each hides the other's latency.
+// // state holds the eight lowpass then the eight bandpass values; ramp the
+// // tuning, the damping and their per-sample steps, and receives the tuning
+// // and damping reached; mix holds the lowpass, highpass and bandpass
+// // weights. The kernel stops before the first sample where a lane would
+// // need soft clipping and returns the number of samples filtered.
+// CLAPGO_KERNEL static uint32_t clapgo_kernel_svf8(float* b0, float* b1, float* b2, float* b3,
+//                                                  float* b4, float* b5, float* b6, float* b7, uint32_t n,
+//                                                  double* state, double* ramp, const double* mix) {
+//     clapgo_v4d lp0, lp1, bp0, bp1, tuning0, tuning1, damping0, damping1;
+//     clapgo_v4d tuning_step0, tuning_step1, damping_step0, damping_step1;
+//     CLAPGO_LOAD(lp0, state);
+//     CLAPGO_LOAD(lp1, state + 4);
+//     CLAPGO_LOAD(bp0, state + 8);
+//     CLAPGO_LOAD(bp1, state + 12);
+//     CLAPGO_LOAD(tuning0, ramp);
+//     CLAPGO_LOAD(tuning1, ramp + 4);
+//     CLAPGO_LOAD(damping0, ramp + 8);
+//     CLAPGO_LOAD(damping1, ramp + 12);
+//     CLAPGO_LOAD(tuning_step0, ramp + 16);
+//     CLAPGO_LOAD(tuning_step1, ramp + 20);
+//     CLAPGO_LOAD(damping_step0, ramp + 24);
+//     CLAPGO_LOAD(damping_step1, ramp + 28);
+//     const clapgo_v4d mix_lp = {mix[0], mix[0], mix[0], mix[0]};
+//     const clapgo_v4d mix_hp = {mix[1], mix[1], mix[1], mix[1]};
+//     const clapgo_v4d mix_bp = {mix[2], mix[2], mix[2], mix[2]};
+//     const clapgo_v4d level = {10.0, 10.0, 10.0, 10.0};
+//     uint32_t i = 0;
+//     for (; i < n; ++i) {
+//         clapgo_v4d t0 = tuning0 + tuning_step0, t1 = tuning1 + tuning_step1;
+//         clapgo_v4d d0 = damping0 + damping_step0, d1 = damping1 + damping_step1;
+//
+//         clapgo_v4d x0 = {b0[i], b1[i], b2[i], b3[i]};
+//         clapgo_v4d x1 = {b4[i], b5[i], b6[i], b7[i]};
+//         clapgo_v4d hp0 = x0 - lp0 - d0 * bp0, hp1 = x1 - lp1 - d1 * bp1;
+//         clapgo_v4d bpn0 = t0 * hp0 + bp0, bpn1 = t1 * hp1 + bp1;
+//         clapgo_v4d lpn0 = t0 * bpn0 + lp0, lpn1 = t1 * bpn1 + lp1;
+//
+//         clapgo_v4l clip = (bpn0 > level) | (bpn0 < -level) | (bpn1 > level) | (bpn1 < -level) |
+//                           (lpn0 > level) | (lpn0 < -level) | (lpn1 > level) | (lpn1 < -level);
+//         if (clip[0] | clip[1] | clip[2] | clip[3]) break;
+//
+//         tuning0 = t0, tuning1 = t1, damping0 = d0, damping1 = d1;
+//         bp0 = bpn0, bp1 = bpn1, lp0 = lpn0, lp1 = lpn1;
+//         clapgo_v4d y0 = mix_lp * lp0 + mix_hp * hp0 + mix_bp * bp0;
+//         clapgo_v4d y1 = mix_lp * lp1 + mix_hp * hp1 + mix_bp * bp1;
+//         b0[i] = (float)y0[0];
+//         b1[i] = (float)y0[1];
+//         b2[i] = (float)y0[2];
+//         b3[i] = (float)y0[3];
+//         b4[i] = (float)y1[0];
+//         b5[i] = (float)y1[1];
+//         b6[i] = (float)y1[2];
+//         b7[i] = (float)y1[3];
+//     }
+//     CLAPGO_STORE(state, lp0);
+//     CLAPGO_STORE(state + 4, lp1);
+//     CLAPGO_STORE(state + 8, bp0);
+//     CLAPGO_STORE(state + 12, bp1);
+//     CLAPGO_STORE(ramp, tuning0);
+//     CLAPGO_STORE(ramp + 4, tuning1);
+//     CLAPGO_STORE(ramp + 8, damping0);
+//     CLAPGO_STORE(ramp + 12, damping1);
+//     return i;
+// }
+//
+// static const char* clapgo_kernel_isa(void) {
+// #if defined(__x86_64__) && defined(__ELF__) && (defined(__clang__) || defined(__GNUC__))
+//     __builtin_cpu_init();
+//     if (__builtin_cpu_supports("avx2")) return "avx2";
+//     return "sse2";
+// #elif defined(__x86_64__)
+//     return "sse2";
+// #elif defined(__aarch64__)
+//     return "neon";
+// #else
+//     return "generic";
+// #endif
+// }
+import "C"
+import (
+	"unsafe"
+)
+
+// nativeKernelISA names the instruction set the native kernels run with
+var nativeKernelISA = C.GoString(C.clapgo_kernel_isa())
+
+func nativeScale(dst, src []float32, gain float32) {
+	// Plain locals keep cgo's pointer check from heap-allocating a closure
+	d := (*C.float)(unsafe.Pointer(&dst[0]))
+	s := (*C.float)(unsafe.Pointer(&src[0]))
+	C.clapgo_kernel_scale(d, s, C.uint32_t(len(dst)), C.float(gain))
+}
+
+func nativeMix(dst, src []float32, gain float32) {
+	d := (*C.float)(unsafe.Pointer(&dst[0]))
+	s := (*C.float)(unsafe.Pointer(&src[0]))
+	C.clapgo_kernel_mix(d, s, C.uint32_t(len(dst)), C.float(gain))
+}
+
+func nativePeak(src []float32) float32 {
+	s := (*C.float)(unsafe.Pointer(&src[0]))
+	return float32(C.clapgo_kernel_peak(s, C.uint32_t(len(src))))
+}
+
+func nativeSumSquares(src []float32) float64 {
+	s := (*C.float)(unsafe.Pointer(&src[0]))
+	return float64(C.clapgo_kernel_sum_squares(s, C.uint32_t(len(src))))
+}
+
+// nativeSVF8 runs eight filters over bufs with the state, coefficient
+// ramps and mix in args, up to the first sample that needs soft clipping,
+// and returns the number of samples filtered. The buffers must all be the
+// same length.
+func nativeSVF8(bufs *[8][]float32, args *svfKernelArgs) int {
+	n := len(bufs[0])
+	b0 := (*C.float)(unsafe.Pointer(&bufs[0][0]))
+	b1 := (*C.float)(unsafe.Pointer(&bufs[1][:n][0]))
+	b2 := (*C.float)(unsafe.Pointer(&bufs[2][:n][0]))
+	b3 := (*C.float)(unsafe.Pointer(&bufs[3][:n][0]))
+	b4 := (*C.float)(unsafe.Pointer(&bufs[4][:n][0]))
+	b5 := (*C.float)(unsafe.Pointer(&bufs[5][:n][0]))
+	b6 := (*C.float)(unsafe.Pointer(&bufs[6][:n][0]))
+	b7 := (*C.float)(unsafe.Pointer(&bufs[7][:n][0]))
+	state := (*C.double)(unsafe.Pointer(&args.state[0]))
+	ramp := (*C.double)(unsafe.Pointer(&args.ramp[0]))
+	mix := (*C.double)(unsafe.Pointer(&args.mix[0]))
+	return int(C.clapgo_kernel_svf8(b0, b1, b2, b3, b4, b5, b6, b7, C.uint32_t(n), state, ramp, mix))
+}
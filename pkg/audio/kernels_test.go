@@ -0,0 +1,107 @@
+package audio_test
+
+import (
+	"math"
+	"testing"
+
+	"github.com/justyntemme/clapgo/pkg/audio"
+)
+
+// TestVerifyKernels checks the native kernels against the pure-Go ones
+func TestVerifyKernels(t *testing.T) {
+	t.Logf("kernels: %s", audio.KernelISA())
+	if err := audio.VerifyKernels(); err != nil {
+		t.Fatal(err)
+	}
+}
+
+// TestKernelDispatch runs the buffer API with native kernels on and off, on
+// block sizes either side of the native threshold, and expects the same result
+func TestKernelDispatch(t *testing.T) {
+	defer audio.SetNativeKernels(true)
+
+	for _, frames := range []int{1, audio.NativeKernelMinFrames - 1, audio.NativeKernelMinFrames, 1021} {
+		var results [2]struct {
+			gained, mixed audio.Buffer
+			peak, rms     float32
+		}
+		for i, native := range []bool{false, true} {
+			audio.SetNativeKernels(native)
+			r := &results[i]
+
+			r.gained = kernelSignal(frames)
+			audio.ApplyGain(r.gained, 0.7071)
+			r.mixed = kernelSignal(frames)
+			if err := audio.Mix(r.mixed, r.gained, -0.25); err != nil {
+				t.Fatal(err)
+			}
+			r.peak = audio.GetPeak(r.mixed)
+			r.rms = audio.GetRMS(r.mixed)
+		}
+
+		goResult, native := results[0], results[1]
+		for ch := range goResult.gained {
+			for i := range goResult.gained[ch] {
+				if goResult.gained[ch][i] != native.gained[ch][i] || goResult.mixed[ch][i] != native.mixed[ch][i] {
+					t.Fatalf("frames=%d: channel %d differs at %d", frames, ch, i)
+				}
+			}
+		}
+		if goResult.peak != native.peak {
+			t.Errorf("frames=%d: GetPeak %g native, %g go", frames, native.peak, goResult.peak)
+		}
+		if math.Abs(float64(goResult.rms-native.rms)) > 1e-6 {
+			t.Errorf("frames=%d: GetRMS %g native, %g go", frames, native.rms, goResult.rms)
+		}
+	}
+}
+
+// TestFilterBankDispatch runs a bank of fifteen lanes, a group of eight
+// then four, two and one, with native kernels on and off and expects the
+// same output
+func TestFilterBankDispatch(t *testing.T) {
+	defer audio.SetNativeKernels(true)
+
+	for _, frames := range []int{audio.NativeKernelMinFrames - 1, audio.NativeKernelMinFrames, 1021} {
+		var results [2][][]float32
+		for i, native := range []bool{false, true} {
+			audio.SetNativeKernels(native)
+			fb := audio.NewFilterBank(15, 48000, true)
+			fb.SetType(audio.FilterBandpass)
+			bufs := make([][]float32, 15)
+			for lane := range bufs {
+				fb.SetFrequency(lane, 300+float64(lane)*500)
+				fb.SetResonance(lane, 0.7+float64(lane))
+				bufs[lane] = kernelSignal(frames)[lane%2]
+			}
+			// A second block glides to new cutoffs
+			fb.Process(bufs)
+			for lane := range bufs {
+				fb.SetFrequency(lane, 500+float64(lane)*600)
+			}
+			fb.Process(bufs)
+			results[i] = bufs
+		}
+
+		for lane := range results[0] {
+			for i, want := range results[0][lane] {
+				if got := results[1][lane][i]; math.Abs(float64(got-want)) > 1e-5 {
+					t.Fatalf("frames=%d: lane %d differs at %d: %g native, %g go", frames, lane, i, got, want)
+				}
+			}
+		}
+	}
+}
+
+// kernelSignal returns a stereo buffer of deterministic noise
+func kernelSignal(frames int) audio.Buffer {
+	buf := audio.NewBuffer(2, frames)
+	seed := uint32(0x9e3779b9)
+	for ch := range buf {
+		for i := range buf[ch] {
+			seed = seed*1664525 + 1013904223
+			buf[ch][i] = float32(int32(seed)) / float32(math.MaxInt32)
+		}
+	}
+	return buf
+}
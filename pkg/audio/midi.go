@@ -56,13 +56,17 @@ func (m *MIDIProcessor) ProcessEvents(events *event.Processor, handler event.Han
 		return
 	}
 	
-	// Create a MIDI event handler that wraps our processor
-	midiHandler := &midiEventHandler{
+	events.ProcessAll(m.NewHandler(handler))
+}
+
+// NewHandler returns an event.Handler that routes note and MIDI events to the
+// processor and forwards everything else to handler. Create it once and reuse
+// it across blocks, e.g. with a SubBlockScheduler.
+func (m *MIDIProcessor) NewHandler(handler event.Handler) event.Handler {
+	return &midiEventHandler{
 		processor: m,
 		handler:   handler,
 	}
-	
-	events.ProcessAll(midiHandler)
 }
 
 // ProcessNoteOn handles a note on event
@@ -82,7 +86,7 @@ func (m *MIDIProcessor) ProcessNoteOn(channel, key int16, velocity float64, note
 // ProcessNoteOff handles a note off event
 func (m *MIDIProcessor) ProcessNoteOff(channel, key int16, noteID int32) {
 	// Release the voice
-	m.voiceManager.ReleaseVoice(noteID, channel)
+	m.voiceManager.ReleaseNote(noteID, channel, key)
 	
 	// Call custom callback if provided
 	if m.onNoteOff != nil {
@@ -177,13 +181,7 @@ func (m *MIDIProcessor) ProcessChannelPressure(channel int16, pressure float64)
 
 // ProcessAllNotesOff handles all notes off message
 func (m *MIDIProcessor) ProcessAllNotesOff(channel int16) {
-	m.voiceManager.ApplyToAllVoices(func(voice *Voice) {
-		if voice.Channel == channel && voice.IsActive {
-			if voice.Envelope != nil {
-				voice.Envelope.Release()
-			}
-		}
-	})
+	m.voiceManager.ReleaseNote(-1, channel, -1)
 }
 
 // ProcessAllSoundOff immediately stops all sound on a channel
@@ -214,13 +212,8 @@ func (h *midiEventHandler) HandleNoteOff(e *event.NoteEvent, time uint32) {
 
 func (h *midiEventHandler) HandleNoteChoke(e *event.NoteEvent, time uint32) {
 	// Immediately stop the note
-	voice := h.processor.voiceManager.GetVoiceByNoteID(e.NoteID, e.Channel)
-	if voice != nil {
-		voice.IsActive = false
-		if voice.Envelope != nil {
-			voice.Envelope.Reset()
-		}
-	}
+	vm := h.processor.voiceManager
+	vm.StopVoice(vm.FindVoice(e.NoteID, e.Channel, e.Key))
 }
 
 func (h *midiEventHandler) HandleNoteEnd(e *event.NoteEvent, time uint32) {
@@ -230,7 +223,7 @@ func (h *midiEventHandler) HandleNoteEnd(e *event.NoteEvent, time uint32) {
 
 func (h *midiEventHandler) HandleNoteExpression(e *event.NoteExpressionEvent, time uint32) {
 	// Apply expression to the specific note
-	voice := h.processor.voiceManager.GetVoiceByNoteID(e.NoteID, e.Channel)
+	voice := h.processor.voiceManager.FindVoice(e.NoteID, e.Channel, e.Key)
 	if voice != nil {
 		switch e.ExpressionID {
 		case event.NoteExpressionVolume:
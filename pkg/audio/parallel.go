@@ -0,0 +1,160 @@
+package audio
+
+import (
+	"runtime"
+	"unsafe"
+
+	"github.com/justyntemme/clapgo/pkg/thread"
+)
+
+// DefaultParallelVoiceThreshold is the active voice count below which
+// ParallelVoiceRenderer renders serially
+const DefaultParallelVoiceThreshold = 8
+
+// ParallelVoiceRenderer spreads voice rendering across the host's
+// clap.thread-pool workers. Active voices are split into contiguous
+// partitions, each task mixes its partition into its own partial bus and the
+// partial buses are summed in task order, so the output is identical from run
+// to run for the same voice list.
+//
+// It implements thread.PoolProvider; the plugin's ClapGo_PluginThreadPoolExec
+// export must forward to Exec.
+type ParallelVoiceRenderer struct {
+	voiceManager *VoiceManager
+	pool         *thread.PoolHelper
+	threshold    int
+	maxTasks     int
+
+	// Per-task partial mix and scratch buses, sized at activation
+	taskBuses   [][]float32
+	taskScratch [][]float32
+
+	// Per-block state read by the worker tasks
+	active     []*Voice
+	render     VoiceRenderFunc
+	frameCount uint32
+	numTasks   uint32
+}
+
+// NewParallelVoiceRenderer creates a renderer for the voice manager using the
+// host's thread pool, falling back to thread.FallbackPool when the host has none.
+// maxTasks <= 0 uses runtime.NumCPU().
+func NewParallelVoiceRenderer(voiceManager *VoiceManager, host unsafe.Pointer, maxTasks int) *ParallelVoiceRenderer {
+	if maxTasks <= 0 {
+		maxTasks = runtime.NumCPU()
+	}
+
+	r := &ParallelVoiceRenderer{
+		voiceManager: voiceManager,
+		threshold:    DefaultParallelVoiceThreshold,
+		maxTasks:     maxTasks,
+		taskBuses:    make([][]float32, maxTasks),
+		taskScratch:  make([][]float32, maxTasks),
+		active:       make([]*Voice, 0, voiceManager.maxVoices),
+	}
+	r.pool = thread.NewPoolHelper(host, r)
+	r.SetMaxFrames(DefaultMaxVoiceFrames)
+	return r
+}
+
+// UsesHostPool reports whether the host provides clap.thread-pool
+func (r *ParallelVoiceRenderer) UsesHostPool() bool {
+	return r.pool.HasHostPool()
+}
+
+// Start launches the fallback worker threads when the host has no thread
+// pool. Call it from Activate so the first block does not pay for it.
+func (r *ParallelVoiceRenderer) Start() {
+	r.pool.Start()
+}
+
+// Stop shuts down the fallback worker threads. Call it from Deactivate.
+func (r *ParallelVoiceRenderer) Stop() {
+	r.pool.Stop()
+}
+
+// SetThreshold sets the active voice count below which rendering stays serial
+func (r *ParallelVoiceRenderer) SetThreshold(voices int) {
+	r.threshold = voices
+}
+
+// SetMaxFrames sizes the per-task buses. Call it from Activate.
+func (r *ParallelVoiceRenderer) SetMaxFrames(maxFrames uint32) {
+	for i := range r.taskBuses {
+		if len(r.taskBuses[i]) < int(maxFrames) {
+			r.taskBuses[i] = make([]float32, maxFrames)
+			r.taskScratch[i] = make([]float32, maxFrames)
+		}
+	}
+}
+
+// Render renders all active voices and returns the voice manager's mix bus,
+// valid until the next call. Below the threshold, or without a host pool
+// when Start was not called, it is the same as VoiceManager.RenderVoices.
+// [audio-thread]
+func (r *ParallelVoiceRenderer) Render(frameCount uint32, render VoiceRenderFunc) []float32 {
+	vm := r.voiceManager
+
+	r.active = r.active[:0]
+	for _, voice := range vm.active {
+		if voice.IsActive {
+			r.active = append(r.active, voice)
+		}
+	}
+
+	if len(r.active) < r.threshold || len(r.active) < 2 || int(frameCount) > len(r.taskBuses[0]) || !r.pool.Parallel() {
+		return vm.RenderVoices(frameCount, render)
+	}
+
+	numTasks := r.maxTasks
+	if numTasks > len(r.active) {
+		numTasks = len(r.active)
+	}
+
+	r.render = render
+	r.frameCount = frameCount
+	r.numTasks = uint32(numTasks)
+
+	r.pool.Execute(r.numTasks)
+
+	// Deterministic reduction: always sum partial buses in task order
+	mix := vm.mixBus[:frameCount]
+	copy(mix, r.taskBuses[0][:frameCount])
+	for task := 1; task < numTasks; task++ {
+		partial := r.taskBuses[task][:frameCount]
+		for i, sample := range partial {
+			mix[i] += sample
+		}
+	}
+
+	vm.finishBlock()
+
+	r.render = nil
+	return mix
+}
+
+// Exec renders one partition of the active voices into its task's bus.
+// Called from host worker threads during Render.
+// [audio-thread, worker-thread]
+func (r *ParallelVoiceRenderer) Exec(taskIndex uint32) {
+	if taskIndex >= r.numTasks {
+		return
+	}
+
+	count := uint32(len(r.active))
+	first := taskIndex * count / r.numTasks
+	last := (taskIndex + 1) * count / r.numTasks
+
+	bus := r.taskBuses[taskIndex][:r.frameCount]
+	for i := range bus {
+		bus[i] = 0
+	}
+
+	scratch := r.taskScratch[taskIndex][:r.frameCount]
+	for _, voice := range r.active[first:last] {
+		r.render(voice, scratch)
+		for i, sample := range scratch {
+			bus[i] += sample
+		}
+	}
+}
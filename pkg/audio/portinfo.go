@@ -47,7 +47,15 @@ const (
 	PortFlagIsMain        = 1 << 0
 	PortFlagSupports64Bit = 1 << 1
 	PortFlagPrefers64Bit  = 1 << 2
-	PortFlagRequiresCC    = 1 << 3
+	PortFlagRequiresCC    = 1 << 3 // inputs and outputs share one sample size
+)
+
+// Sample sizes, in bits, as the audio-ports-activation extension reports
+// them. Zero means the host did not say.
+const (
+	SampleSizeUnspecified = 0
+	SampleSize32          = 32
+	SampleSize64          = 64
 )
 
 // Channel masks for surround sound
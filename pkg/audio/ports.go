@@ -11,6 +11,10 @@ type PortProvider interface {
 type StereoPortProvider struct {
 	InputName  string
 	OutputName string
+	
+	// Flags are ORed into every port's flags, e.g. PortFlagSupports64Bit
+	// for a plugin with a double-precision path
+	Flags uint32
 }
 
 // NewStereoPortProvider creates a standard stereo port provider
@@ -39,13 +43,19 @@ func (s *StereoPortProvider) GetAudioPortInfo(index uint32, isInput bool) PortIn
 		name = s.InputName
 	}
 	
-	return CreateStereoPort(0, name, true)
+	port := CreateStereoPort(0, name, true)
+	port.Flags |= s.Flags
+	return port
 }
 
 // MonoPortProvider provides standard mono input/output configuration
 type MonoPortProvider struct {
 	InputName  string
 	OutputName string
+	
+	// Flags are ORed into every port's flags, e.g. PortFlagSupports64Bit
+	// for a plugin with a double-precision path
+	Flags uint32
 }
 
 // NewMonoPortProvider creates a standard mono port provider
@@ -74,7 +84,9 @@ func (m *MonoPortProvider) GetAudioPortInfo(index uint32, isInput bool) PortInfo
 		name = m.InputName
 	}
 	
-	return CreateMonoPort(0, name, true)
+	port := CreateMonoPort(0, name, true)
+	port.Flags |= m.Flags
+	return port
 }
 
 // MultiPortProvider allows custom port configurations
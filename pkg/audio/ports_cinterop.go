@@ -67,13 +67,19 @@ func UnregisterPortsProvider(plugin unsafe.Pointer) {
 func PortInfoToC(portInfo PortInfo, cInfo unsafe.Pointer) {
 	info := (*C.clap_audio_port_info_t)(cInfo)
 	
+	// Both strings are copied or only compared, so they can go right away
+	name := C.CString(portInfo.Name)
+	defer C.free(unsafe.Pointer(name))
+	portType := C.CString(portInfo.PortType)
+	defer C.free(unsafe.Pointer(portType))
+	
 	C.populate_audio_port_info(
 		info,
 		C.uint32_t(portInfo.ID),
-		C.CString(portInfo.Name),
+		name,
 		C.uint32_t(portInfo.ChannelCount),
 		C.uint32_t(portInfo.Flags),
-		C.CString(portInfo.PortType),
+		portType,
 		C.uint32_t(portInfo.InPlacePair),
 	)
 }
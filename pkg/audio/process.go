@@ -22,23 +22,52 @@ func ApplyGainToChannel(out, in []float32, gain float32) {
 		if len(in) < minLen {
 			minLen = len(in)
 		}
-		for i := 0; i < minLen; i++ {
-			out[i] = in[i] * gain
-		}
+		scaleChannel(out[:minLen], in[:minLen], gain)
 		// Zero remaining samples if out is longer
 		for i := minLen; i < len(out); i++ {
 			out[i] = 0
 		}
 	} else {
 		// Optimized path for matching sizes
-		for i := range out {
-			out[i] = in[i] * gain
-		}
+		scaleChannel(out, in, gain)
+	}
+}
+
+// ProcessWithGainRamp is ProcessWithGain with a per-sample gain, such as a
+// parameter smoother's ramp
+func ProcessWithGainRamp(out, in [][]float32, ramp []float32) {
+	numChannels := len(out)
+	if numChannels > len(in) {
+		numChannels = len(in)
+	}
+	
+	for ch := 0; ch < numChannels; ch++ {
+		ApplyGainRampToChannel(out[ch], in[ch], ramp)
+	}
+}
+
+// ApplyGainRampToChannel multiplies each input sample by the matching ramp
+// value. Samples of out beyond the input or the ramp are zeroed.
+func ApplyGainRampToChannel(out, in, ramp []float32) {
+	n := len(out)
+	if len(in) < n {
+		n = len(in)
+	}
+	if len(ramp) < n {
+		n = len(ramp)
+	}
+	
+	dst, src, gain := out[:n], in[:n], ramp[:n]
+	for i := range dst {
+		dst[i] = src[i] * gain[i]
+	}
+	for i := n; i < len(out); i++ {
+		out[i] = 0
 	}
 }
 
 // CopyAudio copies audio from input to output buffers
-func CopyAudio(out, in [][]float32) {
+func CopyAudio[T Sample](out, in [][]T) {
 	numChannels := len(out)
 	if numChannels > len(in) {
 		numChannels = len(in)
@@ -50,11 +79,9 @@ func CopyAudio(out, in [][]float32) {
 }
 
 // ClearAudio zeroes out audio buffers
-func ClearAudio(buffers [][]float32) {
+func ClearAudio[T Sample](buffers [][]T) {
 	for ch := range buffers {
-		for i := range buffers[ch] {
-			buffers[ch][i] = 0
-		}
+		clear(buffers[ch])
 	}
 }
 
@@ -77,22 +104,18 @@ func MixChannel(out, in []float32, gain float32) {
 		minLen = len(in)
 	}
 	
-	for i := 0; i < minLen; i++ {
-		out[i] += in[i] * gain
-	}
+	mixChannel(out[:minLen], in[:minLen], gain)
 }
 
 // ProcessInPlace applies gain to buffers in place
 func ProcessInPlace(buffers [][]float32, gain float32) {
 	for ch := range buffers {
-		for i := range buffers[ch] {
-			buffers[ch][i] *= gain
-		}
+		scaleChannel(buffers[ch], buffers[ch], gain)
 	}
 }
 
 // ValidateBuffers checks if audio buffers are valid for processing
-func ValidateBuffers(out, in [][]float32) bool {
+func ValidateBuffers[T Sample](out, in [][]T) bool {
 	if len(out) == 0 || len(in) == 0 {
 		return false
 	}
@@ -0,0 +1,101 @@
+package audio
+
+// Sample is a single audio sample at either precision the host may hand a
+// port. Helpers that do the same work at both precisions take it as a type
+// parameter; the arithmetic kernels below have explicit float64 versions so
+// the float32 ones keep their SIMD paths.
+type Sample interface {
+	~float32 | ~float64
+}
+
+// ProcessWithGain64 is ProcessWithGain for double-precision buffers
+func ProcessWithGain64(out, in [][]float64, gain float64) {
+	numChannels := min(len(out), len(in))
+	for ch := 0; ch < numChannels; ch++ {
+		ApplyGainToChannel64(out[ch], in[ch], gain)
+	}
+}
+
+// ApplyGainToChannel64 writes in*gain to out. Samples of out beyond the
+// input are zeroed.
+func ApplyGainToChannel64(out, in []float64, gain float64) {
+	n := min(len(out), len(in))
+	scale64(out[:n], in[:n], gain)
+	clear(out[n:])
+}
+
+// ProcessWithGainRamp64 is ProcessWithGainRamp for double-precision
+// buffers. The ramp stays single precision, as parameter smoothers
+// produce it; only the signal path needs the extra bits.
+func ProcessWithGainRamp64(out, in [][]float64, ramp []float32) {
+	numChannels := min(len(out), len(in))
+	for ch := 0; ch < numChannels; ch++ {
+		ApplyGainRampToChannel64(out[ch], in[ch], ramp)
+	}
+}
+
+// ApplyGainRampToChannel64 multiplies each input sample by the matching
+// ramp value. Samples of out beyond the input or the ramp are zeroed.
+func ApplyGainRampToChannel64(out, in []float64, ramp []float32) {
+	n := min(len(out), len(in), len(ramp))
+	dst, src, gain := out[:n], in[:n], ramp[:n]
+	for i := range dst {
+		dst[i] = src[i] * float64(gain[i])
+	}
+	clear(out[n:])
+}
+
+// MixAudio64 is MixAudio for double-precision buffers
+func MixAudio64(out, in [][]float64, gain float64) {
+	numChannels := min(len(out), len(in))
+	for ch := 0; ch < numChannels; ch++ {
+		MixChannel64(out[ch], in[ch], gain)
+	}
+}
+
+// MixChannel64 adds in*gain to out for a single channel
+func MixChannel64(out, in []float64, gain float64) {
+	n := min(len(out), len(in))
+	mix64(out[:n], in[:n], gain)
+}
+
+// ProcessInPlace64 applies gain to double-precision buffers in place
+func ProcessInPlace64(buffers [][]float64, gain float64) {
+	for ch := range buffers {
+		scale64(buffers[ch], buffers[ch], gain)
+	}
+}
+
+// scale64 writes src*gain to dst; both must have the same length
+func scale64(dst, src []float64, gain float64) {
+	src = src[:len(dst)]
+	i := 0
+	for ; i+4 <= len(dst); i += 4 {
+		d := dst[i : i+4 : i+4]
+		s := src[i : i+4 : i+4]
+		d[0] = s[0] * gain
+		d[1] = s[1] * gain
+		d[2] = s[2] * gain
+		d[3] = s[3] * gain
+	}
+	for ; i < len(dst); i++ {
+		dst[i] = src[i] * gain
+	}
+}
+
+// mix64 adds src*gain to dst; both must have the same length
+func mix64(dst, src []float64, gain float64) {
+	src = src[:len(dst)]
+	i := 0
+	for ; i+4 <= len(dst); i += 4 {
+		d := dst[i : i+4 : i+4]
+		s := src[i : i+4 : i+4]
+		d[0] += s[0] * gain
+		d[1] += s[1] * gain
+		d[2] += s[2] * gain
+		d[3] += s[3] * gain
+	}
+	for ; i < len(dst); i++ {
+		dst[i] += src[i] * gain
+	}
+}
@@ -41,6 +41,9 @@ type SelectableFilter struct {
 	safeMode   bool
 	sampleRate float64
 	
+	// Coefficients carried between ProcessBuffer blocks
+	ramp svfRamp
+	
 	// Statistics for debugging
 	nanCount   uint64
 	infCount   uint64
@@ -119,23 +122,74 @@ func (f *SelectableFilter) Process(input float64) float64 {
 	return output
 }
 
-// ProcessBuffer processes a buffer of samples in place
+// ProcessBuffer processes a buffer of samples in place. The whole buffer is
+// one block: the type is resolved once, coefficient changes since the last
+// call glide across it, and safe mode checks the filter state once at the
+// end, resetting the filter and silencing the block if it blew up.
+// [audio-thread]
 func (f *SelectableFilter) ProcessBuffer(buffer []float32) {
-	for i := range buffer {
-		buffer[i] = float32(f.Process(float64(buffer[i])))
+	mix, ok := svfMixFor(f.filterType)
+	if !ok {
+		if f.safeMode {
+			f.sanitizeBypass(buffer)
+		}
+		return
+	}
+	
+	svf := f.filter
+	tuning, damping, tuningStep, dampingStep := f.ramp.next(svf.frequency, svf.resonance, svf.sampleRate, len(buffer))
+	state := svfLane{lowpass: svf.prevLowpass, bandpass: svf.prevBandpass}
+	svfBlock(&state, buffer, mix, tuning, damping, tuningStep, dampingStep)
+	
+	nan, inf := state.settle()
+	if (nan || inf) && f.safeMode {
+		if nan {
+			f.nanCount++
+		} else {
+			f.infCount++
+		}
+		f.resetCount++
+		svf.Reset()
+		clear(buffer)
+		return
+	}
+	svf.prevLowpass, svf.prevBandpass = state.lowpass, state.bandpass
+	svf.lowpass, svf.bandpass = state.lowpass, state.bandpass
+}
+
+// sanitizeBypass zeroes NaN and Inf samples passing through a bypassed
+// filter, as Process does; the sum finds a clean block without branching
+// per sample
+func (f *SelectableFilter) sanitizeBypass(buffer []float32) {
+	var sum float64
+	for _, sample := range buffer {
+		sum += float64(sample)
+	}
+	if !math.IsNaN(sum) && !math.IsInf(sum, 0) {
+		return
+	}
+	for i, sample := range buffer {
+		x := float64(sample)
+		if math.IsNaN(x) {
+			f.nanCount++
+			buffer[i] = 0
+		} else if math.IsInf(x, 0) {
+			f.infCount++
+			buffer[i] = 0
+		}
 	}
 }
 
 // ProcessBufferSeparate processes input buffer to output buffer
+// [audio-thread]
 func (f *SelectableFilter) ProcessBufferSeparate(input, output []float32) {
 	minLen := len(input)
 	if len(output) < minLen {
 		minLen = len(output)
 	}
 	
-	for i := 0; i < minLen; i++ {
-		output[i] = float32(f.Process(float64(input[i])))
-	}
+	copy(output[:minLen], input[:minLen])
+	f.ProcessBuffer(output[:minLen])
 }
 
 // Reset resets the filter state
@@ -152,6 +206,7 @@ func (f *SelectableFilter) SetSampleRate(sampleRate float64) {
 	f.filter = NewStateVariableFilter(sampleRate)
 	f.filter.SetFrequency(oldFreq)
 	f.filter.SetResonance(oldResonance)
+	f.ramp = svfRamp{}
 }
 
 // GetStatistics returns debugging statistics about the filter
@@ -0,0 +1,129 @@
+package audio
+
+import (
+	"github.com/justyntemme/clapgo/pkg/event"
+)
+
+// DefaultMinSegment is the smallest sub-block the scheduler renders by default
+const DefaultMinSegment = 16
+
+// SegmentFunc renders frames [start, end) of the current block
+type SegmentFunc func(start, end uint32)
+
+// SubBlockScheduler splits a process block at event times so that events
+// take effect on the sample they were scheduled for. It applies every event
+// at a segment boundary, then renders the segment up to the next event.
+//
+// Events closer than the minimum segment size to the previous boundary are
+// folded into it, and a split that would leave a shorter tail is moved back,
+// though never closer than the minimum to the previous boundary. Events are
+// therefore applied at most minSegment-1 samples early, trading timing
+// accuracy for fewer, longer render calls; only the tail may come out short.
+// A minimum of 1 gives full sample accuracy.
+type SubBlockScheduler struct {
+	minSegment uint32
+}
+
+// NewSubBlockScheduler creates a scheduler with the given minimum segment size
+func NewSubBlockScheduler(minSegment uint32) *SubBlockScheduler {
+	s := &SubBlockScheduler{}
+	s.SetMinSegment(minSegment)
+	return s
+}
+
+// SetMinSegment sets the minimum number of frames between two split points
+func (s *SubBlockScheduler) SetMinSegment(minSegment uint32) {
+	if minSegment == 0 {
+		minSegment = 1
+	}
+	s.minSegment = minSegment
+}
+
+// MinSegment returns the minimum number of frames between two split points
+func (s *SubBlockScheduler) MinSegment() uint32 {
+	return s.minSegment
+}
+
+// Run dispatches the batch's events to handler and calls render for each
+// segment between event times. With no events, render is called once for
+// the whole block.
+// [audio-thread]
+func (s *SubBlockScheduler) Run(batch *event.Batch, handler event.Handler, frameCount uint32, render SegmentFunc) {
+	s.RunPaged(nil, batch, handler, frameCount, render)
+}
+
+// RunPaged is Run for a batch returned by events.Gather. When the batch is
+// truncated, the following windows are decoded with GatherNext as the
+// scheduler reaches them, so dense blocks keep every event on time.
+// [audio-thread]
+func (s *SubBlockScheduler) RunPaged(events *event.Processor, batch *event.Batch, handler event.Handler, frameCount uint32, render SegmentFunc) {
+	if batch == nil {
+		if frameCount > 0 {
+			render(0, frameCount)
+		}
+		return
+	}
+	count := batch.Len()
+
+	start := uint32(0)
+	next := 0
+
+	for start < frameCount {
+		// Collect every event due at this boundary; the first event at least
+		// minSegment away opens the next one
+		first := next
+		end := frameCount
+		for {
+			split := false
+			for next < count {
+				t := batch.Order[next].Time
+				if t > frameCount {
+					t = frameCount
+				}
+				if t >= start+s.minSegment {
+					// Pull a split near the end back so the tail keeps the
+					// minimum size, but not so far that the event would fold
+					// into this boundary and move by up to twice the minimum
+					if frameCount-t < s.minSegment {
+						t = max(frameCount-s.minSegment, start+s.minSegment)
+					}
+					if t < frameCount {
+						end = t
+						split = true
+						break
+					}
+				}
+				next++
+			}
+			if split || events == nil || !batch.Truncated {
+				break
+			}
+
+			// The window ran out before the next split: deliver what it
+			// holds and carry on with the following one
+			batch.DispatchRange(handler, first, next)
+			if batch = events.GatherNext(); batch == nil {
+				// Nothing more could be decoded; render the rest as is
+				render(start, end)
+				return
+			}
+			first, next, count = 0, 0, batch.Len()
+		}
+
+		batch.DispatchRange(handler, first, next)
+		render(start, end)
+		start = end
+	}
+
+	// Zero-length blocks still deliver their events
+	for batch != nil {
+		batch.DispatchRange(handler, next, count)
+		if events == nil || !batch.Truncated {
+			return
+		}
+		batch, next = events.GatherNext(), 0
+		if batch != nil {
+			count = batch.Len()
+		}
+	}
+}
@@ -0,0 +1,70 @@
+package audio
+
+import (
+	"testing"
+
+	"github.com/justyntemme/clapgo/pkg/event"
+)
+
+// boundaryRecorder notes the segment boundary each event is applied at
+type boundaryRecorder struct {
+	event.NoOpHandler
+	pending []uint32 // times of events dispatched since the last render
+	applied map[uint32]uint32
+}
+
+func (r *boundaryRecorder) HandleParamValue(e *event.ParamValueEvent, time uint32) {
+	r.pending = append(r.pending, time)
+}
+
+func (r *boundaryRecorder) render(start, end uint32) {
+	for _, time := range r.pending {
+		r.applied[time] = start
+	}
+	r.pending = r.pending[:0]
+}
+
+func paramBatch(times ...uint32) *event.Batch {
+	batch := &event.Batch{}
+	for i, time := range times {
+		batch.Order = append(batch.Order, event.Ref{Time: time, Type: event.TypeParamValue, Index: uint32(i)})
+		batch.ParamValues = append(batch.ParamValues, event.ParamValueEvent{})
+	}
+	return batch
+}
+
+// TestSubBlockTiming checks that every event is applied no later than its
+// time and at most minSegment-1 samples early, including events close to
+// the end of blocks shorter than twice the minimum, and that only the last
+// segment may be shorter than the minimum
+func TestSubBlockTiming(t *testing.T) {
+	const minSegment = 16
+	s := NewSubBlockScheduler(minSegment)
+
+	for frameCount := uint32(1); frameCount <= 5*minSegment; frameCount++ {
+		for at := uint32(0); at < frameCount; at++ {
+			for _, times := range [][]uint32{{at}, {0, at}, {at / 2, at}} {
+				r := &boundaryRecorder{applied: make(map[uint32]uint32)}
+				next := uint32(0)
+				s.Run(paramBatch(times...), r, frameCount, func(start, end uint32) {
+					if start != next {
+						t.Fatalf("frames %d, events %v: segment starts at %d, want %d", frameCount, times, start, next)
+					}
+					if next = end; end < frameCount && end-start < minSegment {
+						t.Errorf("frames %d, events %v: segment [%d, %d) shorter than %d", frameCount, times, start, end, minSegment)
+					}
+					r.render(start, end)
+				})
+				if next != frameCount {
+					t.Fatalf("frames %d, events %v: rendered up to %d", frameCount, times, next)
+				}
+				for _, time := range times {
+					applied, ok := r.applied[time]
+					if !ok || applied > time || time-applied >= minSegment {
+						t.Errorf("frames %d, events %v: event at %d applied at %d", frameCount, times, time, applied)
+					}
+				}
+			}
+		}
+	}
+}
@@ -9,79 +9,137 @@ type PolyphonicOscillator struct {
 	voiceManager *VoiceManager
 	waveformType WaveformType
 	antiAlias    bool
+	
+	// Band-limited tables for the waveform; nil for noise
+	wavetable *Wavetable
+	
+	// Bound once so rendering does not create a closure per block
+	renderFunc VoiceRenderFunc
+	
+	// Optional multi-threaded rendering, see SetParallelRenderer
+	parallel *ParallelVoiceRenderer
 }
 
 // NewPolyphonicOscillator creates a new polyphonic oscillator
 func NewPolyphonicOscillator(voiceManager *VoiceManager) *PolyphonicOscillator {
-	return &PolyphonicOscillator{
+	po := &PolyphonicOscillator{
 		voiceManager: voiceManager,
 		waveformType: WaveformSine,
 		antiAlias:    true,
+		// Builds the shared tables here rather than on the audio thread
+		wavetable: GetWavetable(WaveformSine),
 	}
+	po.renderFunc = po.renderVoice
+	return po
 }
 
 // SetWaveform sets the waveform type for all voices
 func (po *PolyphonicOscillator) SetWaveform(waveform WaveformType) {
 	po.waveformType = waveform
+	po.wavetable = GetWavetable(waveform)
 }
 
-// SetAntiAliasing enables or disables anti-aliasing
+// SetAntiAliasing enables or disables anti-aliasing. With it disabled every
+// waveform is computed naively per sample instead of from the band-limited
+// wavetables.
 func (po *PolyphonicOscillator) SetAntiAliasing(enabled bool) {
 	po.antiAlias = enabled
 }
 
-// Process generates audio for all active voices
+// Process generates audio for all active voices. The returned buffer is the
+// voice manager's mix bus and is only valid until the next call.
 func (po *PolyphonicOscillator) Process(frameCount uint32) []float32 {
-	return po.voiceManager.ProcessVoices(frameCount, func(voice *Voice, frames uint32) []float32 {
-		output := make([]float32, frames)
+	if po.parallel != nil {
+		return po.parallel.Render(frameCount, po.renderFunc)
+	}
+	return po.voiceManager.RenderVoices(frameCount, po.renderFunc)
+}
+
+// SetParallelRenderer opts in to rendering voices across the host thread
+// pool. Pass nil to go back to serial rendering. Call it outside the audio thread.
+func (po *PolyphonicOscillator) SetParallelRenderer(renderer *ParallelVoiceRenderer) {
+	po.parallel = renderer
+}
+
+// renderVoice renders one voice into dst
+func (po *PolyphonicOscillator) renderVoice(voice *Voice, dst []float32) {
+	sampleRate := po.voiceManager.sampleRate
+	
+	// Pitch bend only changes at event boundaries, so the frequency is per call
+	freq := voice.Frequency
+	if voice.PitchBend != 0 {
+		freq *= math.Exp2(voice.PitchBend / 12.0)
+	}
+	
+	// Velocity, volume, brightness and pressure are constant over the block
+	gain := voice.Velocity * voice.Volume
+	
+	// Apply brightness as simple lowpass (this is a placeholder)
+	// In a real implementation, you'd use a proper filter
+	if voice.Brightness < 1.0 {
+		gain *= voice.Brightness*0.7 + 0.3
+	}
+	
+	// Apply pressure (aftertouch) as additional volume
+	if voice.Pressure > 0.0 {
+		gain *= 1.0 + voice.Pressure*0.3
+	}
+	
+	if po.wavetable != nil && po.antiAlias {
+		po.renderWavetableVoice(voice, dst, freq, gain)
+		return
+	}
+	
+	phaseInc := freq / sampleRate
+	useBLEP := po.antiAlias && (po.waveformType == WaveformSaw || po.waveformType == WaveformSquare)
+	
+	for i := range dst {
+		// Get envelope value
+		envValue := 1.0
+		if voice.Envelope != nil {
+			envValue = voice.Envelope.Process()
+		}
 		
-		for i := uint32(0); i < frames; i++ {
-			// Get envelope value
-			envValue := 1.0
-			if voice.Envelope != nil {
-				envValue = voice.Envelope.Process()
-			}
-			
-			// Calculate frequency with pitch bend
-			freq := voice.Frequency * math.Pow(2.0, voice.PitchBend/12.0)
-			
-			// Generate oscillator sample
-			var sample float64
-			if po.antiAlias && (po.waveformType == WaveformSaw || po.waveformType == WaveformSquare) {
-				// Use anti-aliased versions for saw and square
-				phaseInc := freq / po.voiceManager.sampleRate
-				if po.waveformType == WaveformSaw {
-					sample = GeneratePolyBLEPSaw(voice.Phase, phaseInc)
-				} else {
-					sample = GeneratePolyBLEPSquare(voice.Phase, phaseInc)
-				}
+		// Generate oscillator sample
+		var sample float64
+		if useBLEP {
+			// Use anti-aliased versions for saw and square
+			if po.waveformType == WaveformSaw {
+				sample = GeneratePolyBLEPSaw(voice.Phase, phaseInc)
 			} else {
-				// Use standard waveform generation
-				sample = GenerateWaveformSample(voice.Phase, po.waveformType)
-			}
-			
-			// Apply envelope, velocity, and volume
-			sample *= envValue * voice.Velocity * voice.Volume
-			
-			// Apply brightness as simple lowpass (this is a placeholder)
-			// In a real implementation, you'd use a proper filter
-			if voice.Brightness < 1.0 {
-				sample *= (voice.Brightness * 0.7 + 0.3)
-			}
-			
-			// Apply pressure (aftertouch) as additional volume
-			if voice.Pressure > 0.0 {
-				sample *= (1.0 + voice.Pressure * 0.3)
+				sample = GeneratePolyBLEPSquare(voice.Phase, phaseInc)
 			}
-			
-			output[i] = float32(sample)
-			
-			// Advance phase
-			voice.Phase = AdvancePhase(voice.Phase, freq, po.voiceManager.sampleRate)
+		} else {
+			// Use standard waveform generation
+			sample = GenerateWaveformSample(voice.Phase, po.waveformType)
 		}
 		
-		return output
-	})
+		dst[i] = float32(sample * envValue * gain)
+		
+		// Advance phase
+		voice.Phase = AdvancePhase(voice.Phase, freq, sampleRate)
+	}
+}
+
+// renderWavetableVoice plays the voice from the band-limited tables. The
+// increment is fixed for the block unless pitch moved since the last one,
+// in which case it ramps from the old increment to the new.
+func (po *PolyphonicOscillator) renderWavetableVoice(voice *Voice, dst []float32, freq, gain float64) {
+	inc := PhaseIncrement(freq, po.voiceManager.sampleRate)
+	phase := PhaseToFixed(voice.Phase)
+	if voice.phaseInc != 0 && voice.phaseInc != inc {
+		phase = po.wavetable.RenderRamp(dst, phase, voice.phaseInc, inc)
+	} else {
+		phase = po.wavetable.Render(dst, phase, inc)
+	}
+	voice.phaseInc = inc
+	voice.Phase = PhaseFromFixed(phase)
+	
+	if voice.Envelope == nil {
+		ApplyGainToChannel(dst, dst, float32(gain))
+		return
+	}
+	voice.Envelope.ApplyBlock(dst, float32(gain))
 }
 
 // SimpleLowPassFilter implements a basic one-pole lowpass filter
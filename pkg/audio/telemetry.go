@@ -0,0 +1,263 @@
+package audio
+
+// #include <stdlib.h>
+// #include "../../src/c/telemetry.h"
+import "C"
+import (
+	"math"
+	"sync/atomic"
+	"unsafe"
+)
+
+// Telemetry geometry, fixed by src/c/telemetry.h
+const (
+	TelemetryChannels  = C.CLAPGO_TELEMETRY_CHANNELS
+	TelemetryScopeSize = C.CLAPGO_TELEMETRY_SCOPE_SIZE
+	TelemetryKeys      = C.CLAPGO_TELEMETRY_KEYS
+)
+
+const (
+	// DefaultTelemetryRate is how many frames per second Telemetry
+	// publishes, about twice a GUI's refresh rate
+	DefaultTelemetryRate = 120
+
+	// DefaultScopeDecimation is the audio frames per scope point, so the
+	// scope window shows about 40 ms at 48 kHz
+	DefaultScopeDecimation = 4
+
+	telemetryIndexMask = C.CLAPGO_TELEMETRY_INDEX_MASK
+	telemetryFresh     = C.CLAPGO_TELEMETRY_FRESH
+)
+
+// Telemetry publishes peak and RMS levels, a decimated scope and voice
+// activity from the audio thread to a GUI. Frames go into the triple buffer
+// described in src/c/telemetry.h, which the GUI reads in place; the audio
+// thread never waits on it, calls the host or allocates.
+//
+// Levels are measured every block and published DefaultTelemetryRate times
+// a second. A frame covers every block since the last frame the reader
+// took, even when it skipped some, so meters never miss a peak.
+type Telemetry struct {
+	c        *C.clapgo_telemetry_t
+	back     uint32 // index of the frame being written
+	channels int
+
+	interval uint32 // frames between publishes
+	elapsed  uint32
+	sequence uint64
+	steady   int64
+
+	// Levels since the last publish
+	peak       [TelemetryChannels]float32
+	sumSquares [TelemetryChannels]float64
+	frames     uint64
+
+	// Levels of published frames the reader has not taken, carried into
+	// the next one
+	carryPeak       [TelemetryChannels]float32
+	carrySumSquares [TelemetryChannels]float64
+	carryFrames     uint64
+
+	// Scope ring, one point every decimation frames
+	decimation uint32
+	pending    uint32 // frames of the group in progress
+	scope      [TelemetryChannels][TelemetryScopeSize]float32
+	scopePos   int // next point written
+	scopeCount int
+
+	voices uint32
+	keys   [TelemetryKeys / 32]uint32
+}
+
+// NewTelemetry allocates the shared block for up to TelemetryChannels
+// channels. The sample rate is not known before activation, so call
+// SetSampleRate from Activate. Free it when the plugin is destroyed.
+// [main-thread]
+func NewTelemetry(channels int) *Telemetry {
+	t := &Telemetry{
+		c:          (*C.clapgo_telemetry_t)(C.calloc(1, C.sizeof_clapgo_telemetry_t)),
+		channels:   min(channels, TelemetryChannels),
+		steady:     -1,
+		decimation: DefaultScopeDecimation,
+	}
+	t.c.version = C.CLAPGO_TELEMETRY_VERSION
+	t.c.state = 1
+	for i := range t.c.frames {
+		t.c.frames[i].steady_time = -1
+	}
+	t.SetSampleRate(0)
+	return t
+}
+
+// Free releases the shared block. The GUI must have stopped reading it.
+// [main-thread]
+func (t *Telemetry) Free() {
+	if t.c != nil {
+		C.free(unsafe.Pointer(t.c))
+		t.c = nil
+	}
+}
+
+// Pointer returns the clapgo_telemetry_t for the plugin's
+// ClapGo_PluginTelemetry export
+func (t *Telemetry) Pointer() unsafe.Pointer {
+	return unsafe.Pointer(t.c)
+}
+
+// SetSampleRate sets the publish interval for DefaultTelemetryRate. Call it
+// from Activate; until then every block is published.
+func (t *Telemetry) SetSampleRate(sampleRate float64) {
+	t.interval = uint32(max(sampleRate/DefaultTelemetryRate, 1))
+}
+
+// SetScopeDecimation sets the audio frames per scope point, at least 1
+func (t *Telemetry) SetScopeDecimation(frames uint32) {
+	t.decimation = max(frames, 1)
+	t.pending = 0
+}
+
+// CaptureVoices records the number of sounding voices and their keys for
+// the next frame
+// [audio-thread]
+func (t *Telemetry) CaptureVoices(vm *VoiceManager) {
+	t.keys = [TelemetryKeys / 32]uint32{}
+	for _, voice := range vm.active {
+		if uint16(voice.Key) < TelemetryKeys {
+			t.keys[voice.Key/32] |= 1 << (voice.Key % 32)
+		}
+	}
+	t.voices = uint32(len(vm.active))
+}
+
+// Measure folds a block of output into the levels and scope, and publishes
+// a frame when one is due
+// [audio-thread]
+func (t *Telemetry) Measure(steadyTime int64, channels [][]float32) {
+	channels = channels[:min(len(channels), t.channels)]
+	for ch, samples := range channels {
+		t.peak[ch] = max(t.peak[ch], peakChannel(samples))
+		t.sumSquares[ch] += sumSquaresChannel(samples)
+	}
+	t.finishBlock(steadyTime, decimate(t, channels))
+}
+
+// Measure64 is Measure for a 64-bit block
+// [audio-thread]
+func (t *Telemetry) Measure64(steadyTime int64, channels [][]float64) {
+	channels = channels[:min(len(channels), t.channels)]
+	for ch, samples := range channels {
+		peak, sum := t.peak[ch], 0.0
+		for _, sample := range samples {
+			peak = max(peak, float32(math.Abs(sample)))
+			sum += sample * sample
+		}
+		t.peak[ch] = peak
+		t.sumSquares[ch] += sum
+	}
+	t.finishBlock(steadyTime, decimate(t, channels))
+}
+
+func (t *Telemetry) finishBlock(steadyTime int64, frames int) {
+	t.frames += uint64(frames)
+	t.steady = steadyTime
+	t.elapsed += uint32(frames)
+	if t.elapsed >= t.interval {
+		t.publish(true)
+		t.elapsed = 0
+	}
+}
+
+// Flush publishes what was measured since the last frame without waiting
+// for the interval. Call it after Measure when process returns sleep: the
+// host may stop calling process, and the GUI would otherwise keep showing
+// the last frame published while audio was still sounding. Levels of frames
+// the reader skipped are not carried into this one, so the meters settle
+// on the final block.
+// [audio-thread]
+func (t *Telemetry) Flush() {
+	if t.elapsed > 0 {
+		t.publish(false)
+		t.elapsed = 0
+	}
+}
+
+// decimate appends a block to the scope ring and returns its length. A
+// point is the last sample of each group of decimation frames, which costs
+// a fraction of measuring the levels; every channel advances by the same
+// number of points.
+func decimate[T Sample](t *Telemetry, channels [][]T) int {
+	if len(channels) == 0 {
+		return 0
+	}
+	frames := len(channels[0])
+	step := int(t.decimation)
+	first := step - int(t.pending) - 1
+
+	pos, count := t.scopePos, t.scopeCount
+	for ch, samples := range channels {
+		row := &t.scope[ch]
+		pos, count = t.scopePos, t.scopeCount
+		for i := first; i < frames; i += step {
+			row[pos] = float32(samples[i])
+			pos = (pos + 1) % TelemetryScopeSize
+			count = min(count+1, TelemetryScopeSize)
+		}
+	}
+	t.pending = uint32((int(t.pending) + frames) % step)
+	t.scopePos, t.scopeCount = pos, count
+	return frames
+}
+
+// publish writes the back frame and swaps it for the middle one. With carry
+// unset the frame holds only what was measured since the last publish, even
+// when the reader skipped frames.
+func (t *Telemetry) publish(carry bool) {
+	// The reader still holding the last frame published means it missed
+	// nothing; otherwise what it skipped is folded into this frame
+	if !carry || atomic.LoadUint64((*uint64)(unsafe.Pointer(&t.c.consumed))) == t.sequence {
+		t.carryPeak = [TelemetryChannels]float32{}
+		t.carrySumSquares = [TelemetryChannels]float64{}
+		t.carryFrames = 0
+	}
+	t.carryFrames += t.frames
+	for ch := 0; ch < t.channels; ch++ {
+		t.carryPeak[ch] = max(t.carryPeak[ch], t.peak[ch])
+		t.carrySumSquares[ch] += t.sumSquares[ch]
+	}
+	t.peak = [TelemetryChannels]float32{}
+	t.sumSquares = [TelemetryChannels]float64{}
+	t.frames = 0
+
+	t.sequence++
+	frame := &t.c.frames[t.back]
+	frame.sequence = C.uint64_t(t.sequence)
+	frame.steady_time = C.int64_t(t.steady)
+	frame.frame_count = C.uint32_t(t.carryFrames)
+	frame.channel_count = C.uint32_t(t.channels)
+	for ch := 0; ch < t.channels; ch++ {
+		frame.peak[ch] = C.float(t.carryPeak[ch])
+		rms := 0.0
+		if t.carryFrames > 0 {
+			rms = math.Sqrt(t.carrySumSquares[ch] / float64(t.carryFrames))
+		}
+		frame.rms[ch] = C.float(rms)
+
+		// Oldest point first
+		row := (*[TelemetryScopeSize]float32)(unsafe.Pointer(&frame.scope[ch]))
+		if t.scopeCount < TelemetryScopeSize {
+			copy(row[:], t.scope[ch][:t.scopeCount])
+		} else {
+			n := copy(row[:], t.scope[ch][t.scopePos:])
+			copy(row[n:], t.scope[ch][:t.scopePos])
+		}
+	}
+	frame.scope_count = C.uint32_t(t.scopeCount)
+	frame.scope_decimation = C.uint32_t(t.decimation)
+	frame.active_voices = C.uint32_t(t.voices)
+	for i, word := range t.keys {
+		frame.keys[i] = C.uint32_t(word)
+	}
+
+	previous := atomic.SwapUint32((*uint32)(unsafe.Pointer(&t.c.state)), t.back|telemetryFresh)
+	t.back = previous & telemetryIndexMask
+}
@@ -0,0 +1,26 @@
+package audio
+
+import "testing"
+
+// TestTelemetryFlush checks that a block shorter than the publish interval
+// reaches the GUI once Flush is called, as it is when process sleeps
+func TestTelemetryFlush(t *testing.T) {
+	tm := NewTelemetry(2)
+	tm.SetSampleRate(48000)
+	defer tm.Free()
+
+	block := [][]float32{make([]float32, 32), make([]float32, 32)}
+	block[0][0] = 0.5
+	tm.Measure(0, block)
+	if tm.sequence != 0 {
+		t.Fatalf("published %d frames before the interval, want 0", tm.sequence)
+	}
+	tm.Flush()
+	if tm.sequence != 1 {
+		t.Fatalf("Flush published %d frames, want 1", tm.sequence)
+	}
+	tm.Flush()
+	if tm.sequence != 1 {
+		t.Errorf("Flush with nothing measured published a frame")
+	}
+}
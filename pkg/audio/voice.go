@@ -1,7 +1,7 @@
 package audio
 
 import (
-	"sync"
+	"sync/atomic"
 )
 
 // Voice represents a single synthesizer voice that can play a note
@@ -16,6 +16,10 @@ type Voice struct {
 	Phase     float64
 	Frequency float64
 	
+	// Wavetable increment of the last block, 0 at note start; a change
+	// means pitch is moving and the next block ramps to the new one
+	phaseInc uint32
+	
 	// Envelope
 	Envelope *ADSREnvelope
 	
@@ -31,43 +35,103 @@ type Voice struct {
 	
 	// Custom data for plugin-specific use
 	UserData interface{}
+	
+	// Allocator bookkeeping, owned by the VoiceManager
+	noteKey  uint64  // identity in the note index
+	indexed  bool    // whether the note index points at this voice
+	released bool    // note off seen; the envelope is in its tail
+	age      uint64  // allocation order, larger is newer
+	loudness float32 // output level at the end of the last block
+	heapPos  int     // position in the steal heap, -1 when free
 }
 
-// VoiceManager manages polyphonic voice allocation and processing
+// DefaultMaxVoiceFrames is the block size voice buses are sized for until
+// SetMaxFrames is called at activation
+const DefaultMaxVoiceFrames = 1024
+
+// VoiceRenderFunc renders one voice into dst, overwriting its contents.
+// len(dst) is the number of frames to render.
+type VoiceRenderFunc func(voice *Voice, dst []float32)
+
+// VoiceManager manages polyphonic voice allocation and processing.
+//
+// Voice state belongs to the audio thread while the plugin is active: every
+// method is meant to be called from process, or from the main thread while
+// the plugin is deactivated, and none of them lock. Only
+// GetActiveVoiceCount may be called from any thread.
+//
+// Free voices sit on a stack and sounding ones in a heap ordered by how
+// cheap they are to steal, and a hash index finds the voice playing a note,
+// so starting, ending and looking up a note costs O(1) or O(log n) in the
+// polyphony rather than a scan.
 type VoiceManager struct {
-	mu         sync.RWMutex
 	voices     []*Voice
 	maxVoices  int
 	sampleRate float64
 	
+	free   []*Voice // voices ready to allocate, used as a stack
+	active []*Voice // sounding voices, a heap with the next victim first
+	
+	// Note index: open addressing with linear probing, kept at most half
+	// full so probes stay short
+	index     []*Voice
+	indexMask uint64
+	
+	clock       uint64       // allocation counter behind Voice.age
+	activeCount atomic.Int32 // len(active), readable from any thread
+	
 	// Voice stealing strategy
 	stealOldest bool
+	
+	onVoiceEnd func(*Voice)
+	
+	// Render buses sized at activation; only touched by the audio thread
+	mixBus   []float32
+	voiceBus []float32
 }
 
 // NewVoiceManager creates a new voice manager with the specified polyphony
 func NewVoiceManager(maxVoices int, sampleRate float64) *VoiceManager {
+	indexSize := 16
+	for indexSize < 2*maxVoices {
+		indexSize <<= 1
+	}
+	
 	vm := &VoiceManager{
-		maxVoices:   maxVoices,
-		sampleRate:  sampleRate,
-		voices:      make([]*Voice, maxVoices),
-		stealOldest: true,
+		maxVoices:  maxVoices,
+		sampleRate: sampleRate,
+		voices:     make([]*Voice, maxVoices),
+		free:       make([]*Voice, 0, maxVoices),
+		active:     make([]*Voice, 0, maxVoices),
+		index:      make([]*Voice, indexSize),
+		indexMask:  uint64(indexSize - 1),
+		mixBus:     make([]float32, DefaultMaxVoiceFrames),
+		voiceBus:   make([]float32, DefaultMaxVoiceFrames),
 	}
 	
 	// Pre-allocate voices
 	for i := 0; i < maxVoices; i++ {
 		vm.voices[i] = &Voice{
 			Envelope: NewADSREnvelope(sampleRate),
+			heapPos:  -1,
 		}
 	}
+	vm.refillFree()
 	
 	return vm
 }
 
+// refillFree puts every voice on the free stack, the first on top so
+// allocation order matches the pool
+func (vm *VoiceManager) refillFree() {
+	vm.free = vm.free[:0]
+	for i := len(vm.voices) - 1; i >= 0; i-- {
+		vm.free = append(vm.free, vm.voices[i])
+	}
+}
+
 // SetSampleRate updates the sample rate for all voices
 func (vm *VoiceManager) SetSampleRate(sampleRate float64) {
-	vm.mu.Lock()
-	defer vm.mu.Unlock()
-	
 	vm.sampleRate = sampleRate
 	for _, voice := range vm.voices {
 		if voice != nil && voice.Envelope != nil {
@@ -76,44 +140,53 @@ func (vm *VoiceManager) SetSampleRate(sampleRate float64) {
 	}
 }
 
-// AllocateVoice finds a free voice or steals one according to the stealing strategy
+// SetMaxFrames sizes the render buses for the largest block the host will
+// send. Call it from Activate, never while processing.
+func (vm *VoiceManager) SetMaxFrames(maxFrames uint32) {
+	if int(maxFrames) > len(vm.mixBus) {
+		vm.mixBus = make([]float32, maxFrames)
+		vm.voiceBus = make([]float32, maxFrames)
+	}
+}
+
+// SetVoiceEndHandler sets a function called whenever a voice stops
+// sounding: its envelope finished, it was stolen or it was choked. It runs
+// before the voice is reused, on the audio thread, and must not allocate
+// or release voices itself. Plugins send CLAP_EVENT_NOTE_END from it.
+func (vm *VoiceManager) SetVoiceEndHandler(handler func(*Voice)) {
+	vm.onVoiceEnd = handler
+}
+
+// AllocateVoice starts a note on a free voice, or steals the sounding voice
+// cheapest to lose when none is free. A note already playing under the same
+// identity is released first, so its tail plays out and later lookups find
+// the new voice.
+// [audio-thread]
 func (vm *VoiceManager) AllocateVoice(noteID int32, channel, key int16, velocity float64) *Voice {
-	vm.mu.Lock()
-	defer vm.mu.Unlock()
-	
-	// First, look for a free voice
-	for _, voice := range vm.voices {
-		if voice != nil && !voice.IsActive {
-			vm.initializeVoice(voice, noteID, channel, key, velocity)
-			return voice
-		}
+	noteKey := makeNoteKey(noteID, channel, key)
+	if previous := vm.lookup(noteKey); previous != nil {
+		vm.unindex(previous)
+		vm.release(previous)
 	}
 	
-	// No free voice, need to steal one
-	var victimVoice *Voice
-	
-	if vm.stealOldest {
-		// Find the oldest voice (simplest strategy)
-		for _, voice := range vm.voices {
-			if voice != nil {
-				victimVoice = voice
-				break
-			}
-		}
+	var voice *Voice
+	if n := len(vm.free); n > 0 {
+		voice = vm.free[n-1]
+		vm.free = vm.free[:n-1]
+	} else if len(vm.active) > 0 {
+		voice = vm.active[0]
+		vm.heapRemove(0)
+		vm.endVoice(voice)
 	} else {
-		// Could implement other strategies like:
-		// - Steal quietest voice
-		// - Steal voice in release phase
-		// - Steal lowest priority voice
-		victimVoice = vm.voices[0]
+		return nil
 	}
 	
-	if victimVoice != nil {
-		vm.initializeVoice(victimVoice, noteID, channel, key, velocity)
-		return victimVoice
-	}
-	
-	return nil
+	vm.initializeVoice(voice, noteID, channel, key, velocity)
+	voice.noteKey = noteKey
+	vm.insert(voice)
+	vm.heapPush(voice)
+	vm.activeCount.Store(int32(len(vm.active)))
+	return voice
 }
 
 // initializeVoice sets up a voice for a new note
@@ -123,6 +196,7 @@ func (vm *VoiceManager) initializeVoice(voice *Voice, noteID int32, channel, key
 	voice.Key = key
 	voice.Velocity = velocity
 	voice.Phase = 0
+	voice.phaseInc = 0
 	voice.Frequency = NoteToFrequency(int(key))
 	voice.IsActive = true
 	voice.PitchBend = 0
@@ -131,52 +205,199 @@ func (vm *VoiceManager) initializeVoice(voice *Voice, noteID int32, channel, key
 	voice.Volume = 1.0
 	voice.TuningID = 0
 	
+	// A new note counts as full velocity until its first block is rendered,
+	// so a burst of note ons does not steal its own attacks
+	vm.clock++
+	voice.age = vm.clock
+	voice.released = false
+	voice.loudness = float32(velocity)
+	
 	// Trigger the envelope
 	if voice.Envelope != nil {
 		voice.Envelope.Trigger()
 	}
 }
 
-// ReleaseVoice releases a voice by note ID and channel
-func (vm *VoiceManager) ReleaseVoice(noteID int32, channel int16) {
-	vm.mu.Lock()
-	defer vm.mu.Unlock()
+// ReleaseNote releases the voice playing a note. A note ID of -1, and a
+// channel or key of -1, are CLAP wildcards that match any value. With a
+// note ID, or a channel and key, the voice is found through the index.
+// [audio-thread]
+func (vm *VoiceManager) ReleaseNote(noteID int32, channel, key int16) {
+	if noteID >= 0 || (channel >= 0 && key >= 0) {
+		voice := vm.lookup(makeNoteKey(noteID, channel, key))
+		if voice != nil && voice.matches(noteID, channel, key) {
+			vm.release(voice)
+			return
+		}
+		if noteID >= 0 {
+			return
+		}
+	}
 	
-	for _, voice := range vm.voices {
-		if voice != nil && voice.IsActive && 
-		   voice.NoteID == noteID && voice.Channel == channel {
+	// Wildcards may match several voices, and notes started with an ID
+	// are not indexed by channel and key
+	released := false
+	for _, voice := range vm.active {
+		if voice.IsActive && !voice.released && voice.matches(noteID, channel, key) {
+			voice.released = true
 			if voice.Envelope != nil {
 				voice.Envelope.Release()
 			}
+			released = true
 		}
 	}
+	if released {
+		vm.heapify()
+	}
+}
+
+// ReleaseVoice releases the voices playing noteID on channel
+// [audio-thread]
+func (vm *VoiceManager) ReleaseVoice(noteID int32, channel int16) {
+	vm.ReleaseNote(noteID, channel, -1)
+}
+
+// release starts a voice's tail, which makes it the first candidate to steal
+func (vm *VoiceManager) release(voice *Voice) {
+	if voice.released {
+		return
+	}
+	voice.released = true
+	if voice.Envelope != nil {
+		voice.Envelope.Release()
+	}
+	if voice.heapPos >= 0 {
+		vm.heapFix(voice.heapPos)
+	}
 }
 
 // ReleaseAllVoices releases all active voices
+// [audio-thread]
 func (vm *VoiceManager) ReleaseAllVoices() {
-	vm.mu.Lock()
-	defer vm.mu.Unlock()
-	
-	for _, voice := range vm.voices {
-		if voice != nil && voice.IsActive {
+	for _, voice := range vm.active {
+		if voice.IsActive && !voice.released {
+			voice.released = true
 			if voice.Envelope != nil {
 				voice.Envelope.Release()
 			}
 		}
 	}
+	vm.heapify()
 }
 
-// ProcessVoices calls the process function for each active voice and returns mixed output
-func (vm *VoiceManager) ProcessVoices(frameCount uint32, processFunc func(*Voice, uint32) []float32) []float32 {
-	vm.mu.RLock()
-	defer vm.mu.RUnlock()
+// StopVoice silences a voice at once and returns it to the free list, for
+// note chokes
+// [audio-thread]
+func (vm *VoiceManager) StopVoice(voice *Voice) {
+	if voice == nil || voice.heapPos < 0 {
+		return
+	}
+	if voice.Envelope != nil {
+		voice.Envelope.Reset()
+	}
+	vm.heapRemove(voice.heapPos)
+	vm.retire(voice)
+	vm.activeCount.Store(int32(len(vm.active)))
+}
+
+// endVoice drops a voice that stopped sounding from the index and tells the
+// plugin. It is still allocated; the caller frees or reuses it.
+func (vm *VoiceManager) endVoice(voice *Voice) {
+	vm.unindex(voice)
+	if vm.onVoiceEnd != nil {
+		vm.onVoiceEnd(voice)
+	}
+	voice.IsActive = false
+}
+
+// retire ends a voice already removed from the heap and frees it
+func (vm *VoiceManager) retire(voice *Voice) {
+	vm.endVoice(voice)
+	vm.free = append(vm.free, voice)
+}
+
+// finishBlock frees the voices that stopped during the block, either
+// because their envelope ended or because the plugin cleared IsActive, and
+// reorders the heap by the levels they finished the block at. It is O(n)
+// once per block, so events in the block stay O(log n).
+func (vm *VoiceManager) finishBlock() {
+	sounding := vm.active[:0]
+	for _, voice := range vm.active {
+		if voice.IsActive && (voice.Envelope == nil || voice.Envelope.IsActive()) {
+			voice.loudness = voice.level()
+			sounding = append(sounding, voice)
+			continue
+		}
+		voice.heapPos = -1
+		vm.retire(voice)
+	}
+	clear(vm.active[len(sounding):])
+	vm.active = sounding
+	vm.heapify()
+	vm.activeCount.Store(int32(len(vm.active)))
+}
+
+// level is the voice's current output gain, which stealing compares
+func (voice *Voice) level() float32 {
+	gain := voice.Velocity * voice.Volume
+	if voice.Envelope != nil {
+		gain *= voice.Envelope.CurrentValue
+	}
+	return float32(gain)
+}
+
+// matches reports whether the voice plays a note, treating -1 as a wildcard
+func (voice *Voice) matches(noteID int32, channel, key int16) bool {
+	return (noteID < 0 || voice.NoteID == noteID) &&
+		(channel < 0 || voice.Channel == channel) &&
+		(key < 0 || voice.Key == key)
+}
+
+// RenderVoices renders every active voice into the manager's voice bus and
+// accumulates it into the mix bus, which is returned. The result is only
+// valid until the next call.
+//
+// Voices whose envelope finished are freed afterwards, calling the voice
+// end handler. Nothing is allocated for blocks up to the size given to
+// SetMaxFrames.
+// [audio-thread]
+func (vm *VoiceManager) RenderVoices(frameCount uint32, render VoiceRenderFunc) []float32 {
+	if int(frameCount) > len(vm.mixBus) {
+		// The host exceeded max_frames; grow rather than truncate
+		vm.mixBus = make([]float32, frameCount)
+		vm.voiceBus = make([]float32, frameCount)
+	}
+	
+	mix := vm.mixBus[:frameCount]
+	for i := range mix {
+		mix[i] = 0
+	}
+	
+	scratch := vm.voiceBus[:frameCount]
+	for _, voice := range vm.active {
+		if !voice.IsActive {
+			continue
+		}
+		
+		render(voice, scratch)
+		for i, sample := range scratch {
+			mix[i] += sample
+		}
+	}
 	
+	vm.finishBlock()
+	return mix
+}
+
+// ProcessVoices calls the process function for each active voice and returns mixed output.
+// It allocates on every call; audio-thread code should use RenderVoices.
+func (vm *VoiceManager) ProcessVoices(frameCount uint32, processFunc func(*Voice, uint32) []float32) []float32 {
 	// Create output buffer
 	output := make([]float32, frameCount)
 	
 	// Process each active voice
-	for _, voice := range vm.voices {
-		if voice == nil || !voice.IsActive {
+	for _, voice := range vm.active {
+		if !voice.IsActive {
 			continue
 		}
 		
@@ -187,75 +408,246 @@ func (vm *VoiceManager) ProcessVoices(frameCount uint32, processFunc func(*Voice
 		for i := uint32(0); i < frameCount && i < uint32(len(voiceOutput)); i++ {
 			output[i] += voiceOutput[i]
 		}
-		
-		// Check if voice should be deactivated
-		if voice.Envelope != nil && !voice.Envelope.IsActive() {
-			voice.IsActive = false
-		}
 	}
 	
+	vm.finishBlock()
 	return output
 }
 
-// GetActiveVoiceCount returns the number of currently active voices
+// GetActiveVoiceCount returns the number of allocated voices as of the
+// last note event or block. Safe to call from any thread.
 func (vm *VoiceManager) GetActiveVoiceCount() int {
-	vm.mu.RLock()
-	defer vm.mu.RUnlock()
-	
-	count := 0
-	for _, voice := range vm.voices {
-		if voice != nil && voice.IsActive {
-			count++
-		}
-	}
-	return count
+	return int(vm.activeCount.Load())
 }
 
 // GetVoiceByNoteID finds a voice by note ID and channel
+// [audio-thread]
 func (vm *VoiceManager) GetVoiceByNoteID(noteID int32, channel int16) *Voice {
-	vm.mu.RLock()
-	defer vm.mu.RUnlock()
+	return vm.FindVoice(noteID, channel, -1)
+}
+
+// FindVoice returns the voice playing a note, or nil. -1 is a wildcard as
+// in ReleaseNote, and with several matches the newest indexed one wins,
+// then any sounding voice that matches.
+// [audio-thread]
+func (vm *VoiceManager) FindVoice(noteID int32, channel, key int16) *Voice {
+	if noteID >= 0 || (channel >= 0 && key >= 0) {
+		voice := vm.lookup(makeNoteKey(noteID, channel, key))
+		if voice != nil && voice.matches(noteID, channel, key) {
+			return voice
+		}
+		if noteID >= 0 {
+			return nil
+		}
+	}
 	
-	for _, voice := range vm.voices {
-		if voice != nil && voice.IsActive && 
-		   voice.NoteID == noteID && voice.Channel == channel {
+	// Notes started with an ID are indexed by it, so a lookup by channel
+	// and key alone, or with wildcards, has to search
+	for _, voice := range vm.active {
+		if voice.IsActive && voice.matches(noteID, channel, key) {
 			return voice
 		}
 	}
 	return nil
 }
 
-// ApplyToAllVoices applies a function to all active voices
+// ApplyToAllVoices applies a function to all active voices. The function
+// may clear IsActive; the voice is freed at the end of the next block.
+// [audio-thread]
 func (vm *VoiceManager) ApplyToAllVoices(applyFunc func(*Voice)) {
-	vm.mu.RLock()
-	defer vm.mu.RUnlock()
-	
-	for _, voice := range vm.voices {
-		if voice != nil && voice.IsActive {
+	for _, voice := range vm.active {
+		if voice.IsActive {
 			applyFunc(voice)
 		}
 	}
 }
 
-// SetVoiceStealingStrategy sets whether to steal oldest voice (true) or use other strategies
+// SetEnvelope sets the ADSR of every voice, active or not, so notes started
+// later use it too. Envelopes only recompute their coefficients when a
+// value differs, but callers should still skip this while nothing changed.
+// [audio-thread]
+func (vm *VoiceManager) SetEnvelope(attack, decay, sustain, release float64) {
+	for _, voice := range vm.voices {
+		if voice != nil && voice.Envelope != nil {
+			voice.Envelope.SetADSR(attack, decay, sustain, release)
+		}
+	}
+}
+
+// SetVoiceStealingStrategy selects which voice is stolen when every voice
+// is sounding. By default it is a voice in release first, then the
+// quietest, then the oldest; stealOldest steals strictly by age.
+// [audio-thread]
 func (vm *VoiceManager) SetVoiceStealingStrategy(stealOldest bool) {
-	vm.mu.Lock()
-	defer vm.mu.Unlock()
 	vm.stealOldest = stealOldest
+	vm.heapify()
 }
 
 // Reset deactivates all voices and resets their state
 func (vm *VoiceManager) Reset() {
-	vm.mu.Lock()
-	defer vm.mu.Unlock()
-	
 	for _, voice := range vm.voices {
 		if voice != nil {
 			voice.IsActive = false
 			voice.Phase = 0
+			voice.indexed = false
+			voice.released = false
+			voice.loudness = 0
+			voice.heapPos = -1
 			if voice.Envelope != nil {
 				voice.Envelope.Reset()
 			}
 		}
 	}
-}
\ No newline at end of file
+	clear(vm.index)
+	clear(vm.active)
+	vm.active = vm.active[:0]
+	vm.refillFree()
+	vm.activeCount.Store(0)
+}
+
+// Note index
+
+// makeNoteKey is a note's identity. CLAP note IDs are unique among the
+// notes of an instance, so a note with one is keyed by it alone; one
+// without is keyed by channel and key, as MIDI is.
+func makeNoteKey(noteID int32, channel, key int16) uint64 {
+	if noteID >= 0 {
+		return 1<<63 | uint64(uint32(noteID))
+	}
+	return uint64(uint16(channel))<<16 | uint64(uint16(key))
+}
+
+func (vm *VoiceManager) slot(noteKey uint64) uint64 {
+	return (noteKey * 0x9E3779B97F4A7C15 >> 32) & vm.indexMask
+}
+
+func (vm *VoiceManager) lookup(noteKey uint64) *Voice {
+	for i := vm.slot(noteKey); ; i = (i + 1) & vm.indexMask {
+		voice := vm.index[i]
+		if voice == nil || voice.noteKey == noteKey {
+			return voice
+		}
+	}
+}
+
+// insert indexes a voice whose key is not in the index
+func (vm *VoiceManager) insert(voice *Voice) {
+	i := vm.slot(voice.noteKey)
+	for vm.index[i] != nil {
+		i = (i + 1) & vm.indexMask
+	}
+	vm.index[i] = voice
+	voice.indexed = true
+}
+
+// unindex removes a voice from the index, shifting later entries of its
+// probe run back so lookups never meet a hole
+func (vm *VoiceManager) unindex(voice *Voice) {
+	if !voice.indexed {
+		return
+	}
+	voice.indexed = false
+	
+	i := vm.slot(voice.noteKey)
+	for vm.index[i] != voice {
+		i = (i + 1) & vm.indexMask
+	}
+	for j := (i + 1) & vm.indexMask; vm.index[j] != nil; j = (j + 1) & vm.indexMask {
+		// An entry may fill the hole unless its home slot lies cyclically
+		// in (i, j]
+		home := vm.slot(vm.index[j].noteKey)
+		if (j-home)&vm.indexMask >= (j-i)&vm.indexMask {
+			vm.index[i] = vm.index[j]
+			i = j
+		}
+	}
+	vm.index[i] = nil
+}
+
+// Steal heap
+
+// stealBefore reports whether a should be stolen before b
+func (vm *VoiceManager) stealBefore(a, b *Voice) bool {
+	if !vm.stealOldest {
+		if a.released != b.released {
+			return a.released
+		}
+		if a.loudness != b.loudness {
+			return a.loudness < b.loudness
+		}
+	}
+	return a.age < b.age
+}
+
+func (vm *VoiceManager) heapSwap(i, j int) {
+	h := vm.active
+	h[i], h[j] = h[j], h[i]
+	h[i].heapPos = i
+	h[j].heapPos = j
+}
+
+func (vm *VoiceManager) heapUp(i int) {
+	for i > 0 {
+		parent := (i - 1) / 2
+		if !vm.stealBefore(vm.active[i], vm.active[parent]) {
+			break
+		}
+		vm.heapSwap(i, parent)
+		i = parent
+	}
+}
+
+func (vm *VoiceManager) heapDown(i int) bool {
+	start := i
+	n := len(vm.active)
+	for {
+		child := 2*i + 1
+		if child >= n {
+			break
+		}
+		if right := child + 1; right < n && vm.stealBefore(vm.active[right], vm.active[child]) {
+			child = right
+		}
+		if !vm.stealBefore(vm.active[child], vm.active[i]) {
+			break
+		}
+		vm.heapSwap(i, child)
+		i = child
+	}
+	return i > start
+}
+
+func (vm *VoiceManager) heapPush(voice *Voice) {
+	voice.heapPos = len(vm.active)
+	vm.active = append(vm.active, voice)
+	vm.heapUp(voice.heapPos)
+}
+
+func (vm *VoiceManager) heapRemove(i int) {
+	last := len(vm.active) - 1
+	voice := vm.active[i]
+	if i != last {
+		vm.heapSwap(i, last)
+	}
+	vm.active[last] = nil
+	vm.active = vm.active[:last]
+	voice.heapPos = -1
+	if i < last {
+		vm.heapFix(i)
+	}
+}
+
+func (vm *VoiceManager) heapFix(i int) {
+	if !vm.heapDown(i) {
+		vm.heapUp(i)
+	}
+}
+
+func (vm *VoiceManager) heapify() {
+	for i, voice := range vm.active {
+		voice.heapPos = i
+	}
+	for i := len(vm.active)/2 - 1; i >= 0; i-- {
+		vm.heapDown(i)
+	}
+}
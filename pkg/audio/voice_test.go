@@ -0,0 +1,25 @@
+package audio
+
+import "testing"
+
+// TestVoiceManagerReset checks that Reset returns every voice to the state
+// of a fresh one, so none comes back already released
+func TestVoiceManagerReset(t *testing.T) {
+	vm := NewVoiceManager(4, 48000)
+	for key := int16(60); key < 64; key++ {
+		vm.AllocateVoice(int32(key), 0, key, 0.8)
+	}
+	vm.ReleaseNote(60, 0, 60)
+	vm.ReleaseNote(61, 0, 61)
+
+	vm.Reset()
+	for i, voice := range vm.voices {
+		if voice.IsActive || voice.released || voice.indexed || voice.heapPos != -1 {
+			t.Errorf("voice %d after Reset: active %v, released %v, indexed %v, heap position %d",
+				i, voice.IsActive, voice.released, voice.indexed, voice.heapPos)
+		}
+	}
+	if n := vm.GetActiveVoiceCount(); n != 0 {
+		t.Errorf("%d active voices after Reset, want 0", n)
+	}
+}
@@ -0,0 +1,249 @@
+package audio
+
+import (
+	"math"
+	"math/bits"
+	"sync"
+)
+
+// Wavetable geometry. Level L holds the first WavetableSize/2 >> L
+// harmonics, so level 0 is the full-bandwidth table and the last level a
+// pure sine.
+const (
+	wavetableBits = 11
+
+	// WavetableSize is the number of samples in one table cycle
+	WavetableSize = 1 << wavetableBits
+
+	// WavetableLevels is the number of band-limited levels per waveform
+	WavetableLevels = wavetableBits
+
+	// Phase bits below the table index, used for interpolation
+	wavetableFracBits  = 32 - wavetableBits
+	wavetableFracMask  = 1<<wavetableFracBits - 1
+	wavetableFracScale = 1.0 / (1 << wavetableFracBits)
+)
+
+// Wavetable is one waveform as mip-mapped, band-limited tables. Phase is a
+// 32-bit fixed-point accumulator where 2^32 is one cycle; the level for a
+// given phase increment is the richest one whose top harmonic stays below
+// Nyquist, so selection does not depend on the sample rate and the tables
+// are shared by every instance.
+type Wavetable struct {
+	levels [WavetableLevels]*wavetableLevel
+}
+
+// wavetableLevel is one table cycle stored as sample and slope to the next
+// sample pairs, so interpolation reads one cache line and never wraps. The
+// fixed size lets the compiler drop the bounds check on the index taken
+// from the phase's top bits.
+type wavetableLevel [WavetableSize][2]float32
+
+func newWavetableLevel(cycle []float64) *wavetableLevel {
+	table := &wavetableLevel{}
+	for i, s := range cycle {
+		next := cycle[(i+1)&(WavetableSize-1)]
+		table[i] = [2]float32{float32(s), float32(next - s)}
+	}
+	return table
+}
+
+// at interpolates the table at a fixed-point phase
+func (table *wavetableLevel) at(phase uint32) float32 {
+	pair := &table[phase>>wavetableFracBits]
+	return pair[0] + pair[1]*(float32(phase&wavetableFracMask)*wavetableFracScale)
+}
+
+var (
+	wavetablesOnce sync.Once
+	wavetables     [WaveformNoise]*Wavetable
+)
+
+// GetWavetable returns the shared tables for waveform, or nil for
+// WaveformNoise, which has no periodic table. The first call builds every
+// table, a few milliseconds of work, so call it outside the audio thread;
+// NewPolyphonicOscillator does.
+func GetWavetable(waveform WaveformType) *Wavetable {
+	wavetablesOnce.Do(buildWavetables)
+	if waveform < 0 || int(waveform) >= len(wavetables) {
+		return nil
+	}
+	return wavetables[waveform]
+}
+
+// harmonicFunc gives the amplitude of harmonic k and whether it is a cosine
+// rather than a sine partial
+type harmonicFunc func(k int) (amplitude float64, cosine bool)
+
+func buildWavetables() {
+	// Every partial is an index into one cycle of sine: sin(2πki/N) is
+	// sine[k*i mod N], so building a table costs no trigonometry
+	sine := make([]float64, WavetableSize)
+	for i := range sine {
+		sine[i] = math.Sin(2 * math.Pi * float64(i) / WavetableSize)
+	}
+
+	// Series match GenerateWaveformSample's naive shapes
+	wavetables[WaveformSine] = newSineWavetable(sine)
+	wavetables[WaveformSaw] = newWavetable(sine, func(k int) (float64, bool) {
+		return -2 / (math.Pi * float64(k)), false
+	})
+	wavetables[WaveformSquare] = newWavetable(sine, func(k int) (float64, bool) {
+		if k%2 == 0 {
+			return 0, false
+		}
+		return 4 / (math.Pi * float64(k)), false
+	})
+	wavetables[WaveformTriangle] = newWavetable(sine, func(k int) (float64, bool) {
+		if k%2 == 0 {
+			return 0, false
+		}
+		return -8 / (math.Pi * math.Pi * float64(k*k)), true
+	})
+}
+
+// newSineWavetable shares a single table across every level
+func newSineWavetable(sine []float64) *Wavetable {
+	table := newWavetableLevel(sine)
+	wt := &Wavetable{}
+	for level := range wt.levels {
+		wt.levels[level] = table
+	}
+	return wt
+}
+
+// newWavetable sums the series from the sparsest level up, each level
+// adding the harmonics the one above it lacks
+func newWavetable(sine []float64, harmonic harmonicFunc) *Wavetable {
+	wt := &Wavetable{}
+	acc := make([]float64, WavetableSize)
+
+	added := 0
+	for level := WavetableLevels - 1; level >= 0; level-- {
+		top := (WavetableSize / 2) >> level
+		for k := added + 1; k <= top; k++ {
+			amplitude, cosine := harmonic(k)
+			if amplitude == 0 {
+				continue
+			}
+			offset := 0
+			if cosine {
+				offset = WavetableSize / 4
+			}
+			for i := range acc {
+				acc[i] += amplitude * sine[(k*i+offset)&(WavetableSize-1)]
+			}
+		}
+		added = top
+
+		wt.levels[level] = newWavetableLevel(acc)
+	}
+	return wt
+}
+
+// PhaseIncrement converts a frequency to a fixed-point phase increment
+func PhaseIncrement(frequency, sampleRate float64) uint32 {
+	inc := frequency / sampleRate
+	if inc <= 0 {
+		return 0
+	}
+	if inc >= 0.5 {
+		// Nyquist and above can only alias
+		return 1 << 31
+	}
+	return uint32(inc * (1 << 32))
+}
+
+// PhaseToFixed converts a phase in [0, 1) to the fixed-point accumulator
+func PhaseToFixed(phase float64) uint32 {
+	return uint32(uint64(phase*(1<<32)) & math.MaxUint32)
+}
+
+// PhaseFromFixed converts the fixed-point accumulator back to [0, 1)
+func PhaseFromFixed(phase uint32) float64 {
+	return float64(phase) * (1.0 / (1 << 32))
+}
+
+// Sample returns the waveform at a fixed-point phase, from the level that
+// would be played at increment inc
+func (wt *Wavetable) Sample(phase, inc uint32) float32 {
+	return wt.level(inc).at(phase)
+}
+
+// level returns the table to play at phase increment inc: the one with the
+// most harmonics whose highest stays below Nyquist
+func (wt *Wavetable) level(inc uint32) *wavetableLevel {
+	// Level L is safe while inc <= 2^(wavetableFracBits+L)
+	level := 0
+	if inc > 1 {
+		level = bits.Len32(inc-1) - wavetableFracBits
+	}
+	if level < 0 {
+		level = 0
+	} else if level >= WavetableLevels {
+		level = WavetableLevels - 1
+	}
+	return wt.levels[level]
+}
+
+// Render overwrites dst with the waveform at a constant increment and
+// returns the advanced phase
+// [audio-thread]
+func (wt *Wavetable) Render(dst []float32, phase, inc uint32) uint32 {
+	table := wt.level(inc)
+	for i := range dst {
+		dst[i] = table.at(phase)
+		phase += inc
+	}
+	return phase
+}
+
+// RenderRamp overwrites dst while the increment moves linearly from fromInc
+// to toInc across the block, for pitch that changed since the last block.
+// The level is picked for the higher of the two so the ramp never aliases.
+// [audio-thread]
+func (wt *Wavetable) RenderRamp(dst []float32, phase, fromInc, toInc uint32) uint32 {
+	if len(dst) == 0 {
+		return phase
+	}
+	table := wt.level(max(fromInc, toInc))
+
+	// The increment is carried with 16 extra fractional bits so short
+	// blocks still land on toInc
+	inc := int64(fromInc) << 16
+	step := ((int64(toInc) - int64(fromInc)) << 16) / int64(len(dst))
+	for i := range dst {
+		inc += step
+		dst[i] = table.at(phase)
+		phase += uint32(inc >> 16)
+	}
+	return phase
+}
+
+// WavetableVoices holds a batch of voices in structure-of-arrays layout for
+// RenderBatch. All slices must have the same length.
+type WavetableVoices struct {
+	Phase []uint32  // fixed-point phase, advanced by RenderBatch
+	Inc   []uint32  // phase increment for the block
+	Gain  []float32 // constant gain for the block
+}
+
+// RenderBatch adds every voice in the batch into dst, scaled by its gain,
+// and advances their phases. It suits voices that share a waveform and
+// need no per-sample envelope, like unison stacks and drones.
+// [audio-thread]
+func (wt *Wavetable) RenderBatch(voices *WavetableVoices, dst []float32) {
+	phases := voices.Phase
+	incs := voices.Inc[:len(phases)]
+	gains := voices.Gain[:len(phases)]
+
+	for v := range phases {
+		phase, inc, gain := phases[v], incs[v], gains[v]
+		table := wt.level(inc)
+		for i := range dst {
+			dst[i] += table.at(phase) * gain
+			phase += inc
+		}
+		phases[v] = phase
+	}
+}
@@ -0,0 +1,370 @@
+package event
+
+// #include "../../include/clap/include/clap/clap.h"
+//
+// // Walks the host event list once and stores up to capacity header pointers,
+// // starting at index start. The total event count is written to *total.
+// static inline uint32_t clap_input_events_gather_helper(const clap_input_events_t* events, uint32_t start,
+//                                                        const clap_event_header_t** out, uint32_t capacity,
+//                                                        uint32_t* total) {
+//     *total = 0;
+//     if (!events || !events->size || !events->get) {
+//         return 0;
+//     }
+//     uint32_t count = events->size(events);
+//     *total = count;
+//     uint32_t n = 0;
+//     for (uint32_t i = start; i < count && n < capacity; ++i) {
+//         out[n++] = events->get(events, i);
+//     }
+//     return n;
+// }
+import "C"
+import (
+	"unsafe"
+)
+
+// Ref locates one decoded event inside a Batch
+type Ref struct {
+	Time  uint32
+	Type  uint32
+	Index uint32 // index into the typed slice that holds events of Type
+}
+
+// Batch holds one block's input events decoded in bulk. Events of each kind
+// sit contiguously in their typed slice, in time order, and Order lists every
+// event across all kinds in host (time) order. Note on/off/choke/end share
+// Notes and gesture begin/end share ParamGestures; Header.Type tells them apart.
+//
+// A Batch is owned by its Processor and is only valid until the next Gather,
+// GatherNext, Bind or Unbind.
+type Batch struct {
+	Order           []Ref
+	ParamValues     []ParamValueEvent
+	ParamMods       []ParamModEvent
+	ParamGestures   []ParamGestureEvent
+	Notes           []NoteEvent
+	NoteExpressions []NoteExpressionEvent
+	Transports      []TransportEvent
+	MIDI            []MIDIEvent
+	MIDISysex       []MIDISysexEvent
+	MIDI2           []MIDI2Event
+
+	// Truncated is set when the host sent more events than one window
+	// holds; GatherNext decodes the remainder
+	Truncated bool
+}
+
+// Len returns the number of decoded events
+func (b *Batch) Len() int {
+	return len(b.Order)
+}
+
+// Dispatch calls the matching Handler method for every event in time order.
+// This is the adapter that keeps the per-event Handler interface working on
+// top of bulk decoding.
+func (b *Batch) Dispatch(handler Handler) {
+	b.DispatchRange(handler, 0, len(b.Order))
+}
+
+// DispatchRange calls the matching Handler method for events Order[from:to]
+func (b *Batch) DispatchRange(handler Handler, from, to int) {
+	if handler == nil {
+		return
+	}
+	for _, ref := range b.Order[from:to] {
+		switch ref.Type {
+		case TypeParamValue:
+			handler.HandleParamValue(&b.ParamValues[ref.Index], ref.Time)
+		case TypeParamMod:
+			handler.HandleParamMod(&b.ParamMods[ref.Index], ref.Time)
+		case TypeParamGestureBegin:
+			handler.HandleParamGestureBegin(&b.ParamGestures[ref.Index], ref.Time)
+		case TypeParamGestureEnd:
+			handler.HandleParamGestureEnd(&b.ParamGestures[ref.Index], ref.Time)
+		case TypeNoteOn:
+			handler.HandleNoteOn(&b.Notes[ref.Index], ref.Time)
+		case TypeNoteOff:
+			handler.HandleNoteOff(&b.Notes[ref.Index], ref.Time)
+		case TypeNoteChoke:
+			handler.HandleNoteChoke(&b.Notes[ref.Index], ref.Time)
+		case TypeNoteEnd:
+			handler.HandleNoteEnd(&b.Notes[ref.Index], ref.Time)
+		case TypeNoteExpression:
+			handler.HandleNoteExpression(&b.NoteExpressions[ref.Index], ref.Time)
+		case TypeTransport:
+			handler.HandleTransport(&b.Transports[ref.Index], ref.Time)
+		case TypeMIDI:
+			handler.HandleMIDI(&b.MIDI[ref.Index], ref.Time)
+		case TypeMIDISysex:
+			handler.HandleMIDISysex(&b.MIDISysex[ref.Index], ref.Time)
+		case TypeMIDI2:
+			handler.HandleMIDI2(&b.MIDI2[ref.Index], ref.Time)
+		}
+	}
+}
+
+// reset empties every slice while keeping its backing storage
+func (b *Batch) reset() {
+	b.Order = b.Order[:0]
+	b.ParamValues = b.ParamValues[:0]
+	b.ParamMods = b.ParamMods[:0]
+	b.ParamGestures = b.ParamGestures[:0]
+	b.Notes = b.Notes[:0]
+	b.NoteExpressions = b.NoteExpressions[:0]
+	b.Transports = b.Transports[:0]
+	b.MIDI = b.MIDI[:0]
+	b.MIDISysex = b.MIDISysex[:0]
+	b.MIDI2 = b.MIDI2[:0]
+	b.Truncated = false
+}
+
+// Gather decodes the bound input events with a single cgo call and returns
+// them as typed slices. Event storage comes from the processor's pool, which
+// is reset when the block is bound, so no allocation happens once the
+// processor exists and events taken from the pool earlier in the block stay
+// valid. When the host sent more events than fit, Truncated is set and
+// GatherNext continues where this window stopped.
+// [audio-thread]
+func (p *Processor) Gather() *Batch {
+	p.gather(0)
+	return &p.batch
+}
+
+// GatherNext decodes the window following the last Gather or GatherNext and
+// returns it, or nil once every host event has been decoded. The previous
+// window's batch is reused, so finish with it before calling GatherNext.
+// [audio-thread]
+func (p *Processor) GatherNext() *Batch {
+	if p.gatherNext >= p.gatherCount {
+		return nil
+	}
+	if !p.gather(p.gatherNext) {
+		return nil
+	}
+	return &p.batch
+}
+
+// gather decodes host events from index start until the pool or the header
+// scratch fills up, recording where the next window starts. It returns false
+// when no event could be decoded because the pool has no room left; the rest
+// of the block's events are then counted as misses and dropped.
+func (p *Processor) gather(start uint32) bool {
+	p.batch.reset()
+	p.gatherNext, p.gatherCount = 0, 0
+
+	if p.inputEvents == nil || len(p.headers) == 0 {
+		return true
+	}
+	p.pool.beginWindow()
+
+	// Plain locals keep cgo's pointer check from heap-allocating a closure
+	events := p.inputEvents
+	headers := &p.headers[0]
+	capacity := C.uint32_t(len(p.headers))
+	totalOut := &p.gatherTotal
+	n := uint32(C.clap_input_events_gather_helper(events, C.uint32_t(start), headers, capacity, totalOut))
+	total := uint32(p.gatherTotal)
+
+	next := start + n
+	for i := uint32(0); i < n; i++ {
+		if !p.decode(p.headers[i]) {
+			// A typed slab is full; the rest waits for the next window
+			next = start + i
+			break
+		}
+	}
+
+	p.gatherNext, p.gatherCount = next, total
+	if next == start && start < total {
+		p.pool.blockMisses += uint64(total - start)
+		p.gatherNext = total
+		return false
+	}
+	p.batch.Truncated = next < total
+	return true
+}
+
+// decode converts one C event into the next slot of its typed slice.
+// It returns false only when that slice is already at capacity.
+func (p *Processor) decode(h *C.clap_event_header_t) bool {
+	if h == nil || h.space_id != 0 {
+		return true
+	}
+
+	eventType := uint32(h._type)
+	header := Header{
+		Size:    uint32(h.size),
+		Time:    uint32(h.time),
+		SpaceID: uint16(h.space_id),
+		Type:    uint16(h._type),
+		Flags:   uint32(h.flags),
+	}
+
+	b := &p.batch
+	pool := p.pool
+	var index int
+
+	switch eventType {
+	case TypeParamValue:
+		e, ok := pool.paramValues.take(pool)
+		if !ok {
+			return false
+		}
+		c := (*C.clap_event_param_value_t)(unsafe.Pointer(h))
+		*e = ParamValueEvent{
+			Header:  header,
+			ParamID: uint32(c.param_id),
+			Cookie:  unsafe.Pointer(c.cookie),
+			NoteID:  int32(c.note_id),
+			Port:    int16(c.port_index),
+			Channel: int16(c.channel),
+			Key:     int16(c.key),
+			Value:   float64(c.value),
+		}
+		index = len(b.ParamValues)
+		b.ParamValues = pool.paramValues.filled()
+
+	case TypeParamMod:
+		e, ok := pool.paramMods.take(pool)
+		if !ok {
+			return false
+		}
+		c := (*C.clap_event_param_mod_t)(unsafe.Pointer(h))
+		*e = ParamModEvent{
+			Header:  header,
+			ParamID: uint32(c.param_id),
+			Cookie:  unsafe.Pointer(c.cookie),
+			NoteID:  int32(c.note_id),
+			Port:    int16(c.port_index),
+			Channel: int16(c.channel),
+			Key:     int16(c.key),
+			Amount:  float64(c.amount),
+		}
+		index = len(b.ParamMods)
+		b.ParamMods = pool.paramMods.filled()
+
+	case TypeParamGestureBegin, TypeParamGestureEnd:
+		e, ok := pool.paramGestures.take(pool)
+		if !ok {
+			return false
+		}
+		c := (*C.clap_event_param_gesture_t)(unsafe.Pointer(h))
+		*e = ParamGestureEvent{
+			Header:  header,
+			ParamID: uint32(c.param_id),
+		}
+		index = len(b.ParamGestures)
+		b.ParamGestures = pool.paramGestures.filled()
+
+	case TypeNoteOn, TypeNoteOff, TypeNoteChoke, TypeNoteEnd:
+		e, ok := pool.noteEvents.take(pool)
+		if !ok {
+			return false
+		}
+		c := (*C.clap_event_note_t)(unsafe.Pointer(h))
+		*e = NoteEvent{
+			Header:   header,
+			NoteID:   int32(c.note_id),
+			Port:     int16(c.port_index),
+			Channel:  int16(c.channel),
+			Key:      int16(c.key),
+			Velocity: float64(c.velocity),
+		}
+		index = len(b.Notes)
+		b.Notes = pool.noteEvents.filled()
+
+	case TypeNoteExpression:
+		e, ok := pool.noteExpressions.take(pool)
+		if !ok {
+			return false
+		}
+		c := (*C.clap_event_note_expression_t)(unsafe.Pointer(h))
+		*e = NoteExpressionEvent{
+			Header:       header,
+			ExpressionID: uint32(c.expression_id),
+			NoteID:       int32(c.note_id),
+			Port:         int16(c.port_index),
+			Channel:      int16(c.channel),
+			Key:          int16(c.key),
+			Value:        float64(c.value),
+		}
+		index = len(b.NoteExpressions)
+		b.NoteExpressions = pool.noteExpressions.filled()
+
+	case TypeTransport:
+		e, ok := pool.transports.take(pool)
+		if !ok {
+			return false
+		}
+		c := (*C.clap_event_transport_t)(unsafe.Pointer(h))
+		*e = TransportEvent{
+			Header:             header,
+			Flags:              uint32(c.flags),
+			SongPosBeats:       float64(c.song_pos_beats),
+			SongPosSeconds:     float64(c.song_pos_seconds),
+			Tempo:              float64(c.tempo),
+			TempoInc:           float64(c.tempo_inc),
+			LoopStartBeats:     float64(c.loop_start_beats),
+			LoopEndBeats:       float64(c.loop_end_beats),
+			LoopStartSeconds:   float64(c.loop_start_seconds),
+			LoopEndSeconds:     float64(c.loop_end_seconds),
+			BarStart:           float64(c.bar_start),
+			BarNumber:          int32(c.bar_number),
+			TimeSignatureNum:   uint16(c.tsig_num),
+			TimeSignatureDenom: uint16(c.tsig_denom),
+		}
+		index = len(b.Transports)
+		b.Transports = pool.transports.filled()
+
+	case TypeMIDI:
+		e, ok := pool.midiEvents.take(pool)
+		if !ok {
+			return false
+		}
+		c := (*C.clap_event_midi_t)(unsafe.Pointer(h))
+		*e = MIDIEvent{
+			Header: header,
+			Port:   uint16(c.port_index),
+			Data:   [3]byte{byte(c.data[0]), byte(c.data[1]), byte(c.data[2])},
+		}
+		index = len(b.MIDI)
+		b.MIDI = pool.midiEvents.filled()
+
+	case TypeMIDISysex:
+		e, ok := pool.midiSysexEvents.take(pool)
+		if !ok {
+			return false
+		}
+		c := (*C.clap_event_midi_sysex_t)(unsafe.Pointer(h))
+		*e = MIDISysexEvent{
+			Header: header,
+			Port:   uint16(c.port_index),
+			Buffer: unsafe.Pointer(c.buffer),
+			Size:   uint32(c.size),
+		}
+		index = len(b.MIDISysex)
+		b.MIDISysex = pool.midiSysexEvents.filled()
+
+	case TypeMIDI2:
+		e, ok := pool.midi2Events.take(pool)
+		if !ok {
+			return false
+		}
+		c := (*C.clap_event_midi2_t)(unsafe.Pointer(h))
+		*e = MIDI2Event{
+			Header: header,
+			Port:   uint16(c.port_index),
+			Data:   [4]uint32{uint32(c.data[0]), uint32(c.data[1]), uint32(c.data[2]), uint32(c.data[3])},
+		}
+		index = len(b.MIDI2)
+		b.MIDI2 = pool.midi2Events.filled()
+
+	default:
+		// Unknown core event types are skipped, as before
+		return true
+	}
+
+	b.Order = append(b.Order, Ref{Time: header.Time, Type: eventType, Index: uint32(index)})
+	return true
+}
@@ -0,0 +1,165 @@
+package event_test
+
+import (
+	"fmt"
+	"testing"
+
+	"github.com/justyntemme/clapgo/internal/clapfake"
+	"github.com/justyntemme/clapgo/pkg/event"
+)
+
+// benchFrames is the block size the event lists are spread over
+const benchFrames = 512
+
+var eventCounts = []int{10, 100, 1000}
+
+// countingHandler does the least a real handler would: it looks at each event
+type countingHandler struct {
+	event.NoOpHandler
+	params, notes, midi int
+	last                float64
+}
+
+func (h *countingHandler) HandleParamValue(e *event.ParamValueEvent, time uint32) {
+	h.params++
+	h.last = e.Value
+}
+
+func (h *countingHandler) HandleNoteOn(e *event.NoteEvent, time uint32) {
+	h.notes++
+}
+
+func (h *countingHandler) HandleNoteOff(e *event.NoteEvent, time uint32) {
+	h.notes++
+}
+
+func (h *countingHandler) HandleMIDI(e *event.MIDIEvent, time uint32) {
+	h.midi++
+}
+
+func (h *countingHandler) total() int {
+	return h.params + h.notes + h.midi
+}
+
+func BenchmarkProcessAll(b *testing.B) {
+	for _, n := range eventCounts {
+		b.Run(fmt.Sprintf("events=%d", n), func(b *testing.B) {
+			list := clapfake.NewEventList(n, benchFrames, 8)
+			defer list.Free()
+			p := event.NewProcessor(nil, nil)
+			h := &countingHandler{}
+
+			b.ReportAllocs()
+			b.ResetTimer()
+			for i := 0; i < b.N; i++ {
+				p.Bind(list.In(), list.Out())
+				p.ProcessAll(h)
+				p.Unbind()
+			}
+			b.ReportMetric(float64(b.Elapsed().Nanoseconds())/float64(b.N*n), "ns/event")
+		})
+	}
+}
+
+func BenchmarkGather(b *testing.B) {
+	for _, n := range eventCounts {
+		b.Run(fmt.Sprintf("events=%d", n), func(b *testing.B) {
+			list := clapfake.NewEventList(n, benchFrames, 8)
+			defer list.Free()
+			p := event.NewProcessor(nil, nil)
+
+			b.ReportAllocs()
+			b.ResetTimer()
+			for i := 0; i < b.N; i++ {
+				p.Bind(list.In(), list.Out())
+				if p.Gather().Len() == 0 {
+					b.Fatal("no events gathered")
+				}
+				p.Unbind()
+			}
+			b.ReportMetric(float64(b.Elapsed().Nanoseconds())/float64(b.N*n), "ns/event")
+		})
+	}
+}
+
+func TestProcessAllocs(t *testing.T) {
+	for _, n := range eventCounts {
+		list := clapfake.NewEventList(n, benchFrames, 8)
+		defer list.Free()
+		p := event.NewProcessor(nil, nil)
+		h := &countingHandler{}
+
+		processAll := testing.AllocsPerRun(100, func() {
+			p.Bind(list.In(), list.Out())
+			p.ProcessAll(h)
+			p.Unbind()
+		})
+		gather := testing.AllocsPerRun(100, func() {
+			p.Bind(list.In(), list.Out())
+			p.Gather()
+			p.Unbind()
+		})
+		if processAll != 0 || gather != 0 {
+			t.Errorf("events=%d: ProcessAll %.1f, Gather %.1f allocs per block, want 0", n, processAll, gather)
+		}
+	}
+}
+
+// TestGatherPaging checks that blocks larger than the pool are decoded in
+// full, window by window, without recycling events taken earlier
+func TestGatherPaging(t *testing.T) {
+	const n = 3000
+	list := clapfake.NewEventList(n, benchFrames, 8)
+	defer list.Free()
+	p := event.NewProcessor(nil, nil)
+	p.Bind(list.In(), list.Out())
+	defer p.Unbind()
+
+	held := p.GetPool().GetNoteEvent()
+	held.Key = 99
+
+	h := &countingHandler{}
+	p.ProcessAll(h)
+	if h.total() != n {
+		t.Errorf("ProcessAll dispatched %d events, want %d", h.total(), n)
+	}
+
+	gathered := 0
+	batch := p.Gather()
+	if !batch.Truncated {
+		t.Errorf("first window of %d events not truncated", n)
+	}
+	for ; batch != nil; batch = p.GatherNext() {
+		gathered += batch.Len()
+	}
+	if gathered != n {
+		t.Errorf("Gather and GatherNext decoded %d events, want %d", gathered, n)
+	}
+	if held.Key != 99 {
+		t.Errorf("event taken before gathering was overwritten")
+	}
+}
+
+func TestPoolOverflow(t *testing.T) {
+	pool := event.NewPoolWithCapacity(2)
+	a, b := pool.GetNoteEvent(), pool.GetNoteEvent()
+	if a == nil || b == nil || a == b {
+		t.Fatal("pool did not hand out two distinct events")
+	}
+	if pool.GetNoteEvent() != nil {
+		t.Error("overflowing Get returned an event, want nil")
+	}
+	pool.GetMIDIEvent()
+	pool.Reset()
+
+	_, _, misses, highWaterMark, _ := pool.GetDiagnostics()
+	if misses != 1 {
+		t.Errorf("misses = %d, want 1", misses)
+	}
+	if highWaterMark != 2 {
+		t.Errorf("high-water mark = %d, want the fullest slab's 2", highWaterMark)
+	}
+	if marks := pool.HighWaterMarks(); marks.Notes != 2 || marks.MIDI != 1 {
+		t.Errorf("high-water marks = %+v, want Notes 2 and MIDI 1", marks)
+	}
+}
@@ -36,20 +36,70 @@ type Processor struct {
 	inputEvents  *C.clap_input_events_t
 	outputEvents *C.clap_output_events_t
 	pool         *Pool
+
+	// Scratch events reused for every push; try_push copies the event,
+	// so one instance of each layout is enough
+	noteScratch  C.clap_event_note_t
+	paramScratch C.clap_event_param_value_t
+
+	// Bulk decoding state, sized from the pool's capacity
+	headers     []*C.clap_event_header_t
+	gatherTotal C.uint32_t
+	gatherNext  uint32 // first host event the next window decodes
+	gatherCount uint32 // host event count of the bound block
+	batch       Batch
 }
 
 // NewProcessor creates a new Processor from C event queues
 func NewProcessor(inputEvents, outputEvents unsafe.Pointer) *Processor {
-	return &Processor{
+	p := &Processor{
 		inputEvents:  (*C.clap_input_events_t)(inputEvents),
 		outputEvents: (*C.clap_output_events_t)(outputEvents),
-		pool:         NewPool(),
 	}
+	p.SetPool(NewPool())
+	return p
+}
+
+// Bind points a long-lived processor at the host's event queues for one
+// block. Create the processor once at activation and call Bind at the top of
+// each process or flush call so the pool and its counters survive across blocks.
+// [audio-thread]
+func (p *Processor) Bind(inputEvents, outputEvents unsafe.Pointer) {
+	if p.pool != nil {
+		p.pool.Reset()
+	}
+	p.inputEvents = (*C.clap_input_events_t)(inputEvents)
+	p.outputEvents = (*C.clap_output_events_t)(outputEvents)
+	p.gatherNext, p.gatherCount = 0, 0
 }
 
-// SetPool allows setting a custom event pool (useful for sharing across processors)
+// Unbind drops the event queue pointers once the host call has returned,
+// so a stale queue can never be read outside its block. It also ends the
+// pool's block, recycling every event handed out and publishing statistics.
+// [audio-thread]
+func (p *Processor) Unbind() {
+	p.inputEvents = nil
+	p.outputEvents = nil
+	p.gatherNext, p.gatherCount = 0, 0
+	if p.pool != nil {
+		p.pool.Reset()
+	}
+}
+
+// SetPool allows setting a custom event pool (useful for sharing across processors
+// or for a different number of events per block). Call it outside the audio thread.
 func (p *Processor) SetPool(pool *Pool) {
+	if pool == nil {
+		pool = NewPool()
+	}
 	p.pool = pool
+	
+	capacity := pool.MaxEventsPerBlock()
+	if cap(p.headers) < capacity {
+		p.headers = make([]*C.clap_event_header_t, capacity)
+		p.batch.Order = make([]Ref, 0, capacity)
+	}
+	p.headers = p.headers[:capacity]
 }
 
 // GetPool returns the event pool for diagnostics
@@ -66,168 +116,16 @@ func (p *Processor) GetInputEventCount() uint32 {
 	return uint32(C.clap_input_events_size_helper(p.inputEvents))
 }
 
-// ProcessAll processes all input events and calls the appropriate handler
+// ProcessAll processes all input events and calls the appropriate handler.
+// Events are decoded in bulk through Gather and dispatched in time order;
+// lists larger than the pool are handled in several windows.
 func (p *Processor) ProcessAll(handler Handler) {
 	if handler == nil || p.inputEvents == nil {
 		return
 	}
 	
-	count := uint32(C.clap_input_events_size_helper(p.inputEvents))
-	
-	for i := uint32(0); i < count; i++ {
-		cEventHeader := C.clap_input_events_get_helper(p.inputEvents, C.uint32_t(i))
-		if cEventHeader == nil || cEventHeader.space_id != 0 {
-			continue
-		}
-		
-		time := uint32(cEventHeader.time)
-		
-		// Process events directly without creating Event wrapper
-		switch int(cEventHeader._type) {
-		case int(TypeParamValue):
-			cParamEvent := (*C.clap_event_param_value_t)(unsafe.Pointer(cEventHeader))
-			paramEvent := p.pool.GetParamValueEvent()
-			paramEvent.ParamID = uint32(cParamEvent.param_id)
-			paramEvent.Cookie = unsafe.Pointer(cParamEvent.cookie)
-			paramEvent.NoteID = int32(cParamEvent.note_id)
-			paramEvent.Port = int16(cParamEvent.port_index)
-			paramEvent.Channel = int16(cParamEvent.channel)
-			paramEvent.Key = int16(cParamEvent.key)
-			paramEvent.Value = float64(cParamEvent.value)
-			handler.HandleParamValue(paramEvent, time)
-			p.pool.PutParamValueEvent(paramEvent)
-			
-		case int(TypeParamMod):
-			cParamModEvent := (*C.clap_event_param_mod_t)(unsafe.Pointer(cEventHeader))
-			paramModEvent := p.pool.GetParamModEvent()
-			paramModEvent.ParamID = uint32(cParamModEvent.param_id)
-			paramModEvent.Cookie = unsafe.Pointer(cParamModEvent.cookie)
-			paramModEvent.NoteID = int32(cParamModEvent.note_id)
-			paramModEvent.Port = int16(cParamModEvent.port_index)
-			paramModEvent.Channel = int16(cParamModEvent.channel)
-			paramModEvent.Key = int16(cParamModEvent.key)
-			paramModEvent.Amount = float64(cParamModEvent.amount)
-			handler.HandleParamMod(paramModEvent, time)
-			p.pool.PutParamModEvent(paramModEvent)
-			
-		case int(TypeParamGestureBegin):
-			cGestureEvent := (*C.clap_event_param_gesture_t)(unsafe.Pointer(cEventHeader))
-			gestureEvent := p.pool.GetParamGestureEvent()
-			gestureEvent.ParamID = uint32(cGestureEvent.param_id)
-			handler.HandleParamGestureBegin(gestureEvent, time)
-			p.pool.PutParamGestureEvent(gestureEvent)
-			
-		case int(TypeParamGestureEnd):
-			cGestureEvent := (*C.clap_event_param_gesture_t)(unsafe.Pointer(cEventHeader))
-			gestureEvent := p.pool.GetParamGestureEvent()
-			gestureEvent.ParamID = uint32(cGestureEvent.param_id)
-			handler.HandleParamGestureEnd(gestureEvent, time)
-			p.pool.PutParamGestureEvent(gestureEvent)
-			
-		case int(TypeNoteOn):
-			cNoteEvent := (*C.clap_event_note_t)(unsafe.Pointer(cEventHeader))
-			noteEvent := p.pool.GetNoteEvent()
-			noteEvent.NoteID = int32(cNoteEvent.note_id)
-			noteEvent.Port = int16(cNoteEvent.port_index)
-			noteEvent.Channel = int16(cNoteEvent.channel)
-			noteEvent.Key = int16(cNoteEvent.key)
-			noteEvent.Velocity = float64(cNoteEvent.velocity)
-			handler.HandleNoteOn(noteEvent, time)
-			p.pool.PutNoteEvent(noteEvent)
-			
-		case int(TypeNoteOff):
-			cNoteEvent := (*C.clap_event_note_t)(unsafe.Pointer(cEventHeader))
-			noteEvent := p.pool.GetNoteEvent()
-			noteEvent.NoteID = int32(cNoteEvent.note_id)
-			noteEvent.Port = int16(cNoteEvent.port_index)
-			noteEvent.Channel = int16(cNoteEvent.channel)
-			noteEvent.Key = int16(cNoteEvent.key)
-			noteEvent.Velocity = float64(cNoteEvent.velocity)
-			handler.HandleNoteOff(noteEvent, time)
-			p.pool.PutNoteEvent(noteEvent)
-			
-		case int(TypeNoteChoke):
-			cNoteEvent := (*C.clap_event_note_t)(unsafe.Pointer(cEventHeader))
-			noteEvent := p.pool.GetNoteEvent()
-			noteEvent.NoteID = int32(cNoteEvent.note_id)
-			noteEvent.Port = int16(cNoteEvent.port_index)
-			noteEvent.Channel = int16(cNoteEvent.channel)
-			noteEvent.Key = int16(cNoteEvent.key)
-			noteEvent.Velocity = float64(cNoteEvent.velocity)
-			handler.HandleNoteChoke(noteEvent, time)
-			p.pool.PutNoteEvent(noteEvent)
-			
-		case int(TypeNoteEnd):
-			cNoteEvent := (*C.clap_event_note_t)(unsafe.Pointer(cEventHeader))
-			noteEvent := p.pool.GetNoteEvent()
-			noteEvent.NoteID = int32(cNoteEvent.note_id)
-			noteEvent.Port = int16(cNoteEvent.port_index)
-			noteEvent.Channel = int16(cNoteEvent.channel)
-			noteEvent.Key = int16(cNoteEvent.key)
-			noteEvent.Velocity = float64(cNoteEvent.velocity)
-			handler.HandleNoteEnd(noteEvent, time)
-			p.pool.PutNoteEvent(noteEvent)
-			
-		case int(TypeNoteExpression):
-			cNoteExprEvent := (*C.clap_event_note_expression_t)(unsafe.Pointer(cEventHeader))
-			noteExprEvent := p.pool.GetNoteExpressionEvent()
-			noteExprEvent.ExpressionID = uint32(cNoteExprEvent.expression_id)
-			noteExprEvent.NoteID = int32(cNoteExprEvent.note_id)
-			noteExprEvent.Port = int16(cNoteExprEvent.port_index)
-			noteExprEvent.Channel = int16(cNoteExprEvent.channel)
-			noteExprEvent.Key = int16(cNoteExprEvent.key)
-			noteExprEvent.Value = float64(cNoteExprEvent.value)
-			handler.HandleNoteExpression(noteExprEvent, time)
-			p.pool.PutNoteExpressionEvent(noteExprEvent)
-			
-		case int(TypeTransport):
-			cTransportEvent := (*C.clap_event_transport_t)(unsafe.Pointer(cEventHeader))
-			transportEvent := p.pool.GetTransportEvent()
-			transportEvent.Flags = uint32(cTransportEvent.flags)
-			transportEvent.SongPosBeats = float64(cTransportEvent.song_pos_beats)
-			transportEvent.SongPosSeconds = float64(cTransportEvent.song_pos_seconds)
-			transportEvent.Tempo = float64(cTransportEvent.tempo)
-			transportEvent.TempoInc = float64(cTransportEvent.tempo_inc)
-			transportEvent.LoopStartBeats = float64(cTransportEvent.loop_start_beats)
-			transportEvent.LoopEndBeats = float64(cTransportEvent.loop_end_beats)
-			transportEvent.LoopStartSeconds = float64(cTransportEvent.loop_start_seconds)
-			transportEvent.LoopEndSeconds = float64(cTransportEvent.loop_end_seconds)
-			transportEvent.BarStart = float64(cTransportEvent.bar_start)
-			transportEvent.BarNumber = int32(cTransportEvent.bar_number)
-			transportEvent.TimeSignatureNum = uint16(cTransportEvent.tsig_num)
-			transportEvent.TimeSignatureDenom = uint16(cTransportEvent.tsig_denom)
-			handler.HandleTransport(transportEvent, time)
-			p.pool.PutTransportEvent(transportEvent)
-			
-		case int(TypeMIDI):
-			cMidiEvent := (*C.clap_event_midi_t)(unsafe.Pointer(cEventHeader))
-			midiEvent := p.pool.GetMIDIEvent()
-			midiEvent.Port = uint16(cMidiEvent.port_index)
-			for j := 0; j < 3; j++ {
-				midiEvent.Data[j] = byte(cMidiEvent.data[j])
-			}
-			handler.HandleMIDI(midiEvent, time)
-			p.pool.PutMIDIEvent(midiEvent)
-			
-		case int(TypeMIDISysex):
-			cSysexEvent := (*C.clap_event_midi_sysex_t)(unsafe.Pointer(cEventHeader))
-			sysexEvent := p.pool.GetMIDISysexEvent()
-			sysexEvent.Port = uint16(cSysexEvent.port_index)
-			sysexEvent.Buffer = unsafe.Pointer(cSysexEvent.buffer)
-			sysexEvent.Size = uint32(cSysexEvent.size)
-			handler.HandleMIDISysex(sysexEvent, time)
-			p.pool.PutMIDISysexEvent(sysexEvent)
-			
-		case int(TypeMIDI2):
-			cMidi2Event := (*C.clap_event_midi2_t)(unsafe.Pointer(cEventHeader))
-			midi2Event := p.pool.GetMIDI2Event()
-			midi2Event.Port = uint16(cMidi2Event.port_index)
-			for j := 0; j < 4; j++ {
-				midi2Event.Data[j] = uint32(cMidi2Event.data[j])
-			}
-			handler.HandleMIDI2(midi2Event, time)
-			p.pool.PutMIDI2Event(midi2Event)
-		}
+	for batch := p.Gather(); batch != nil; batch = p.GatherNext() {
+		batch.Dispatch(handler)
 	}
 }
 
@@ -237,11 +135,7 @@ func (p *Processor) PushParamValue(event *ParamValueEvent, time uint32) bool {
 		return false
 	}
 	
-	cEvent := (*C.clap_event_param_value_t)(C.malloc(C.sizeof_clap_event_param_value_t))
-	if cEvent == nil {
-		return false
-	}
-	
+	cEvent := &p.paramScratch
 	cEvent.header.size = C.sizeof_clap_event_param_value_t
 	cEvent.header.time = C.uint32_t(time)
 	cEvent.header.space_id = 0 // CLAP_CORE_EVENT_SPACE_ID
@@ -256,56 +150,33 @@ func (p *Processor) PushParamValue(event *ParamValueEvent, time uint32) bool {
 	cEvent.key = C.int16_t(event.Key)
 	cEvent.value = C.double(event.Value)
 	
-	result := C.clap_output_events_try_push_helper(p.outputEvents, &cEvent.header)
-	C.free(unsafe.Pointer(cEvent))
-	
-	return bool(result)
+	// Plain locals keep cgo's pointer check from heap-allocating a closure
+	events := p.outputEvents
+	header := &cEvent.header
+	return bool(C.clap_output_events_try_push_helper(events, header))
 }
 
 // PushNoteOn pushes a note on event to the output
 func (p *Processor) PushNoteOn(event *NoteEvent, time uint32) bool {
-	if p.outputEvents == nil {
-		return false
-	}
-	
-	cEvent := (*C.clap_event_note_t)(C.malloc(C.sizeof_clap_event_note_t))
-	if cEvent == nil {
-		return false
-	}
-	
-	cEvent.header.size = C.sizeof_clap_event_note_t
-	cEvent.header.time = C.uint32_t(time)
-	cEvent.header.space_id = 0
-	cEvent.header._type = C.uint16_t(TypeNoteOn)
-	cEvent.header.flags = 0
-	
-	cEvent.note_id = C.int32_t(event.NoteID)
-	cEvent.port_index = C.int16_t(event.Port)
-	cEvent.channel = C.int16_t(event.Channel)
-	cEvent.key = C.int16_t(event.Key)
-	cEvent.velocity = C.double(event.Velocity)
-	
-	result := C.clap_output_events_try_push_helper(p.outputEvents, &cEvent.header)
-	C.free(unsafe.Pointer(cEvent))
-	
-	return bool(result)
+	return p.pushNote(event, time, TypeNoteOn)
 }
 
 // PushNoteOff pushes a note off event to the output
 func (p *Processor) PushNoteOff(event *NoteEvent, time uint32) bool {
+	return p.pushNote(event, time, TypeNoteOff)
+}
+
+// pushNote fills the note scratch event and hands it to the host
+func (p *Processor) pushNote(event *NoteEvent, time uint32, eventType uint32) bool {
 	if p.outputEvents == nil {
 		return false
 	}
 	
-	cEvent := (*C.clap_event_note_t)(C.malloc(C.sizeof_clap_event_note_t))
-	if cEvent == nil {
-		return false
-	}
-	
+	cEvent := &p.noteScratch
 	cEvent.header.size = C.sizeof_clap_event_note_t
 	cEvent.header.time = C.uint32_t(time)
 	cEvent.header.space_id = 0
-	cEvent.header._type = C.uint16_t(TypeNoteOff)
+	cEvent.header._type = C.uint16_t(eventType)
 	cEvent.header.flags = 0
 	
 	cEvent.note_id = C.int32_t(event.NoteID)
@@ -314,8 +185,8 @@ func (p *Processor) PushNoteOff(event *NoteEvent, time uint32) bool {
 	cEvent.key = C.int16_t(event.Key)
 	cEvent.velocity = C.double(event.Velocity)
 	
-	result := C.clap_output_events_try_push_helper(p.outputEvents, &cEvent.header)
-	C.free(unsafe.Pointer(cEvent))
-	
-	return bool(result)
-}
\ No newline at end of file
+	// Plain locals keep cgo's pointer check from heap-allocating a closure
+	events := p.outputEvents
+	header := &cEvent.header
+	return bool(C.clap_output_events_try_push_helper(events, header))
+}
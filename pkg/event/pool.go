@@ -2,253 +2,365 @@ package event
 
 import (
 	"fmt"
-	"sync"
 	"sync/atomic"
 	
 	"github.com/justyntemme/clapgo/pkg/host"
 )
 
-// Pool manages pre-allocated events to avoid allocations during audio processing
-type Pool struct {
-	// Separate pools for each event type to avoid interface{} allocations
-	paramValuePool      sync.Pool
-	paramModPool        sync.Pool
-	paramGesturePool    sync.Pool
-	noteEventPool       sync.Pool
-	noteExpressionPool  sync.Pool
-	transportPool       sync.Pool
-	midiPool            sync.Pool
-	midiSysexPool       sync.Pool
-	midi2Pool           sync.Pool
-
-	// Diagnostics
-	totalAllocations  uint64
-	poolHits          uint64
-	poolMisses        uint64
-	highWaterMark     uint64
-	currentAllocated  uint64
-	
-	// Logger for diagnostics
-	logger *host.Logger
+// DefaultMaxEventsPerBlock is the per-type slab capacity used by NewPool
+const DefaultMaxEventsPerBlock = 512
+
+// slab is a fixed-capacity block of events of one type. Slots are handed out
+// in order and all of them are recycled at once when the block ends.
+type slab[T any] struct {
+	items []T
+	next  int
+	peak  int // most slots in use at once during the current block
+
+	// Slots [windowStart, windowEnd) hold the last bulk-decoded window
+	windowStart int
+	windowEnd   int
+
+	// highWaterMark is the largest peak of any block, published by Reset
+	highWaterMark uint64
 }
 
-// NewPool creates a new event pool
-func NewPool() *Pool {
-	p := &Pool{}
+func newSlab[T any](capacity int) slab[T] {
+	return slab[T]{items: make([]T, capacity)}
+}
 
-	// Initialize pools with factory functions
-	p.paramValuePool.New = func() interface{} {
-		atomic.AddUint64(&p.totalAllocations, 1)
-		atomic.AddUint64(&p.poolMisses, 1)
-		return &ParamValueEvent{}
+// get returns a cleared slot, or nil once the slab is exhausted. An overflow
+// is counted as a miss and the caller drops the event; handing out a shared
+// slot instead would let two live events alias the same memory.
+func (s *slab[T]) get(p *Pool) *T {
+	var zero T
+	
+	if s.next < len(s.items) {
+		event := &s.items[s.next]
+		s.next++
+		s.mark()
+		*event = zero
+		p.blockHits++
+		p.blockInUse++
+		return event
 	}
+	
+	p.blockMisses++
+	return nil
+}
 
-	p.paramModPool.New = func() interface{} {
-		atomic.AddUint64(&p.totalAllocations, 1)
-		atomic.AddUint64(&p.poolMisses, 1)
-		return &ParamModEvent{}
+// mark records the slab's fill level for the high-water mark
+func (s *slab[T]) mark() {
+	if s.next > s.peak {
+		s.peak = s.next
 	}
+}
 
-	p.paramGesturePool.New = func() interface{} {
-		atomic.AddUint64(&p.totalAllocations, 1)
-		atomic.AddUint64(&p.poolMisses, 1)
-		return &ParamGestureEvent{}
+// endBlock recycles every slot and publishes the block's peak
+func (s *slab[T]) endBlock() {
+	if peak := uint64(s.peak); peak > atomic.LoadUint64(&s.highWaterMark) {
+		atomic.StoreUint64(&s.highWaterMark, peak)
 	}
+	s.next = 0
+	s.peak = 0
+	s.windowStart = 0
+	s.windowEnd = 0
+}
 
-	p.noteEventPool.New = func() interface{} {
-		atomic.AddUint64(&p.totalAllocations, 1)
-		atomic.AddUint64(&p.poolMisses, 1)
-		return &NoteEvent{}
+// beginWindow starts a new bulk-decode window. The previous window's slots
+// are recycled when nothing was handed out after them; otherwise the window
+// continues behind the newer slots so no live event is overwritten.
+func (s *slab[T]) beginWindow() {
+	if s.next == s.windowEnd {
+		s.next = s.windowStart
 	}
+	s.windowStart = s.next
+	s.windowEnd = s.next
+}
 
-	p.noteExpressionPool.New = func() interface{} {
-		atomic.AddUint64(&p.totalAllocations, 1)
-		atomic.AddUint64(&p.poolMisses, 1)
-		return &NoteExpressionEvent{}
+// take returns the next slot for bulk decoding, or false when the slab is full.
+// Bulk-decoded events belong to the block and are never Put back.
+func (s *slab[T]) take(p *Pool) (*T, bool) {
+	if s.next >= len(s.items) {
+		return nil, false
 	}
+	event := &s.items[s.next]
+	s.next++
+	s.windowEnd = s.next
+	s.mark()
+	p.blockHits++
+	return event, true
+}
 
-	p.transportPool.New = func() interface{} {
-		atomic.AddUint64(&p.totalAllocations, 1)
-		atomic.AddUint64(&p.poolMisses, 1)
-		return &TransportEvent{}
-	}
+// filled returns the slots decoded so far in the current window
+func (s *slab[T]) filled() []T {
+	return s.items[s.windowStart:s.next]
+}
 
-	p.midiPool.New = func() interface{} {
-		atomic.AddUint64(&p.totalAllocations, 1)
-		atomic.AddUint64(&p.poolMisses, 1)
-		return &MIDIEvent{}
-	}
+// Pool manages pre-allocated events to avoid allocations during audio processing.
+// Each event type has its own fixed-capacity slab sized from the maximum number
+// of events expected per block. Events stay valid until the pool is reset at the
+// end of the block. Get never allocates: once a slab is full it returns nil and
+// counts a miss, so callers must handle a nil event.
+//
+// A Pool belongs to one plugin instance and is only touched from the thread
+// running that instance's process call.
+type Pool struct {
+	// Separate slabs for each event type to avoid interface{} boxing
+	paramValues      slab[ParamValueEvent]
+	paramMods        slab[ParamModEvent]
+	paramGestures    slab[ParamGestureEvent]
+	noteEvents       slab[NoteEvent]
+	noteExpressions  slab[NoteExpressionEvent]
+	transports       slab[TransportEvent]
+	midiEvents       slab[MIDIEvent]
+	midiSysexEvents  slab[MIDISysexEvent]
+	midi2Events      slab[MIDI2Event]
+	
+	maxEventsPerBlock int
+	
+	// Per-block counters, plain fields on the audio thread
+	blockHits   uint64
+	blockMisses uint64
+	blockInUse  uint64
+
+	// Diagnostics, published once per block by Reset.
+	// totalAllocations counts every Get, poolMisses counts overflows
+	// and currentAllocated is how many events the last block never Put back.
+	// High-water marks are kept per slab, since the capacity is per type.
+	totalAllocations  uint64
+	poolHits          uint64
+	poolMisses        uint64
+	currentAllocated  uint64
+	
+	// Logger for diagnostics
+	logger *host.Logger
+}
 
-	p.midiSysexPool.New = func() interface{} {
-		atomic.AddUint64(&p.totalAllocations, 1)
-		atomic.AddUint64(&p.poolMisses, 1)
-		return &MIDISysexEvent{}
-	}
+// NewPool creates a new event pool with DefaultMaxEventsPerBlock slots per type
+func NewPool() *Pool {
+	return NewPoolWithCapacity(DefaultMaxEventsPerBlock)
+}
 
-	p.midi2Pool.New = func() interface{} {
-		atomic.AddUint64(&p.totalAllocations, 1)
-		atomic.AddUint64(&p.poolMisses, 1)
-		return &MIDI2Event{}
+// NewPoolWithCapacity creates a new event pool holding up to maxEventsPerBlock
+// events of each type per block. All memory is allocated here.
+func NewPoolWithCapacity(maxEventsPerBlock int) *Pool {
+	if maxEventsPerBlock <= 0 {
+		maxEventsPerBlock = DefaultMaxEventsPerBlock
 	}
+	
+	return &Pool{
+		paramValues:       newSlab[ParamValueEvent](maxEventsPerBlock),
+		paramMods:         newSlab[ParamModEvent](maxEventsPerBlock),
+		paramGestures:     newSlab[ParamGestureEvent](maxEventsPerBlock),
+		noteEvents:        newSlab[NoteEvent](maxEventsPerBlock),
+		noteExpressions:   newSlab[NoteExpressionEvent](maxEventsPerBlock),
+		transports:        newSlab[TransportEvent](maxEventsPerBlock),
+		midiEvents:        newSlab[MIDIEvent](maxEventsPerBlock),
+		midiSysexEvents:   newSlab[MIDISysexEvent](maxEventsPerBlock),
+		midi2Events:       newSlab[MIDI2Event](maxEventsPerBlock),
+		maxEventsPerBlock: maxEventsPerBlock,
+	}
+}
 
-	return p
+// MaxEventsPerBlock returns the per-type slab capacity
+func (p *Pool) MaxEventsPerBlock() int {
+	return p.maxEventsPerBlock
 }
 
-// GetParamValueEvent gets a ParamValueEvent from the pool
-func (p *Pool) GetParamValueEvent() *ParamValueEvent {
-	event := p.paramValuePool.Get().(*ParamValueEvent)
-	atomic.AddUint64(&p.poolHits, 1)
-	atomic.AddUint64(&p.currentAllocated, 1)
+// beginWindow starts a bulk-decode window in every slab
+func (p *Pool) beginWindow() {
+	p.paramValues.beginWindow()
+	p.paramMods.beginWindow()
+	p.paramGestures.beginWindow()
+	p.noteEvents.beginWindow()
+	p.noteExpressions.beginWindow()
+	p.transports.beginWindow()
+	p.midiEvents.beginWindow()
+	p.midiSysexEvents.beginWindow()
+	p.midi2Events.beginWindow()
+}
+
+// Reset recycles every slot at the end of a block and publishes the block's
+// statistics. Events obtained before Reset must not be used afterwards.
+// [audio-thread]
+func (p *Pool) Reset() {
+	p.paramValues.endBlock()
+	p.paramMods.endBlock()
+	p.paramGestures.endBlock()
+	p.noteEvents.endBlock()
+	p.noteExpressions.endBlock()
+	p.transports.endBlock()
+	p.midiEvents.endBlock()
+	p.midiSysexEvents.endBlock()
+	p.midi2Events.endBlock()
 	
-	// Update high water mark
-	current := atomic.LoadUint64(&p.currentAllocated)
-	for {
-		high := atomic.LoadUint64(&p.highWaterMark)
-		if current <= high || atomic.CompareAndSwapUint64(&p.highWaterMark, high, current) {
-			break
-		}
+	if gets := p.blockHits + p.blockMisses; gets > 0 {
+		atomic.AddUint64(&p.totalAllocations, gets)
+		atomic.AddUint64(&p.poolHits, p.blockHits)
+		atomic.AddUint64(&p.poolMisses, p.blockMisses)
 	}
 	
-	return event
+	// Events still outstanding at the end of a block were never Put back
+	atomic.StoreUint64(&p.currentAllocated, p.blockInUse)
+	
+	p.blockHits = 0
+	p.blockMisses = 0
+	p.blockInUse = 0
+}
+
+// release marks one event as no longer in use. The slot itself is only
+// recycled by Reset, so events handed out earlier in the block stay valid.
+func (p *Pool) release() {
+	if p.blockInUse > 0 {
+		p.blockInUse--
+	}
+}
+
+// GetParamValueEvent gets a ParamValueEvent from the pool, or nil when this
+// block has already used every ParamValueEvent slot
+func (p *Pool) GetParamValueEvent() *ParamValueEvent {
+	return p.paramValues.get(p)
 }
 
 // PutParamValueEvent returns a ParamValueEvent to the pool
 func (p *Pool) PutParamValueEvent(event *ParamValueEvent) {
-	// Clear the event before returning to pool
-	*event = ParamValueEvent{}
-	p.paramValuePool.Put(event)
-	atomic.AddUint64(&p.currentAllocated, ^uint64(0)) // Decrement
+	p.release()
 }
 
-// GetParamModEvent gets a ParamModEvent from the pool
+// GetParamModEvent gets a ParamModEvent from the pool, or nil when this
+// block has already used every ParamModEvent slot
 func (p *Pool) GetParamModEvent() *ParamModEvent {
-	event := p.paramModPool.Get().(*ParamModEvent)
-	atomic.AddUint64(&p.poolHits, 1)
-	atomic.AddUint64(&p.currentAllocated, 1)
-	return event
+	return p.paramMods.get(p)
 }
 
 // PutParamModEvent returns a ParamModEvent to the pool
 func (p *Pool) PutParamModEvent(event *ParamModEvent) {
-	*event = ParamModEvent{}
-	p.paramModPool.Put(event)
-	atomic.AddUint64(&p.currentAllocated, ^uint64(0))
+	p.release()
 }
 
-// GetParamGestureEvent gets a ParamGestureEvent from the pool
+// GetParamGestureEvent gets a ParamGestureEvent from the pool, or nil when this
+// block has already used every ParamGestureEvent slot
 func (p *Pool) GetParamGestureEvent() *ParamGestureEvent {
-	event := p.paramGesturePool.Get().(*ParamGestureEvent)
-	atomic.AddUint64(&p.poolHits, 1)
-	atomic.AddUint64(&p.currentAllocated, 1)
-	return event
+	return p.paramGestures.get(p)
 }
 
 // PutParamGestureEvent returns a ParamGestureEvent to the pool
 func (p *Pool) PutParamGestureEvent(event *ParamGestureEvent) {
-	*event = ParamGestureEvent{}
-	p.paramGesturePool.Put(event)
-	atomic.AddUint64(&p.currentAllocated, ^uint64(0))
+	p.release()
 }
 
-// GetNoteEvent gets a NoteEvent from the pool
+// GetNoteEvent gets a NoteEvent from the pool, or nil when this
+// block has already used every NoteEvent slot
 func (p *Pool) GetNoteEvent() *NoteEvent {
-	event := p.noteEventPool.Get().(*NoteEvent)
-	atomic.AddUint64(&p.poolHits, 1)
-	atomic.AddUint64(&p.currentAllocated, 1)
-	return event
+	return p.noteEvents.get(p)
 }
 
 // PutNoteEvent returns a NoteEvent to the pool
 func (p *Pool) PutNoteEvent(event *NoteEvent) {
-	*event = NoteEvent{}
-	p.noteEventPool.Put(event)
-	atomic.AddUint64(&p.currentAllocated, ^uint64(0))
+	p.release()
 }
 
-// GetNoteExpressionEvent gets a NoteExpressionEvent from the pool
+// GetNoteExpressionEvent gets a NoteExpressionEvent from the pool, or nil when this
+// block has already used every NoteExpressionEvent slot
 func (p *Pool) GetNoteExpressionEvent() *NoteExpressionEvent {
-	event := p.noteExpressionPool.Get().(*NoteExpressionEvent)
-	atomic.AddUint64(&p.poolHits, 1)
-	atomic.AddUint64(&p.currentAllocated, 1)
-	return event
+	return p.noteExpressions.get(p)
 }
 
 // PutNoteExpressionEvent returns a NoteExpressionEvent to the pool
 func (p *Pool) PutNoteExpressionEvent(event *NoteExpressionEvent) {
-	*event = NoteExpressionEvent{}
-	p.noteExpressionPool.Put(event)
-	atomic.AddUint64(&p.currentAllocated, ^uint64(0))
+	p.release()
 }
 
-// GetTransportEvent gets a TransportEvent from the pool
+// GetTransportEvent gets a TransportEvent from the pool, or nil when this
+// block has already used every TransportEvent slot
 func (p *Pool) GetTransportEvent() *TransportEvent {
-	event := p.transportPool.Get().(*TransportEvent)
-	atomic.AddUint64(&p.poolHits, 1)
-	atomic.AddUint64(&p.currentAllocated, 1)
-	return event
+	return p.transports.get(p)
 }
 
 // PutTransportEvent returns a TransportEvent to the pool
 func (p *Pool) PutTransportEvent(event *TransportEvent) {
-	*event = TransportEvent{}
-	p.transportPool.Put(event)
-	atomic.AddUint64(&p.currentAllocated, ^uint64(0))
+	p.release()
 }
 
-// GetMIDIEvent gets a MIDIEvent from the pool
+// GetMIDIEvent gets a MIDIEvent from the pool, or nil when this
+// block has already used every MIDIEvent slot
 func (p *Pool) GetMIDIEvent() *MIDIEvent {
-	event := p.midiPool.Get().(*MIDIEvent)
-	atomic.AddUint64(&p.poolHits, 1)
-	atomic.AddUint64(&p.currentAllocated, 1)
-	return event
+	return p.midiEvents.get(p)
 }
 
 // PutMIDIEvent returns a MIDIEvent to the pool
 func (p *Pool) PutMIDIEvent(event *MIDIEvent) {
-	*event = MIDIEvent{}
-	p.midiPool.Put(event)
-	atomic.AddUint64(&p.currentAllocated, ^uint64(0))
+	p.release()
 }
 
-// GetMIDISysexEvent gets a MIDISysexEvent from the pool
+// GetMIDISysexEvent gets a MIDISysexEvent from the pool, or nil when this
+// block has already used every MIDISysexEvent slot
 func (p *Pool) GetMIDISysexEvent() *MIDISysexEvent {
-	event := p.midiSysexPool.Get().(*MIDISysexEvent)
-	atomic.AddUint64(&p.poolHits, 1)
-	atomic.AddUint64(&p.currentAllocated, 1)
-	return event
+	return p.midiSysexEvents.get(p)
 }
 
 // PutMIDISysexEvent returns a MIDISysexEvent to the pool
 func (p *Pool) PutMIDISysexEvent(event *MIDISysexEvent) {
-	*event = MIDISysexEvent{}
-	p.midiSysexPool.Put(event)
-	atomic.AddUint64(&p.currentAllocated, ^uint64(0))
+	p.release()
 }
 
-// GetMIDI2Event gets a MIDI2Event from the pool
+// GetMIDI2Event gets a MIDI2Event from the pool, or nil when this
+// block has already used every MIDI2Event slot
 func (p *Pool) GetMIDI2Event() *MIDI2Event {
-	event := p.midi2Pool.Get().(*MIDI2Event)
-	atomic.AddUint64(&p.poolHits, 1)
-	atomic.AddUint64(&p.currentAllocated, 1)
-	return event
+	return p.midi2Events.get(p)
 }
 
 // PutMIDI2Event returns a MIDI2Event to the pool
 func (p *Pool) PutMIDI2Event(event *MIDI2Event) {
-	*event = MIDI2Event{}
-	p.midi2Pool.Put(event)
-	atomic.AddUint64(&p.currentAllocated, ^uint64(0))
+	p.release()
 }
 
-// GetDiagnostics returns pool diagnostics
+// GetDiagnostics returns pool diagnostics as of the last Reset. highWaterMark
+// is the fullest any single slab has been in one block, so it compares
+// directly against MaxEventsPerBlock.
 func (p *Pool) GetDiagnostics() (totalAllocations, poolHits, poolMisses, highWaterMark, currentAllocated uint64) {
 	return atomic.LoadUint64(&p.totalAllocations),
 		atomic.LoadUint64(&p.poolHits),
 		atomic.LoadUint64(&p.poolMisses),
-		atomic.LoadUint64(&p.highWaterMark),
+		p.HighWaterMarks().Max(),
 		atomic.LoadUint64(&p.currentAllocated)
 }
 
+// HighWaterMarks returns each event type's high-water mark as of the last Reset
+func (p *Pool) HighWaterMarks() SlabHighWaterMarks {
+	return SlabHighWaterMarks{
+		ParamValues:     atomic.LoadUint64(&p.paramValues.highWaterMark),
+		ParamMods:       atomic.LoadUint64(&p.paramMods.highWaterMark),
+		ParamGestures:   atomic.LoadUint64(&p.paramGestures.highWaterMark),
+		Notes:           atomic.LoadUint64(&p.noteEvents.highWaterMark),
+		NoteExpressions: atomic.LoadUint64(&p.noteExpressions.highWaterMark),
+		Transports:      atomic.LoadUint64(&p.transports.highWaterMark),
+		MIDI:            atomic.LoadUint64(&p.midiEvents.highWaterMark),
+		MIDISysex:       atomic.LoadUint64(&p.midiSysexEvents.highWaterMark),
+		MIDI2:           atomic.LoadUint64(&p.midi2Events.highWaterMark),
+	}
+}
+
+// SlabHighWaterMarks holds the most events of each type used in one block
+type SlabHighWaterMarks struct {
+	ParamValues     uint64
+	ParamMods       uint64
+	ParamGestures   uint64
+	Notes           uint64
+	NoteExpressions uint64
+	Transports      uint64
+	MIDI            uint64
+	MIDISysex       uint64
+	MIDI2           uint64
+}
+
+// Max returns the fullest slab's high-water mark
+func (m SlabHighWaterMarks) Max() uint64 {
+	return max(m.ParamValues, m.ParamMods, m.ParamGestures, m.Notes, m.NoteExpressions,
+		m.Transports, m.MIDI, m.MIDISysex, m.MIDI2)
+}
+
 // SetLogger sets the logger for pool diagnostics
 func (p *Pool) SetLogger(logger *host.Logger) {
 	p.logger = logger
@@ -266,6 +378,6 @@ func (p *Pool) LogDiagnostics() {
 		hitRate = float64(poolHits) / float64(totalAllocations) * 100
 	}
 	
-	p.logger.Debug(fmt.Sprintf("Event Pool Diagnostics: Total=%d Hits=%d Misses=%d HitRate=%.1f%% HighWaterMark=%d Current=%d",
-		totalAllocations, poolHits, poolMisses, hitRate, highWaterMark, currentAllocated))
-}
\ No newline at end of file
+	p.logger.Debug(fmt.Sprintf("Event Pool Diagnostics: Total=%d Hits=%d Overflows=%d HitRate=%.1f%% BlockHighWaterMark=%d/%d Current=%d",
+		totalAllocations, poolHits, poolMisses, hitRate, highWaterMark, p.maxEventsPerBlock, currentAllocated))
+}
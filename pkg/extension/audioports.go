@@ -7,8 +7,11 @@ type AudioPortsActivationProvider interface {
 	// activation/deactivation while processing.
 	CanActivateWhileProcessing() bool
 
-	// SetActive activates or deactivates the given port.
-	SetActive(portIndex uint32, isInput bool, isActive bool) bool
+	// SetActive activates or deactivates the given port. sampleSize is the
+	// precision the host will process the port at, 32 or 64, or 0 when
+	// it did not say; plugins with a 64-bit path can prepare for it here
+	// instead of on the first block.
+	SetActive(portIndex uint32, isInput bool, isActive bool, sampleSize uint32) bool
 }
 
 // ConfigurableAudioPortsProvider is an extension for plugins with configurable audio ports.
@@ -14,6 +14,7 @@ type ExtensionBundle struct {
 	TrackInfo        *hostpkg.TrackInfoProvider
 	TransportControl *hostpkg.TransportControl
 	Tuning          *HostTuning
+	TuningCache     *TuningCache
 	Logger          *hostpkg.Logger
 	
 	// Internal state
@@ -40,6 +41,7 @@ func NewExtensionBundle(host unsafe.Pointer, pluginName string) *ExtensionBundle
 	bundle.TrackInfo = hostpkg.NewTrackInfoProvider(host)
 	bundle.TransportControl = hostpkg.NewTransportControl(host)
 	bundle.Tuning = NewHostTuning(host)
+	bundle.TuningCache = NewTuningCache(bundle.Tuning)
 	
 	// Log initialization status
 	bundle.logInitStatus()
@@ -174,12 +176,34 @@ func (b *ExtensionBundle) GetTrackInfo() (*hostpkg.TrackInfo, bool) {
 	return b.TrackInfo.Get()
 }
 
-// ApplyTuning applies tuning to a frequency if tuning support is available
+// ApplyTuning applies tuning to a frequency if tuning support is available.
+// Static tunings are read from TuningCache without calling the host.
+// [audio-thread]
 func (b *ExtensionBundle) ApplyTuning(baseFreq float64, tuningID int64, channel, key int32, keyboardMapping int16) float64 {
-	if b.Tuning == nil || tuningID == 0 {
+	if b.TuningCache == nil || tuningID == 0 {
 		return baseFreq
 	}
-	return b.Tuning.ApplyTuning(baseFreq, uint64(tuningID), channel, key, uint32(keyboardMapping))
+	return b.TuningCache.Frequency(baseFreq, uint64(tuningID), channel, key, uint32(keyboardMapping))
+}
+
+// EnableTuning builds the tuning cache for a plugin that tunes notes. Call
+// it from Init; snapshotting a static tuning takes a host query per MIDI
+// channel and key, which plugins that never call ApplyTuning should not
+// pay for. Until it or RefreshTuning runs, ApplyTuning queries the host.
+// [main-thread]
+func (b *ExtensionBundle) EnableTuning() {
+	if b.TuningCache != nil {
+		b.TuningCache.EnsureRefreshed()
+	}
+}
+
+// RefreshTuning snapshots the host's tuning pool again. Call it from the
+// plugin's tuning changed callback.
+// [main-thread]
+func (b *ExtensionBundle) RefreshTuning() {
+	if b.TuningCache != nil {
+		b.TuningCache.Refresh()
+	}
 }
 
 // GetAvailableTunings returns all available tunings
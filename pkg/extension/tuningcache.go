@@ -0,0 +1,122 @@
+package extension
+
+import (
+	"math"
+	"sync/atomic"
+)
+
+// Cached range of a tuning: the 16 MIDI channels by the 128 MIDI keys
+const (
+	tuningChannels = 16
+	tuningKeys     = 128
+)
+
+// TuningCache keeps the host's tunings as frequency ratios so the audio
+// thread can tune notes without a cgo call per voice and block. Refresh
+// rebuilds it on the main thread, from clapgo_tuning_changed and when a
+// plugin opts in to tuning, and publishes the result atomically; lookups
+// never lock or allocate. Until the first refresh every lookup goes to the
+// host, so plugins that never tune notes never pay for building it.
+//
+// Tunings the host flags as dynamic may change at any sample, so they are
+// not cached. Lookups for them, for IDs the last refresh did not see and
+// for notes outside the MIDI range go to the host.
+type TuningCache struct {
+	tuning    *HostTuning
+	snapshot  atomic.Pointer[tuningSnapshot]
+	refreshed bool // main thread only
+}
+
+// tuningSnapshot is immutable once published
+type tuningSnapshot struct {
+	tunings []cachedTuning
+	dynamic bool // whether any tuning in the pool is dynamic
+}
+
+type cachedTuning struct {
+	id      uint64
+	dynamic bool
+	ratios  *[tuningChannels][tuningKeys]float64 // nil when dynamic
+}
+
+// NewTuningCache creates an empty cache over the host's tuning extension.
+// Call Refresh or EnsureRefreshed before use.
+func NewTuningCache(tuning *HostTuning) *TuningCache {
+	c := &TuningCache{tuning: tuning}
+	c.snapshot.Store(&tuningSnapshot{})
+	return c
+}
+
+// Refresh snapshots every tuning in the host's pool. It costs one host
+// query per channel and key of each static tuning, so call it when the
+// pool changes, not per block.
+// [main-thread]
+func (c *TuningCache) Refresh() {
+	snapshot := &tuningSnapshot{}
+	for _, info := range c.tuning.GetAllTunings() {
+		cached := cachedTuning{id: info.TuningID, dynamic: info.IsDynamic}
+		if info.IsDynamic {
+			snapshot.dynamic = true
+		} else {
+			cached.ratios = new([tuningChannels][tuningKeys]float64)
+			for channel := range cached.ratios {
+				for key := range cached.ratios[channel] {
+					semitones := c.tuning.GetRelativeTuning(info.TuningID, int32(channel), int32(key), 0)
+					cached.ratios[channel][key] = math.Exp2(semitones / 12.0)
+				}
+			}
+		}
+		snapshot.tunings = append(snapshot.tunings, cached)
+	}
+	c.snapshot.Store(snapshot)
+	c.refreshed = true
+}
+
+// EnsureRefreshed refreshes the cache unless it has been refreshed already
+// [main-thread]
+func (c *TuningCache) EnsureRefreshed() {
+	if !c.refreshed {
+		c.Refresh()
+	}
+}
+
+// find returns the cached tuning for id, or nil. Pools hold a handful of
+// tunings, so a scan beats hashing.
+func (s *tuningSnapshot) find(id uint64) *cachedTuning {
+	for i := range s.tunings {
+		if s.tunings[i].id == id {
+			return &s.tunings[i]
+		}
+	}
+	return nil
+}
+
+// Frequency tunes an equal temperament frequency. Static tunings come from
+// the cache whatever the sample offset; dynamic ones are queried at it.
+// [audio-thread]
+func (c *TuningCache) Frequency(baseFreq float64, tuningID uint64, channel, key int32, sampleOffset uint32) float64 {
+	if tuningID == 0 {
+		return baseFreq
+	}
+	cached := c.snapshot.Load().find(tuningID)
+	if cached != nil && cached.ratios != nil &&
+		uint32(channel) < tuningChannels && uint32(key) < tuningKeys {
+		return baseFreq * cached.ratios[channel][key]
+	}
+	semitones := c.tuning.GetRelativeTuning(tuningID, channel, key, sampleOffset)
+	return baseFreq * math.Exp2(semitones/12.0)
+}
+
+// IsDynamic reports whether the host flags a tuning as changing over time.
+// Only then is it worth calling Frequency at more than one offset per block.
+// [audio-thread]
+func (c *TuningCache) IsDynamic(tuningID uint64) bool {
+	cached := c.snapshot.Load().find(tuningID)
+	return cached != nil && cached.dynamic
+}
+
+// HasDynamic reports whether any tuning in the pool is dynamic
+// [audio-thread]
+func (c *TuningCache) HasDynamic() bool {
+	return c.snapshot.Load().dynamic
+}
@@ -0,0 +1,36 @@
+package host_test
+
+import (
+	"testing"
+
+	hostpkg "github.com/justyntemme/clapgo/pkg/host"
+)
+
+func BenchmarkLogRing(b *testing.B) {
+	ring := hostpkg.NewLogRing(nil, hostpkg.DefaultLogRingSize, nil)
+	format := ring.Register(hostpkg.SeverityInfo, "value %d is %.3f")
+
+	b.ReportAllocs()
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		ring.Log(format, hostpkg.IntArg(int64(i)), hostpkg.FloatArg(0.5))
+		if i%128 == 127 {
+			// Drained outside the timer, as the main thread would
+			b.StopTimer()
+			ring.Flush()
+			b.StartTimer()
+		}
+	}
+}
+
+func TestLogRingAllocs(t *testing.T) {
+	ring := hostpkg.NewLogRing(nil, hostpkg.DefaultLogRingSize, nil)
+	format := ring.Register(hostpkg.SeverityInfo, "value %d is %.3f")
+
+	allocs := testing.AllocsPerRun(100, func() {
+		ring.Log(format, hostpkg.IntArg(1), hostpkg.FloatArg(0.5))
+	})
+	if allocs != 0 {
+		t.Errorf("Log: %.1f allocs per run, want 0", allocs)
+	}
+}
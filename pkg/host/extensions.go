@@ -4,6 +4,13 @@ package host
 // #include "../../include/clap/include/clap/ext/draft/transport-control.h"
 // #include <stdlib.h>
 //
+// // Main-thread callback request; part of clap_host_t itself, thread-safe
+// static void clap_host_request_callback_helper(const clap_host_t* host) {
+//     if (host && host->request_callback) {
+//         host->request_callback(host);
+//     }
+// }
+//
 // // Timer support helpers
 // static bool clap_host_register_timer_helper(const clap_host_t* host, uint32_t period_ms, clap_id* timer_id) {
 //     if (host && host->get_extension) {
@@ -183,6 +190,16 @@ import (
 // InvalidID represents an invalid ID value
 const InvalidID = ^uint64(0)
 
+// RequestCallback asks the host to call the plugin's on_main_thread.
+// It may be called from any thread, including the audio thread.
+func RequestCallback(host unsafe.Pointer) {
+	if host == nil {
+		return
+	}
+	
+	C.clap_host_request_callback_helper((*C.clap_host_t)(host))
+}
+
 // TimerSupport provides timer functionality from the host
 type TimerSupport struct {
 	host unsafe.Pointer
@@ -0,0 +1,198 @@
+package host
+
+import (
+	"fmt"
+	"math"
+	"sync/atomic"
+)
+
+// DefaultLogRingSize is the number of records a LogRing holds when no size
+// is given
+const DefaultLogRingSize = 256
+
+// LogRingArgs is the number of numeric arguments a record carries
+const LogRingArgs = 4
+
+// LogFormat identifies a message format registered with a LogRing
+type LogFormat uint32
+
+// LogArg is one numeric argument of a ring record. Build it with IntArg or
+// FloatArg; it holds no pointers, so passing it costs no allocation.
+type LogArg struct {
+	bits    uint64
+	isFloat bool
+}
+
+// IntArg wraps an integer log argument; format it with %d
+func IntArg(v int64) LogArg {
+	return LogArg{bits: uint64(v)}
+}
+
+// FloatArg wraps a floating point log argument; format it with %f, %g, ...
+func FloatArg(v float64) LogArg {
+	return LogArg{bits: math.Float64bits(v), isFloat: true}
+}
+
+type logFormat struct {
+	severity int32
+	format   string
+}
+
+type logRecord struct {
+	format    LogFormat
+	argc      uint8
+	floatMask uint8 // bit i set when args[i] holds float64 bits
+	args      [LogRingArgs]uint64
+}
+
+// LogRing lets the audio thread log without formatting, allocating or
+// calling the host. Messages are registered up front as formats; the audio
+// thread writes a fixed-size record holding the format ID and up to
+// LogRingArgs numbers, and the main thread formats the records and forwards
+// them to the Logger when it flushes.
+//
+// The ring is single-producer, single-consumer: Log is wait-free and may be
+// called from one thread at a time (the audio thread), Register and Flush
+// belong to the main thread. Records that do not fit are dropped and
+// counted, and the next flush reports how many were lost.
+type LogRing struct {
+	logger  *Logger
+	formats []logFormat // main thread only
+
+	records []logRecord
+	mask    uint32
+
+	tail atomic.Uint32 // written by the producer
+	_    [60]byte
+	head atomic.Uint32 // written by the consumer
+	_    [60]byte
+
+	dropped         atomic.Uint64
+	reported        uint64 // consumer only: drops already reported
+	requested       atomic.Bool
+	requestCallback func()
+}
+
+// NewLogRing creates a ring of at least size records, DefaultLogRingSize
+// when size is not positive. logger may be nil, in which case flushed
+// records are discarded. requestCallback asks the host for a main-thread
+// callback and may be nil, leaving flushing to a timer.
+func NewLogRing(logger *Logger, size int, requestCallback func()) *LogRing {
+	if size <= 0 {
+		size = DefaultLogRingSize
+	}
+	capacity := uint32(1)
+	for capacity < uint32(size) {
+		capacity <<= 1
+	}
+	return &LogRing{
+		logger:          logger,
+		records:         make([]logRecord, capacity),
+		mask:            capacity - 1,
+		requestCallback: requestCallback,
+	}
+}
+
+// Register adds a message format and returns its ID. The format takes the
+// record's arguments in order, %d for IntArg and a float verb for FloatArg.
+// Call it from the main thread, typically in init.
+func (r *LogRing) Register(severity int32, format string) LogFormat {
+	if r == nil {
+		return 0
+	}
+	r.formats = append(r.formats, logFormat{severity: severity, format: format})
+	return LogFormat(len(r.formats) - 1)
+}
+
+// Log appends a record without blocking; arguments past LogRingArgs are
+// ignored. It returns false and counts a drop when the ring is full. The
+// first record after a flush asks the host for a main-thread callback.
+func (r *LogRing) Log(format LogFormat, args ...LogArg) bool {
+	if r == nil {
+		return false
+	}
+
+	tail := r.tail.Load()
+	if tail-r.head.Load() > r.mask {
+		r.dropped.Add(1)
+		return false
+	}
+
+	record := &r.records[tail&r.mask]
+	record.format = format
+	record.floatMask = 0
+	n := len(args)
+	if n > LogRingArgs {
+		n = LogRingArgs
+	}
+	record.argc = uint8(n)
+	for i := 0; i < n; i++ {
+		record.args[i] = args[i].bits
+		if args[i].isFloat {
+			record.floatMask |= 1 << i
+		}
+	}
+	r.tail.Store(tail + 1)
+
+	if r.requestCallback != nil && !r.requested.Swap(true) {
+		r.requestCallback()
+	}
+	return true
+}
+
+// Dropped returns the total number of records lost to a full ring
+func (r *LogRing) Dropped() uint64 {
+	if r == nil {
+		return 0
+	}
+	return r.dropped.Load()
+}
+
+// Pending reports whether records are waiting to be flushed
+func (r *LogRing) Pending() bool {
+	return r != nil && r.head.Load() != r.tail.Load()
+}
+
+// Flush formats every pending record and sends it to the logger, then
+// reports any records dropped since the last flush as a warning. It returns
+// the number of records read. Main thread only: call it from on_main_thread
+// or a timer.
+func (r *LogRing) Flush() int {
+	if r == nil {
+		return 0
+	}
+	// Re-arm first so records logged while flushing request a new callback
+	r.requested.Store(false)
+
+	count := 0
+	var args [LogRingArgs]interface{}
+	head := r.head.Load()
+	for tail := r.tail.Load(); head != tail; head++ {
+		record := r.records[head&r.mask]
+		r.head.Store(head + 1)
+		count++
+
+		if r.logger == nil {
+			continue
+		}
+		if int(record.format) >= len(r.formats) {
+			r.logger.Warningf("log ring: unknown format %d", record.format)
+			continue
+		}
+		for i := 0; i < int(record.argc); i++ {
+			if record.floatMask&(1<<i) != 0 {
+				args[i] = math.Float64frombits(record.args[i])
+			} else {
+				args[i] = int64(record.args[i])
+			}
+		}
+		f := r.formats[record.format]
+		r.logger.log(f.severity, fmt.Sprintf(f.format, args[:record.argc]...))
+	}
+
+	if dropped := r.dropped.Load(); dropped != r.reported {
+		r.logger.Warningf("log ring overflowed: %d records dropped", dropped-r.reported)
+		r.reported = dropped
+	}
+	return count
+}
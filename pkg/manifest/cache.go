@@ -0,0 +1,195 @@
+package manifest
+
+import (
+	"bytes"
+	"encoding/binary"
+	"encoding/json"
+	"fmt"
+	"hash/fnv"
+	"os"
+	"strings"
+)
+
+// CacheExtension is appended to a manifest's base name to name its cache:
+// gain.json is cached as gain.manifest.bin
+const CacheExtension = ".manifest.bin"
+
+// Cache format constants, matching src/c/manifest_cache.h
+const (
+	cacheMagic     = "CLGOMFC\x00"
+	cacheVersion   = 1
+	cacheByteOrder = 0x01020304
+)
+
+// cacheHeader mirrors clapgo_manifest_cache_header_t
+type cacheHeader struct {
+	Magic          [8]byte
+	Version        uint32
+	ByteOrder      uint32
+	HeaderSize     uint32
+	EntrySize      uint32
+	EntryCount     uint32
+	EntriesOffset  uint32
+	FeatureCount   uint32
+	FeaturesOffset uint32
+	StringsOffset  uint32
+	StringsSize    uint32
+	SourceSize     uint64
+	SourceMtimeNs  int64
+	SourceHash     uint64
+}
+
+// cacheEntry mirrors clapgo_manifest_cache_entry_t
+type cacheEntry struct {
+	ID            uint32
+	Name          uint32
+	Vendor        uint32
+	Version       uint32
+	Description   uint32
+	URL           uint32
+	ManualURL     uint32
+	SupportURL    uint32
+	FeaturesIndex uint32
+	FeaturesCount uint32
+}
+
+// stringTable interns NUL-terminated strings. Offset 0 is the empty string.
+type stringTable struct {
+	data    []byte
+	offsets map[string]uint32
+}
+
+func newStringTable() *stringTable {
+	return &stringTable{data: []byte{0}, offsets: map[string]uint32{"": 0}}
+}
+
+func (t *stringTable) add(s string) (uint32, error) {
+	if strings.IndexByte(s, 0) >= 0 {
+		return 0, fmt.Errorf("string %q contains a NUL byte", s)
+	}
+	if offset, ok := t.offsets[s]; ok {
+		return offset, nil
+	}
+	offset := uint32(len(t.data))
+	t.data = append(t.data, s...)
+	t.data = append(t.data, 0)
+	t.offsets[s] = offset
+	return offset, nil
+}
+
+// CachePath returns the cache path for the manifest at jsonPath
+func CachePath(jsonPath string) string {
+	return strings.TrimSuffix(jsonPath, ".json") + CacheExtension
+}
+
+// EncodeCache compiles the manifest's plugins into the binary cache format,
+// stamped with the JSON source it was compiled from: its contents and, when
+// known, its modification time (0 otherwise).
+func EncodeCache(m *Manifest, source []byte, sourceMtimeNs int64) ([]byte, error) {
+	plugins := m.AllPlugins()
+	if len(plugins) == 0 {
+		return nil, fmt.Errorf("manifest describes no plugins")
+	}
+
+	table := newStringTable()
+	entries := make([]cacheEntry, len(plugins))
+	var features []uint32
+
+	for i, p := range plugins {
+		if p.ID == "" || p.Name == "" || p.Vendor == "" || p.Version == "" {
+			return nil, fmt.Errorf("plugin %d: missing id, name, vendor or version", i)
+		}
+		fields := []struct {
+			dst *uint32
+			s   string
+		}{
+			{&entries[i].ID, p.ID},
+			{&entries[i].Name, p.Name},
+			{&entries[i].Vendor, p.Vendor},
+			{&entries[i].Version, p.Version},
+			{&entries[i].Description, p.Description},
+			{&entries[i].URL, p.URL},
+			{&entries[i].ManualURL, p.ManualURL},
+			{&entries[i].SupportURL, p.SupportURL},
+		}
+		for _, f := range fields {
+			offset, err := table.add(f.s)
+			if err != nil {
+				return nil, fmt.Errorf("plugin %s: %w", p.ID, err)
+			}
+			*f.dst = offset
+		}
+
+		entries[i].FeaturesIndex = uint32(len(features))
+		for _, feature := range p.Features {
+			offset, err := table.add(feature)
+			if err != nil {
+				return nil, fmt.Errorf("plugin %s: %w", p.ID, err)
+			}
+			features = append(features, offset)
+		}
+		entries[i].FeaturesCount = uint32(len(p.Features))
+	}
+
+	headerSize := uint32(binary.Size(cacheHeader{}))
+	entrySize := uint32(binary.Size(cacheEntry{}))
+	hash := fnv.New64a()
+	hash.Write(source)
+
+	header := cacheHeader{
+		Version:        cacheVersion,
+		ByteOrder:      cacheByteOrder,
+		HeaderSize:     headerSize,
+		EntrySize:      entrySize,
+		EntryCount:     uint32(len(entries)),
+		EntriesOffset:  headerSize,
+		FeatureCount:   uint32(len(features)),
+		FeaturesOffset: headerSize + entrySize*uint32(len(entries)),
+		StringsSize:    uint32(len(table.data)),
+		SourceSize:     uint64(len(source)),
+		SourceMtimeNs:  sourceMtimeNs,
+		SourceHash:     hash.Sum64(),
+	}
+	copy(header.Magic[:], cacheMagic)
+	header.StringsOffset = header.FeaturesOffset + 4*header.FeatureCount
+
+	var buf bytes.Buffer
+	for _, part := range []interface{}{header, entries, features} {
+		if err := binary.Write(&buf, binary.LittleEndian, part); err != nil {
+			return nil, err
+		}
+	}
+	buf.Write(table.data)
+	return buf.Bytes(), nil
+}
+
+// CompileCache reads the JSON manifest at jsonPath and writes its cache to
+// cachePath, or next to it when cachePath is empty. It returns the path
+// written.
+func CompileCache(jsonPath, cachePath string) (string, error) {
+	source, err := os.ReadFile(jsonPath)
+	if err != nil {
+		return "", fmt.Errorf("error reading manifest file: %w", err)
+	}
+	info, err := os.Stat(jsonPath)
+	if err != nil {
+		return "", fmt.Errorf("error reading manifest file: %w", err)
+	}
+
+	var m Manifest
+	if err := json.Unmarshal(source, &m); err != nil {
+		return "", fmt.Errorf("error parsing manifest file: %w", err)
+	}
+	data, err := EncodeCache(&m, source, info.ModTime().UnixNano())
+	if err != nil {
+		return "", fmt.Errorf("error compiling manifest %s: %w", jsonPath, err)
+	}
+
+	if cachePath == "" {
+		cachePath = CachePath(jsonPath)
+	}
+	if err := os.WriteFile(cachePath, data, 0644); err != nil {
+		return "", fmt.Errorf("error writing manifest cache: %w", err)
+	}
+	return cachePath, nil
+}
@@ -6,6 +6,7 @@ package manifest
 type Manifest struct {
 	SchemaVersion string       `json:"schemaVersion"`
 	Plugin        PluginInfo   `json:"plugin"`
+	Plugins       []PluginInfo `json:"plugins,omitempty"` // further plugins in a bundle
 	Build         BuildInfo    `json:"build"`
 	Extensions    []Extension  `json:"extensions,omitempty"`
 	Parameters    []Parameter  `json:"parameters,omitempty"`
@@ -45,4 +46,14 @@ type Parameter struct {
 	MaxValue     float64   `json:"maxValue"`
 	DefaultValue float64   `json:"defaultValue"`
 	Flags        []string  `json:"flags,omitempty"`
-}
\ No newline at end of file
+}
+
+// AllPlugins returns every plugin the manifest describes, in the order the
+// bridge registers them: Plugin, when set, then Plugins.
+func (m *Manifest) AllPlugins() []PluginInfo {
+	plugins := make([]PluginInfo, 0, 1+len(m.Plugins))
+	if m.Plugin.ID != "" {
+		plugins = append(plugins, m.Plugin)
+	}
+	return append(plugins, m.Plugins...)
+}
@@ -57,6 +57,15 @@ func (a *AtomicFloat64) UpdateWithManager(value float64, manager *Manager, param
 	}
 }
 
+// PublishWithManager is UpdateWithManager for the audio thread: listeners
+// are notified later on the main thread if the manager has a change queue
+func (a *AtomicFloat64) PublishWithManager(value float64, manager *Manager, paramID uint32) {
+	a.Store(value)
+	if manager != nil {
+		_ = manager.Publish(paramID, value)
+	}
+}
+
 // LoadParameterAtomic loads a parameter value from atomic storage
 // This is a compatibility function for existing code
 func LoadParameterAtomic(bits *int64) float64 {
@@ -0,0 +1,204 @@
+package param_test
+
+import (
+	"fmt"
+	"sync"
+	"sync/atomic"
+	"testing"
+
+	"github.com/justyntemme/clapgo/pkg/param"
+)
+
+// benchFrames is the block size the smoother renders
+const benchFrames = 512
+
+// benchParams is the size of the parameter set the param benchmarks use
+const benchParams = 32
+
+// guiReaders is the number of goroutines polling parameters while the
+// audio thread writes, as an editor redrawing its controls would
+const guiReaders = 4
+
+func newBenchManager() *param.Manager {
+	m := param.NewManager()
+	for i := uint32(0); i < benchParams; i++ {
+		m.Register(param.Info{
+			ID:           i * 7, // sparse, as real plugins' IDs often are
+			Name:         fmt.Sprintf("Param %d", i),
+			MinValue:     0,
+			MaxValue:     1,
+			DefaultValue: 0.5,
+		})
+	}
+	m.Freeze()
+	return m
+}
+
+// startReaders polls every parameter from n goroutines until the returned
+// function is called
+func startReaders(m *param.Manager, n int) (stop func()) {
+	var done atomic.Bool
+	var wg sync.WaitGroup
+	for r := 0; r < n; r++ {
+		wg.Add(1)
+		go func() {
+			defer wg.Done()
+			var sink float64
+			for !done.Load() {
+				for i := uint32(0); i < benchParams; i++ {
+					sink += m.Get(i * 7)
+				}
+			}
+			_ = sink
+		}()
+	}
+	return func() {
+		done.Store(true)
+		wg.Wait()
+	}
+}
+
+func BenchmarkManagerGet(b *testing.B) {
+	b.Run("readers=0", func(b *testing.B) { benchManagerGet(b, 0) })
+	b.Run(fmt.Sprintf("readers=%d", guiReaders), func(b *testing.B) { benchManagerGet(b, guiReaders) })
+}
+
+func benchManagerGet(b *testing.B, readers int) {
+	m := newBenchManager()
+	stop := startReaders(m, readers)
+	defer stop()
+
+	var sink float64
+	b.ReportAllocs()
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		sink += m.Get(uint32(i%benchParams) * 7)
+	}
+	_ = sink
+}
+
+func BenchmarkManagerSet(b *testing.B) {
+	b.Run("readers=0", func(b *testing.B) { benchManagerSet(b, 0) })
+	b.Run(fmt.Sprintf("readers=%d", guiReaders), func(b *testing.B) { benchManagerSet(b, guiReaders) })
+}
+
+func benchManagerSet(b *testing.B, readers int) {
+	m := newBenchManager()
+	stop := startReaders(m, readers)
+	defer stop()
+
+	b.ReportAllocs()
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		m.Set(uint32(i%benchParams)*7, float64(i&1023)/1023)
+	}
+}
+
+func BenchmarkManagerSetAt(b *testing.B) {
+	m := newBenchManager()
+	b.ReportAllocs()
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		m.SetAt(uint32(i%benchParams), float64(i&1023)/1023)
+	}
+}
+
+// BenchmarkManagerPublish measures a block of automation going through the
+// change queue: one value per parameter, then the end-of-block flush
+func BenchmarkManagerPublish(b *testing.B) {
+	m := newBenchManager()
+	m.EnableChangeQueue(nil)
+	b.ReportAllocs()
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		for index := uint32(0); index < benchParams; index++ {
+			m.PublishAt(index, float64((i+int(index))&1023)/1023)
+		}
+		m.EndBlock()
+		m.DispatchChanges()
+	}
+}
+
+func BenchmarkSmootherProcess(b *testing.B) {
+	m := newBenchManager()
+	s, err := m.Smooth(0, param.SmoothingLinear, param.DefaultSmoothingTime)
+	if err != nil {
+		b.Fatal(err)
+	}
+	s.Prepare(48000, benchFrames)
+	b.ReportAllocs()
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		// Move the target every block so the ramp is always being rendered
+		m.Set(0, float64(i&1))
+		s.Process(benchFrames)
+	}
+}
+
+func BenchmarkMapper(b *testing.B) {
+	b.Run("analytic", func(b *testing.B) {
+		benchMapper(b, param.CreateFrequencyMapper(20, 20000, true))
+	})
+	b.Run("compiled", func(b *testing.B) {
+		compiled, err := param.CompileMapper(param.CreateFrequencyMapper(20, 20000, true), 0, 1, param.CompileOptions{})
+		if err != nil {
+			b.Fatal(err)
+		}
+		benchMapper(b, compiled.Map)
+	})
+}
+
+func benchMapper(b *testing.B, mapper param.ValueMapper) {
+	var sink float64
+	b.ReportAllocs()
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		sink += mapper(float64(i&1023) / 1023)
+	}
+	_ = sink
+}
+
+// TestAudioThreadAllocs checks that the parameter paths the audio thread
+// takes never allocate
+func TestAudioThreadAllocs(t *testing.T) {
+	m := newBenchManager()
+	queued := newBenchManager()
+	queued.EnableChangeQueue(nil)
+	smoothed := newBenchManager()
+	s, err := smoothed.Smooth(0, param.SmoothingLinear, param.DefaultSmoothingTime)
+	if err != nil {
+		t.Fatal(err)
+	}
+	s.Prepare(48000, benchFrames)
+	q := param.NewChangeQueue(benchParams, nil)
+
+	var toggle float64
+	checks := []struct {
+		name string
+		fn   func()
+	}{
+		{"ManagerGet", func() { _ = m.Get(7) }},
+		{"ManagerSet", func() { toggle = 1 - toggle; m.Set(7, toggle) }},
+		{"ManagerSetAt", func() { toggle = 1 - toggle; m.SetAt(1, toggle) }},
+		{"ManagerPublish", func() {
+			toggle = 1 - toggle
+			queued.PublishAt(1, toggle)
+			queued.EndBlock()
+		}},
+		{"ChangeQueue", func() {
+			q.Push(3)
+			q.EndBlock()
+			q.Drain(func(uint32) {})
+		}},
+		{"SmootherProcess", func() {
+			toggle = 1 - toggle
+			smoothed.Set(0, toggle)
+			s.Process(benchFrames)
+		}},
+	}
+	for _, check := range checks {
+		if allocs := testing.AllocsPerRun(100, check.fn); allocs != 0 {
+			t.Errorf("%s: %.1f allocs per run, want 0", check.name, allocs)
+		}
+	}
+}
@@ -16,12 +16,17 @@ type ParameterBinding struct {
 	Max       float64        // Maximum value
 	Default   float64        // Default value
 	Mapper    ValueMapper    // Optional value transformation function
+	Inverse   ValueMapper    // Maps Mapper's display values back, for text input
+	Compiled  *CompiledMapper // Table form of Mapper, when compiled
 }
 
 // ParameterBinder manages parameter bindings and automates common operations
 type ParameterBinder struct {
 	bindings map[uint32]*ParameterBinding
 	manager  *Manager
+	
+	// Bindings by the manager's dense index, built by Freeze
+	dense []*ParameterBinding
 }
 
 // NewParameterBinder creates a new parameter binder
@@ -34,11 +39,11 @@ func NewParameterBinder(manager *Manager) *ParameterBinder {
 
 // bindParameter is the internal method for creating and registering a parameter
 func (pb *ParameterBinder) bindParameter(info Info, format Format, choices []string) *AtomicFloat64 {
-	return pb.bindParameterWithMapper(info, format, choices, nil)
+	return pb.bindParameterWithMapper(info, format, choices, nil, nil)
 }
 
 // bindParameterWithMapper is the internal method for creating and registering a parameter with value mapping
-func (pb *ParameterBinder) bindParameterWithMapper(info Info, format Format, choices []string, mapper ValueMapper) *AtomicFloat64 {
+func (pb *ParameterBinder) bindParameterWithMapper(info Info, format Format, choices []string, mapper, inverse ValueMapper) *AtomicFloat64 {
 	// Create atomic storage
 	atomic := NewAtomicFloat64(info.DefaultValue)
 	
@@ -52,6 +57,7 @@ func (pb *ParameterBinder) bindParameterWithMapper(info Info, format Format, cho
 		Max:     info.MaxValue,
 		Default: info.DefaultValue,
 		Mapper:  mapper,
+		Inverse: inverse,
 	}
 	
 	// Store binding
@@ -96,14 +102,16 @@ func (pb *ParameterBinder) BindCutoffMusical(id uint32, name string, defaultValu
 func (pb *ParameterBinder) BindCutoffLog(id uint32, name string, defaultParamValue float64) *AtomicFloat64 {
 	info := CutoffLog(id, name)
 	info.DefaultValue = defaultParamValue
-	return pb.bindParameterWithMapper(info, FormatHertz, nil, FrequencyMappers.LogMusical)
+	return pb.bindParameterWithMapper(info, FormatHertz, nil, FrequencyMappers.LogMusical,
+		InverseFrequencyMapper(20.0, 8000.0, true))
 }
 
 // BindCutoffLogFull binds a logarithmic filter cutoff parameter (0-1 → 20Hz-20kHz)
 func (pb *ParameterBinder) BindCutoffLogFull(id uint32, name string, defaultParamValue float64) *AtomicFloat64 {
 	info := CutoffLogFull(id, name)
 	info.DefaultValue = defaultParamValue
-	return pb.bindParameterWithMapper(info, FormatHertz, nil, FrequencyMappers.LogFull)
+	return pb.bindParameterWithMapper(info, FormatHertz, nil, FrequencyMappers.LogFull,
+		InverseFrequencyMapper(20.0, 20000.0, true))
 }
 
 // BindResonance binds a filter resonance parameter (0-1)
@@ -148,6 +156,56 @@ func (pb *ParameterBinder) BindLinear(id uint32, name string, min, max, defaultV
 	return pb.bindParameter(info, FormatDefault, nil)
 }
 
+// Freeze freezes the manager's registration and indexes the bindings by
+// dense parameter index, so the audio-thread paths below skip the map
+func (pb *ParameterBinder) Freeze() {
+	pb.manager.Freeze()
+	if pb.dense != nil {
+		return
+	}
+	
+	dense := make([]*ParameterBinding, pb.manager.Count())
+	for id, binding := range pb.bindings {
+		if index, ok := pb.manager.IndexOf(id); ok {
+			dense[index] = binding
+		}
+	}
+	pb.dense = dense
+}
+
+// binding finds a binding by parameter ID
+func (pb *ParameterBinder) binding(paramID uint32) (*ParameterBinding, bool) {
+	if pb.dense != nil {
+		index, ok := pb.manager.IndexOf(paramID)
+		if !ok || pb.dense[index] == nil {
+			return nil, false
+		}
+		return pb.dense[index], true
+	}
+	
+	binding, ok := pb.bindings[paramID]
+	return binding, ok
+}
+
+// CompileMapper replaces a binding's mapper with a lookup table over the
+// parameter's range. Text input is then converted back through the table's
+// inverse. Call it after binding, before the plugin is activated. On error
+// the binding keeps its exact mapper.
+func (pb *ParameterBinder) CompileMapper(id uint32, opts CompileOptions) error {
+	binding, ok := pb.bindings[id]
+	if !ok || binding.Mapper == nil {
+		return ErrInvalidParam
+	}
+	
+	compiled, err := CompileMapper(binding.Mapper, binding.Min, binding.Max, opts)
+	if err != nil {
+		return err
+	}
+	binding.Compiled = compiled
+	binding.Mapper = compiled.Mapper()
+	return nil
+}
+
 // SetCallback sets a callback function for when a parameter changes
 func (pb *ParameterBinder) SetCallback(id uint32, callback func(float64)) {
 	if binding, ok := pb.bindings[id]; ok {
@@ -155,9 +213,21 @@ func (pb *ParameterBinder) SetCallback(id uint32, callback func(float64)) {
 	}
 }
 
-// HandleParamValue automatically handles parameter value changes
+// HandleParamValue automatically handles parameter value changes from
+// parameter events, on the audio thread or in flush. Listeners are notified
+// through the manager's change queue when it has one.
 func (pb *ParameterBinder) HandleParamValue(paramID uint32, value float64) bool {
-	binding, ok := pb.bindings[paramID]
+	return pb.apply(paramID, value, true)
+}
+
+// SetParamValue is HandleParamValue for the main thread, e.g. when loading
+// state: listeners are notified before it returns
+func (pb *ParameterBinder) SetParamValue(paramID uint32, value float64) bool {
+	return pb.apply(paramID, value, false)
+}
+
+func (pb *ParameterBinder) apply(paramID uint32, value float64, fromAudio bool) bool {
+	binding, ok := pb.binding(paramID)
 	if !ok {
 		return false
 	}
@@ -172,7 +242,11 @@ func (pb *ParameterBinder) HandleParamValue(paramID uint32, value float64) bool
 	value = ClampValue(value, binding.Min, binding.Max)
 	
 	// Update atomic storage and manager
-	binding.Atomic.UpdateWithManager(value, pb.manager, paramID)
+	if fromAudio {
+		binding.Atomic.PublishWithManager(value, pb.manager, paramID)
+	} else {
+		binding.Atomic.UpdateWithManager(value, pb.manager, paramID)
+	}
 	
 	// Call callback if set
 	if binding.OnChange != nil {
@@ -208,7 +282,10 @@ func (pb *ParameterBinder) ValueToText(paramID uint32, value float64) (string, b
 	return FormatValue(displayValue, binding.Format), true
 }
 
-// TextToValue converts text to a parameter value based on its binding
+// TextToValue converts text to a parameter value based on its binding.
+// Text for a mapped parameter is in display units and goes back through the
+// compiled table's inverse or the binding's Inverse; a mapper with neither
+// returns ErrMapperNotInvertible.
 func (pb *ParameterBinder) TextToValue(paramID uint32, text string) (float64, error) {
 	binding, ok := pb.bindings[paramID]
 	if !ok {
@@ -232,6 +309,16 @@ func (pb *ParameterBinder) TextToValue(paramID uint32, text string) (float64, er
 		return 0, err
 	}
 	
+	// Text is in display units; map it back to the parameter's range
+	switch {
+	case binding.Compiled != nil:
+		value = binding.Compiled.Inverse(value)
+	case binding.Inverse != nil:
+		value = binding.Inverse(value)
+	case binding.Mapper != nil:
+		return 0, ErrMapperNotInvertible
+	}
+	
 	// Clamp to valid range
 	return ClampValue(value, binding.Min, binding.Max), nil
 }
@@ -244,7 +331,7 @@ func (pb *ParameterBinder) GetBinding(paramID uint32) (*ParameterBinding, bool)
 
 // GetMappedValue returns the mapped value for a parameter (applies value mapping if present)
 func (pb *ParameterBinder) GetMappedValue(paramID uint32) (float64, bool) {
-	binding, ok := pb.bindings[paramID]
+	binding, ok := pb.binding(paramID)
 	if !ok {
 		return 0, false
 	}
@@ -258,7 +345,7 @@ func (pb *ParameterBinder) GetMappedValue(paramID uint32) (float64, bool) {
 
 // GetRawValue returns the raw parameter value (0-1 range, no mapping applied)
 func (pb *ParameterBinder) GetRawValue(paramID uint32) (float64, bool) {
-	binding, ok := pb.bindings[paramID]
+	binding, ok := pb.binding(paramID)
 	if !ok {
 		return 0, false
 	}
@@ -273,4 +360,13 @@ func (pb *ParameterBinder) GetAllBindings() map[uint32]*ParameterBinding {
 		result[k] = v
 	}
 	return result
-}
\ No newline at end of file
+}
+
+// Smooth attaches a smoother to a bound parameter's atomic storage
+func (pb *ParameterBinder) Smooth(id uint32, mode SmoothingMode, seconds float64) (*Smoother, error) {
+	binding, exists := pb.binding(id)
+	if !exists {
+		return nil, ErrInvalidParam
+	}
+	return pb.manager.SmoothSource(id, binding.Atomic, mode, seconds)
+}
@@ -0,0 +1,48 @@
+package param_test
+
+import (
+	"errors"
+	"math"
+	"testing"
+
+	"github.com/justyntemme/clapgo/pkg/param"
+)
+
+// TestTextToValueRoundTrip checks that a mapped parameter's displayed text
+// parses back to its value, with and without a compiled table, and that a
+// mapper with no inverse is refused rather than read as a raw value
+func TestTextToValueRoundTrip(t *testing.T) {
+	binder := param.NewParameterBinder(param.NewManager())
+	binder.BindCutoffLog(1, "Cutoff", 0.5)
+	binder.BindCutoffLogFull(2, "Cutoff Full", 0.5)
+	if err := binder.CompileMapper(2, param.CompileOptions{}); err != nil {
+		t.Fatal(err)
+	}
+
+	for _, id := range []uint32{1, 2} {
+		for _, value := range []float64{0.1, 0.5, 0.9} {
+			text, ok := binder.ValueToText(id, value)
+			if !ok {
+				t.Fatalf("param %d: no text for %g", id, value)
+			}
+			got, err := binder.TextToValue(id, text)
+			if err != nil {
+				t.Fatalf("param %d: %q: %v", id, text, err)
+			}
+			if math.Abs(got-value) > 1e-3 {
+				t.Errorf("param %d: %g shows as %q, which parses back to %g", id, value, text, got)
+			}
+		}
+	}
+
+	binder.BindLinear(3, "Custom", 0, 1, 0.5)
+	binding, _ := binder.GetBinding(3)
+	binding.Mapper = func(v float64) float64 { return v * v * 100 }
+	if _, err := binder.TextToValue(3, "25"); !errors.Is(err, param.ErrMapperNotInvertible) {
+		t.Errorf("mapper without inverse: err = %v, want ErrMapperNotInvertible", err)
+	}
+	binding.Inverse = func(v float64) float64 { return math.Sqrt(v / 100) }
+	if got, err := binder.TextToValue(3, "25"); err != nil || math.Abs(got-0.5) > 1e-9 {
+		t.Errorf("mapper with inverse: got %g, %v, want 0.5", got, err)
+	}
+}
@@ -0,0 +1,102 @@
+package param
+
+import (
+	"sync/atomic"
+)
+
+// ChangeQueue carries parameter changes from the audio thread to the main
+// thread without locks. It is single-producer, single-consumer: the audio
+// thread pushes dense parameter indices and the main thread drains them.
+//
+// Changes coalesce per parameter. An index sits in the ring at most once no
+// matter how often its value changes before the main thread catches up, so
+// the ring can never overflow and a burst of automation costs one entry per
+// distinct parameter. The consumer reads the value when it drains, which is
+// always the latest.
+type ChangeQueue struct {
+	ring []uint32
+	mask uint32
+
+	tail atomic.Uint32 // written by the producer
+	_    [60]byte
+	head atomic.Uint32 // written by the consumer
+	_    [60]byte
+
+	queued []atomic.Uint32 // 1 while the index is in the ring
+
+	pushed          bool // producer only: something was pushed this block
+	requested       atomic.Bool
+	requestCallback func()
+}
+
+// NewChangeQueue creates a queue for paramCount parameters. requestCallback
+// asks the host to call back on the main thread and may be nil.
+func NewChangeQueue(paramCount int, requestCallback func()) *ChangeQueue {
+	size := uint32(1)
+	for size < uint32(paramCount) {
+		size <<= 1
+	}
+	return &ChangeQueue{
+		ring:            make([]uint32, size),
+		mask:            size - 1,
+		queued:          make([]atomic.Uint32, paramCount),
+		requestCallback: requestCallback,
+	}
+}
+
+// Push marks the parameter at index as changed. Audio thread only.
+func (q *ChangeQueue) Push(index uint32) {
+	if index >= uint32(len(q.queued)) {
+		return
+	}
+	if !q.queued[index].CompareAndSwap(0, 1) {
+		// Already waiting; the consumer will see the new value
+		return
+	}
+
+	tail := q.tail.Load()
+	q.ring[tail&q.mask] = index
+	q.tail.Store(tail + 1)
+	q.pushed = true
+}
+
+// EndBlock asks the host for a main-thread callback if anything was pushed
+// since the last block and no request is outstanding, so there is at most
+// one request per block. Audio thread only.
+func (q *ChangeQueue) EndBlock() {
+	if !q.pushed {
+		return
+	}
+	q.pushed = false
+
+	if q.requestCallback != nil && !q.requested.Swap(true) {
+		q.requestCallback()
+	}
+}
+
+// Drain calls fn once for every changed parameter index and returns how
+// many there were. Main thread only.
+func (q *ChangeQueue) Drain(fn func(index uint32)) int {
+	// Re-arm first so changes pushed while draining request a new callback
+	q.requested.Store(false)
+
+	count := 0
+	head := q.head.Load()
+	for head != q.tail.Load() {
+		index := q.ring[head&q.mask]
+		head++
+		q.head.Store(head)
+
+		// Clear before reading the value: a change after this point queues
+		// the index again rather than being lost
+		q.queued[index].Store(0)
+		fn(index)
+		count++
+	}
+	return count
+}
+
+// Pending reports whether changes are waiting to be drained
+func (q *ChangeQueue) Pending() bool {
+	return q.head.Load() != q.tail.Load()
+}
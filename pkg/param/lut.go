@@ -0,0 +1,204 @@
+package param
+
+import (
+	"errors"
+	"math"
+)
+
+// Interpolation selects how a compiled mapper reads between table points
+type Interpolation int
+
+const (
+	// InterpolationLinear blends the two neighbouring points
+	InterpolationLinear Interpolation = iota
+	// InterpolationCubic fits a Catmull-Rom spline through four points
+	InterpolationCubic
+)
+
+const (
+	// DefaultMapperTableSize is the number of table segments when none is given
+	DefaultMapperTableSize = 1024
+	// MaxMapperTableSize caps how far a table grows to meet its error bound
+	MaxMapperTableSize = 65536
+	// DefaultMapperMaxError is the default relative error bound
+	DefaultMapperMaxError = 1e-4
+	// mapperErrorFloor is the fraction of the output span below which the
+	// error is measured absolutely, so mappers that cross zero can compile
+	mapperErrorFloor = 1e-3
+)
+
+// ErrMapperErrorBound is returned when no table up to MaxMapperTableSize
+// meets the requested error bound
+var ErrMapperErrorBound = errors.New("mapper table cannot meet error bound")
+
+// CompileOptions configures CompileMapper. Zero values select the defaults.
+type CompileOptions struct {
+	Size          int           // initial number of segments
+	Interpolation Interpolation // linear or cubic
+	MaxError      float64       // largest allowed relative error, absolute near zero
+}
+
+// CompiledMapper is a ValueMapper evaluated from a precomputed table, so an
+// exponential mapping costs a few loads instead of a math.Pow. The table is
+// built once, when the parameter is registered, and grows until it meets
+// the error bound.
+type CompiledMapper struct {
+	table         []float64 // size+3 points: one guard before and after for cubic
+	min, max      float64
+	scale         float64 // segments per unit of parameter value
+	size          int
+	interpolation Interpolation
+	maxError      float64 // measured worst relative error
+	increasing    bool
+}
+
+// CompileMapper tabulates mapper over [min, max]. The mapper must be
+// monotonic on that range for Inverse to be meaningful.
+func CompileMapper(mapper ValueMapper, min, max float64, opts CompileOptions) (*CompiledMapper, error) {
+	if mapper == nil || !(max > min) {
+		return nil, ErrInvalidParam
+	}
+	size := opts.Size
+	if size <= 0 {
+		size = DefaultMapperTableSize
+	}
+	bound := opts.MaxError
+	if bound <= 0 {
+		bound = DefaultMapperMaxError
+	}
+
+	for {
+		c := buildMapper(mapper, min, max, size, opts.Interpolation)
+		if c.maxError <= bound {
+			return c, nil
+		}
+		if size >= MaxMapperTableSize {
+			return nil, ErrMapperErrorBound
+		}
+		size *= 2
+	}
+}
+
+func buildMapper(mapper ValueMapper, min, max float64, size int, interpolation Interpolation) *CompiledMapper {
+	c := &CompiledMapper{
+		table:         make([]float64, size+3),
+		min:           min,
+		max:           max,
+		scale:         float64(size) / (max - min),
+		size:          size,
+		interpolation: interpolation,
+	}
+
+	step := (max - min) / float64(size)
+	for i := 0; i <= size; i++ {
+		c.table[i+1] = mapper(min + float64(i)*step)
+	}
+	// Extrapolate the guards quadratically rather than evaluate outside
+	// the domain, where the mapper may not be defined
+	if size >= 2 {
+		c.table[0] = 3*c.table[1] - 3*c.table[2] + c.table[3]
+		c.table[size+2] = 3*c.table[size+1] - 3*c.table[size] + c.table[size-1]
+	} else {
+		c.table[0] = 2*c.table[1] - c.table[2]
+		c.table[size+2] = 2*c.table[size+1] - c.table[size]
+	}
+	c.increasing = c.table[size+1] >= c.table[1]
+
+	// Errors are relative, but against no less than a fraction of the output
+	// span: near a zero crossing any relative bound is out of reach
+	low, high := c.table[1], c.table[1]
+	for _, v := range c.table[1 : size+2] {
+		low, high = math.Min(low, v), math.Max(high, v)
+	}
+	floor := math.Max((high-low)*mapperErrorFloor, 1e-12)
+
+	// Measure at several points inside every segment
+	const probes = 4
+	for i := 0; i < size; i++ {
+		for k := 1; k <= probes; k++ {
+			x := min + (float64(i)+float64(k)/(probes+1))*step
+			exact := mapper(x)
+			err := math.Abs(c.Map(x)-exact) / math.Max(math.Abs(exact), floor)
+			if err > c.maxError {
+				c.maxError = err
+			}
+		}
+	}
+	return c
+}
+
+// Map returns the mapped value, clamping the input to the table's range
+func (c *CompiledMapper) Map(paramValue float64) float64 {
+	pos := (paramValue - c.min) * c.scale
+	if pos <= 0 {
+		return c.table[1]
+	}
+	if pos >= float64(c.size) {
+		return c.table[c.size+1]
+	}
+
+	i := int(pos)
+	t := pos - float64(i)
+	p := c.table[i : i+4 : i+4] // p[1] and p[2] bracket the value
+
+	if c.interpolation == InterpolationCubic {
+		a := p[2] - p[0]
+		b := 2*p[0] - 5*p[1] + 4*p[2] - p[3]
+		d := 3*(p[1]-p[2]) + p[3] - p[0]
+		return p[1] + 0.5*t*(a+t*(b+t*d))
+	}
+	return p[1] + (p[2]-p[1])*t
+}
+
+// MapRamp maps a block of parameter values, such as a smoother's ramp
+func (c *CompiledMapper) MapRamp(dst, src []float32) {
+	src = src[:len(dst)]
+	for i := range dst {
+		dst[i] = float32(c.Map(float64(src[i])))
+	}
+}
+
+// Mapper returns Map as a ValueMapper, for use in a binding
+func (c *CompiledMapper) Mapper() ValueMapper {
+	return c.Map
+}
+
+// Inverse maps a value back to a parameter value by searching the
+// monotonic table and interpolating linearly within the segment
+func (c *CompiledMapper) Inverse(value float64) float64 {
+	points := c.table[1 : c.size+2]
+
+	// Index of the first point at or past value in the mapping's direction
+	lo, hi := 0, len(points)
+	for lo < hi {
+		mid := int(uint(lo+hi) >> 1)
+		if (c.increasing && points[mid] < value) || (!c.increasing && points[mid] > value) {
+			lo = mid + 1
+		} else {
+			hi = mid
+		}
+	}
+	if lo == 0 {
+		return c.min
+	}
+	if lo >= len(points) {
+		return c.max
+	}
+
+	y0, y1 := points[lo-1], points[lo]
+	t := 0.0
+	if y1 != y0 {
+		t = (value - y0) / (y1 - y0)
+	}
+	return c.min + (float64(lo-1)+t)/c.scale
+}
+
+// MaxError returns the worst relative error measured when the table was built
+func (c *CompiledMapper) MaxError() float64 {
+	return c.maxError
+}
+
+// Size returns the number of table segments
+func (c *CompiledMapper) Size() int {
+	return c.size
+}
@@ -0,0 +1,55 @@
+package param_test
+
+import (
+	"math"
+	"testing"
+
+	"github.com/justyntemme/clapgo/pkg/param"
+)
+
+// TestCompileMapperBipolar checks that mappers whose output crosses zero
+// compile, with the error near zero measured against the output span
+func TestCompileMapperBipolar(t *testing.T) {
+	mappers := map[string]param.ValueMapper{
+		"linear":   func(x float64) float64 { return 48*x - 24 },
+		"cubic":    func(x float64) float64 { return 24 * math.Pow(2*x-1, 3) },
+		"sine":     func(x float64) float64 { return math.Sin(math.Pi * (x - 0.3)) },
+		"offcross": func(x float64) float64 { return math.Tan(x - 0.123456789) },
+	}
+	for name, mapper := range mappers {
+		for _, interpolation := range []param.Interpolation{param.InterpolationLinear, param.InterpolationCubic} {
+			compiled, err := param.CompileMapper(mapper, 0, 1, param.CompileOptions{Interpolation: interpolation})
+			if err != nil {
+				t.Errorf("%s, interpolation %d: %v", name, interpolation, err)
+				continue
+			}
+			span := math.Abs(mapper(1) - mapper(0))
+			for i := 0; i <= 10000; i++ {
+				x := float64(i) / 10000
+				exact := mapper(x)
+				bound := param.DefaultMapperMaxError * math.Max(math.Abs(exact), 1e-3*span)
+				if got := compiled.Map(x); math.Abs(got-exact) > bound {
+					t.Errorf("%s, interpolation %d: Map(%g) = %g, want %g within %g", name, interpolation, x, got, exact, bound)
+					break
+				}
+			}
+		}
+	}
+}
+
+// TestCompileMapperRelative checks that a mapper far from zero is still held
+// to the relative bound at the bottom of its range
+func TestCompileMapperRelative(t *testing.T) {
+	mapper := param.CreateFrequencyMapper(20, 20000, true)
+	compiled, err := param.CompileMapper(mapper, 0, 1, param.CompileOptions{Interpolation: param.InterpolationCubic})
+	if err != nil {
+		t.Fatal(err)
+	}
+	for i := 0; i <= 10000; i++ {
+		x := float64(i) / 10000
+		exact := mapper(x)
+		if got := compiled.Map(x); math.Abs(got-exact) > param.DefaultMapperMaxError*exact {
+			t.Fatalf("Map(%g) = %g, want %g within a relative %g", x, got, exact, param.DefaultMapperMaxError)
+		}
+	}
+}
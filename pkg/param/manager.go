@@ -1,6 +1,7 @@
 package param
 
 import (
+	"sort"
 	"sync"
 	"sync/atomic"
 	"unsafe"
@@ -9,13 +10,119 @@ import (
 // ChangeListener is called when parameter values change
 type ChangeListener func(paramID uint32, oldValue, newValue float64)
 
-// Manager provides thread-safe parameter management with validation and change notification
+// Manager provides thread-safe parameter management with validation and change notification.
+//
+// Parameters are registered during construction and init, then Freeze moves
+// their values into a dense, index-addressed store. From then on Get, Set and
+// change notification take no locks and do no map lookups, so the audio
+// thread never contends with the GUI or main thread.
 type Manager struct {
 	mutex         sync.RWMutex
 	params        map[uint32]*Parameter
 	paramOrder    []uint32
 	listeners     [MaxListeners]ChangeListener
 	listenerCount int32 // atomic
+	smoothers     []*Smoother
+	
+	// Published copy of listeners, swapped on add/remove and read lock-free
+	listenerSnapshot atomic.Pointer[listenerSet]
+	
+	// Dense store, immutable once frozen is set
+	frozen atomic.Bool
+	dense  []*Parameter // by index, in registration order
+	slots  []paddedValue
+	lookup idLookup
+	
+	// Audio-to-main-thread notification, set up by EnableChangeQueue
+	changes    *ChangeQueue
+	notified   []int64 // float64 bits last passed to listeners, by index
+	dispatchFn func(index uint32)
+}
+
+// listenerSet is an immutable snapshot of the registered listeners
+type listenerSet struct {
+	listeners [MaxListeners]ChangeListener
+	count     int32
+}
+
+// paddedValue keeps each parameter value on its own cache line so writes
+// to one parameter never invalidate readers of its neighbours
+type paddedValue struct {
+	bits int64
+	_    [56]byte
+}
+
+// directLookupSlack bounds how sparse IDs may be for a direct table
+const directLookupSlack = 4
+
+// idLookup maps parameter IDs to dense indices. IDs that are small relative
+// to the parameter count get a direct table; anything else is looked up by
+// binary search over the sorted IDs.
+type idLookup struct {
+	direct  []int32 // direct[id] is the index, or -1
+	ids     []uint32
+	indices []uint32
+}
+
+func newIDLookup(order []uint32) idLookup {
+	var l idLookup
+	if len(order) == 0 {
+		return l
+	}
+	
+	maxID := uint32(0)
+	for _, id := range order {
+		if id > maxID {
+			maxID = id
+		}
+	}
+	
+	if uint64(maxID) < uint64(len(order))*directLookupSlack+64 {
+		l.direct = make([]int32, maxID+1)
+		for i := range l.direct {
+			l.direct[i] = -1
+		}
+		for index, id := range order {
+			l.direct[id] = int32(index)
+		}
+		return l
+	}
+	
+	l.ids = make([]uint32, len(order))
+	copy(l.ids, order)
+	sort.Slice(l.ids, func(i, j int) bool { return l.ids[i] < l.ids[j] })
+	position := make(map[uint32]uint32, len(order))
+	for index, id := range order {
+		position[id] = uint32(index)
+	}
+	l.indices = make([]uint32, len(l.ids))
+	for i, id := range l.ids {
+		l.indices[i] = position[id]
+	}
+	return l
+}
+
+func (l *idLookup) find(id uint32) (uint32, bool) {
+	if l.direct != nil {
+		if id >= uint32(len(l.direct)) || l.direct[id] < 0 {
+			return 0, false
+		}
+		return uint32(l.direct[id]), true
+	}
+	
+	lo, hi := 0, len(l.ids)
+	for lo < hi {
+		mid := int(uint(lo+hi) >> 1)
+		if l.ids[mid] < id {
+			lo = mid + 1
+		} else {
+			hi = mid
+		}
+	}
+	if lo < len(l.ids) && l.ids[lo] == id {
+		return l.indices[lo], true
+	}
+	return 0, false
 }
 
 // NewManager creates a new thread-safe parameter manager
@@ -32,6 +139,10 @@ func (m *Manager) Register(info Info) error {
 	m.mutex.Lock()
 	defer m.mutex.Unlock()
 	
+	if m.frozen.Load() {
+		return ErrRegistrationFrozen
+	}
+	
 	if _, exists := m.params[info.ID]; exists {
 		return ErrParamExists
 	}
@@ -39,9 +150,10 @@ func (m *Manager) Register(info Info) error {
 	param := &Parameter{
 		Info: info,
 	}
+	param.bits = &param.value
 	
 	// Set default value atomically
-	atomic.StoreInt64(&param.value, int64(floatToBits(info.DefaultValue)))
+	atomic.StoreInt64(param.bits, int64(floatToBits(info.DefaultValue)))
 	
 	// Add validator if parameter has bounds
 	if info.Flags&(IsBoundedBelow|IsBoundedAbove) != 0 {
@@ -72,8 +184,102 @@ func (m *Manager) RegisterAll(infos ...Info) error {
 	return nil
 }
 
+// Freeze ends registration and moves every parameter value into the dense
+// store. Call it once all parameters are registered, at the latest from
+// init and before the plugin is activated; it is safe to call again.
+func (m *Manager) Freeze() {
+	m.mutex.Lock()
+	defer m.mutex.Unlock()
+	
+	if m.frozen.Load() {
+		return
+	}
+	
+	m.dense = make([]*Parameter, len(m.paramOrder))
+	m.slots = make([]paddedValue, len(m.paramOrder))
+	for index, id := range m.paramOrder {
+		param := m.params[id]
+		m.slots[index].bits = atomic.LoadInt64(param.bits)
+		
+		// Smoothers reading the old storage follow the value
+		for _, s := range m.smoothers {
+			if s.source == param.bits {
+				s.source = &m.slots[index].bits
+			}
+		}
+		
+		param.bits = &m.slots[index].bits
+		param.index = uint32(index)
+		m.dense[index] = param
+	}
+	m.lookup = newIDLookup(m.paramOrder)
+	
+	m.frozen.Store(true)
+}
+
+// IsFrozen reports whether registration has ended
+func (m *Manager) IsFrozen() bool {
+	return m.frozen.Load()
+}
+
+// IndexOf returns the dense index of a parameter. Indices follow
+// registration order; lookups are lock-free once the manager is frozen.
+func (m *Manager) IndexOf(paramID uint32) (uint32, bool) {
+	if m.frozen.Load() {
+		return m.lookup.find(paramID)
+	}
+	
+	m.mutex.RLock()
+	defer m.mutex.RUnlock()
+	
+	for index, id := range m.paramOrder {
+		if id == paramID {
+			return uint32(index), true
+		}
+	}
+	return 0, false
+}
+
+// ValueAt returns the value of the parameter at a dense index. It is meant
+// for the audio thread after Freeze and returns 0 before it.
+func (m *Manager) ValueAt(index uint32) float64 {
+	if !m.frozen.Load() || index >= uint32(len(m.slots)) {
+		return 0.0
+	}
+	return bitsToFloat(atomic.LoadInt64(&m.slots[index].bits))
+}
+
+// SetAt sets the parameter at a dense index with validation and change
+// notification. Like ValueAt it requires a frozen manager.
+func (m *Manager) SetAt(index uint32, value float64) error {
+	if !m.frozen.Load() || index >= uint32(len(m.dense)) {
+		return ErrInvalidParam
+	}
+	return m.set(m.dense[index], value)
+}
+
+// lookupParam finds a parameter without locking once the manager is frozen
+func (m *Manager) lookupParam(paramID uint32) (*Parameter, bool) {
+	if m.frozen.Load() {
+		index, ok := m.lookup.find(paramID)
+		if !ok {
+			return nil, false
+		}
+		return m.dense[index], true
+	}
+	
+	m.mutex.RLock()
+	param, exists := m.params[paramID]
+	m.mutex.RUnlock()
+	return param, exists
+}
+
 // Count returns the number of registered parameters
 func (m *Manager) Count() uint32 {
+	if m.frozen.Load() {
+		return uint32(len(m.dense))
+	}
+	
 	m.mutex.RLock()
 	defer m.mutex.RUnlock()
 	return uint32(len(m.params))
@@ -81,10 +287,7 @@ func (m *Manager) Count() uint32 {
 
 // GetInfo returns information about a parameter by ID
 func (m *Manager) GetInfo(paramID uint32) (Info, error) {
-	m.mutex.RLock()
-	defer m.mutex.RUnlock()
-	
-	if param, exists := m.params[paramID]; exists {
+	if param, exists := m.lookupParam(paramID); exists {
 		return param.Info, nil
 	}
 	
@@ -93,6 +296,13 @@ func (m *Manager) GetInfo(paramID uint32) (Info, error) {
 
 // GetInfoByIndex returns information about a parameter by index
 func (m *Manager) GetInfoByIndex(index uint32) (Info, error) {
+	if m.frozen.Load() {
+		if index >= uint32(len(m.dense)) {
+			return Info{}, ErrInvalidParam
+		}
+		return m.dense[index].Info, nil
+	}
+	
 	m.mutex.RLock()
 	defer m.mutex.RUnlock()
 	
@@ -106,10 +316,7 @@ func (m *Manager) GetInfoByIndex(index uint32) (Info, error) {
 
 // Get returns the current value of a parameter (thread-safe)
 func (m *Manager) Get(paramID uint32) float64 {
-	m.mutex.RLock()
-	param, exists := m.params[paramID]
-	m.mutex.RUnlock()
-	
+	param, exists := m.lookupParam(paramID)
 	if !exists {
 		return 0.0
 	}
@@ -119,14 +326,15 @@ func (m *Manager) Get(paramID uint32) float64 {
 
 // Set sets the value of a parameter with validation (thread-safe)
 func (m *Manager) Set(paramID uint32, value float64) error {
-	m.mutex.RLock()
-	param, exists := m.params[paramID]
-	m.mutex.RUnlock()
-	
+	param, exists := m.lookupParam(paramID)
 	if !exists {
 		return ErrInvalidParam
 	}
 	
+	return m.set(param, value)
+}
+
+func (m *Manager) set(param *Parameter, value float64) error {
 	// Get old value for change notification
 	oldValue := param.Value()
 	
@@ -138,18 +346,101 @@ func (m *Manager) Set(paramID uint32, value float64) error {
 	// Notify listeners if value changed
 	newValue := param.Value()
 	if oldValue != newValue {
-		m.notifyListeners(paramID, oldValue, newValue)
+		if m.changes != nil {
+			atomic.StoreInt64(&m.notified[param.index], floatToBits(newValue))
+		}
+		m.notifyListeners(param.Info.ID, oldValue, newValue)
+	}
+	
+	return nil
+}
+
+// EnableChangeQueue makes Publish defer listener notification to the main
+// thread. requestCallback should ask the host for a main-thread callback
+// (clap_host.request_callback); it is called at most once per block from
+// EndBlock. The manager must be frozen.
+func (m *Manager) EnableChangeQueue(requestCallback func()) error {
+	if !m.frozen.Load() {
+		return ErrInvalidParam
+	}
+	if m.changes != nil {
+		return nil
+	}
+	
+	m.notified = make([]int64, len(m.dense))
+	for index, param := range m.dense {
+		m.notified[index] = atomic.LoadInt64(param.bits)
+	}
+	m.dispatchFn = m.dispatchChange
+	m.changes = NewChangeQueue(len(m.dense), requestCallback)
+	return nil
+}
+
+// Publish sets a parameter from the audio thread. The value is validated and
+// stored immediately, but listeners run later on the main thread from
+// DispatchChanges. Without a change queue it behaves like Set.
+func (m *Manager) Publish(paramID uint32, value float64) error {
+	param, exists := m.lookupParam(paramID)
+	if !exists {
+		return ErrInvalidParam
+	}
+	return m.publish(param, value)
+}
+
+// PublishAt is Publish by dense index
+func (m *Manager) PublishAt(index uint32, value float64) error {
+	if !m.frozen.Load() || index >= uint32(len(m.dense)) {
+		return ErrInvalidParam
+	}
+	return m.publish(m.dense[index], value)
+}
+
+func (m *Manager) publish(param *Parameter, value float64) error {
+	if m.changes == nil {
+		return m.set(param, value)
 	}
 	
+	oldValue := param.Value()
+	if err := param.SetValue(value); err != nil {
+		return err
+	}
+	if param.Value() != oldValue {
+		m.changes.Push(param.index)
+	}
 	return nil
 }
 
+// EndBlock requests a main-thread callback if parameters were published
+// during the block. Call it from the audio thread once per process call and
+// after a flush.
+func (m *Manager) EndBlock() {
+	if m.changes != nil {
+		m.changes.EndBlock()
+	}
+}
+
+// DispatchChanges notifies listeners of every parameter published since the
+// last call, once per parameter with its latest value, and returns how many
+// were dispatched. Call it from the main thread, e.g. on_main_thread.
+func (m *Manager) DispatchChanges() int {
+	if m.changes == nil {
+		return 0
+	}
+	return m.changes.Drain(m.dispatchFn)
+}
+
+func (m *Manager) dispatchChange(index uint32) {
+	param := m.dense[index]
+	newBits := atomic.LoadInt64(param.bits)
+	oldBits := atomic.SwapInt64(&m.notified[index], newBits)
+	if oldBits != newBits {
+		m.notifyListeners(param.Info.ID, bitsToFloat(oldBits), bitsToFloat(newBits))
+	}
+}
+
 // GetParameter returns the parameter object for direct access
 func (m *Manager) GetParameter(paramID uint32) (*Parameter, error) {
-	m.mutex.RLock()
-	defer m.mutex.RUnlock()
-	
-	if param, exists := m.params[paramID]; exists {
+	if param, exists := m.lookupParam(paramID); exists {
 		return param, nil
 	}
 	
@@ -173,6 +464,7 @@ func (m *Manager) AddListener(listener ChangeListener) error {
 	// Add listener and increment count
 	m.listeners[count] = listener
 	atomic.AddInt32(&m.listenerCount, 1)
+	m.publishListeners()
 	
 	return nil
 }
@@ -208,6 +500,7 @@ func (m *Manager) RemoveListener(listener ChangeListener) bool {
 			m.listeners[count-1] = nil
 			// Decrement count
 			atomic.AddInt32(&m.listenerCount, -1)
+			m.publishListeners()
 			return true
 		}
 	}
@@ -220,18 +513,23 @@ func (m *Manager) ListenerCount() int32 {
 	return atomic.LoadInt32(&m.listenerCount)
 }
 
+// publishListeners swaps in a fresh snapshot; called with the mutex held
+func (m *Manager) publishListeners() {
+	set := &listenerSet{count: atomic.LoadInt32(&m.listenerCount)}
+	copy(set.listeners[:], m.listeners[:set.count])
+	m.listenerSnapshot.Store(set)
+}
+
 // notifyListeners notifies all registered listeners of parameter changes
 func (m *Manager) notifyListeners(paramID uint32, oldValue, newValue float64) {
-	// Take a snapshot of listeners under lock to avoid race conditions
-	m.mutex.RLock()
-	count := atomic.LoadInt32(&m.listenerCount)
-	var listeners [MaxListeners]ChangeListener
-	copy(listeners[:count], m.listeners[:count])
-	m.mutex.RUnlock()
+	// The snapshot is immutable, so no lock or copy is needed
+	set := m.listenerSnapshot.Load()
+	if set == nil {
+		return
+	}
 	
-	// Call listeners without holding the lock
-	for i := int32(0); i < count; i++ {
-		listener := listeners[i]
+	for i := int32(0); i < set.count; i++ {
+		listener := set.listeners[i]
 		
 		if listener != nil {
 			listener(paramID, oldValue, newValue)
@@ -261,17 +559,11 @@ func (m *Manager) SetAll(values map[uint32]float64) {
 
 // GetValue is an alias for Get (for API compatibility)
 func (m *Manager) GetValue(paramID uint32) (float64, error) {
-	value := m.Get(paramID)
-	if value == 0.0 {
-		// Check if parameter exists
-		m.mutex.RLock()
-		_, exists := m.params[paramID]
-		m.mutex.RUnlock()
-		if !exists {
-			return 0, ErrInvalidParam
-		}
+	param, exists := m.lookupParam(paramID)
+	if !exists {
+		return 0, ErrInvalidParam
 	}
-	return value, nil
+	return param.Value(), nil
 }
 
 // SetValue is an alias for Set (for API compatibility)
@@ -285,7 +577,7 @@ func (m *Manager) ResetToDefaults() {
 	defer m.mutex.RUnlock()
 	
 	for _, param := range m.params {
-		atomic.StoreInt64(&param.value, int64(floatToBits(param.Info.DefaultValue)))
+		atomic.StoreInt64(param.bits, int64(floatToBits(param.Info.DefaultValue)))
 	}
 }
 
@@ -14,6 +14,8 @@ var (
 	ErrValueAboveMaximum    = errors.New("value above maximum")
 	ErrParameterExists      = errors.New("parameter ID already exists")
 	ErrParamExists          = errors.New("parameter ID already exists") // Alias for compatibility
+	ErrRegistrationFrozen   = errors.New("parameter registration is frozen")
+	ErrMapperNotInvertible  = errors.New("parameter mapper has no inverse")
 )
 
 // MaxListeners is the maximum number of parameter change listeners
@@ -50,13 +52,15 @@ type Info struct {
 // Parameter represents a plugin parameter with thread-safe access
 type Parameter struct {
 	Info      Info
-	value     int64 // atomic storage for float64 bits
+	value     int64  // atomic storage for float64 bits until the manager is frozen
+	bits      *int64 // where the value lives: &value, then a slot of the dense store
+	index     uint32 // dense index, assigned by Freeze
 	validator func(float64) error
 }
 
 // Value returns the current value atomically
 func (p *Parameter) Value() float64 {
-	bits := atomic.LoadInt64(&p.value)
+	bits := atomic.LoadInt64(p.bits)
 	return bitsToFloat(bits)
 }
 
@@ -70,7 +74,7 @@ func (p *Parameter) SetValue(value float64) error {
 	}
 	
 	// Store atomically
-	atomic.StoreInt64(&p.value, floatToBits(value))
+	atomic.StoreInt64(p.bits, floatToBits(value))
 	return nil
 }
 
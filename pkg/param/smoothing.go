@@ -0,0 +1,308 @@
+package param
+
+import (
+	"math"
+	"sync/atomic"
+)
+
+// SmoothingMode selects how a smoother moves towards a new parameter value
+type SmoothingMode int
+
+const (
+	// SmoothingNone jumps to the new value at the start of the block
+	SmoothingNone SmoothingMode = iota
+	// SmoothingLinear reaches the new value in a fixed time along a straight line
+	SmoothingLinear
+	// SmoothingOnePole approaches the new value exponentially, time being the
+	// time constant
+	SmoothingOnePole
+	// SmoothingMultiplicative reaches the new value in a fixed time with a
+	// constant ratio per sample, which sounds even for gains and frequencies.
+	// It falls back to linear when either end of the ramp is not positive.
+	SmoothingMultiplicative
+)
+
+// DefaultSmoothingTime is the ramp time used when none is given
+const DefaultSmoothingTime = 0.02
+
+// smoothingEpsilon is how close a one-pole smoother must get before it snaps
+// to the target and stops producing ramps
+const smoothingEpsilon = 1e-6
+
+// Smoother de-zippers a parameter by turning value changes into per-sample
+// ramps. Once per block the audio thread calls Process; while the value is
+// settled that is a single atomic load and no per-sample work is done, so
+// DSP code can branch to a constant-gain path almost all the time.
+//
+// A Smoother belongs to the audio thread. Only the parameter value it reads
+// is shared.
+type Smoother struct {
+	paramID uint32
+	source  *int64 // float64 bits, stored atomically by the main/audio thread
+
+	mode       SmoothingMode
+	time       float64
+	sampleRate float64
+
+	current   float64
+	target    float64
+	remaining int     // samples left on a linear or multiplicative ramp
+	step      float64 // per-sample increment, or ratio when geometric
+	geometric bool    // current ramp multiplies by step instead of adding
+	coeff     float64 // one-pole coefficient
+	settled   bool
+
+	ramp   []float32
+	filled int // samples of ramp written by the last Process call
+}
+
+func newSmoother(paramID uint32, source *int64, mode SmoothingMode, time float64) *Smoother {
+	if time <= 0 {
+		time = DefaultSmoothingTime
+	}
+	value := bitsToFloat(atomic.LoadInt64(source))
+	s := &Smoother{
+		paramID:    paramID,
+		source:     source,
+		mode:       mode,
+		time:       time,
+		sampleRate: 44100,
+		current:    value,
+		target:     value,
+		settled:    true,
+	}
+	s.updateCoefficient()
+	return s
+}
+
+// ParamID returns the ID of the smoothed parameter
+func (s *Smoother) ParamID() uint32 {
+	return s.paramID
+}
+
+// Mode returns the smoothing mode
+func (s *Smoother) Mode() SmoothingMode {
+	return s.mode
+}
+
+// Prepare sets the sample rate and sizes the ramp buffer for blocks of up to
+// maxFrames. Call it from activate; it allocates, Process does not. The
+// smoother snaps to the current parameter value.
+func (s *Smoother) Prepare(sampleRate float64, maxFrames uint32) {
+	if sampleRate > 0 {
+		s.sampleRate = sampleRate
+	}
+	if uint32(cap(s.ramp)) < maxFrames {
+		s.ramp = make([]float32, maxFrames)
+	}
+	s.ramp = s.ramp[:maxFrames]
+	s.updateCoefficient()
+	s.Reset()
+}
+
+// SetTime changes the ramp time in seconds; it applies from the next change
+func (s *Smoother) SetTime(seconds float64) {
+	if seconds <= 0 {
+		seconds = DefaultSmoothingTime
+	}
+	s.time = seconds
+	s.updateCoefficient()
+}
+
+// Reset drops any ramp in progress and jumps to the current parameter value
+func (s *Smoother) Reset() {
+	value := bitsToFloat(atomic.LoadInt64(s.source))
+	s.current = value
+	s.target = value
+	s.remaining = 0
+	s.settled = true
+}
+
+// Process advances the smoother by frameCount samples, picking up the latest
+// parameter value first. It returns true when the value is constant for the
+// whole block, in which case Value holds it and the ramp is not filled.
+// Otherwise Ramp holds one value per sample, for up to the prepared maximum
+// number of frames.
+func (s *Smoother) Process(frameCount uint32) bool {
+	if target := bitsToFloat(atomic.LoadInt64(s.source)); target != s.target {
+		s.setTarget(target)
+	}
+	if s.settled {
+		return true
+	}
+
+	n := int(frameCount)
+	if n > len(s.ramp) {
+		n = len(s.ramp)
+	}
+	ramp := s.ramp[:n]
+	s.filled = n
+
+	i := 0
+	switch s.mode {
+	case SmoothingOnePole:
+		current, target, coeff := s.current, s.target, s.coeff
+		for ; i < len(ramp); i++ {
+			current += coeff * (target - current)
+			if math.Abs(target-current) < smoothingEpsilon {
+				current = target
+				break
+			}
+			ramp[i] = float32(current)
+		}
+		s.current = current
+		if current == target {
+			s.settled = true
+		}
+	default:
+		i = s.advance(ramp)
+	}
+
+	// Hold the target for the rest of the block once the ramp is done
+	final := float32(s.current)
+	for ; i < len(ramp); i++ {
+		ramp[i] = final
+	}
+	return false
+}
+
+// advance runs a fixed-length ramp and returns how many samples it wrote
+func (s *Smoother) advance(ramp []float32) int {
+	count := s.remaining
+	if count > len(ramp) {
+		count = len(ramp)
+	}
+	current, step := s.current, s.step
+	if s.geometric {
+		for i := 0; i < count; i++ {
+			current *= step
+			ramp[i] = float32(current)
+		}
+	} else {
+		for i := 0; i < count; i++ {
+			current += step
+			ramp[i] = float32(current)
+		}
+	}
+	s.remaining -= count
+	if s.remaining == 0 {
+		// Land exactly on the target whatever the accumulated rounding
+		current = s.target
+		if count > 0 {
+			ramp[count-1] = float32(current)
+		}
+		s.settled = true
+	}
+	s.current = current
+	return count
+}
+
+// Value returns the smoothed value at the end of the last processed block
+func (s *Smoother) Value() float64 {
+	return s.current
+}
+
+// Target returns the value the smoother is moving towards
+func (s *Smoother) Target() float64 {
+	return s.target
+}
+
+// Ramp returns the per-sample values filled by the last Process call that
+// returned false
+func (s *Smoother) Ramp() []float32 {
+	return s.ramp[:s.filled]
+}
+
+// IsSettled reports whether the smoother has reached its target
+func (s *Smoother) IsSettled() bool {
+	return s.settled
+}
+
+func (s *Smoother) setTarget(target float64) {
+	s.target = target
+	samples := int(s.time*s.sampleRate + 0.5)
+	if s.mode == SmoothingNone || samples <= 0 || len(s.ramp) == 0 {
+		s.current = target
+		s.remaining = 0
+		s.settled = true
+		return
+	}
+
+	s.settled = false
+	if s.mode == SmoothingOnePole {
+		// No fixed length: runs until within smoothingEpsilon
+		return
+	}
+
+	s.remaining = samples
+	s.geometric = s.mode == SmoothingMultiplicative && s.current > 0 && target > 0
+	if s.geometric {
+		s.step = math.Exp(math.Log(target/s.current) / float64(samples))
+	} else {
+		s.step = (target - s.current) / float64(samples)
+	}
+}
+
+func (s *Smoother) updateCoefficient() {
+	s.coeff = 1 - math.Exp(-1/(s.time*s.sampleRate))
+}
+
+// Smooth attaches a smoother to a registered parameter, reading the value
+// held by the manager; it follows the value into the dense store on Freeze.
+// The smoother is prepared by PrepareSmoothers.
+func (m *Manager) Smooth(paramID uint32, mode SmoothingMode, seconds float64) (*Smoother, error) {
+	m.mutex.RLock()
+	param, exists := m.params[paramID]
+	m.mutex.RUnlock()
+
+	if !exists {
+		return nil, ErrInvalidParam
+	}
+	return m.addSmoother(newSmoother(paramID, param.bits, mode, seconds)), nil
+}
+
+// SmoothSource attaches a smoother to a registered parameter whose audio
+// thread value lives in separate atomic storage, such as a binder's
+func (m *Manager) SmoothSource(paramID uint32, source *AtomicFloat64, mode SmoothingMode, seconds float64) (*Smoother, error) {
+	if source == nil {
+		return nil, ErrInvalidParam
+	}
+
+	m.mutex.RLock()
+	_, exists := m.params[paramID]
+	m.mutex.RUnlock()
+
+	if !exists {
+		return nil, ErrInvalidParam
+	}
+	return m.addSmoother(newSmoother(paramID, &source.bits, mode, seconds)), nil
+}
+
+func (m *Manager) addSmoother(s *Smoother) *Smoother {
+	m.mutex.Lock()
+	m.smoothers = append(m.smoothers, s)
+	m.mutex.Unlock()
+	return s
+}
+
+// PrepareSmoothers sets the sample rate and block size of every attached
+// smoother. Call it from activate.
+func (m *Manager) PrepareSmoothers(sampleRate float64, maxFrames uint32) {
+	m.mutex.RLock()
+	defer m.mutex.RUnlock()
+
+	for _, s := range m.smoothers {
+		s.Prepare(sampleRate, maxFrames)
+	}
+}
+
+// ResetSmoothers makes every attached smoother jump to its parameter's
+// current value, e.g. after a reset or state load
+func (m *Manager) ResetSmoothers() {
+	m.mutex.RLock()
+	defer m.mutex.RUnlock()
+
+	for _, s := range m.smoothers {
+		s.Reset()
+	}
+}
@@ -9,6 +9,7 @@ import (
 	"github.com/justyntemme/clapgo/pkg/event"
 	hostpkg "github.com/justyntemme/clapgo/pkg/host"
 	"github.com/justyntemme/clapgo/pkg/param"
+	"github.com/justyntemme/clapgo/pkg/process"
 	"github.com/justyntemme/clapgo/pkg/state"
 	"github.com/justyntemme/clapgo/pkg/thread"
 )
@@ -27,6 +28,7 @@ type PluginBase struct {
 	ParamManager *param.Manager
 	StateManager *state.Manager
 	Logger       *hostpkg.Logger
+	LogRing      *hostpkg.LogRing // audio-thread logging, flushed on the main thread
 	
 	// Extensions
 	ThreadCheck  *thread.Checker
@@ -37,6 +39,11 @@ type PluginBase struct {
 	
 	// Diagnostics
 	PoolDiagnostics event.Diagnostics
+	Profiler        process.Profiler // opt-in process timing
+	
+	// Tail reported by the tail extension, and the silence countdown that
+	// turns it into ProcessTail/ProcessSleep
+	Tail process.TailTracker
 }
 
 // NewPluginBase creates a new plugin base with common initialization
@@ -55,6 +62,7 @@ func NewPluginBase(info Info) *PluginBase {
 func (b *PluginBase) InitWithHost(host unsafe.Pointer) {
 	b.Host = host
 	b.Logger = hostpkg.NewLogger(host)
+	b.LogRing = hostpkg.NewLogRing(b.Logger, hostpkg.DefaultLogRingSize, b.requestCallback)
 	
 	if host != nil {
 		// Initialize thread checker
@@ -73,6 +81,13 @@ func (b *PluginBase) CommonInit() error {
 	// Mark main thread for debug builds
 	thread.SetMainThread()
 	
+	// Parameters are registered by now; freeze them so the audio thread
+	// reads and writes them without locks
+	b.ParamManager.Freeze()
+	
+	// Process timing is opt-in, per session, through the environment
+	b.Profiler.EnableFromEnv(b.LogRing)
+	
 	if b.Logger != nil {
 		b.Logger.Info(fmt.Sprintf("[%s] Plugin initialized", b.Info.Name))
 		b.Logger.Debug(fmt.Sprintf("[%s] Plugin ID: %s, Version: %s", b.Info.Name, b.Info.ID, b.Info.Version))
@@ -112,6 +127,7 @@ func (b *PluginBase) CommonActivate(sampleRate float64, minFrames, maxFrames uin
 	
 	b.SampleRate = sampleRate
 	b.IsActivated = true
+	b.Tail.Reset()
 	
 	if b.Logger != nil {
 		b.Logger.Info(fmt.Sprintf("[%s] Plugin activated - Sample rate: %.0f Hz, Frame range: %d-%d", 
@@ -165,6 +181,8 @@ func (b *PluginBase) CommonStopProcessing() {
 
 // CommonReset resets plugin state
 func (b *PluginBase) CommonReset() {
+	b.Tail.Reset()
+	
 	if b.Logger != nil {
 		b.Logger.Debug("Plugin reset")
 	}
@@ -186,19 +204,36 @@ func (b *PluginBase) GetLatency() uint32 {
 	return 0
 }
 
-// GetTail returns 0 by default (no tail)
+// GetTail returns the tail set on b.Tail, 0 unless the plugin set one
 func (b *PluginBase) GetTail() uint32 {
-	return 0
+	return b.Tail.Tail()
 }
 
-// OnTimer does nothing by default
+// OnTimer flushes the log ring, for hosts that are slow to honour callback
+// requests
 func (b *PluginBase) OnTimer(timerID uint64) {
-	// Default implementation does nothing
+	b.LogRing.Flush()
 }
 
-// OnMainThread does nothing by default
+// OnMainThread notifies parameter listeners of changes made on the audio
+// thread and forwards anything it logged to the host
 func (b *PluginBase) OnMainThread() {
-	// Default implementation does nothing
+	b.ParamManager.DispatchChanges()
+	b.LogRing.Flush()
+}
+
+// EnableParamChangeQueue defers parameter listener notification from the
+// audio thread to OnMainThread. It is opt-in: a plugin that enables it must
+// call ParamManager.EndBlock at the end of every process call, or listeners
+// are never notified. Call it from Init, after CommonInit.
+// [main-thread]
+func (b *PluginBase) EnableParamChangeQueue() error {
+	return b.ParamManager.EnableChangeQueue(b.requestCallback)
+}
+
+// requestCallback asks the host for an OnMainThread call
+func (b *PluginBase) requestCallback() {
+	hostpkg.RequestCallback(b.Host)
 }
 
 // LoadPresetFromLocation returns an error by default (no preset loading)
@@ -341,7 +376,7 @@ func (b *PluginBase) OnTrackInfoChanged() {
 // This simplifies the common pattern of saving plugin state to a stream
 func (b *PluginBase) SaveStateWithParams(stream unsafe.Pointer, params map[uint32]float64) error {
 	// Create output stream
-	outStream := state.NewClapOutputStream(stream)
+	outStream := state.NewBufferedClapOutputStream(stream)
 	
 	// Convert parameter map to slice
 	var parameters []state.Parameter
@@ -363,17 +398,16 @@ func (b *PluginBase) SaveStateWithParams(stream unsafe.Pointer, params map[uint3
 	// Create state
 	pluginState := b.StateManager.CreateState(parameters, nil)
 	
-	// Serialize to JSON
-	data, err := b.StateManager.SaveToJSON(pluginState)
-	if err != nil {
+	// Serialize in the manager's format (binary unless set to JSON) and
+	// push it to the host in as few calls as the buffer allows
+	if err := b.StateManager.WriteState(outStream, pluginState); err != nil {
 		if b.Logger != nil {
 			b.Logger.Error(fmt.Sprintf("Failed to serialize state: %v", err))
 		}
 		return fmt.Errorf("failed to serialize state: %w", err)
 	}
 	
-	// Write to stream
-	if err := outStream.WriteBytes(data); err != nil {
+	if err := outStream.Flush(); err != nil {
 		if b.Logger != nil {
 			b.Logger.Error(fmt.Sprintf("Failed to write state: %v", err))
 		}
@@ -381,7 +415,7 @@ func (b *PluginBase) SaveStateWithParams(stream unsafe.Pointer, params map[uint3
 	}
 	
 	if b.Logger != nil {
-		b.Logger.Debug(fmt.Sprintf("State saved successfully (%d bytes)", len(data)))
+		b.Logger.Debug(fmt.Sprintf("State saved successfully (%d parameters)", len(parameters)))
 	}
 	
 	return nil
@@ -393,36 +427,9 @@ func (b *PluginBase) LoadStateWithCallback(stream unsafe.Pointer, applyParam fun
 	// Create input stream
 	inStream := state.NewClapInputStream(stream)
 	
-	// Read all data from stream
-	const maxStateSize = 1024 * 1024 // 1MB max state size
-	data := make([]byte, 0, 4096)
-	buf := make([]byte, 4096)
-	
-	for {
-		n, err := inStream.Read(buf)
-		if n > 0 {
-			data = append(data, buf[:n]...)
-			if len(data) > maxStateSize {
-				if b.Logger != nil {
-					b.Logger.Error(fmt.Sprintf("State size exceeds maximum (%d bytes)", maxStateSize))
-				}
-				return ErrInvalidState
-			}
-		}
-		if err != nil || n == 0 {
-			break
-		}
-	}
-	
-	if len(data) == 0 {
-		if b.Logger != nil {
-			b.Logger.Error("No state data found")
-		}
-		return ErrInvalidState
-	}
-	
-	// Parse state
-	pluginState, err := b.StateManager.LoadFromJSON(data)
+	// Parse state; binary and JSON are both accepted, and older versions
+	// go through the manager's migration chain
+	pluginState, err := b.StateManager.LoadState(inStream)
 	if err != nil {
 		if b.Logger != nil {
 			b.Logger.Error(fmt.Sprintf("Failed to parse state: %v", err))
@@ -0,0 +1,93 @@
+package plugin_test
+
+import (
+	"runtime/cgo"
+	"testing"
+	"unsafe"
+
+	"github.com/justyntemme/clapgo/internal/clapfake"
+	"github.com/justyntemme/clapgo/pkg/plugin"
+)
+
+type dispatchPlugin struct {
+	calls int
+}
+
+// BenchmarkInstanceDispatch measures resolving the plugin pointer an export
+// receives, through a cgo.Handle or from plugin.Instances
+func BenchmarkInstanceDispatch(b *testing.B) {
+	b.Run("handle", func(b *testing.B) { benchInstanceDispatch(b, false) })
+	b.Run("pinned", func(b *testing.B) { benchInstanceDispatch(b, true) })
+}
+
+func benchInstanceDispatch(b *testing.B, pinned bool) {
+	var instances plugin.Instances[dispatchPlugin]
+	p := &dispatchPlugin{}
+	var token unsafe.Pointer
+	if pinned {
+		token = clapfake.Pointer(instances.Add(p))
+		defer instances.Remove(token)
+	} else {
+		handle := cgo.NewHandle(p)
+		token = clapfake.Pointer(uintptr(handle))
+		defer handle.Delete()
+	}
+
+	b.ReportAllocs()
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		if pinned {
+			instances.Get(token).calls++
+		} else {
+			cgo.Handle(token).Value().(*dispatchPlugin).calls++
+		}
+	}
+}
+
+func TestInstances(t *testing.T) {
+	var instances plugin.Instances[dispatchPlugin]
+	p, other := &dispatchPlugin{}, &dispatchPlugin{}
+	handle := instances.Add(p)
+	token := clapfake.Pointer(handle)
+
+	if got := instances.Get(token); got != p {
+		t.Fatalf("Get returned %p, want %p", got, p)
+	}
+	if again := instances.Add(p); again != handle {
+		t.Fatalf("second Add of the same instance returned %#x, want %#x", again, handle)
+	}
+	otherToken := clapfake.Pointer(instances.Add(other))
+	if instances.Get(otherToken) != other || otherToken == token {
+		t.Fatal("a second instance did not get a handle of its own")
+	}
+
+	// Two references: the first Remove must keep the instance live
+	instances.Remove(token)
+	if !instances.Has(token) || instances.Get(token) != p {
+		t.Fatal("instance removed while a reference was left")
+	}
+	instances.Remove(token)
+	if instances.Has(token) {
+		t.Fatal("instance still live after its last Remove")
+	}
+	if !instances.Has(otherToken) {
+		t.Fatal("removing one instance removed another")
+	}
+	instances.Remove(token) // unknown by now, must be ignored
+	if instances.Has(token) {
+		t.Fatal("removing an unknown handle revived it")
+	}
+
+	// Adding a removed instance again pins it afresh with one reference
+	if readded := instances.Add(p); readded != handle {
+		t.Fatalf("re-Add returned %#x, want the instance's address %#x", readded, handle)
+	}
+	instances.Remove(token)
+	if instances.Has(token) {
+		t.Fatal("re-added instance kept a stale reference count")
+	}
+	instances.Remove(otherToken)
+	if instances.Has(otherToken) {
+		t.Fatal("second instance still live after Remove")
+	}
+}
@@ -0,0 +1,83 @@
+package plugin
+
+import (
+	"runtime"
+	"sync"
+	"unsafe"
+)
+
+// Instances hands the C bridge the address of each plugin instance, so the
+// exports dispatch on the pointer go_plugin_data_t already holds instead of
+// resolving a cgo.Handle, a sync.Map lookup and a type assertion, on every
+// call. Each instance is pinned from ClapGo_CreatePlugin to
+// ClapGo_PluginDestroy, which is what lets C keep its address.
+//
+// Declare one per plugin type:
+//
+//	var instances plugin.Instances[MyPlugin]
+//
+// The address goes back to C as an integer. cgo rejects a pinned pointer as
+// an export result when the object holds Go pointers of its own, and C only
+// ever passes it back, so nothing is lost.
+type Instances[T any] struct {
+	mu     sync.Mutex
+	pinned map[*T]*pinnedInstance
+}
+
+type pinnedInstance struct {
+	pinner runtime.Pinner
+	refs   int // creates of the same object not yet destroyed
+}
+
+// Add pins p and returns the value for ClapGo_CreatePlugin to return.
+// Adding an object that is already live counts another reference, for
+// plugins that hand the host one shared object.
+// [main-thread]
+func (r *Instances[T]) Add(p *T) uintptr {
+	r.mu.Lock()
+	defer r.mu.Unlock()
+	if r.pinned == nil {
+		r.pinned = make(map[*T]*pinnedInstance)
+	}
+	entry := r.pinned[p]
+	if entry == nil {
+		entry = &pinnedInstance{}
+		entry.pinner.Pin(p)
+		r.pinned[p] = entry
+	}
+	entry.refs++
+	return uintptr(unsafe.Pointer(p))
+}
+
+// Get returns the instance behind the plugin pointer the bridge passes to
+// every export. It is a conversion, so the audio thread can call it freely.
+// [thread-safe]
+func (r *Instances[T]) Get(plugin unsafe.Pointer) *T {
+	return (*T)(plugin)
+}
+
+// Has reports whether plugin is live, that is added and not yet removed as
+// often. Get does not check, so use Has for assertions off the audio thread.
+// [main-thread]
+func (r *Instances[T]) Has(plugin unsafe.Pointer) bool {
+	r.mu.Lock()
+	defer r.mu.Unlock()
+	return r.pinned[(*T)(plugin)] != nil
+}
+
+// Remove drops the reference Add returned plugin for, and unpins the
+// instance with its last one. Call it from ClapGo_PluginDestroy.
+// [main-thread]
+func (r *Instances[T]) Remove(plugin unsafe.Pointer) {
+	p := (*T)(plugin)
+	r.mu.Lock()
+	defer r.mu.Unlock()
+	entry := r.pinned[p]
+	if entry == nil {
+		return
+	}
+	if entry.refs--; entry.refs == 0 {
+		entry.pinner.Unpin()
+		delete(r.pinned, p)
+	}
+}
@@ -3,6 +3,7 @@ package plugin
 import (
 	"context"
 	"errors"
+	"strconv"
 	"unsafe"
 )
 
@@ -180,9 +181,9 @@ type ParameterError struct {
 
 func (e *ParameterError) Error() string {
 	if e.Value != 0 {
-		return "param " + e.Op + " " + string(e.ParamID) + " value " + string(int(e.Value)) + ": " + e.Err.Error()
+		return "param " + e.Op + " " + strconv.FormatUint(uint64(e.ParamID), 10) + " value " + strconv.FormatFloat(e.Value, 'g', -1, 64) + ": " + e.Err.Error()
 	}
-	return "param " + e.Op + " " + string(e.ParamID) + ": " + e.Err.Error()
+	return "param " + e.Op + " " + strconv.FormatUint(uint64(e.ParamID), 10) + ": " + e.Err.Error()
 }
 
 func (e *ParameterError) Unwrap() error {
@@ -197,7 +198,7 @@ type ProcessError struct {
 }
 
 func (e *ProcessError) Error() string {
-	return "process frame " + string(e.Frame) + " channel " + string(e.Channel) + ": " + e.Err.Error()
+	return "process frame " + strconv.FormatUint(uint64(e.Frame), 10) + " channel " + strconv.FormatUint(uint64(e.Channel), 10) + ": " + e.Err.Error()
 }
 
 func (e *ProcessError) Unwrap() error {
@@ -0,0 +1,40 @@
+package plugin
+
+// #include "../../src/c/runtime_stats.h"
+import "C"
+import (
+	"runtime"
+)
+
+// ClapGo_RuntimeStats reports Go allocation and GC counters to offline
+// tools such as the benchmark host. pause_max_ns covers the collections
+// after sinceGC that the runtime still remembers (the last 256).
+//
+//export ClapGo_RuntimeStats
+func ClapGo_RuntimeStats(sinceGC C.uint32_t, out *C.clapgo_runtime_stats_t) {
+	if out == nil {
+		return
+	}
+
+	var ms runtime.MemStats
+	runtime.ReadMemStats(&ms)
+
+	var pauseMax uint64
+	since := uint32(sinceGC)
+	if ms.NumGC-since > uint32(len(ms.PauseNs)) {
+		since = ms.NumGC - uint32(len(ms.PauseNs))
+	}
+	for gc := since + 1; gc <= ms.NumGC; gc++ {
+		if pause := ms.PauseNs[(gc+255)%256]; pause > pauseMax {
+			pauseMax = pause
+		}
+	}
+
+	out.mallocs = C.uint64_t(ms.Mallocs)
+	out.frees = C.uint64_t(ms.Frees)
+	out.total_alloc_bytes = C.uint64_t(ms.TotalAlloc)
+	out.heap_alloc_bytes = C.uint64_t(ms.HeapAlloc)
+	out.num_gc = C.uint32_t(ms.NumGC)
+	out.pause_total_ns = C.uint64_t(ms.PauseTotalNs)
+	out.pause_max_ns = C.uint64_t(pauseMax)
+}
@@ -0,0 +1,42 @@
+package process_test
+
+import (
+	"testing"
+
+	"github.com/justyntemme/clapgo/pkg/process"
+)
+
+// BenchmarkProfiler measures the hooks one block pays for
+func BenchmarkProfiler(b *testing.B) {
+	b.Run("disabled", func(b *testing.B) { benchProfiler(b, false) })
+	b.Run("enabled", func(b *testing.B) { benchProfiler(b, true) })
+}
+
+func benchProfiler(b *testing.B, enabled bool) {
+	var p process.Profiler
+	if enabled {
+		p.Enable()
+	}
+	b.ReportAllocs()
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		p.Begin()
+		p.Mark(process.StageEvents)
+		p.Mark(process.StageDSP)
+		p.End(512, 48000)
+	}
+}
+
+func TestProfilerAllocs(t *testing.T) {
+	var p process.Profiler
+	p.Enable()
+
+	allocs := testing.AllocsPerRun(100, func() {
+		p.Begin()
+		p.Mark(process.StageEvents)
+		p.End(512, 48000)
+	})
+	if allocs != 0 {
+		t.Errorf("Profiler: %.1f allocs per block, want 0", allocs)
+	}
+}
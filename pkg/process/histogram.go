@@ -0,0 +1,133 @@
+package process
+
+import (
+	"math/bits"
+	"sync/atomic"
+)
+
+// Histogram layout: values below histogramSubBuckets get a bucket each;
+// above that every power of two is split into histogramSubBuckets/2 linear
+// buckets, so any recorded value is known to within 1/32 (about 3%) of
+// itself, as in an HDR histogram.
+const (
+	histogramSubBits    = 6
+	histogramSubBuckets = 1 << histogramSubBits
+	histogramHalf       = histogramSubBuckets / 2
+	histogramMaxShift   = 40 - histogramSubBits + 1 // values up to 2^40
+	histogramBuckets    = histogramSubBuckets + histogramMaxShift*histogramHalf
+)
+
+// Histogram records non-negative integer samples, such as nanoseconds, into
+// fixed log-linear buckets. Record is wait-free and never allocates; it
+// must be called from one thread at a time. Any thread may read.
+type Histogram struct {
+	counts [histogramBuckets]atomic.Uint64
+	count  atomic.Uint64
+	sum    atomic.Uint64
+	max    atomic.Uint64
+}
+
+// HistogramStats summarises a histogram. Percentiles are the upper edge of
+// the bucket holding them, capped at Max.
+type HistogramStats struct {
+	Count uint64
+	Mean  float64
+	P50   uint64
+	P99   uint64
+	P999  uint64
+	Max   uint64
+}
+
+func histogramIndex(v uint64) int {
+	if v < histogramSubBuckets {
+		return int(v)
+	}
+	shift := bits.Len64(v) - histogramSubBits
+	if shift > histogramMaxShift {
+		return histogramBuckets - 1
+	}
+	top := int(v >> uint(shift)) // in [histogramHalf, histogramSubBuckets)
+	return histogramSubBuckets + (shift-1)*histogramHalf + top - histogramHalf
+}
+
+// histogramUpper returns the largest value that lands in bucket index
+func histogramUpper(index int) uint64 {
+	if index < histogramSubBuckets {
+		return uint64(index)
+	}
+	index -= histogramSubBuckets
+	shift := uint(index/histogramHalf + 1)
+	top := uint64(index%histogramHalf + histogramHalf)
+	return (top+1)<<shift - 1
+}
+
+// Record adds one sample. Single writer: the counters are updated with
+// plain load/store pairs rather than read-modify-write instructions.
+func (h *Histogram) Record(v uint64) {
+	c := &h.counts[histogramIndex(v)]
+	c.Store(c.Load() + 1)
+	h.sum.Store(h.sum.Load() + v)
+	if v > h.max.Load() {
+		h.max.Store(v)
+	}
+	// Count last, so a reader never sees more samples than bucket entries
+	h.count.Store(h.count.Load() + 1)
+}
+
+// Count returns the number of recorded samples
+func (h *Histogram) Count() uint64 {
+	return h.count.Load()
+}
+
+// Max returns the largest recorded sample
+func (h *Histogram) Max() uint64 {
+	return h.max.Load()
+}
+
+// Stats computes the summary in one pass over the buckets. It does not
+// allocate, so the audio thread may call it for periodic dumps.
+func (h *Histogram) Stats() HistogramStats {
+	stats := HistogramStats{
+		Count: h.count.Load(),
+		Max:   h.max.Load(),
+	}
+	if stats.Count == 0 {
+		return stats
+	}
+	stats.Mean = float64(h.sum.Load()) / float64(stats.Count)
+
+	// Ranks are 1-based: the sample at or below which q of the samples lie
+	rank := func(q float64) uint64 {
+		r := uint64(q*float64(stats.Count) + 0.5)
+		if r < 1 {
+			r = 1
+		}
+		return r
+	}
+	r50, r99, r999 := rank(0.5), rank(0.99), rank(0.999)
+
+	var seen uint64
+	have50, have99 := false, false
+	for i := range h.counts {
+		n := h.counts[i].Load()
+		if n == 0 {
+			continue
+		}
+		seen += n
+		upper := histogramUpper(i)
+		if upper > stats.Max {
+			upper = stats.Max
+		}
+		if !have50 && seen >= r50 {
+			stats.P50, have50 = upper, true
+		}
+		if !have99 && seen >= r99 {
+			stats.P99, have99 = upper, true
+		}
+		if seen >= r999 {
+			stats.P999 = upper
+			break
+		}
+	}
+	return stats
+}
@@ -0,0 +1,210 @@
+package process
+
+import (
+	"os"
+	"sync/atomic"
+	"time"
+
+	"github.com/justyntemme/clapgo/pkg/host"
+)
+
+// Stage is a part of the process callback timed separately by a Profiler
+type Stage int
+
+const (
+	// StageEvents covers decoding and dispatching input events
+	StageEvents Stage = iota
+	// StageDSP covers rendering audio
+	StageDSP
+	// StageOutput covers pushing output events and publishing telemetry
+	StageOutput
+
+	stageCount
+)
+
+// ProfileEnv names the environment variable that turns profiling on for
+// every instance, so a slow plugin can be found in a running session
+const ProfileEnv = "CLAPGO_PROFILE"
+
+// ProfileLogInterval is how many blocks pass between dumps when profiling
+// is enabled from the environment
+const ProfileLogInterval = 1000
+
+// epoch anchors the monotonic clock the profiler reads
+var epoch = time.Now()
+
+func nanotime() int64 {
+	return int64(time.Since(epoch))
+}
+
+// profileData is one generation of measurements. Enable and Reset publish a
+// fresh one, so the main thread never writes memory the audio thread uses.
+type profileData struct {
+	total    Histogram
+	stages   [stageCount]Histogram
+	load     Histogram // block wall time in parts per million of its deadline
+	overruns atomic.Uint64
+}
+
+// profileLog configures periodic dumps through a log ring
+type profileLog struct {
+	ring       *host.LogRing
+	every      uint64
+	formatTime host.LogFormat
+	formatLoad host.LogFormat
+}
+
+// Profiler measures the process callback: wall time per block, the time
+// spent in each Stage and the block's share of its real-time deadline
+// (frames / sample rate). It is off until Enable; while off, each hook is
+// one atomic load.
+//
+// Begin, Mark and End belong to the audio thread. Enable, Disable, Reset,
+// Report and LogTo belong to the main thread. The zero value is ready.
+type Profiler struct {
+	data atomic.Pointer[profileData]
+	log  atomic.Pointer[profileLog]
+
+	// Audio thread only
+	current    *profileData
+	blockStart int64
+	lastMark   int64
+	blocks     uint64
+}
+
+// ProfileReport is a snapshot of a profiler's measurements. Times are in
+// nanoseconds and Load in parts per million of the block deadline, so a
+// Load.P99 of 250000 means the slowest 1% of blocks used a quarter of the
+// time available to them.
+type ProfileReport struct {
+	Total    HistogramStats
+	Events   HistogramStats
+	DSP      HistogramStats
+	Output   HistogramStats
+	Load     HistogramStats
+	Overruns uint64 // blocks that took longer than their deadline
+}
+
+// Enable starts collecting, keeping any measurements already taken
+func (p *Profiler) Enable() {
+	if p.data.Load() == nil {
+		p.data.Store(new(profileData))
+	}
+}
+
+// Disable stops collecting and discards the measurements
+func (p *Profiler) Disable() {
+	p.data.Store(nil)
+}
+
+// Enabled reports whether the profiler is collecting
+func (p *Profiler) Enabled() bool {
+	return p.data.Load() != nil
+}
+
+// Reset discards the measurements taken so far and keeps collecting
+func (p *Profiler) Reset() {
+	if p.data.Load() != nil {
+		p.data.Store(new(profileData))
+	}
+}
+
+// LogTo has the audio thread write a summary to ring every everyBlocks
+// blocks; a nil ring or zero interval stops it. Register the formats here,
+// on the main thread, before processing starts.
+func (p *Profiler) LogTo(ring *host.LogRing, everyBlocks uint64) {
+	if ring == nil || everyBlocks == 0 {
+		p.log.Store(nil)
+		return
+	}
+	p.log.Store(&profileLog{
+		ring:       ring,
+		every:      everyBlocks,
+		formatTime: ring.Register(host.SeverityInfo, "process time us: p50 %.1f p99 %.1f p999 %.1f max %.1f"),
+		formatLoad: ring.Register(host.SeverityInfo, "process load %%: p99 %.1f max %.1f, %d overruns"),
+	})
+}
+
+// EnableFromEnv enables the profiler, dumping through ring, when ProfileEnv
+// is set to anything but "" or "0". It reports whether it did.
+func (p *Profiler) EnableFromEnv(ring *host.LogRing) bool {
+	if v := os.Getenv(ProfileEnv); v == "" || v == "0" {
+		return false
+	}
+	p.Enable()
+	p.LogTo(ring, ProfileLogInterval)
+	return true
+}
+
+// Begin starts timing a block
+func (p *Profiler) Begin() {
+	p.current = p.data.Load()
+	if p.current == nil {
+		return
+	}
+	now := nanotime()
+	p.blockStart = now
+	p.lastMark = now
+}
+
+// Mark attributes the time since Begin or the previous Mark to stage
+func (p *Profiler) Mark(stage Stage) {
+	if p.current == nil {
+		return
+	}
+	now := nanotime()
+	p.current.stages[stage].Record(uint64(now - p.lastMark))
+	p.lastMark = now
+}
+
+// End finishes timing a block of frames at sampleRate
+func (p *Profiler) End(frames uint32, sampleRate float64) {
+	d := p.current
+	if d == nil {
+		return
+	}
+	p.current = nil
+
+	elapsed := nanotime() - p.blockStart
+	d.total.Record(uint64(elapsed))
+	if frames > 0 && sampleRate > 0 {
+		deadline := float64(frames) / sampleRate * 1e9
+		d.load.Record(uint64(float64(elapsed) * 1e6 / deadline))
+		if float64(elapsed) > deadline {
+			d.overruns.Store(d.overruns.Load() + 1)
+		}
+	}
+
+	p.blocks++
+	if l := p.log.Load(); l != nil && p.blocks%l.every == 0 {
+		p.dump(d, l)
+	}
+}
+
+func (p *Profiler) dump(d *profileData, l *profileLog) {
+	t := d.total.Stats()
+	l.ring.Log(l.formatTime,
+		host.FloatArg(float64(t.P50)/1e3), host.FloatArg(float64(t.P99)/1e3),
+		host.FloatArg(float64(t.P999)/1e3), host.FloatArg(float64(t.Max)/1e3))
+
+	load := d.load.Stats()
+	l.ring.Log(l.formatLoad,
+		host.FloatArg(float64(load.P99)/1e4), host.FloatArg(float64(load.Max)/1e4),
+		host.IntArg(int64(d.overruns.Load())))
+}
+
+// Report returns the measurements so far; empty when disabled
+func (p *Profiler) Report() ProfileReport {
+	d := p.data.Load()
+	if d == nil {
+		return ProfileReport{}
+	}
+	return ProfileReport{
+		Total:    d.total.Stats(),
+		Events:   d.stages[StageEvents].Stats(),
+		DSP:      d.stages[StageDSP].Stats(),
+		Output:   d.stages[StageOutput].Stats(),
+		Load:     d.load.Stats(),
+		Overruns: d.overruns.Load(),
+	}
+}
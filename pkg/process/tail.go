@@ -0,0 +1,66 @@
+package process
+
+import (
+	"math"
+	"sync/atomic"
+)
+
+// TailInfinite is the tail of a plugin that may keep producing output
+// forever after its input goes quiet. CLAP treats any tail of INT32_MAX or
+// more as infinite.
+const TailInfinite = math.MaxInt32
+
+// TailTracker turns input silence into the process status that lets the
+// host put an instance to sleep. While the input is audible a block
+// returns ProcessContinue. Once it goes silent the tracker counts the
+// plugin's tail down, returning ProcessTail until it has elapsed and
+// ProcessSleep after. The host stops calling process then, until new
+// events or input arrive.
+//
+// The tail is what the tail extension reports, so set it wherever the
+// plugin's tail changes and tell the host with host.TailNotifier.
+type TailTracker struct {
+	tail  atomic.Uint32
+	quiet uint64 // samples of silent input since the last audible block
+}
+
+// SetTail sets the tail length in samples; TailInfinite never sleeps
+func (t *TailTracker) SetTail(samples uint32) {
+	t.tail.Store(samples)
+}
+
+// Tail returns the tail length in samples
+func (t *TailTracker) Tail() uint32 {
+	return t.tail.Load()
+}
+
+// Reset forgets any silence counted so far, like a fresh activation
+// [audio-thread]
+func (t *TailTracker) Reset() {
+	t.quiet = 0
+}
+
+// Status records a block of frames and returns the status to hand back to
+// the host. inputSilent is whether every input channel was silent for the
+// whole block; instruments pass whether anything is still sounding
+// instead.
+// [audio-thread]
+func (t *TailTracker) Status(inputSilent bool, frames uint32) int {
+	if !inputSilent {
+		t.quiet = 0
+		return ProcessContinue
+	}
+
+	tail := t.tail.Load()
+	if tail >= TailInfinite {
+		return ProcessContinue
+	}
+
+	// The block that finishes the tail is still delivered, so it can
+	// already report sleep
+	t.quiet += uint64(frames)
+	if t.quiet >= uint64(tail) {
+		return ProcessSleep
+	}
+	return ProcessTail
+}
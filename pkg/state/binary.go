@@ -0,0 +1,344 @@
+package state
+
+import (
+	"bytes"
+	"encoding/binary"
+	"encoding/json"
+	"errors"
+	"fmt"
+	"io"
+	"math"
+)
+
+// Binary state layout, little-endian throughout. src/c/state_converter.c
+// reads and writes the same layout, so keep the two in step.
+//
+//	magic        [4]byte  "CGST"
+//	format       uint16   BinaryFormatVersion
+//	flags        uint16   reserved, zero
+//	length       uint32   bytes of body that follow
+//	body:
+//	  version    uint32   State Version
+//	  saved_at   int64
+//	  plugin_id, plugin_name, format_type   str16
+//	  param_count   uint32
+//	  params:       id uint32, value float64, name str16
+//	  chunk_count   uint32
+//	  chunks:       id str16, length uint32, data
+//
+// str16 is a uint16 byte length followed by the bytes. Readers skip chunks
+// they do not know, and body bytes after the last chunk, so later format
+// revisions can append fields without breaking older plugins.
+const (
+	binaryMagic = "CGST"
+
+	// BinaryFormatVersion is the layout revision written by this package,
+	// independent of the plugin's own state Version
+	BinaryFormatVersion = 1
+
+	binaryPreambleSize = 12
+
+	// MaxStateSize bounds the body a reader accepts, in either format
+	MaxStateSize = 16 << 20
+
+	// CustomDataChunkID is the chunk State.CustomData travels in. It is
+	// JSON, since the values are arbitrary; plugins that care about load
+	// time should store their data in chunks of their own instead.
+	CustomDataChunkID = "clapgo.custom_data"
+)
+
+// Binary format errors
+var (
+	ErrUnknownFormat  = errors.New("unrecognized state format")
+	ErrTruncatedState = errors.New("truncated state")
+	ErrStateTooLarge  = errors.New("state exceeds maximum size")
+	ErrFormatTooNew   = errors.New("binary state format too new")
+	ErrFieldTooLong   = errors.New("state field too long")
+)
+
+// Chunk is an opaque, named block of plugin data carried with the state
+type Chunk struct {
+	ID   string `json:"id"`
+	Data []byte `json:"data"`
+}
+
+// IsBinaryState reports whether data starts with the binary state magic
+func IsBinaryState(data []byte) bool {
+	return len(data) >= len(binaryMagic) && string(data[:len(binaryMagic)]) == binaryMagic
+}
+
+// AppendBinary appends the binary encoding of state to buf and returns the
+// extended buffer. It does not validate; Manager.SaveToBinary does.
+func AppendBinary(buf []byte, state *State) ([]byte, error) {
+	var custom []byte
+	if len(state.CustomData) > 0 {
+		var err error
+		if custom, err = json.Marshal(state.CustomData); err != nil {
+			return buf, fmt.Errorf("failed to marshal custom data: %w", err)
+		}
+	}
+
+	size, err := binaryBodySize(state, custom)
+	if err != nil {
+		return buf, err
+	}
+	if size > MaxStateSize {
+		return buf, ErrStateTooLarge
+	}
+
+	buf = grow(buf, binaryPreambleSize+size)
+	buf = append(buf, binaryMagic...)
+	buf = binary.LittleEndian.AppendUint16(buf, BinaryFormatVersion)
+	buf = binary.LittleEndian.AppendUint16(buf, 0)
+	buf = binary.LittleEndian.AppendUint32(buf, uint32(size))
+
+	buf = binary.LittleEndian.AppendUint32(buf, uint32(state.Header.Version))
+	buf = binary.LittleEndian.AppendUint64(buf, uint64(state.Header.SavedAt))
+	buf = appendStr16(buf, state.Header.PluginID)
+	buf = appendStr16(buf, state.Header.PluginName)
+	buf = appendStr16(buf, state.Header.FormatType)
+
+	buf = binary.LittleEndian.AppendUint32(buf, uint32(len(state.Parameters)))
+	for i := range state.Parameters {
+		p := &state.Parameters[i]
+		buf = binary.LittleEndian.AppendUint32(buf, p.ID)
+		buf = binary.LittleEndian.AppendUint64(buf, math.Float64bits(p.Value))
+		buf = appendStr16(buf, p.Name)
+	}
+
+	chunks := len(state.Chunks)
+	if custom != nil {
+		chunks++
+	}
+	buf = binary.LittleEndian.AppendUint32(buf, uint32(chunks))
+	for i := range state.Chunks {
+		buf = appendChunk(buf, state.Chunks[i].ID, state.Chunks[i].Data)
+	}
+	if custom != nil {
+		buf = appendChunk(buf, CustomDataChunkID, custom)
+	}
+
+	return buf, nil
+}
+
+// binaryBodySize is the encoded body length, so the buffer is sized once
+// and the length prefix is known before anything is written
+func binaryBodySize(state *State, custom []byte) (int, error) {
+	size := 4 + 8 + 4 + 4
+	for _, s := range [...]string{state.Header.PluginID, state.Header.PluginName, state.Header.FormatType} {
+		if len(s) > math.MaxUint16 {
+			return 0, ErrFieldTooLong
+		}
+		size += 2 + len(s)
+	}
+	for i := range state.Parameters {
+		if len(state.Parameters[i].Name) > math.MaxUint16 {
+			return 0, ErrFieldTooLong
+		}
+		size += 4 + 8 + 2 + len(state.Parameters[i].Name)
+	}
+	for i := range state.Chunks {
+		if len(state.Chunks[i].ID) > math.MaxUint16 {
+			return 0, ErrFieldTooLong
+		}
+		size += 2 + len(state.Chunks[i].ID) + 4 + len(state.Chunks[i].Data)
+	}
+	if custom != nil {
+		size += 2 + len(CustomDataChunkID) + 4 + len(custom)
+	}
+	return size, nil
+}
+
+func grow(buf []byte, n int) []byte {
+	if cap(buf)-len(buf) >= n {
+		return buf
+	}
+	grown := make([]byte, len(buf), len(buf)+n)
+	copy(grown, buf)
+	return grown
+}
+
+func appendStr16(buf []byte, s string) []byte {
+	buf = binary.LittleEndian.AppendUint16(buf, uint16(len(s)))
+	return append(buf, s...)
+}
+
+func appendChunk(buf []byte, id string, data []byte) []byte {
+	buf = appendStr16(buf, id)
+	buf = binary.LittleEndian.AppendUint32(buf, uint32(len(data)))
+	return append(buf, data...)
+}
+
+// DecodeBinary decodes a complete binary state. Chunk data is copied, so
+// data may be reused once it returns. It does not validate or migrate;
+// Manager.LoadFromBinary does.
+func DecodeBinary(data []byte) (*State, error) {
+	body, err := binaryBody(data[:min(len(data), binaryPreambleSize)])
+	if err != nil {
+		return nil, err
+	}
+	if len(data)-binaryPreambleSize < body {
+		return nil, ErrTruncatedState
+	}
+	return decodeBinaryBody(data[binaryPreambleSize : binaryPreambleSize+body])
+}
+
+// binaryBody checks a preamble and returns the body length it announces
+func binaryBody(preamble []byte) (int, error) {
+	if !IsBinaryState(preamble) {
+		return 0, ErrUnknownFormat
+	}
+	if len(preamble) < binaryPreambleSize {
+		return 0, ErrTruncatedState
+	}
+	if format := binary.LittleEndian.Uint16(preamble[4:]); format > BinaryFormatVersion {
+		return 0, fmt.Errorf("%w: %d", ErrFormatTooNew, format)
+	}
+	body := binary.LittleEndian.Uint32(preamble[8:])
+	if body > MaxStateSize {
+		return 0, ErrStateTooLarge
+	}
+	return int(body), nil
+}
+
+func decodeBinaryBody(body []byte) (*State, error) {
+	d := binaryDecoder{data: body}
+	state := &State{}
+
+	state.Header.Version = Version(d.uint32())
+	state.Header.SavedAt = int64(d.uint64())
+	state.Header.PluginID = d.str16()
+	state.Header.PluginName = d.str16()
+	state.Header.FormatType = d.str16()
+
+	// Each record is at least 14 bytes, which bounds the allocation by the
+	// body actually present rather than by the count read from it
+	count := d.uint32()
+	if d.err != nil || uint64(count)*14 > uint64(d.remaining()) {
+		return nil, ErrTruncatedState
+	}
+	state.Parameters = make([]Parameter, count)
+	for i := range state.Parameters {
+		p := &state.Parameters[i]
+		p.ID = d.uint32()
+		p.Value = math.Float64frombits(d.uint64())
+		p.Name = d.str16()
+	}
+
+	count = d.uint32()
+	if d.err != nil || uint64(count)*6 > uint64(d.remaining()) {
+		return nil, ErrTruncatedState
+	}
+	for i := uint32(0); i < count; i++ {
+		id := d.str16()
+		data := d.bytes(int(d.uint32()))
+		if d.err != nil {
+			break
+		}
+		if id == CustomDataChunkID {
+			if err := json.Unmarshal(data, &state.CustomData); err != nil {
+				return nil, fmt.Errorf("failed to unmarshal custom data: %w", err)
+			}
+			continue
+		}
+		state.Chunks = append(state.Chunks, Chunk{ID: id, Data: bytes.Clone(data)})
+	}
+
+	if d.err != nil {
+		return nil, d.err
+	}
+	return state, nil
+}
+
+// binaryDecoder reads fields from a body held in memory. The first short
+// read latches ErrTruncatedState and every later read returns zero.
+type binaryDecoder struct {
+	data []byte
+	off  int
+	err  error
+}
+
+func (d *binaryDecoder) remaining() int {
+	return len(d.data) - d.off
+}
+
+func (d *binaryDecoder) bytes(n int) []byte {
+	if d.err != nil || n < 0 || n > d.remaining() {
+		d.err = ErrTruncatedState
+		return nil
+	}
+	b := d.data[d.off : d.off+n : d.off+n]
+	d.off += n
+	return b
+}
+
+func (d *binaryDecoder) uint16() uint16 {
+	if b := d.bytes(2); b != nil {
+		return binary.LittleEndian.Uint16(b)
+	}
+	return 0
+}
+
+func (d *binaryDecoder) uint32() uint32 {
+	if b := d.bytes(4); b != nil {
+		return binary.LittleEndian.Uint32(b)
+	}
+	return 0
+}
+
+func (d *binaryDecoder) uint64() uint64 {
+	if b := d.bytes(8); b != nil {
+		return binary.LittleEndian.Uint64(b)
+	}
+	return 0
+}
+
+func (d *binaryDecoder) str16() string {
+	return string(d.bytes(int(d.uint16())))
+}
+
+// ReadState reads one state from r in either format: a binary state is read
+// up to its announced length, anything starting with '{' as JSON up to EOF.
+// r should be buffered; NewClapInputStream is.
+func ReadState(r io.Reader) (*State, error) {
+	preamble := make([]byte, binaryPreambleSize)
+	n, err := io.ReadFull(r, preamble)
+	if err != nil && err != io.ErrUnexpectedEOF {
+		if err == io.EOF {
+			return nil, ErrTruncatedState
+		}
+		return nil, err
+	}
+	preamble = preamble[:n]
+
+	if IsBinaryState(preamble) {
+		size, err := binaryBody(preamble)
+		if err != nil {
+			return nil, err
+		}
+		body := make([]byte, size)
+		if _, err := io.ReadFull(r, body); err != nil {
+			if err == io.EOF || err == io.ErrUnexpectedEOF {
+				return nil, ErrTruncatedState
+			}
+			return nil, err
+		}
+		return decodeBinaryBody(body)
+	}
+
+	if trimmed := bytes.TrimLeft(preamble, " \t\r\n"); len(trimmed) == 0 || trimmed[0] != '{' {
+		return nil, ErrUnknownFormat
+	}
+	rest, err := io.ReadAll(io.LimitReader(r, MaxStateSize+1))
+	if err != nil {
+		return nil, err
+	}
+	if len(rest)+len(preamble) > MaxStateSize {
+		return nil, ErrStateTooLarge
+	}
+	var state State
+	if err := json.Unmarshal(append(preamble, rest...), &state); err != nil {
+		return nil, fmt.Errorf("failed to unmarshal state: %w", err)
+	}
+	return &state, nil
+}
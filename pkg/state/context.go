@@ -20,8 +20,14 @@ func (m *Manager) SaveWithContext(ctx context.Context, w io.Writer, state *State
 	default:
 	}
 	
-	// Marshal to JSON
-	data, err := json.MarshalIndent(state, "", "  ")
+	// Encode in the manager's format
+	var data []byte
+	var err error
+	if m.format == FormatJSON {
+		data, err = json.MarshalIndent(state, "", "  ")
+	} else {
+		data, err = AppendBinary(nil, state)
+	}
 	if err != nil {
 		return err
 	}
@@ -82,18 +88,21 @@ func (m *Manager) LoadWithContext(ctx context.Context, r io.Reader) (*State, err
 		}
 	}
 	
-	// Parse JSON
-	var state State
-	if err := json.Unmarshal(data, &state); err != nil {
-		return nil, err
+	// Decode either format, then migrate and validate
+	if IsBinaryState(data) {
+		state, err := DecodeBinary(data)
+		if err != nil {
+			return nil, err
+		}
+		return m.finishLoad(state)
 	}
 	
-	// Validate
-	if err := m.ValidateState(&state); err != nil {
+	var state State
+	if err := json.Unmarshal(data, &state); err != nil {
 		return nil, err
 	}
 	
-	return &state, nil
+	return m.finishLoad(&state)
 }
 
 // SaveAsyncResult represents the result of an async save operation
@@ -117,6 +117,9 @@ func MigrateV1ToV2(oldState *State) (*State, error) {
 		newState.CustomData[k] = v
 	}
 	
+	// Chunks are opaque to the migration, so they carry over as they are
+	newState.Chunks = append([]Chunk(nil), oldState.Chunks...)
+	
 	// Perform version-specific migrations
 	// For example, you might rename parameters, change value ranges, etc.
 	
@@ -4,6 +4,7 @@ import (
 	"encoding/json"
 	"errors"
 	"fmt"
+	"io"
 	"time"
 )
 
@@ -62,8 +63,19 @@ type State struct {
 	Header     Header                 `json:"header"`
 	Parameters []Parameter            `json:"parameters"`
 	CustomData map[string]interface{} `json:"custom_data,omitempty"`
+	Chunks     []Chunk                `json:"chunks,omitempty"` // opaque plugin data
 }
 
+// Format selects the encoding Manager.WriteState produces
+type Format int
+
+const (
+	// FormatBinary is the compact, length-prefixed format (see binary.go)
+	FormatBinary Format = iota
+	// FormatJSON is indented JSON, for export and debugging
+	FormatJSON
+)
+
 // PresetMetadata contains metadata about a preset
 type PresetMetadata struct {
 	Name        string   `json:"name"`
@@ -84,6 +96,8 @@ type Manager struct {
 	pluginID   string
 	pluginName string
 	version    Version
+	format     Format
+	migrations *MigrationChain
 }
 
 // NewManager creates a new state manager
@@ -95,6 +109,18 @@ func NewManager(pluginID, pluginName string, version Version) *Manager {
 	}
 }
 
+// SetFormat selects the format WriteState produces. Loading accepts
+// either format regardless.
+func (m *Manager) SetFormat(format Format) {
+	m.format = format
+}
+
+// SetMigrationChain sets the chain loaded states older than the manager's
+// version are migrated through before validation
+func (m *Manager) SetMigrationChain(chain *MigrationChain) {
+	m.migrations = chain
+}
+
 // CreateState creates a new state with the given parameters
 func (m *Manager) CreateState(params []Parameter, customData map[string]interface{}) *State {
 	return &State{
@@ -147,11 +173,68 @@ func (m *Manager) LoadFromJSON(data []byte) (*State, error) {
 		return nil, fmt.Errorf("failed to unmarshal state: %w", err)
 	}
 	
-	if err := m.ValidateState(&state); err != nil {
+	return m.finishLoad(&state)
+}
+
+// SaveToBinary saves state to the binary format
+func (m *Manager) SaveToBinary(state *State) ([]byte, error) {
+	if err := m.ValidateState(state); err != nil {
+		return nil, err
+	}
+	return AppendBinary(nil, state)
+}
+
+// LoadFromBinary loads state from the binary format
+func (m *Manager) LoadFromBinary(data []byte) (*State, error) {
+	state, err := DecodeBinary(data)
+	if err != nil {
+		return nil, fmt.Errorf("failed to decode state: %w", err)
+	}
+	return m.finishLoad(state)
+}
+
+// WriteState writes state to w in the manager's format with a single Write
+func (m *Manager) WriteState(w io.Writer, state *State) error {
+	var data []byte
+	var err error
+	if m.format == FormatJSON {
+		data, err = m.SaveToJSON(state)
+	} else {
+		data, err = m.SaveToBinary(state)
+	}
+	if err != nil {
+		return err
+	}
+	_, err = w.Write(data)
+	return err
+}
+
+// LoadState reads a state in either format from r, then migrates and
+// validates it
+func (m *Manager) LoadState(r io.Reader) (*State, error) {
+	state, err := ReadState(r)
+	if err != nil {
+		return nil, err
+	}
+	return m.finishLoad(state)
+}
+
+// finishLoad migrates a decoded state up to the manager's version when a
+// chain is set, then validates it
+func (m *Manager) finishLoad(state *State) (*State, error) {
+	if m.migrations != nil && state.Header.Version < m.version {
+		migrated, err := m.migrations.Migrate(state, m.version)
+		if err != nil {
+			return nil, err
+		}
+		state = migrated
+	}
+	
+	if err := m.ValidateState(state); err != nil {
 		return nil, err
 	}
 	
-	return &state, nil
+	return state, nil
 }
 
 // CreatePreset creates a new preset
@@ -22,12 +22,20 @@ package state
 // }
 import "C"
 import (
+	"bufio"
 	"encoding/binary"
 	"errors"
 	"io"
+	"math"
 	"unsafe"
 )
 
+// ClapStreamBufferSize is the buffer the CLAP stream helpers batch host
+// calls through. Hosts implement read and write as a callback each, often
+// with a lock or a file write behind it, so small field reads must not
+// reach them one by one.
+const ClapStreamBufferSize = 64 * 1024
+
 // Common stream errors
 var (
 	ErrStreamClosed = errors.New("stream is closed")
@@ -37,8 +45,9 @@ var (
 
 // InputStream provides methods for reading binary data
 type InputStream struct {
-	reader io.Reader
-	err    error
+	reader  io.Reader
+	err     error
+	scratch [8]byte
 }
 
 // NewInputStream creates a new input stream
@@ -53,50 +62,48 @@ func (s *InputStream) Error() error {
 
 // ReadUint32 reads a uint32 from the stream
 func (s *InputStream) ReadUint32() (uint32, error) {
-	if s.err != nil {
-		return 0, s.err
-	}
-	
-	var value uint32
-	err := binary.Read(s.reader, binary.LittleEndian, &value)
+	b, err := s.readScratch(4)
 	if err != nil {
-		s.err = err
 		return 0, err
 	}
 	
-	return value, nil
+	return binary.LittleEndian.Uint32(b), nil
 }
 
 // ReadUint64 reads a uint64 from the stream
 func (s *InputStream) ReadUint64() (uint64, error) {
-	if s.err != nil {
-		return 0, s.err
-	}
-	
-	var value uint64
-	err := binary.Read(s.reader, binary.LittleEndian, &value)
+	b, err := s.readScratch(8)
 	if err != nil {
-		s.err = err
 		return 0, err
 	}
 	
-	return value, nil
+	return binary.LittleEndian.Uint64(b), nil
 }
 
 // ReadFloat64 reads a float64 from the stream
 func (s *InputStream) ReadFloat64() (float64, error) {
+	b, err := s.readScratch(8)
+	if err != nil {
+		return 0, err
+	}
+	
+	return math.Float64frombits(binary.LittleEndian.Uint64(b)), nil
+}
+
+// readScratch reads exactly n bytes into the stream's scratch buffer, so
+// fixed-size fields decode without reflection or allocation
+func (s *InputStream) readScratch(n int) ([]byte, error) {
 	if s.err != nil {
-		return 0, s.err
+		return nil, s.err
 	}
 	
-	var value float64
-	err := binary.Read(s.reader, binary.LittleEndian, &value)
-	if err != nil {
+	b := s.scratch[:n]
+	if _, err := io.ReadFull(s.reader, b); err != nil {
 		s.err = err
-		return 0, err
+		return nil, err
 	}
 	
-	return value, nil
+	return b, nil
 }
 
 // ReadBytes reads a byte slice from the stream
@@ -151,8 +158,10 @@ func (s *InputStream) Read(data []byte) (int, error) {
 
 // OutputStream provides methods for writing binary data
 type OutputStream struct {
-	writer io.Writer
-	err    error
+	writer  io.Writer
+	flusher *bufio.Writer // set when the writer is buffered
+	err     error
+	scratch [8]byte
 }
 
 // NewOutputStream creates a new output stream
@@ -167,47 +176,23 @@ func (s *OutputStream) Error() error {
 
 // WriteUint32 writes a uint32 to the stream
 func (s *OutputStream) WriteUint32(value uint32) error {
-	if s.err != nil {
-		return s.err
-	}
-	
-	err := binary.Write(s.writer, binary.LittleEndian, value)
-	if err != nil {
-		s.err = err
-		return err
-	}
-	
-	return nil
+	b := s.scratch[:4]
+	binary.LittleEndian.PutUint32(b, value)
+	return s.WriteBytes(b)
 }
 
 // WriteUint64 writes a uint64 to the stream
 func (s *OutputStream) WriteUint64(value uint64) error {
-	if s.err != nil {
-		return s.err
-	}
-	
-	err := binary.Write(s.writer, binary.LittleEndian, value)
-	if err != nil {
-		s.err = err
-		return err
-	}
-	
-	return nil
+	b := s.scratch[:8]
+	binary.LittleEndian.PutUint64(b, value)
+	return s.WriteBytes(b)
 }
 
 // WriteFloat64 writes a float64 to the stream
 func (s *OutputStream) WriteFloat64(value float64) error {
-	if s.err != nil {
-		return s.err
-	}
-	
-	err := binary.Write(s.writer, binary.LittleEndian, value)
-	if err != nil {
-		s.err = err
-		return err
-	}
-	
-	return nil
+	b := s.scratch[:8]
+	binary.LittleEndian.PutUint64(b, math.Float64bits(value))
+	return s.WriteBytes(b)
 }
 
 // WriteBytes writes a byte slice to the stream
@@ -235,7 +220,13 @@ func (s *OutputStream) WriteString(value string) error {
 	
 	// Write data
 	if len(value) > 0 {
-		return s.WriteBytes([]byte(value))
+		if s.err != nil {
+			return s.err
+		}
+		if _, err := io.WriteString(s.writer, value); err != nil {
+			s.err = err
+			return err
+		}
 	}
 	
 	return nil
@@ -250,6 +241,24 @@ func (s *OutputStream) Write(data []byte) (int, error) {
 	return len(data), nil
 }
 
+// Flush writes out anything still buffered. Streams from
+// NewBufferedClapOutputStream buffer, so call it before returning from state
+// save; for unbuffered streams it only reports the latched error.
+func (s *OutputStream) Flush() error {
+	if s.err != nil {
+		return s.err
+	}
+	
+	if s.flusher != nil {
+		if err := s.flusher.Flush(); err != nil {
+			s.err = err
+			return err
+		}
+	}
+	
+	return nil
+}
+
 // C Stream Adapters - these implement io.Reader/Writer for CLAP streams
 
 // ClapReader adapts a CLAP input stream to io.Reader
@@ -294,30 +303,43 @@ func NewClapWriter(stream unsafe.Pointer) *ClapWriter {
 	}
 }
 
-// Write implements io.Writer
+// Write implements io.Writer. The host may accept less than asked, so it
+// keeps writing until p is consumed or the host refuses.
 func (w *ClapWriter) Write(p []byte) (int, error) {
-	if len(p) == 0 {
-		return 0, nil
+	written := 0
+	for written < len(p) {
+		bytesWritten := C.clap_stream_write(w.stream, unsafe.Pointer(&p[written]), C.uint64_t(len(p)-written))
+		if bytesWritten <= 0 {
+			return written, ErrWriteFailed
+		}
+		written += int(bytesWritten)
 	}
 	
-	bytesWritten := C.clap_stream_write(w.stream, unsafe.Pointer(&p[0]), C.uint64_t(len(p)))
-	if bytesWritten < 0 {
-		return 0, ErrWriteFailed
-	}
-	
-	return int(bytesWritten), nil
+	return written, nil
 }
 
 // Convenience functions for CLAP streams
 
-// NewClapInputStream creates an InputStream that wraps a CLAP input stream
+// NewClapInputStream creates a buffered InputStream that wraps a CLAP
+// input stream. It may read ahead of what has been consumed, which is fine
+// for state load, where the host stream holds nothing else.
 func NewClapInputStream(stream unsafe.Pointer) *InputStream {
-	reader := NewClapReader(stream)
+	reader := bufio.NewReaderSize(NewClapReader(stream), ClapStreamBufferSize)
 	return NewInputStream(reader)
 }
 
-// NewClapOutputStream creates an OutputStream that wraps a CLAP output stream
+// NewClapOutputStream creates an OutputStream that wraps a CLAP output
+// stream. Every write goes straight to the host.
 func NewClapOutputStream(stream unsafe.Pointer) *OutputStream {
 	writer := NewClapWriter(stream)
 	return NewOutputStream(writer)
+}
+
+// NewBufferedClapOutputStream creates a buffered OutputStream that wraps a
+// CLAP output stream, batching small field writes into few host calls.
+// Nothing reaches the host until the buffer fills or Flush is called, so
+// Flush before returning from state save.
+func NewBufferedClapOutputStream(stream unsafe.Pointer) *OutputStream {
+	writer := bufio.NewWriterSize(NewClapWriter(stream), ClapStreamBufferSize)
+	return &OutputStream{writer: writer, flusher: writer}
 }
\ No newline at end of file
@@ -0,0 +1,249 @@
+package thread
+
+import (
+	"runtime"
+	"sync"
+	"sync/atomic"
+)
+
+// Spin budgets before a waiter parks. Tasks in an audio block are short, so
+// a brief spin usually sees the result without a scheduler round trip.
+const (
+	workerSpinIterations = 2000
+	callerSpinIterations = 4000
+)
+
+// FallbackPool is the thread pool used when the host doesn't provide one.
+// Its workers are long-lived goroutines, each locked to its own OS thread,
+// started once before processing. Execute publishes a job, the workers and
+// the calling thread claim task indices from a shared atomic counter, and
+// everyone waits by spinning briefly before parking, so a call does not
+// allocate or spawn goroutines.
+type FallbackPool struct {
+	maxWorkers int
+
+	// Serializes Execute callers that share the pool
+	execMu sync.Mutex
+
+	// Lifecycle
+	lifeMu  sync.Mutex
+	running atomic.Bool
+	quit    atomic.Bool
+	wake    []chan struct{}
+	stopped sync.WaitGroup
+
+	// Current job. claim packs the job generation, its task count and the
+	// next task index into one word, so a worker that is late from a
+	// previous job can never claim a task of the next one.
+	claim     atomic.Uint64
+	completed atomic.Uint32
+	offset    uint32
+	taskFunc  func(uint32)
+	doneCh    chan struct{}
+}
+
+// Layout of FallbackPool.claim: generation | task count | next index
+const (
+	claimIndexBits = 20
+	claimCountBits = 20
+	claimMask      = 1<<claimIndexBits - 1
+	maxJobTasks    = 1<<claimCountBits - 1
+)
+
+func packClaim(generation uint64, count uint32) uint64 {
+	return generation<<(claimIndexBits+claimCountBits) | uint64(count)<<claimIndexBits
+}
+
+func claimGeneration(v uint64) uint32 {
+	return uint32(v >> (claimIndexBits + claimCountBits))
+}
+
+// NewFallbackPool creates a new fallback thread pool. The calling thread
+// takes part in every job, so maxWorkers-1 worker threads are started.
+func NewFallbackPool(maxWorkers int) *FallbackPool {
+	if maxWorkers <= 0 {
+		maxWorkers = runtime.NumCPU()
+	}
+	return &FallbackPool{
+		maxWorkers: maxWorkers,
+		doneCh:     make(chan struct{}, 1),
+	}
+}
+
+// Start launches the worker threads. It is safe to call more than once.
+// Call it from Activate: spawning threads is not allowed on the audio thread,
+// so Execute never starts the pool itself.
+// [main-thread]
+func (p *FallbackPool) Start() {
+	p.lifeMu.Lock()
+	defer p.lifeMu.Unlock()
+
+	if p.running.Load() {
+		return
+	}
+	p.quit.Store(false)
+
+	workers := p.maxWorkers - 1
+	p.wake = make([]chan struct{}, workers)
+	p.stopped.Add(workers)
+	for i := 0; i < workers; i++ {
+		p.wake[i] = make(chan struct{}, 1)
+		go p.worker(p.wake[i])
+	}
+	p.running.Store(true)
+}
+
+// Stop shuts the worker threads down and waits for them to exit.
+// [main-thread]
+func (p *FallbackPool) Stop() {
+	p.lifeMu.Lock()
+	defer p.lifeMu.Unlock()
+
+	if !p.running.Load() {
+		return
+	}
+	p.quit.Store(true)
+	for _, wake := range p.wake {
+		select {
+		case wake <- struct{}{}:
+		default:
+		}
+	}
+	p.stopped.Wait()
+	p.wake = nil
+	p.running.Store(false)
+}
+
+// Running reports whether the worker threads are started
+// [thread-safe]
+func (p *FallbackPool) Running() bool {
+	return p.running.Load()
+}
+
+// Execute runs taskFunc for every index in [0, numTasks) and returns once
+// all of them have finished. The caller runs tasks too. A pool that was not
+// started runs them all on the caller, in order.
+// [audio-thread]
+func (p *FallbackPool) Execute(numTasks uint32, taskFunc func(uint32)) {
+	if numTasks == 0 {
+		return
+	}
+
+	p.execMu.Lock()
+	defer p.execMu.Unlock()
+
+	if !p.running.Load() {
+		for i := uint32(0); i < numTasks; i++ {
+			taskFunc(i)
+		}
+		return
+	}
+
+	// Very large jobs run as several rounds so the count fits in claim
+	for offset := uint32(0); offset < numTasks; offset += maxJobTasks {
+		count := numTasks - offset
+		if count > maxJobTasks {
+			count = maxJobTasks
+		}
+		p.runJob(offset, count, taskFunc)
+	}
+
+	p.taskFunc = nil
+}
+
+// runJob publishes one job, takes part in it and waits for it to finish
+func (p *FallbackPool) runJob(offset, count uint32, taskFunc func(uint32)) {
+	// Drop a completion signal left over from the previous job
+	select {
+	case <-p.doneCh:
+	default:
+	}
+
+	// Publish the job; storing claim makes it visible to the workers
+	p.taskFunc = taskFunc
+	p.offset = offset
+	p.completed.Store(0)
+	generation := uint64(claimGeneration(p.claim.Load())) + 1
+	p.claim.Store(packClaim(generation, count))
+
+	for _, wake := range p.wake {
+		select {
+		case wake <- struct{}{}:
+		default:
+		}
+	}
+
+	p.runTasks()
+
+	// Spin, then park until the last task reports in
+	for i := 0; p.completed.Load() < count; i++ {
+		if i < callerSpinIterations {
+			spinPause(i)
+			continue
+		}
+		<-p.doneCh
+	}
+}
+
+// runTasks claims and runs tasks of the current job until none are left
+func (p *FallbackPool) runTasks() {
+	for {
+		v := p.claim.Load()
+		count := uint32(v>>claimIndexBits) & claimMask
+		index := uint32(v) & claimMask
+		if index >= count {
+			return
+		}
+		if !p.claim.CompareAndSwap(v, v+1) {
+			continue
+		}
+
+		// A successful claim means the job is still running, so its fields
+		// cannot be replaced until this task completes
+		p.taskFunc(p.offset + index)
+
+		if p.completed.Add(1) == count {
+			select {
+			case p.doneCh <- struct{}{}:
+			default:
+			}
+		}
+	}
+}
+
+// worker is the body of one pinned worker thread
+func (p *FallbackPool) worker(wake chan struct{}) {
+	runtime.LockOSThread()
+	defer runtime.UnlockOSThread()
+	defer p.stopped.Done()
+
+	lastGeneration := claimGeneration(p.claim.Load())
+	for {
+		// Spin, then park until a new job is published
+		for i := 0; ; i++ {
+			if p.quit.Load() {
+				return
+			}
+			if generation := claimGeneration(p.claim.Load()); generation != lastGeneration {
+				lastGeneration = generation
+				break
+			}
+			if i < workerSpinIterations {
+				spinPause(i)
+				continue
+			}
+			<-wake
+			i = 0
+		}
+
+		p.runTasks()
+	}
+}
+
+// spinPause backs off a spinning waiter, yielding the processor now and then
+// so an oversubscribed machine still makes progress
+func spinPause(iteration int) {
+	if iteration&63 == 63 {
+		runtime.Gosched()
+	}
+}
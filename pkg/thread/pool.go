@@ -21,7 +21,6 @@ static inline bool clap_host_thread_pool_request_exec(const clap_host_thread_poo
 import "C"
 import (
 	"runtime"
-	"sync"
 	"unsafe"
 )
 
@@ -91,6 +90,7 @@ type PoolHelper struct {
 	
 	// For fallback implementation
 	fallbackPool *FallbackPool
+	exec         func(uint32) // provider.Exec bound once
 }
 
 // NewPoolHelper creates a new thread pool helper
@@ -99,9 +99,35 @@ func NewPoolHelper(host unsafe.Pointer, provider PoolProvider) *PoolHelper {
 		host:         NewPoolHost(host),
 		provider:     provider,
 		fallbackPool: NewFallbackPool(runtime.NumCPU()),
+		exec:         provider.Exec,
 	}
 }
 
+// Start launches the fallback workers ahead of processing when the host has
+// no thread pool. Call it from Activate; Execute never starts them.
+func (h *PoolHelper) Start() {
+	if h.host == nil {
+		h.fallbackPool.Start()
+	}
+}
+
+// Stop shuts the fallback workers down. Call it from Deactivate or Destroy.
+func (h *PoolHelper) Stop() {
+	h.fallbackPool.Stop()
+}
+
+// HasHostPool reports whether the host provides the thread pool extension
+func (h *PoolHelper) HasHostPool() bool {
+	return h.host != nil
+}
+
+// Parallel reports whether Execute can spread tasks across threads: the
+// host provides a thread pool, or the fallback workers were started
+// [thread-safe]
+func (h *PoolHelper) Parallel() bool {
+	return h.host != nil || h.fallbackPool.Running()
+}
+
 // Execute runs numTasks in parallel using either the host's thread pool
 // or a fallback implementation.
 func (h *PoolHelper) Execute(numTasks uint32) {
@@ -129,60 +155,8 @@ func (h *PoolHelper) fallbackExecute(numTasks uint32) {
 		return
 	}
 	
-	// Use goroutines for parallel execution
-	h.fallbackPool.Execute(numTasks, h.provider.Exec)
-}
-
-// FallbackPool provides a simple thread pool implementation
-// for when the host doesn't provide one.
-type FallbackPool struct {
-	maxWorkers int
-}
-
-// NewFallbackPool creates a new fallback thread pool
-func NewFallbackPool(maxWorkers int) *FallbackPool {
-	if maxWorkers <= 0 {
-		maxWorkers = runtime.NumCPU()
-	}
-	return &FallbackPool{
-		maxWorkers: maxWorkers,
-	}
-}
-
-// Execute runs tasks in parallel using goroutines
-func (p *FallbackPool) Execute(numTasks uint32, taskFunc func(uint32)) {
-	if numTasks == 0 {
-		return
-	}
-	
-	// Determine number of workers
-	workers := int(numTasks)
-	if workers > p.maxWorkers {
-		workers = p.maxWorkers
-	}
-	
-	var wg sync.WaitGroup
-	taskChan := make(chan uint32, numTasks)
-	
-	// Queue all tasks
-	for i := uint32(0); i < numTasks; i++ {
-		taskChan <- i
-	}
-	close(taskChan)
-	
-	// Start workers
-	wg.Add(workers)
-	for i := 0; i < workers; i++ {
-		go func() {
-			defer wg.Done()
-			for taskIndex := range taskChan {
-				taskFunc(taskIndex)
-			}
-		}()
-	}
-	
-	// Wait for all tasks to complete
-	wg.Wait()
+	// Use the persistent fallback workers
+	h.fallbackPool.Execute(numTasks, h.exec)
 }
 
 // ParallelProcessor provides a high-level interface for parallel audio processing
@@ -205,6 +179,7 @@ func (p *ParallelProcessor) ProcessChannels(numChannels uint32, processFunc func
 		host:         p.helper.host,
 		provider:     adapter,
 		fallbackPool: p.helper.fallbackPool,
+		exec:         adapter.Exec,
 	}
 	tempHelper.Execute(numChannels)
 }
@@ -217,6 +192,7 @@ func (p *ParallelProcessor) ProcessVoices(numVoices uint32, processFunc func(voi
 		host:         p.helper.host,
 		provider:     adapter,
 		fallbackPool: p.helper.fallbackPool,
+		exec:         adapter.Exec,
 	}
 	tempHelper.Execute(numVoices)
 }
@@ -17,8 +17,13 @@
 manifest_plugin_entry_t manifest_plugins[MAX_PLUGIN_MANIFESTS];
 int manifest_plugin_count = 0;
 
+// Mapped manifest cache backing cached registry entries
+static clapgo_manifest_cache_t manifest_cache;
+
 // Go functions are now statically linked - declare external functions
-extern void* ClapGo_CreatePlugin(void* host, char* plugin_id);
+// Returns the instance's address or a cgo.Handle, either way an integer:
+// cgo will not return a pointer to Go memory that holds Go pointers
+extern uintptr_t ClapGo_CreatePlugin(void* host, char* plugin_id);
 extern bool ClapGo_PluginInit(void* plugin);
 extern void ClapGo_PluginDestroy(void* plugin);
 extern bool ClapGo_PluginActivate(void* plugin, double sample_rate, uint32_t min_frames, uint32_t max_frames);
@@ -129,12 +134,89 @@ __attribute__((weak)) bool ClapGo_PluginRenderSet(void* plugin, int32_t mode);
 // Thread pool extension
 __attribute__((weak)) void ClapGo_PluginThreadPoolExec(void* plugin, uint32_t task_index);
 
+// Telemetry for GUI bridges, not a CLAP extension
+__attribute__((weak)) void* ClapGo_PluginTelemetry(void* plugin);
+
+// Fill the registry from the manifest cache; no JSON is parsed
+static int clapgo_load_manifest_cache(const clapgo_manifest_cache_t* cache) {
+    uint32_t count = manifest_cache_count(cache);
+    if (count > MAX_PLUGIN_MANIFESTS) {
+        count = MAX_PLUGIN_MANIFESTS;
+    }
+    
+    for (uint32_t i = 0; i < count; i++) {
+        const clapgo_manifest_cache_entry_t* cached = &cache->entries[i];
+        manifest_plugin_entry_t* entry = &manifest_plugins[i];
+        plugin_manifest_t* m = &entry->manifest;
+        memset(entry, 0, sizeof(*entry));
+        
+        // Just what lookups and preset discovery read; the rest stays in the map
+        strncpy(m->plugin.id, manifest_cache_string(cache, cached->id), sizeof(m->plugin.id) - 1);
+        strncpy(m->plugin.name, manifest_cache_string(cache, cached->name), sizeof(m->plugin.name) - 1);
+        strncpy(m->plugin.vendor, manifest_cache_string(cache, cached->vendor), sizeof(m->plugin.vendor) - 1);
+        strncpy(m->plugin.version, manifest_cache_string(cache, cached->version), sizeof(m->plugin.version) - 1);
+        entry->cached = cached;
+    }
+    return (int)count;
+}
+
+// Load the manifest at json_path, preferring a fresh cache at cache_path.
+// Returns the number of plugins registered.
+static int clapgo_load_manifest_location(const char* json_path, const char* cache_path) {
+    clapgo_manifest_cache_t cache;
+    if (manifest_cache_open(cache_path, json_path, &cache)) {
+        int count = clapgo_load_manifest_cache(&cache);
+        if (count > 0) {
+            CLAPGO_DEBUG("Loaded %d plugin(s) from manifest cache: %s\n", count, cache_path);
+            manifest_cache = cache;
+            return count;
+        }
+        manifest_cache_close(&cache);
+    }
+    
+    if (access(json_path, R_OK) != 0) {
+        return 0;
+    }
+    
+    plugin_manifest_t* manifests = (plugin_manifest_t*)malloc(sizeof(plugin_manifest_t) * MAX_PLUGIN_MANIFESTS);
+    if (!manifests) {
+        return 0;
+    }
+    int count = manifest_load_bundle_from_file(json_path, manifests, MAX_PLUGIN_MANIFESTS);
+    for (int i = 0; i < count; i++) {
+        manifest_plugins[i].manifest = manifests[i];
+        manifest_plugins[i].cached = NULL;
+        manifest_plugins[i].loaded = false;
+        manifest_plugins[i].descriptor = NULL;
+    }
+    free(manifests);
+    
+    if (count > 0) {
+        CLAPGO_DEBUG("Loaded %d plugin(s) from manifest: %s\n", count, json_path);
+    } else {
+        fprintf(stderr, "Error: Failed to load manifest from %s\n", json_path);
+    }
+    return count;
+}
+
+// Format a location's manifest and cache paths from its stem, the path
+// without extension. Returns false when either does not fit.
+static bool clapgo_location_paths(char* manifest_path, size_t manifest_size,
+                                  char* cache_path, size_t cache_size, const char* stem) {
+    int written = snprintf(manifest_path, manifest_size, "%s.json", stem);
+    if (written < 0 || (size_t)written >= manifest_size) {
+        return false;
+    }
+    written = snprintf(cache_path, cache_size, "%s" CLAPGO_MANIFEST_CACHE_EXT, stem);
+    return written >= 0 && (size_t)written < cache_size;
+}
+
 // Find manifest files for the plugin
 int clapgo_find_manifests(const char* plugin_path) {
-    printf("Searching for manifest for plugin: %s\n", plugin_path);
+    CLAPGO_DEBUG("Searching for manifest for plugin: %s\n", plugin_path);
     
-    // Clear existing manifest entries
-    memset(manifest_plugins, 0, sizeof(manifest_plugins));
+    // Clear the entries a previous scan filled; the rest are still zero
+    memset(manifest_plugins, 0, sizeof(manifest_plugins[0]) * (size_t)manifest_plugin_count);
     manifest_plugin_count = 0;
     
     // Extract the plugin name from the path
@@ -149,60 +231,129 @@ int clapgo_find_manifests(const char* plugin_path) {
     size_t plugin_name_len = strlen(plugin_file);
     
     // Remove .clap extension
-    if (plugin_name_len > 5 && strcmp(plugin_file + plugin_name_len - 5, ".clap") == 0) {
-        strncpy(plugin_name, plugin_file, plugin_name_len - 5);
+    if (plugin_name_len > 5 && plugin_name_len - 5 < sizeof(plugin_name) &&
+        strcmp(plugin_file + plugin_name_len - 5, ".clap") == 0) {
+        memcpy(plugin_name, plugin_file, plugin_name_len - 5);
         plugin_name[plugin_name_len - 5] = '\0';
     } else {
         strncpy(plugin_name, plugin_file, sizeof(plugin_name) - 1);
         plugin_name[sizeof(plugin_name) - 1] = '\0';
     }
     
-    printf("Extracted plugin name: %s\n", plugin_name);
+    CLAPGO_DEBUG("Extracted plugin name: %s\n", plugin_name);
     
-    char manifest_path[512];
-    bool manifest_found = false;
+    // A location too long for the buffers is skipped, not truncated
+    char stem[512];
+    char manifest_path[sizeof(stem) + sizeof(".json")];
+    char cache_path[sizeof(stem) + sizeof(CLAPGO_MANIFEST_CACHE_EXT)];
+    int written;
     
     // First try: same directory as plugin (for development/testing)
     char* plugin_path_copy = strdup(plugin_path);
     char* plugin_dir = dirname(plugin_path_copy);
-    snprintf(manifest_path, sizeof(manifest_path), "%s/%s.json", plugin_dir, plugin_name);
-    printf("Looking for manifest at: %s\n", manifest_path);
+    written = snprintf(stem, sizeof(stem), "%s/%s", plugin_dir, plugin_name);
+    if (written >= 0 && (size_t)written < sizeof(stem) &&
+        clapgo_location_paths(manifest_path, sizeof(manifest_path), cache_path, sizeof(cache_path), stem)) {
+        CLAPGO_DEBUG("Looking for manifest at: %s\n", manifest_path);
+        manifest_plugin_count = clapgo_load_manifest_location(manifest_path, cache_path);
+    }
     
-    if (access(manifest_path, R_OK) == 0) {
-        manifest_found = true;
-    } else {
+    if (manifest_plugin_count == 0) {
         // Second try: installed location ~/.clap/$PLUGIN/$PLUGIN.json
         char* home = getenv("HOME");
         if (home) {
-            snprintf(manifest_path, sizeof(manifest_path), "%s/.clap/%s/%s.json", home, plugin_name, plugin_name);
-            printf("Looking for manifest at: %s\n", manifest_path);
-            
-            if (access(manifest_path, R_OK) == 0) {
-                manifest_found = true;
+            written = snprintf(stem, sizeof(stem), "%s/.clap/%s/%s", home, plugin_name, plugin_name);
+            if (written >= 0 && (size_t)written < sizeof(stem) &&
+                clapgo_location_paths(manifest_path, sizeof(manifest_path), cache_path, sizeof(cache_path), stem)) {
+                CLAPGO_DEBUG("Looking for manifest at: %s\n", manifest_path);
+                manifest_plugin_count = clapgo_load_manifest_location(manifest_path, cache_path);
             }
         }
     }
     
-    if (manifest_found) {
-        // Load the manifest
-        if (manifest_load_from_file(manifest_path, &manifest_plugins[0].manifest)) {
-            printf("Loaded manifest: %s\n", manifest_path);
-            manifest_plugins[0].loaded = false;
-            manifest_plugins[0].descriptor = NULL;
-            manifest_plugin_count = 1;
-        } else {
-            fprintf(stderr, "Error: Failed to load manifest from %s\n", manifest_path);
-        }
-    } else {
+    if (manifest_plugin_count == 0) {
         fprintf(stderr, "Error: No manifest file found for plugin %s\n", plugin_name);
     }
     
     free(plugin_path_copy);
     
-    // Return the number of manifests found (should be 0 or 1)
     return manifest_plugin_count;
 }
 
+// Features used when a manifest lists none
+static const char* const clapgo_default_features[] = { "audio-effect", "stereo", "mono", NULL };
+
+// Build a descriptor for a cached entry. Strings point into the mapping;
+// only the descriptor and its feature array are allocated.
+static clap_plugin_descriptor_t* clapgo_descriptor_from_cache(const clapgo_manifest_cache_entry_t* cached) {
+    const clapgo_manifest_cache_t* cache = &manifest_cache;
+    clap_plugin_descriptor_t* desc = (clap_plugin_descriptor_t*)calloc(1, sizeof(clap_plugin_descriptor_t));
+    if (!desc) return NULL;
+    
+    desc->clap_version.major = 1;
+    desc->clap_version.minor = 1;
+    desc->clap_version.revision = 0;
+    desc->id = manifest_cache_string(cache, cached->id);
+    desc->name = manifest_cache_string(cache, cached->name);
+    desc->vendor = manifest_cache_string(cache, cached->vendor);
+    desc->url = manifest_cache_string(cache, cached->url);
+    desc->manual_url = manifest_cache_string(cache, cached->manual_url);
+    desc->support_url = manifest_cache_string(cache, cached->support_url);
+    desc->version = manifest_cache_string(cache, cached->version);
+    desc->description = manifest_cache_string(cache, cached->description);
+    
+    if (cached->features_count == 0) {
+        desc->features = (const char**)clapgo_default_features;
+        return desc;
+    }
+    
+    const char** features = (const char**)calloc(cached->features_count + 1, sizeof(const char*));
+    if (!features) {
+        free(desc);
+        return NULL;
+    }
+    for (uint32_t i = 0; i < cached->features_count; i++) {
+        features[i] = manifest_cache_string(cache, cache->features[cached->features_index + i]);
+    }
+    desc->features = features;
+    return desc;
+}
+
+// Free an entry's descriptor, which owns its strings unless it is cached
+static void clapgo_free_descriptor(manifest_plugin_entry_t* entry) {
+    clap_plugin_descriptor_t* desc = (clap_plugin_descriptor_t*)entry->descriptor;
+    if (!desc) return;
+    
+    if (entry->cached) {
+        if (desc->features != (const char**)clapgo_default_features) {
+            free((void*)desc->features);
+        }
+    } else {
+        // Free features array if allocated
+        if (desc->features) {
+            // Free each feature string
+            for (int j = 0; desc->features[j] != NULL; j++) {
+                free((void*)desc->features[j]);
+            }
+            free((void*)desc->features);
+        }
+        
+        // Free all string fields
+        free((void*)desc->id);
+        free((void*)desc->name);
+        free((void*)desc->vendor);
+        free((void*)desc->url);
+        free((void*)desc->manual_url);
+        free((void*)desc->support_url);
+        free((void*)desc->version);
+        free((void*)desc->description);
+    }
+    
+    // Free the descriptor itself
+    free(desc);
+    entry->descriptor = NULL;
+}
+
 // Load a manifest plugin by index (simplified for self-contained plugins)
 bool clapgo_load_manifest_plugin(int index) {
     if (index < 0 || index >= manifest_plugin_count) {
@@ -217,10 +368,11 @@ bool clapgo_load_manifest_plugin(int index) {
         return true;
     }
     
-    printf("Loading self-contained plugin: %s\n", entry->manifest.plugin.id);
+    CLAPGO_DEBUG("Loading self-contained plugin: %s\n", entry->manifest.plugin.id);
     
-    // Create the descriptor from the manifest
-    entry->descriptor = manifest_to_descriptor(&entry->manifest);
+    // Create the descriptor from the manifest, or straight from the cache
+    entry->descriptor = entry->cached ? clapgo_descriptor_from_cache(entry->cached)
+                                      : manifest_to_descriptor(&entry->manifest);
     if (!entry->descriptor) {
         fprintf(stderr, "Error: Failed to create descriptor from manifest\n");
         return false;
@@ -229,7 +381,7 @@ bool clapgo_load_manifest_plugin(int index) {
     // Mark as loaded
     entry->loaded = true;
     
-    printf("Successfully loaded manifest plugin: %s (%s)\n", 
+    CLAPGO_DEBUG("Successfully loaded manifest plugin: %s (%s)\n", 
            entry->manifest.plugin.name, entry->manifest.plugin.id);
     
     return true;
@@ -248,6 +400,53 @@ int clapgo_find_manifest_plugin_by_id(const char* plugin_id) {
     return -1;
 }
 
+// Extensions the linked Go library exports, probed once in clapgo_init
+static clapgo_supports_t library_supports;
+
+// Weak exports are resolved when the library is linked, so one probe is
+// good for every instance
+static void clapgo_probe_supports(clapgo_supports_t* s) {
+    s->params = (ClapGo_PluginParamsCount != NULL);
+    s->audio_ports = (ClapGo_PluginAudioPortsCount != NULL &&
+                      ClapGo_PluginAudioPortsGet != NULL);
+    s->note_ports = (ClapGo_PluginNotePortsCount != NULL &&
+                     ClapGo_PluginNotePortsGet != NULL);
+    s->state = (ClapGo_PluginStateSave != NULL &&
+                ClapGo_PluginStateLoad != NULL);
+    s->latency = (ClapGo_PluginLatencyGet != NULL);
+    s->tail = (ClapGo_PluginTailGet != NULL);
+    s->timer = (ClapGo_PluginOnTimer != NULL);
+    s->audio_ports_config = (ClapGo_PluginAudioPortsConfigCount != NULL &&
+                             ClapGo_PluginAudioPortsConfigGet != NULL &&
+                             ClapGo_PluginAudioPortsConfigSelect != NULL);
+    s->surround = (ClapGo_PluginSurroundIsChannelMaskSupported != NULL &&
+                   ClapGo_PluginSurroundGetChannelMap != NULL);
+    s->voice_info = (ClapGo_PluginVoiceInfoGet != NULL);
+    s->state_context = (ClapGo_PluginStateSaveWithContext != NULL &&
+                        ClapGo_PluginStateLoadWithContext != NULL);
+    s->preset_load = (ClapGo_PluginPresetLoadFromLocation != NULL);
+    s->track_info = (ClapGo_PluginTrackInfoChanged != NULL);
+    s->tuning = (ClapGo_PluginTuningChanged != NULL);
+    s->param_indication = (ClapGo_PluginParamIndicationSetMapping != NULL &&
+                           ClapGo_PluginParamIndicationSetAutomation != NULL);
+    s->context_menu = (ClapGo_PluginContextMenuPopulate != NULL &&
+                       ClapGo_PluginContextMenuPerform != NULL);
+    s->remote_controls = (ClapGo_PluginRemoteControlsCount != NULL &&
+                          ClapGo_PluginRemoteControlsGet != NULL);
+    s->note_name = (ClapGo_PluginNoteNameCount != NULL &&
+                    ClapGo_PluginNoteNameGet != NULL);
+    s->ambisonic = (ClapGo_PluginAmbisonicIsConfigSupported != NULL &&
+                    ClapGo_PluginAmbisonicGetConfig != NULL);
+    s->audio_ports_activation = (ClapGo_PluginAudioPortsActivationCanActivateWhileProcessing != NULL &&
+                                 ClapGo_PluginAudioPortsActivationSetActive != NULL);
+    s->configurable_audio_ports = (ClapGo_PluginConfigurableAudioPortsCanApplyConfiguration != NULL &&
+                                   ClapGo_PluginConfigurableAudioPortsApplyConfiguration != NULL);
+    s->posix_fd_support = (ClapGo_PluginPosixFDSupportOnFD != NULL);
+    s->render = (ClapGo_PluginRenderHasHardRealtimeRequirement != NULL &&
+                 ClapGo_PluginRenderSet != NULL);
+    s->thread_pool = (ClapGo_PluginThreadPoolExec != NULL);
+}
+
 // Create a plugin instance from a manifest entry
 const clap_plugin_t* clapgo_create_plugin_from_manifest(const clap_host_t* host, int index) {
     if (index < 0 || index >= manifest_plugin_count) {
@@ -266,7 +465,7 @@ const clap_plugin_t* clapgo_create_plugin_from_manifest(const clap_host_t* host,
     }
     
     // Debug logging before calling Go
-    FILE* init_log = fopen("/tmp/clapgo_plugin_init.log", "a");
+    FILE* init_log = CLAPGO_DEBUG_FILE("/tmp/clapgo_plugin_init.log");
     if (init_log) {
         fprintf(init_log, "\n[%ld] === ClapGo_CreatePlugin Call ===\n", time(NULL));
         fprintf(init_log, "Plugin ID: %s\n", entry->manifest.plugin.id);
@@ -286,7 +485,7 @@ const clap_plugin_t* clapgo_create_plugin_from_manifest(const clap_host_t* host,
     }
     
     // Create the plugin instance using the statically linked Go function
-    void* go_instance = ClapGo_CreatePlugin((void*)host, (char*)entry->manifest.plugin.id);
+    void* go_instance = (void*)ClapGo_CreatePlugin((void*)host, (char*)entry->manifest.plugin.id);
     
     if (init_log) {
         fprintf(init_log, "ClapGo_CreatePlugin returned: %p\n", go_instance);
@@ -310,7 +509,7 @@ const clap_plugin_t* clapgo_create_plugin_from_manifest(const clap_host_t* host,
         return NULL;
     }
     
-    printf("Successfully created plugin instance for: %s\n", entry->manifest.plugin.id);
+    CLAPGO_DEBUG("Successfully created plugin instance for: %s\n", entry->manifest.plugin.id);
     
     // Allocate plugin instance data
     go_plugin_data_t* data = calloc(1, sizeof(go_plugin_data_t));
@@ -325,68 +524,21 @@ const clap_plugin_t* clapgo_create_plugin_from_manifest(const clap_host_t* host,
     data->host = (void*)host;  // Store host for later use
     
     // Add crash logging
-    FILE* crash_log = fopen("/tmp/clapgo_plugin_init.log", "a");
+    FILE* crash_log = CLAPGO_DEBUG_FILE("/tmp/clapgo_plugin_init.log");
     if (crash_log) {
         fprintf(crash_log, "\n[%ld] === Plugin Creation Debug ===\n", time(NULL));
         fprintf(crash_log, "Plugin ID: %s\n", entry->manifest.plugin.id);
         fprintf(crash_log, "Host: %p\n", host);
         fprintf(crash_log, "Data struct: %p\n", data);
         fprintf(crash_log, "Go instance: %p\n", go_instance);
-        fprintf(crash_log, "About to check extension support...\n");
+        fprintf(crash_log, "Creating CLAP plugin structure...\n");
         fflush(crash_log);
     }
     
-    // Determine extension support based on available exports
-    data->supports_params = (ClapGo_PluginParamsCount != NULL);
+    // Extension support is fixed by the library's exports
+    data->supports = library_supports;
     
     if (crash_log) {
-        fprintf(crash_log, "Params support check passed\n");
-        fflush(crash_log);
-    }
-    // Check for audio ports support (new)
-    data->supports_audio_ports = (ClapGo_PluginAudioPortsCount != NULL && 
-                                 ClapGo_PluginAudioPortsGet != NULL);
-    data->supports_note_ports = (ClapGo_PluginNotePortsCount != NULL && 
-                                 ClapGo_PluginNotePortsGet != NULL);
-    data->supports_state = (ClapGo_PluginStateSave != NULL && 
-                           ClapGo_PluginStateLoad != NULL);
-    data->supports_latency = (ClapGo_PluginLatencyGet != NULL);
-    data->supports_tail = (ClapGo_PluginTailGet != NULL);
-    data->supports_timer = (ClapGo_PluginOnTimer != NULL);
-    data->supports_audio_ports_config = (ClapGo_PluginAudioPortsConfigCount != NULL &&
-                                         ClapGo_PluginAudioPortsConfigGet != NULL &&
-                                         ClapGo_PluginAudioPortsConfigSelect != NULL);
-    data->supports_surround = (ClapGo_PluginSurroundIsChannelMaskSupported != NULL &&
-                              ClapGo_PluginSurroundGetChannelMap != NULL);
-    data->supports_voice_info = (ClapGo_PluginVoiceInfoGet != NULL);
-    data->supports_state_context = (ClapGo_PluginStateSaveWithContext != NULL &&
-                                   ClapGo_PluginStateLoadWithContext != NULL);
-    data->supports_preset_load = (ClapGo_PluginPresetLoadFromLocation != NULL);
-    printf("DEBUG: ClapGo_PluginPresetLoadFromLocation = %p, supports_preset_load = %d\n", 
-           ClapGo_PluginPresetLoadFromLocation, data->supports_preset_load);
-    data->supports_track_info = (ClapGo_PluginTrackInfoChanged != NULL);
-    data->supports_tuning = (ClapGo_PluginTuningChanged != NULL);
-    data->supports_param_indication = (ClapGo_PluginParamIndicationSetMapping != NULL &&
-                                      ClapGo_PluginParamIndicationSetAutomation != NULL);
-    data->supports_context_menu = (ClapGo_PluginContextMenuPopulate != NULL &&
-                                  ClapGo_PluginContextMenuPerform != NULL);
-    data->supports_remote_controls = (ClapGo_PluginRemoteControlsCount != NULL &&
-                                     ClapGo_PluginRemoteControlsGet != NULL);
-    data->supports_note_name = (ClapGo_PluginNoteNameCount != NULL &&
-                               ClapGo_PluginNoteNameGet != NULL);
-    data->supports_ambisonic = (ClapGo_PluginAmbisonicIsConfigSupported != NULL &&
-                               ClapGo_PluginAmbisonicGetConfig != NULL);
-    data->supports_audio_ports_activation = (ClapGo_PluginAudioPortsActivationCanActivateWhileProcessing != NULL &&
-                                            ClapGo_PluginAudioPortsActivationSetActive != NULL);
-    data->supports_configurable_audio_ports = (ClapGo_PluginConfigurableAudioPortsCanApplyConfiguration != NULL &&
-                                               ClapGo_PluginConfigurableAudioPortsApplyConfiguration != NULL);
-    data->supports_posix_fd_support = (ClapGo_PluginPosixFDSupportOnFD != NULL);
-    data->supports_render = (ClapGo_PluginRenderHasHardRealtimeRequirement != NULL &&
-                            ClapGo_PluginRenderSet != NULL);
-    data->supports_thread_pool = (ClapGo_PluginThreadPoolExec != NULL);
-    
-    if (crash_log) {
-        fprintf(crash_log, "All extension support checks completed\n");
         fclose(crash_log);
     }
     
@@ -419,7 +571,7 @@ const clap_plugin_t* clapgo_create_plugin_from_manifest(const clap_host_t* host,
 
 // Initialize the Go runtime and plugin environment
 bool clapgo_init(const char* plugin_path) {
-    printf("Initializing ClapGo plugin at path: %s\n", plugin_path);
+    CLAPGO_DEBUG("Initializing ClapGo plugin at path: %s\n", plugin_path);
     
     // Find manifest for this plugin
     int manifest_count = clapgo_find_manifests(plugin_path);
@@ -431,58 +583,34 @@ bool clapgo_init(const char* plugin_path) {
         return false;
     }
     
-    printf("Found manifest, using manifest-based loading\n");
+    clapgo_probe_supports(&library_supports);
     
-    // Mark as not loaded yet - descriptor will be created on demand
-    manifest_plugins[0].loaded = false;
-    manifest_plugins[0].descriptor = NULL;
+    // Descriptors are created on demand, the first time the host asks
+    CLAPGO_DEBUG("Found %d plugin(s), using manifest-based loading\n", manifest_count);
     
     return true;
 }
 
 // Cleanup the Go runtime and plugin environment
 void clapgo_deinit(void) {
-    printf("Deinitializing ClapGo plugin\n");
+    CLAPGO_DEBUG("Deinitializing ClapGo plugin\n");
     
     // Clean up any manifest plugins
     for (int i = 0; i < manifest_plugin_count; i++) {
         if (manifest_plugins[i].loaded) {
-            // Free the descriptor
-            if (manifest_plugins[i].descriptor) {
-                // Free features array if allocated
-                if (manifest_plugins[i].descriptor->features) {
-                    // Free each feature string
-                    for (int j = 0; manifest_plugins[i].descriptor->features[j] != NULL; j++) {
-                        free((void*)manifest_plugins[i].descriptor->features[j]);
-                    }
-                    free((void*)manifest_plugins[i].descriptor->features);
-                }
-                
-                // Free all string fields
-                if (manifest_plugins[i].descriptor->id) free((void*)manifest_plugins[i].descriptor->id);
-                if (manifest_plugins[i].descriptor->name) free((void*)manifest_plugins[i].descriptor->name);
-                if (manifest_plugins[i].descriptor->vendor) free((void*)manifest_plugins[i].descriptor->vendor);
-                if (manifest_plugins[i].descriptor->url) free((void*)manifest_plugins[i].descriptor->url);
-                if (manifest_plugins[i].descriptor->manual_url) free((void*)manifest_plugins[i].descriptor->manual_url);
-                if (manifest_plugins[i].descriptor->support_url) free((void*)manifest_plugins[i].descriptor->support_url);
-                if (manifest_plugins[i].descriptor->version) free((void*)manifest_plugins[i].descriptor->version);
-                if (manifest_plugins[i].descriptor->description) free((void*)manifest_plugins[i].descriptor->description);
-                
-                // Free the descriptor itself
-                free((void*)manifest_plugins[i].descriptor);
-                manifest_plugins[i].descriptor = NULL;
-            }
-            
+            clapgo_free_descriptor(&manifest_plugins[i]);
             manifest_plugins[i].loaded = false;
-            
-            // Free manifest resources
-            manifest_free(&manifest_plugins[i].manifest);
         }
+        // Free manifest resources
+        manifest_free(&manifest_plugins[i].manifest);
     }
     
+    // Cached descriptors borrowed from the mapping; they are gone now
+    manifest_cache_close(&manifest_cache);
+    
     manifest_plugin_count = 0;
     
-    printf("ClapGo plugin deinitialized successfully\n");
+    CLAPGO_DEBUG("ClapGo plugin deinitialized successfully\n");
 }
 
 // Get the plugin descriptor at the given index
@@ -523,6 +651,8 @@ const clap_plugin_t* clapgo_create_plugin(const clap_host_t* host, const char* p
     return clapgo_create_plugin_from_manifest(host, index);
 }
 
+static void clapgo_build_extension_table(go_plugin_data_t* data);
+
 // Initialize a plugin instance
 bool clapgo_plugin_init(const clap_plugin_t* plugin) {
     if (!plugin) return false;
@@ -541,6 +671,9 @@ bool clapgo_plugin_init(const clap_plugin_t* plugin) {
         }
     }
     
+    // Resolve supported extensions once so get_extension is a table lookup
+    clapgo_build_extension_table(data);
+    
     // Call into Go code to initialize the plugin instance
     bool result = ClapGo_PluginInit(data->go_instance);
     
@@ -565,8 +698,9 @@ void clapgo_plugin_destroy(const clap_plugin_t* plugin) {
     go_plugin_data_t* data = (go_plugin_data_t*)plugin->plugin_data;
     if (!data) return;
     
-    // Log to host
+    // Log to host, including anything the audio thread left in the ring
     const clap_host_t* host = data->host;
+    clapgo_log_ring_flush(&data->log_ring, host);
     if (host && host->get_extension) {
         const clap_host_log_t* log_ext = (const clap_host_log_t*)host->get_extension(host, CLAP_EXT_LOG);
         if (log_ext && log_ext->log) {
@@ -657,10 +791,19 @@ clap_process_status clapgo_plugin_process(const clap_plugin_t* plugin, const cla
     if (!plugin || !process) return CLAP_PROCESS_ERROR;
     
     go_plugin_data_t* data = (go_plugin_data_t*)plugin->plugin_data;
-    if (!data || !data->go_instance) return CLAP_PROCESS_ERROR;
+    if (!data) return CLAP_PROCESS_ERROR;
+    if (!data->go_instance) {
+        CLAPGO_RT_LOG(data, CLAP_LOG_ERROR, "process called without a Go instance");
+        return CLAP_PROCESS_ERROR;
+    }
     
     // Call into Go code to process audio
-    return ClapGo_PluginProcess(data->go_instance, (void*)process);
+    clap_process_status status = ClapGo_PluginProcess(data->go_instance, (void*)process);
+    if (status == CLAP_PROCESS_ERROR) {
+        CLAPGO_RT_LOG(data, CLAP_LOG_ERROR, "process failed (%.0f frames, steady time %.0f)",
+                      process->frames_count, process->steady_time);
+    }
+    return status;
 }
 
 // Audio ports extension implementation - GUARDRAILS compliant (full implementation)
@@ -898,7 +1041,7 @@ uint32_t clapgo_audio_ports_count(const clap_plugin_t* plugin, bool is_input) {
     go_plugin_data_t* data = (go_plugin_data_t*)plugin->plugin_data;
     
     // If plugin implements audio ports, call the Go function
-    if (data->supports_audio_ports && ClapGo_PluginAudioPortsCount) {
+    if (data->supports.audio_ports && ClapGo_PluginAudioPortsCount) {
         return ClapGo_PluginAudioPortsCount(data->go_instance, is_input);
     }
     
@@ -914,7 +1057,7 @@ bool clapgo_audio_ports_info(const clap_plugin_t* plugin, uint32_t index, bool i
     go_plugin_data_t* data = (go_plugin_data_t*)plugin->plugin_data;
     
     // If plugin implements audio ports, call the Go function
-    if (data->supports_audio_ports && ClapGo_PluginAudioPortsGet) {
+    if (data->supports.audio_ports && ClapGo_PluginAudioPortsGet) {
         return ClapGo_PluginAudioPortsGet(data->go_instance, index, is_input, info);
     }
     
@@ -935,273 +1078,127 @@ bool clapgo_audio_ports_info(const clap_plugin_t* plugin, uint32_t index, bool i
     return true;
 }
 
-// Get an extension from a plugin instance
-const void* clapgo_plugin_get_extension(const clap_plugin_t* plugin, const char* id) {
-    if (!plugin || !id) return NULL;
-    
-    printf("DEBUG: get_extension called for id: %s\n", id);
-    
-    go_plugin_data_t* data = (go_plugin_data_t*)plugin->plugin_data;
-    if (!data || !data->go_instance) return NULL;
-    
-    // Check if this is the params extension
-    if (strcmp(id, CLAP_EXT_PARAMS) == 0) {
-        if (data->supports_params) {
-            printf("DEBUG: params extension requested and supported\n");
-            return &s_params_extension;
-        }
-        printf("DEBUG: params extension requested but not supported\n");
-        return NULL;
-    }
-    
-    // Check if this is the state extension
-    if (strcmp(id, CLAP_EXT_STATE) == 0) {
-        if (data->supports_state) {
-            printf("DEBUG: state extension requested and supported\n");
-            return &s_state_extension;
-        }
-        printf("DEBUG: state extension requested but not supported\n");
-        return NULL;
-    }
-    
-    // Check if this is the state context extension
-    if (strcmp(id, CLAP_EXT_STATE_CONTEXT) == 0) {
-        if (data->supports_state_context) {
-            printf("DEBUG: state context extension requested and supported\n");
-            return &s_state_context_extension;
-        }
-        printf("DEBUG: state context extension requested but not supported\n");
-        return NULL;
-    }
-    
-    // Check if this is the audio ports extension
-    if (strcmp(id, CLAP_EXT_AUDIO_PORTS) == 0) {
-        printf("DEBUG: audio ports extension requested, always supported\n");
-        // Audio ports are always supported for all plugins
-        return &s_audio_ports_extension;
-    }
-    
-    // Check if this is the note ports extension
-    if (strcmp(id, CLAP_EXT_NOTE_PORTS) == 0) {
-        if (data->supports_note_ports) {
-            printf("DEBUG: note ports extension requested and supported\n");
-            return &s_note_ports_extension;
-        }
-        printf("DEBUG: note ports extension requested but not supported\n");
-        return NULL;
-    }
-    
-    // Check if this is the latency extension
-    if (strcmp(id, CLAP_EXT_LATENCY) == 0) {
-        if (data->supports_latency) {
-            printf("DEBUG: latency extension requested and supported\n");
-            return &s_latency_extension;
-        }
-        printf("DEBUG: latency extension requested but not supported\n");
-        return NULL;
-    }
-    
-    // Check if this is the tail extension
-    if (strcmp(id, CLAP_EXT_TAIL) == 0) {
-        if (data->supports_tail) {
-            printf("DEBUG: tail extension requested and supported\n");
-            return &s_tail_extension;
-        }
-        printf("DEBUG: tail extension requested but not supported\n");
-        return NULL;
-    }
-    
-    // Check if this is the timer support extension
-    if (strcmp(id, CLAP_EXT_TIMER_SUPPORT) == 0) {
-        if (data->supports_timer) {
-            printf("DEBUG: timer support extension requested and supported\n");
-            return &s_timer_support_extension;
-        }
-        printf("DEBUG: timer support extension requested but not supported\n");
-        return NULL;
-    }
-    
-    // Check if this is the audio ports config extension
-    if (strcmp(id, CLAP_EXT_AUDIO_PORTS_CONFIG) == 0) {
-        if (data->supports_audio_ports_config) {
-            printf("DEBUG: audio ports config extension requested and supported\n");
-            return &s_audio_ports_config_extension;
-        }
-        printf("DEBUG: audio ports config extension requested but not supported\n");
-        return NULL;
-    }
-    
-    // Check if this is the audio ports config info extension
-    if (strcmp(id, CLAP_EXT_AUDIO_PORTS_CONFIG_INFO) == 0 || 
-        strcmp(id, CLAP_EXT_AUDIO_PORTS_CONFIG_INFO_COMPAT) == 0) {
-        if (data->supports_audio_ports_config) {
-            printf("DEBUG: audio ports config info extension requested and supported\n");
-            return &s_audio_ports_config_info_extension;
-        }
-        printf("DEBUG: audio ports config info extension requested but not supported\n");
-        return NULL;
-    }
-    
-    // Check if this is the surround extension  
-    if (strcmp(id, CLAP_EXT_SURROUND) == 0 || strcmp(id, CLAP_EXT_SURROUND_COMPAT) == 0) {
-        if (data->supports_surround) {
-            printf("DEBUG: surround extension requested and supported\n");
-            return &s_surround_extension;
-        }
-        printf("DEBUG: surround extension requested but not supported\n");
-        return NULL;
-    }
-    
-    // Check if this is the voice info extension
-    if (strcmp(id, CLAP_EXT_VOICE_INFO) == 0) {
-        if (data->supports_voice_info) {
-            printf("DEBUG: voice info extension requested and supported\n");
-            return &s_voice_info_extension;
-        }
-        printf("DEBUG: voice info extension requested but not supported\n");
-        return NULL;
-    }
-    
-    // Check if this is the preset load extension
-    if (strcmp(id, CLAP_EXT_PRESET_LOAD) == 0 || 
-        strcmp(id, CLAP_EXT_PRESET_LOAD_COMPAT) == 0) {
-        FILE* log = fopen("/tmp/clapgo_factory_calls.log", "a");
-        if (log) {
-            fprintf(log, "[%ld] Plugin extension requested: %s\n", time(NULL), id);
-            fprintf(log, "  supports_preset_load = %d\n", data->supports_preset_load);
-            fclose(log);
-        }
-        if (data->supports_preset_load) {
-            printf("DEBUG: preset load extension requested and supported\n");
-            return &s_preset_load_extension;
-        }
-        printf("DEBUG: preset load extension requested but not supported\n");
-        return NULL;
-    }
-    
-    // Check if this is the track info extension
-    if (strcmp(id, CLAP_EXT_TRACK_INFO) == 0 || strcmp(id, CLAP_EXT_TRACK_INFO_COMPAT) == 0) {
-        if (data->supports_track_info) {
-            printf("DEBUG: track info extension requested and supported\n");
-            return &s_track_info_extension;
-        }
-        printf("DEBUG: track info extension requested but not supported\n");
-        return NULL;
-    }
-    
-    // Check if this is the tuning extension
-    if (strcmp(id, CLAP_EXT_TUNING) == 0) {
-        if (data->supports_tuning) {
-            printf("DEBUG: tuning extension requested and supported\n");
-            return &s_tuning_extension;
-        }
-        printf("DEBUG: tuning extension requested but not supported\n");
-        return NULL;
-    }
-    
-    // Check if this is the param indication extension
-    if (strcmp(id, CLAP_EXT_PARAM_INDICATION) == 0 || strcmp(id, CLAP_EXT_PARAM_INDICATION_COMPAT) == 0) {
-        if (data->supports_param_indication) {
-            printf("DEBUG: param indication extension requested and supported\n");
-            return &s_param_indication_extension;
-        }
-        printf("DEBUG: param indication extension requested but not supported\n");
-        return NULL;
-    }
-    
-    // Check if this is the context menu extension
-    if (strcmp(id, CLAP_EXT_CONTEXT_MENU) == 0 || strcmp(id, CLAP_EXT_CONTEXT_MENU_COMPAT) == 0) {
-        if (data->supports_context_menu) {
-            printf("DEBUG: context menu extension requested and supported\n");
-            return &s_context_menu_extension;
-        }
-        printf("DEBUG: context menu extension requested but not supported\n");
-        return NULL;
-    }
-    
-    // Check if this is the remote controls extension
-    if (strcmp(id, CLAP_EXT_REMOTE_CONTROLS) == 0 || strcmp(id, CLAP_EXT_REMOTE_CONTROLS_COMPAT) == 0) {
-        if (data->supports_remote_controls) {
-            printf("DEBUG: remote controls extension requested and supported\n");
-            return &s_remote_controls_extension;
-        }
-        printf("DEBUG: remote controls extension requested but not supported\n");
-        return NULL;
+// FNV-1a hash of an extension ID
+static uint32_t clapgo_extension_hash(const char* id) {
+    uint32_t hash = 2166136261u;
+    for (const unsigned char* p = (const unsigned char*)id; *p; p++) {
+        hash ^= *p;
+        hash *= 16777619u;
     }
+    return hash;
+}
+
+static void clapgo_extension_table_add(go_plugin_data_t* data, const char* id, const void* vtable) {
+    const uint32_t mask = CLAPGO_EXTENSION_TABLE_SIZE - 1;
+    uint32_t hash = clapgo_extension_hash(id);
     
-    // Check if this is the note name extension
-    if (strcmp(id, CLAP_EXT_NOTE_NAME) == 0) {
-        if (data->supports_note_name) {
-            printf("DEBUG: note name extension requested and supported\n");
-            return &s_note_name_extension;
+    for (uint32_t i = 0; i < CLAPGO_EXTENSION_TABLE_SIZE; i++) {
+        clapgo_extension_entry_t* entry = &data->extensions[(hash + i) & mask];
+        if (!entry->id) {
+            entry->id = id;
+            entry->vtable = vtable;
+            entry->hash = hash;
+            return;
         }
-        printf("DEBUG: note name extension requested but not supported\n");
-        return NULL;
-    }
-    
-    // Check if this is the ambisonic extension
-    if (strcmp(id, CLAP_EXT_AMBISONIC) == 0 || strcmp(id, CLAP_EXT_AMBISONIC_COMPAT) == 0) {
-        if (data->supports_ambisonic) {
-            printf("DEBUG: ambisonic extension requested and supported\n");
-            return &s_ambisonic_extension;
+        // Some compat IDs equal the stable ID in newer CLAP headers
+        if (entry->hash == hash && strcmp(entry->id, id) == 0) {
+            return;
         }
-        printf("DEBUG: ambisonic extension requested but not supported\n");
-        return NULL;
     }
-    
-    // Check if this is the audio ports activation extension
-    if (strcmp(id, CLAP_EXT_AUDIO_PORTS_ACTIVATION) == 0 || strcmp(id, CLAP_EXT_AUDIO_PORTS_ACTIVATION_COMPAT) == 0) {
-        if (data->supports_audio_ports_activation) {
-            printf("DEBUG: audio ports activation extension requested and supported\n");
-            return &s_audio_ports_activation_extension;
+}
+
+// Resolve the extensions this instance supports into its lookup table.
+// Every ID the bridge implements gets an entry, with a NULL vtable when the
+// Go side lacks the exports, so queries for them never reach Go.
+static void clapgo_build_extension_table(go_plugin_data_t* data) {
+    memset(data->extensions, 0, sizeof(data->extensions));
+    
+#define CLAPGO_EXT(ext_id, supported, vtable) \
+    clapgo_extension_table_add(data, (ext_id), (supported) ? (const void*)(vtable) : NULL)
+    
+    CLAPGO_EXT(CLAP_EXT_PARAMS, data->supports.params, &s_params_extension);
+    CLAPGO_EXT(CLAP_EXT_STATE, data->supports.state, &s_state_extension);
+    CLAPGO_EXT(CLAP_EXT_STATE_CONTEXT, data->supports.state_context, &s_state_context_extension);
+    // Audio ports are always supported for all plugins
+    CLAPGO_EXT(CLAP_EXT_AUDIO_PORTS, true, &s_audio_ports_extension);
+    CLAPGO_EXT(CLAP_EXT_NOTE_PORTS, data->supports.note_ports, &s_note_ports_extension);
+    CLAPGO_EXT(CLAP_EXT_LATENCY, data->supports.latency, &s_latency_extension);
+    CLAPGO_EXT(CLAP_EXT_TAIL, data->supports.tail, &s_tail_extension);
+    CLAPGO_EXT(CLAP_EXT_TIMER_SUPPORT, data->supports.timer, &s_timer_support_extension);
+    CLAPGO_EXT(CLAP_EXT_AUDIO_PORTS_CONFIG, data->supports.audio_ports_config, &s_audio_ports_config_extension);
+    CLAPGO_EXT(CLAP_EXT_AUDIO_PORTS_CONFIG_INFO, data->supports.audio_ports_config, &s_audio_ports_config_info_extension);
+    CLAPGO_EXT(CLAP_EXT_AUDIO_PORTS_CONFIG_INFO_COMPAT, data->supports.audio_ports_config, &s_audio_ports_config_info_extension);
+    CLAPGO_EXT(CLAP_EXT_SURROUND, data->supports.surround, &s_surround_extension);
+    CLAPGO_EXT(CLAP_EXT_SURROUND_COMPAT, data->supports.surround, &s_surround_extension);
+    CLAPGO_EXT(CLAP_EXT_VOICE_INFO, data->supports.voice_info, &s_voice_info_extension);
+    CLAPGO_EXT(CLAP_EXT_PRESET_LOAD, data->supports.preset_load, &s_preset_load_extension);
+    CLAPGO_EXT(CLAP_EXT_PRESET_LOAD_COMPAT, data->supports.preset_load, &s_preset_load_extension);
+    CLAPGO_EXT(CLAP_EXT_TRACK_INFO, data->supports.track_info, &s_track_info_extension);
+    CLAPGO_EXT(CLAP_EXT_TRACK_INFO_COMPAT, data->supports.track_info, &s_track_info_extension);
+    CLAPGO_EXT(CLAP_EXT_TUNING, data->supports.tuning, &s_tuning_extension);
+    CLAPGO_EXT(CLAP_EXT_PARAM_INDICATION, data->supports.param_indication, &s_param_indication_extension);
+    CLAPGO_EXT(CLAP_EXT_PARAM_INDICATION_COMPAT, data->supports.param_indication, &s_param_indication_extension);
+    CLAPGO_EXT(CLAP_EXT_CONTEXT_MENU, data->supports.context_menu, &s_context_menu_extension);
+    CLAPGO_EXT(CLAP_EXT_CONTEXT_MENU_COMPAT, data->supports.context_menu, &s_context_menu_extension);
+    CLAPGO_EXT(CLAP_EXT_REMOTE_CONTROLS, data->supports.remote_controls, &s_remote_controls_extension);
+    CLAPGO_EXT(CLAP_EXT_REMOTE_CONTROLS_COMPAT, data->supports.remote_controls, &s_remote_controls_extension);
+    CLAPGO_EXT(CLAP_EXT_NOTE_NAME, data->supports.note_name, &s_note_name_extension);
+    CLAPGO_EXT(CLAP_EXT_AMBISONIC, data->supports.ambisonic, &s_ambisonic_extension);
+    CLAPGO_EXT(CLAP_EXT_AMBISONIC_COMPAT, data->supports.ambisonic, &s_ambisonic_extension);
+    CLAPGO_EXT(CLAP_EXT_AUDIO_PORTS_ACTIVATION, data->supports.audio_ports_activation, &s_audio_ports_activation_extension);
+    CLAPGO_EXT(CLAP_EXT_AUDIO_PORTS_ACTIVATION_COMPAT, data->supports.audio_ports_activation, &s_audio_ports_activation_extension);
+    CLAPGO_EXT(CLAP_EXT_CONFIGURABLE_AUDIO_PORTS, data->supports.configurable_audio_ports, &s_configurable_audio_ports_extension);
+    CLAPGO_EXT(CLAP_EXT_CONFIGURABLE_AUDIO_PORTS_COMPAT, data->supports.configurable_audio_ports, &s_configurable_audio_ports_extension);
+    CLAPGO_EXT(CLAP_EXT_POSIX_FD_SUPPORT, data->supports.posix_fd_support, &s_posix_fd_support_extension);
+    CLAPGO_EXT(CLAP_EXT_RENDER, data->supports.render, &s_render_extension);
+    CLAPGO_EXT(CLAP_EXT_THREAD_POOL, data->supports.thread_pool, &s_thread_pool_extension);
+    
+#undef CLAPGO_EXT
+    
+    data->extensions_ready = true;
+}
+
+// Look an ID up in the instance's extension table. Returns false for IDs
+// the bridge does not implement.
+static bool clapgo_extension_table_find(const go_plugin_data_t* data, const char* id, const void** vtable) {
+    const uint32_t mask = CLAPGO_EXTENSION_TABLE_SIZE - 1;
+    uint32_t hash = clapgo_extension_hash(id);
+    
+    for (uint32_t i = 0; i < CLAPGO_EXTENSION_TABLE_SIZE; i++) {
+        const clapgo_extension_entry_t* entry = &data->extensions[(hash + i) & mask];
+        if (!entry->id) {
+            return false;
         }
-        printf("DEBUG: audio ports activation extension requested but not supported\n");
-        return NULL;
-    }
-    
-    // Check if this is the configurable audio ports extension
-    if (strcmp(id, CLAP_EXT_CONFIGURABLE_AUDIO_PORTS) == 0 || strcmp(id, CLAP_EXT_CONFIGURABLE_AUDIO_PORTS_COMPAT) == 0) {
-        if (data->supports_configurable_audio_ports) {
-            printf("DEBUG: configurable audio ports extension requested and supported\n");
-            return &s_configurable_audio_ports_extension;
+        if (entry->hash == hash && strcmp(entry->id, id) == 0) {
+            *vtable = entry->vtable;
+            return true;
         }
-        printf("DEBUG: configurable audio ports extension requested but not supported\n");
-        return NULL;
     }
+    return false;
+}
+
+// Get an extension from a plugin instance
+const void* clapgo_plugin_get_extension(const clap_plugin_t* plugin, const char* id) {
+    if (!plugin || !id) return NULL;
     
-    // Check if this is the POSIX FD support extension
-    if (strcmp(id, CLAP_EXT_POSIX_FD_SUPPORT) == 0) {
-        if (data->supports_posix_fd_support) {
-            printf("DEBUG: POSIX FD support extension requested and supported\n");
-            return &s_posix_fd_support_extension;
-        }
-        printf("DEBUG: POSIX FD support extension requested but not supported\n");
-        return NULL;
-    }
+    go_plugin_data_t* data = (go_plugin_data_t*)plugin->plugin_data;
+    if (!data || !data->go_instance) return NULL;
     
-    // Check if this is the render extension
-    if (strcmp(id, CLAP_EXT_RENDER) == 0) {
-        if (data->supports_render) {
-            printf("DEBUG: render extension requested and supported\n");
-            return &s_render_extension;
-        }
-        printf("DEBUG: render extension requested but not supported\n");
-        return NULL;
+    // The table is built in init; CLAP forbids queries before it, but a
+    // host that does so is on the main thread and can pay for the build
+    if (!data->extensions_ready) {
+        clapgo_build_extension_table(data);
     }
     
-    // Check if this is the thread pool extension
-    if (strcmp(id, CLAP_EXT_THREAD_POOL) == 0) {
-        if (data->supports_thread_pool) {
-            printf("DEBUG: thread pool extension requested and supported\n");
-            return &s_thread_pool_extension;
-        }
-        printf("DEBUG: thread pool extension requested but not supported\n");
-        return NULL;
+    const void* vtable = NULL;
+    if (clapgo_extension_table_find(data, id, &vtable)) {
+        CLAPGO_DEBUG("DEBUG: get_extension %s -> %s\n", id, vtable ? "supported" : "not supported");
+        return vtable;
     }
     
-    // Call into Go code to get the extension
+    // Not a bridge extension: the Go side may provide it
     void* ext = ClapGo_PluginGetExtension(data->go_instance, (char*)id);
-    printf("DEBUG: Go returned extension: %p\n", ext);
+    CLAPGO_DEBUG("DEBUG: Go returned extension for %s: %p\n", id, ext);
     return ext;
 }
 
@@ -1210,7 +1207,11 @@ void clapgo_plugin_on_main_thread(const clap_plugin_t* plugin) {
     if (!plugin) return;
     
     go_plugin_data_t* data = (go_plugin_data_t*)plugin->plugin_data;
-    if (!data || !data->go_instance) return;
+    if (!data) return;
+    
+    // Forward anything the audio thread logged through the bridge
+    clapgo_log_ring_flush(&data->log_ring, data->host);
+    if (!data->go_instance) return;
     
     // Call into Go code to handle main thread tasks
     ClapGo_PluginOnMainThread(data->go_instance);
@@ -1867,6 +1868,24 @@ static void clapgo_thread_pool_exec(const clap_plugin_t* plugin, uint32_t task_i
     ClapGo_PluginThreadPoolExec(data->go_instance, task_index);
 }
 
+// Telemetry block of an instance, for GUI bridges
+clapgo_telemetry_t* clapgo_plugin_get_telemetry(const clap_plugin_t* plugin) {
+    if (!plugin) return NULL;
+    
+    go_plugin_data_t* data = (go_plugin_data_t*)plugin->plugin_data;
+    if (!data || !data->go_instance) return NULL;
+    
+    if (!ClapGo_PluginTelemetry) {
+        return NULL;
+    }
+    
+    clapgo_telemetry_t* telemetry = (clapgo_telemetry_t*)ClapGo_PluginTelemetry(data->go_instance);
+    if (telemetry && telemetry->version != CLAPGO_TELEMETRY_VERSION) {
+        return NULL;
+    }
+    return telemetry;
+}
+
 // Reload manifest files - used by invalidation factory
 void clapgo_reload_manifests(void) {
     // Store the current plugin path if we have one loaded
@@ -1881,14 +1900,19 @@ void clapgo_reload_manifests(void) {
             const char* simple_name = strrchr(plugin_id, '.');
             simple_name = simple_name ? simple_name + 1 : plugin_id;
             
-            snprintf(stored_plugin_path, sizeof(stored_plugin_path),
-                    "%s/.clap/%s/%s.clap", home, simple_name, simple_name);
+            int written = snprintf(stored_plugin_path, sizeof(stored_plugin_path),
+                                   "%s/.clap/%s/%s.clap", home, simple_name, simple_name);
+            if (written < 0 || (size_t)written >= sizeof(stored_plugin_path)) {
+                stored_plugin_path[0] = '\0';
+            }
         }
     }
     
-    // Clear current manifests
+    // Clear current manifests. Live instances still point at the old
+    // descriptors, and cached ones at the old mapping, so both are left be.
+    memset(manifest_plugins, 0, sizeof(manifest_plugins[0]) * (size_t)manifest_plugin_count);
     manifest_plugin_count = 0;
-    memset(manifest_plugins, 0, sizeof(manifest_plugins));
+    memset(&manifest_cache, 0, sizeof(manifest_cache));
     
     // Reload manifests if we have a path
     if (stored_plugin_path[0] != '\0') {
@@ -5,6 +5,9 @@
 #include <stdint.h>
 #include "../../include/clap/include/clap/clap.h"
 #include "manifest.h"
+#include "manifest_cache.h"
+#include "log_ring.h"
+#include "telemetry.h"
 
 // Platform detection
 #if defined(_WIN32) || defined(_WIN64)
@@ -37,11 +40,67 @@
 // Maximum number of manifests that can be tracked
 #define MAX_PLUGIN_MANIFESTS 32
 
+// Bridge debug logging, compiled out unless CLAPGO_DEBUG_LOG is defined.
+// Hosts may call into the bridge from the audio thread (get_extension in
+// particular), so release builds must never reach stdio from these paths.
+#ifdef CLAPGO_DEBUG_LOG
+    #define CLAPGO_DEBUG(...) fprintf(stderr, __VA_ARGS__)
+    #define CLAPGO_DEBUG_FILE(path) fopen((path), "a")
+#else
+    #define CLAPGO_DEBUG(...) ((void)0)
+    #define CLAPGO_DEBUG_FILE(path) ((void*)0)
+#endif
+
+// Slots in the per-instance extension table; a power of two, comfortably
+// more than twice the number of extension IDs the bridge knows
+#define CLAPGO_EXTENSION_TABLE_SIZE 64
+
+// Extension lookup entry: a known ID and the vtable to return for it,
+// NULL when the plugin does not implement the extension
+typedef struct clapgo_extension_entry {
+    const char* id;
+    const void* vtable;
+    uint32_t hash;
+} clapgo_extension_entry_t;
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-// Go plugin state structure - holds the Go instance handle
+// Extensions a plugin library implements, one flag per group of exports.
+// The export set is fixed when the library is built, generated from the
+// manifest by generate-manifest, so the bridge probes it once in
+// clapgo_init and every instance copies the result.
+typedef struct clapgo_supports {
+    bool params;                   // Has param-related exports
+    bool audio_ports;              // Has audio port exports
+    bool note_ports;               // Has note port exports
+    bool state;                    // Has state save/load exports
+    bool latency;                  // Has latency export
+    bool tail;                     // Has tail export
+    bool timer;                    // Has timer export
+    bool audio_ports_config;       // Has audio ports config exports
+    bool surround;                 // Has surround exports
+    bool voice_info;               // Has voice info export
+    bool state_context;            // Has state context exports
+    bool preset_load;              // Has preset load export
+    bool track_info;               // Has track info export
+    bool tuning;                   // Has tuning export
+    bool param_indication;         // Has param indication exports
+    bool context_menu;             // Has context menu exports
+    bool remote_controls;          // Has remote controls exports
+    bool note_name;                // Has note name exports
+    bool ambisonic;                // Has ambisonic exports
+    bool audio_ports_activation;   // Has audio ports activation exports
+    bool configurable_audio_ports; // Has configurable audio ports exports
+    bool posix_fd_support;         // Has POSIX FD support export
+    bool render;                   // Has render exports
+    bool thread_pool;              // Has thread pool export
+} clapgo_supports_t;
+
+// Go plugin state structure. go_instance is the value ClapGo_CreatePlugin
+// returned and every export receives back: the instance address for
+// plugins using plugin.Instances, a cgo.Handle for older ones.
 typedef struct go_plugin_data {
     void* go_instance;
     const clap_plugin_descriptor_t* descriptor;
@@ -51,31 +110,19 @@ typedef struct go_plugin_data {
     // Store the host pointer for logging
     const clap_host_t* host;
     
-    // Extension support flags - determined at plugin creation
-    bool supports_params;      // Has param-related exports
-    bool supports_audio_ports; // Has audio port exports
-    bool supports_note_ports;  // Has note port exports
-    bool supports_state;       // Has state save/load exports
-    bool supports_latency;     // Has latency export
-    bool supports_tail;        // Has tail export
-    bool supports_timer;       // Has timer export
-    bool supports_audio_ports_config; // Has audio ports config exports
-    bool supports_surround;    // Has surround exports
-    bool supports_voice_info;  // Has voice info export
-    bool supports_state_context; // Has state context exports
-    bool supports_preset_load;  // Has preset load export
-    bool supports_track_info;   // Has track info export
-    bool supports_tuning;       // Has tuning export
-    bool supports_param_indication; // Has param indication exports
-    bool supports_context_menu; // Has context menu exports
-    bool supports_remote_controls; // Has remote controls exports
-    bool supports_note_name; // Has note name exports
-    bool supports_ambisonic; // Has ambisonic exports
-    bool supports_audio_ports_activation; // Has audio ports activation exports
-    bool supports_configurable_audio_ports; // Has configurable audio ports exports
-    bool supports_posix_fd_support; // Has POSIX FD support export
-    bool supports_render; // Has render exports
-    bool supports_thread_pool; // Has thread pool export
+    // Extension support, copied from the library's at creation
+    clapgo_supports_t supports;
+    
+    // Extension lookup, built from the flags above in clapgo_plugin_init.
+    // Open-addressed by ID hash; empty slots have a NULL id.
+    clapgo_extension_entry_t extensions[CLAPGO_EXTENSION_TABLE_SIZE];
+    bool extensions_ready;
+    
+    // Log records written from the audio thread, flushed in on_main_thread
+    clapgo_log_ring_t log_ring;
+    
+    // Owned by the GUI bridge, from gui create to destroy
+    void* gui_state;
 } go_plugin_data_t;
 
 
@@ -84,6 +131,11 @@ typedef struct {
     plugin_manifest_t manifest;
     const clap_plugin_descriptor_t* descriptor;
     bool loaded;
+    
+    // Set when the entry came from the manifest cache. Only the ID, name,
+    // vendor and version are copied into manifest; the descriptor borrows
+    // its strings from the mapping.
+    const clapgo_manifest_cache_entry_t* cached;
 } manifest_plugin_entry_t;
 
 // Manifest plugin registry - external declarations
@@ -136,6 +188,10 @@ clap_process_status clapgo_plugin_process(const clap_plugin_t* plugin, const cla
 const void* clapgo_plugin_get_extension(const clap_plugin_t* plugin, const char* id);
 void clapgo_plugin_on_main_thread(const clap_plugin_t* plugin);
 
+// Meter and scope frames published by the plugin, NULL when it publishes
+// none. Main thread; valid until the plugin is destroyed.
+clapgo_telemetry_t* clapgo_plugin_get_telemetry(const clap_plugin_t* plugin);
+
 // Audio ports extension implementation
 uint32_t clapgo_audio_ports_count(const clap_plugin_t* plugin, bool is_input);
 bool clapgo_audio_ports_info(const clap_plugin_t* plugin, uint32_t index, bool is_input, clap_audio_port_info_t* info);
@@ -163,7 +219,7 @@ typedef const void* (*clapgo_plugin_get_extension_func)(void* plugin, const char
 typedef void (*clapgo_plugin_on_main_thread_func)(void* plugin);
 
 // Function pointer types for plugin creation and versioning
-typedef void* (*clapgo_create_plugin_func)(void* host, const char* plugin_id);
+typedef uintptr_t (*clapgo_create_plugin_func)(void* host, const char* plugin_id);
 typedef bool (*clapgo_get_version_func)(uint32_t* major, uint32_t* minor, uint32_t* patch);
 
 // Reload manifest files - used by invalidation factory
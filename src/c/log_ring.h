@@ -0,0 +1,116 @@
+#ifndef CLAPGO_LOG_RING_H
+#define CLAPGO_LOG_RING_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "../../include/clap/include/clap/clap.h"
+
+// Real-time-safe logging for bridge code that may run on the audio thread.
+//
+// Producers copy a fixed-size record into a preallocated ring: a static
+// format string, a severity and up to four numeric arguments. Nothing is
+// formatted and nothing is allocated until the main thread flushes the ring
+// to clap_host_log. The ring is single-producer, single-consumer; the audio
+// thread writes and on_main_thread reads. A zeroed ring is empty and ready.
+
+// Records in the ring; a power of two
+#define CLAPGO_LOG_RING_SIZE 64
+
+// Arguments per record
+#define CLAPGO_LOG_RING_ARGS 4
+
+// One pending log line. The format must be a string literal and take only
+// double arguments (%g, %f, %.0f, ...), since every argument is stored as
+// one; unused trailing arguments are ignored by the formatter.
+typedef struct clapgo_log_record {
+    const char* format;
+    int32_t severity;
+    double args[CLAPGO_LOG_RING_ARGS];
+} clapgo_log_record_t;
+
+typedef struct clapgo_log_ring {
+    clapgo_log_record_t records[CLAPGO_LOG_RING_SIZE];
+    _Atomic uint32_t tail;      // written by the producer
+    _Atomic uint32_t head;      // written by the consumer
+    _Atomic uint32_t dropped;   // records lost to a full ring
+    _Atomic bool requested;     // a main-thread callback is outstanding
+    uint32_t reported;          // consumer only: drops already reported
+} clapgo_log_ring_t;
+
+// Append a record without blocking. Returns false and counts a drop when
+// the ring is full. Asks the host for a main-thread callback on the first
+// record after a flush; request_callback is thread-safe per the CLAP spec.
+static inline bool clapgo_log_ring_push(clapgo_log_ring_t* ring, const clap_host_t* host,
+                                        int32_t severity, const char* format,
+                                        double a0, double a1, double a2, double a3) {
+    uint32_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+    uint32_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+    if (tail - head >= CLAPGO_LOG_RING_SIZE) {
+        atomic_fetch_add_explicit(&ring->dropped, 1, memory_order_relaxed);
+        return false;
+    }
+
+    clapgo_log_record_t* record = &ring->records[tail & (CLAPGO_LOG_RING_SIZE - 1)];
+    record->format = format;
+    record->severity = severity;
+    record->args[0] = a0;
+    record->args[1] = a1;
+    record->args[2] = a2;
+    record->args[3] = a3;
+    atomic_store_explicit(&ring->tail, tail + 1, memory_order_release);
+
+    if (host && host->request_callback &&
+        !atomic_exchange_explicit(&ring->requested, true, memory_order_acq_rel)) {
+        host->request_callback(host);
+    }
+    return true;
+}
+
+// Convenience wrapper taking a format followed by zero to four arguments:
+// CLAPGO_RT_LOG(data, CLAP_LOG_WARNING, "bad frame count %.0f", n)
+#define CLAPGO_RT_LOG(data, severity, ...) \
+    CLAPGO_RT_LOG_(data, severity, __VA_ARGS__, 0.0, 0.0, 0.0, 0.0, 0.0)
+#define CLAPGO_RT_LOG_(data, severity, format, a0, a1, a2, a3, ...) \
+    clapgo_log_ring_push(&(data)->log_ring, (data)->host, (severity), (format), \
+                         (double)(a0), (double)(a1), (double)(a2), (double)(a3))
+
+// Format every pending record and forward it to the host log; main thread
+// only. Reports new drops as a warning. Returns the number of records read.
+static inline uint32_t clapgo_log_ring_flush(clapgo_log_ring_t* ring, const clap_host_t* host) {
+    // Re-arm first so records pushed while flushing request another callback
+    atomic_store_explicit(&ring->requested, false, memory_order_release);
+
+    const clap_host_log_t* log = NULL;
+    if (host && host->get_extension) {
+        log = (const clap_host_log_t*)host->get_extension(host, CLAP_EXT_LOG);
+    }
+
+    char message[256];
+    uint32_t count = 0;
+    uint32_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    uint32_t tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+    for (; head != tail; head++, count++) {
+        const clapgo_log_record_t* record = &ring->records[head & (CLAPGO_LOG_RING_SIZE - 1)];
+        if (log && log->log) {
+            snprintf(message, sizeof(message), record->format,
+                     record->args[0], record->args[1], record->args[2], record->args[3]);
+            log->log(host, record->severity, message);
+        }
+        atomic_store_explicit(&ring->head, head + 1, memory_order_release);
+    }
+
+    uint32_t dropped = atomic_load_explicit(&ring->dropped, memory_order_relaxed);
+    if (dropped != ring->reported) {
+        if (log && log->log) {
+            snprintf(message, sizeof(message), "bridge log ring overflowed: %u records dropped",
+                     (unsigned)(dropped - ring->reported));
+            log->log(host, CLAP_LOG_WARNING, message);
+        }
+        ring->reported = dropped;
+    }
+    return count;
+}
+
+#endif // CLAPGO_LOG_RING_H
@@ -8,6 +8,14 @@
 #include <libgen.h>
 #include <json-c/json.h>
 
+// Scan diagnostics, compiled out unless CLAPGO_DEBUG_LOG is defined; hosts
+// load every plugin on a scan and stdout is not theirs to write to
+#ifdef CLAPGO_DEBUG_LOG
+    #define MANIFEST_DEBUG(...) fprintf(stderr, __VA_ARGS__)
+#else
+    #define MANIFEST_DEBUG(...) ((void)0)
+#endif
+
 // Initialize the plugin manifest with default values
 void manifest_init(plugin_manifest_t* manifest) {
     memset(manifest, 0, sizeof(plugin_manifest_t));
@@ -21,134 +29,58 @@ void manifest_init(plugin_manifest_t* manifest) {
     // No default entry_point - we use standardized export functions
 }
 
-bool manifest_load_from_file(const char* path, plugin_manifest_t* manifest) {
-    printf("Loading manifest from file: %s\n", path);
-    
-    // Initialize manifest with default values
-    manifest_init(manifest);
-    
-    // Parse JSON file using json-c
-    struct json_object* root = json_object_from_file(path);
-    if (!root) {
-        fprintf(stderr, "Error: Failed to parse manifest file: %s\n", path);
-        printf("json-c error: %s\n", json_util_get_last_err());
-        return false;
-    }
-    
-    printf("Successfully parsed JSON file: %s\n", path);
-    
-    // Get schema version
-    struct json_object* schema_version_obj;
-    if (json_object_object_get_ex(root, "schemaVersion", &schema_version_obj)) {
-        const char* schema_version = json_object_get_string(schema_version_obj);
-        if (schema_version) {
-            strncpy(manifest->schema_version, schema_version, sizeof(manifest->schema_version) - 1);
+// Copy a string member of obj into dst, leaving dst alone when absent
+static void manifest_copy_string(struct json_object* obj, const char* key, char* dst, size_t size) {
+    struct json_object* value;
+    if (json_object_object_get_ex(obj, key, &value)) {
+        const char* str = json_object_get_string(value);
+        if (str) {
+            strncpy(dst, str, size - 1);
+            dst[size - 1] = '\0';
         }
     }
+}
+
+// Parse one plugin object: the top-level "plugin" or an entry of "plugins"
+static void manifest_parse_plugin(struct json_object* plugin_obj, plugin_manifest_t* manifest) {
+    manifest_copy_string(plugin_obj, "id", manifest->plugin.id, sizeof(manifest->plugin.id));
+    manifest_copy_string(plugin_obj, "name", manifest->plugin.name, sizeof(manifest->plugin.name));
+    manifest_copy_string(plugin_obj, "vendor", manifest->plugin.vendor, sizeof(manifest->plugin.vendor));
+    manifest_copy_string(plugin_obj, "version", manifest->plugin.version, sizeof(manifest->plugin.version));
+    manifest_copy_string(plugin_obj, "description", manifest->plugin.description, sizeof(manifest->plugin.description));
+    manifest_copy_string(plugin_obj, "url", manifest->plugin.url, sizeof(manifest->plugin.url));
+    manifest_copy_string(plugin_obj, "manualUrl", manifest->plugin.manual_url, sizeof(manifest->plugin.manual_url));
+    manifest_copy_string(plugin_obj, "supportUrl", manifest->plugin.support_url, sizeof(manifest->plugin.support_url));
     
-    // Parse plugin object
-    struct json_object* plugin_obj;
-    if (json_object_object_get_ex(root, "plugin", &plugin_obj)) {
-        // Parse plugin ID
-        struct json_object* id_obj;
-        if (json_object_object_get_ex(plugin_obj, "id", &id_obj)) {
-            const char* id = json_object_get_string(id_obj);
-            if (id) {
-                strncpy(manifest->plugin.id, id, sizeof(manifest->plugin.id) - 1);
-            }
-        }
+    // Parse features array
+    struct json_object* features_obj;
+    if (json_object_object_get_ex(plugin_obj, "features", &features_obj) && 
+        json_object_is_type(features_obj, json_type_array)) {
         
-        // Parse plugin name
-        struct json_object* name_obj;
-        if (json_object_object_get_ex(plugin_obj, "name", &name_obj)) {
-            const char* name = json_object_get_string(name_obj);
-            if (name) {
-                strncpy(manifest->plugin.name, name, sizeof(manifest->plugin.name) - 1);
-            }
+        int feature_count = json_object_array_length(features_obj);
+        if (feature_count > MAX_FEATURES) {
+            feature_count = MAX_FEATURES;
         }
         
-        // Parse plugin vendor
-        struct json_object* vendor_obj;
-        if (json_object_object_get_ex(plugin_obj, "vendor", &vendor_obj)) {
-            const char* vendor = json_object_get_string(vendor_obj);
-            if (vendor) {
-                strncpy(manifest->plugin.vendor, vendor, sizeof(manifest->plugin.vendor) - 1);
-            }
-        }
-        
-        // Parse plugin version
-        struct json_object* version_obj;
-        if (json_object_object_get_ex(plugin_obj, "version", &version_obj)) {
-            const char* version = json_object_get_string(version_obj);
-            if (version) {
-                strncpy(manifest->plugin.version, version, sizeof(manifest->plugin.version) - 1);
-            }
-        }
-        
-        // Parse plugin description
-        struct json_object* description_obj;
-        if (json_object_object_get_ex(plugin_obj, "description", &description_obj)) {
-            const char* description = json_object_get_string(description_obj);
-            if (description) {
-                strncpy(manifest->plugin.description, description, sizeof(manifest->plugin.description) - 1);
-            }
-        }
-        
-        // Parse plugin URLs
-        struct json_object* url_obj;
-        if (json_object_object_get_ex(plugin_obj, "url", &url_obj)) {
-            const char* url = json_object_get_string(url_obj);
-            if (url) {
-                strncpy(manifest->plugin.url, url, sizeof(manifest->plugin.url) - 1);
-            }
-        }
-        
-        struct json_object* manual_url_obj;
-        if (json_object_object_get_ex(plugin_obj, "manualUrl", &manual_url_obj)) {
-            const char* manual_url = json_object_get_string(manual_url_obj);
-            if (manual_url) {
-                strncpy(manifest->plugin.manual_url, manual_url, sizeof(manifest->plugin.manual_url) - 1);
-            }
-        }
-        
-        struct json_object* support_url_obj;
-        if (json_object_object_get_ex(plugin_obj, "supportUrl", &support_url_obj)) {
-            const char* support_url = json_object_get_string(support_url_obj);
-            if (support_url) {
-                strncpy(manifest->plugin.support_url, support_url, sizeof(manifest->plugin.support_url) - 1);
-            }
-        }
-        
-        // Parse features array
-        struct json_object* features_obj;
-        if (json_object_object_get_ex(plugin_obj, "features", &features_obj) && 
-            json_object_is_type(features_obj, json_type_array)) {
-            
-            int feature_count = json_object_array_length(features_obj);
-            if (feature_count > MAX_FEATURES) {
-                feature_count = MAX_FEATURES;
-            }
-            
-            manifest->plugin.feature_count = feature_count;
-            
-            for (int i = 0; i < feature_count; i++) {
-                struct json_object* feature = json_object_array_get_idx(features_obj, i);
-                if (feature && json_object_is_type(feature, json_type_string)) {
-                    const char* feature_str = json_object_get_string(feature);
-                    if (feature_str) {
-                        manifest->plugin.features[i] = strdup(feature_str);
-                    }
+        manifest->plugin.feature_count = 0;
+        for (int i = 0; i < feature_count; i++) {
+            struct json_object* feature = json_object_array_get_idx(features_obj, i);
+            if (feature && json_object_is_type(feature, json_type_string)) {
+                const char* feature_str = json_object_get_string(feature);
+                if (feature_str) {
+                    manifest->plugin.features[manifest->plugin.feature_count++] = strdup(feature_str);
                 }
             }
         }
     }
+}
+
+// Parse the members shared by every plugin of a bundle
+static void manifest_parse_shared(struct json_object* root, plugin_manifest_t* manifest) {
+    manifest_copy_string(root, "schemaVersion", manifest->schema_version, sizeof(manifest->schema_version));
     
     // Parse build object (optional, kept for future extensibility)
-    struct json_object* build_obj;
-    if (json_object_object_get_ex(root, "build", &build_obj)) {
-        // All plugins are self-contained by design - no fields to parse currently
-        // We don't need the entry_point field anymore - we use standardized export functions
-    }
+    // All plugins are self-contained by design - no fields to parse currently
     
     // Parse extensions array
     struct json_object* extensions_obj;
@@ -165,13 +97,7 @@ bool manifest_load_from_file(const char* path, plugin_manifest_t* manifest) {
         for (int i = 0; i < extension_count; i++) {
             struct json_object* ext = json_object_array_get_idx(extensions_obj, i);
             if (ext && json_object_is_type(ext, json_type_object)) {
-                struct json_object* id_obj;
-                if (json_object_object_get_ex(ext, "id", &id_obj)) {
-                    const char* id = json_object_get_string(id_obj);
-                    if (id) {
-                        strncpy(manifest->extensions[i].id, id, sizeof(manifest->extensions[i].id) - 1);
-                    }
-                }
+                manifest_copy_string(ext, "id", manifest->extensions[i].id, sizeof(manifest->extensions[i].id));
                 
                 struct json_object* supported_obj;
                 if (json_object_object_get_ex(ext, "supported", &supported_obj)) {
@@ -201,13 +127,7 @@ bool manifest_load_from_file(const char* path, plugin_manifest_t* manifest) {
                     manifest->parameters[i].id = json_object_get_int(id_obj);
                 }
                 
-                struct json_object* name_obj;
-                if (json_object_object_get_ex(param, "name", &name_obj)) {
-                    const char* name = json_object_get_string(name_obj);
-                    if (name) {
-                        strncpy(manifest->parameters[i].name, name, sizeof(manifest->parameters[i].name) - 1);
-                    }
-                }
+                manifest_copy_string(param, "name", manifest->parameters[i].name, sizeof(manifest->parameters[i].name));
                 
                 struct json_object* min_obj;
                 if (json_object_object_get_ex(param, "minValue", &min_obj)) {
@@ -231,22 +151,77 @@ bool manifest_load_from_file(const char* path, plugin_manifest_t* manifest) {
             }
         }
     }
+}
+
+// Check the fields a descriptor cannot do without
+static bool manifest_has_required_fields(const plugin_manifest_t* manifest) {
+    return manifest->plugin.id[0] != '\0' &&
+           manifest->plugin.name[0] != '\0' &&
+           manifest->plugin.vendor[0] != '\0' &&
+           manifest->plugin.version[0] != '\0';
+}
+
+// Parse one plugin of root into manifest; returns whether it is usable
+static bool manifest_load_entry(struct json_object* root, struct json_object* plugin_obj,
+                                const char* path, plugin_manifest_t* manifest) {
+    manifest_init(manifest);
+    manifest_parse_shared(root, manifest);
+    manifest_parse_plugin(plugin_obj, manifest);
     
-    // Free the JSON object
-    json_object_put(root);
-    
-    // Validate required fields
-    if (manifest->plugin.id[0] == '\0' || 
-        manifest->plugin.name[0] == '\0' || 
-        manifest->plugin.vendor[0] == '\0' || 
-        manifest->plugin.version[0] == '\0') {
+    if (!manifest_has_required_fields(manifest)) {
         fprintf(stderr, "Error: Missing required fields in manifest file: %s\n", path);
+        manifest_free(manifest);
         return false;
     }
-    
     return true;
 }
 
+int manifest_load_bundle_from_file(const char* path, plugin_manifest_t* manifests, int max_manifests) {
+    MANIFEST_DEBUG("Loading manifest from file: %s\n", path);
+    
+    // Parse JSON file using json-c
+    struct json_object* root = json_object_from_file(path);
+    if (!root) {
+        fprintf(stderr, "Error: Failed to parse manifest file: %s (%s)\n", path, json_util_get_last_err());
+        return 0;
+    }
+    
+    int count = 0;
+    
+    // The single-plugin form
+    struct json_object* plugin_obj;
+    if (count < max_manifests && json_object_object_get_ex(root, "plugin", &plugin_obj) &&
+        json_object_is_type(plugin_obj, json_type_object)) {
+        if (manifest_load_entry(root, plugin_obj, path, &manifests[count])) {
+            count++;
+        }
+    }
+    
+    // Bundles list any further plugins under "plugins"
+    struct json_object* plugins_obj;
+    if (json_object_object_get_ex(root, "plugins", &plugins_obj) &&
+        json_object_is_type(plugins_obj, json_type_array)) {
+        int plugin_count = json_object_array_length(plugins_obj);
+        for (int i = 0; i < plugin_count && count < max_manifests; i++) {
+            struct json_object* entry = json_object_array_get_idx(plugins_obj, i);
+            if (entry && json_object_is_type(entry, json_type_object) &&
+                manifest_load_entry(root, entry, path, &manifests[count])) {
+                count++;
+            }
+        }
+    }
+    
+    // Free the JSON object
+    json_object_put(root);
+    
+    MANIFEST_DEBUG("Loaded %d plugin(s) from %s\n", count, path);
+    return count;
+}
+
+bool manifest_load_from_file(const char* path, plugin_manifest_t* manifest) {
+    return manifest_load_bundle_from_file(path, manifest, 1) == 1;
+}
+
 clap_plugin_descriptor_t* manifest_to_descriptor(const plugin_manifest_t* manifest) {
     // Allocate descriptor
     clap_plugin_descriptor_t* desc = (clap_plugin_descriptor_t*)calloc(1, sizeof(clap_plugin_descriptor_t));
@@ -307,18 +282,18 @@ void manifest_free(plugin_manifest_t* manifest) {
 
 // Find manifest files in a directory
 char** manifest_find_files(const char* directory, int* count) {
-    printf("Searching for manifest files in directory: %s\n", directory);
+    MANIFEST_DEBUG("Searching for manifest files in directory: %s\n", directory);
     
     // First check for specific file patterns
     char manifest_path[512];
     const char* plugin_basename = basename(strdup(directory));
     snprintf(manifest_path, sizeof(manifest_path), "%s/%s.json", directory, plugin_basename);
-    printf("Checking for specific manifest file: %s\n", manifest_path);
+    MANIFEST_DEBUG("Checking for specific manifest file: %s\n", manifest_path);
     
     // Try to find file in the directory
     FILE* test = fopen(manifest_path, "r");
     if (test) {
-        printf("Found specific manifest file: %s\n", manifest_path);
+        MANIFEST_DEBUG("Found specific manifest file: %s\n", manifest_path);
         fclose(test);
         
         // Allocate and return a single file
@@ -335,11 +310,11 @@ char** manifest_find_files(const char* directory, int* count) {
     char central_path[512];
     const char* plugin_name = basename(strdup(plugin_basename));
     snprintf(central_path, sizeof(central_path), "%s/.clap/manifests/%s.json", getenv("HOME"), plugin_name);
-    printf("Checking for manifest in central repository: %s\n", central_path);
+    MANIFEST_DEBUG("Checking for manifest in central repository: %s\n", central_path);
     
     test = fopen(central_path, "r");
     if (test) {
-        printf("Found manifest file in central repository: %s\n", central_path);
+        MANIFEST_DEBUG("Found manifest file in central repository: %s\n", central_path);
         fclose(test);
         
         // Allocate and return a single file
@@ -355,7 +330,7 @@ char** manifest_find_files(const char* directory, int* count) {
     // Open directory to search for all JSON files
     DIR* dir = opendir(directory);
     if (!dir) {
-        printf("Failed to open directory: %s\n", directory);
+        MANIFEST_DEBUG("Failed to open directory: %s\n", directory);
         *count = 0;
         return NULL;
     }
@@ -368,7 +343,7 @@ char** manifest_find_files(const char* directory, int* count) {
         const char* name = entry->d_name;
         size_t len = strlen(name);
         if (len > 5 && strcmp(name + len - 5, ".json") == 0) {
-            printf("Found JSON file: %s\n", name);
+            MANIFEST_DEBUG("Found JSON file: %s\n", name);
             file_count++;
         }
     }
@@ -396,7 +371,7 @@ char** manifest_find_files(const char* directory, int* count) {
                 files[index] = (char*)malloc(path_len);
                 if (files[index]) {
                     snprintf(files[index], path_len, "%s/%s", directory, name);
-                    printf("Added manifest file path: %s\n", files[index]);
+                    MANIFEST_DEBUG("Added manifest file path: %s\n", files[index]);
                     index++;
                 }
             }
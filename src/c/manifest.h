@@ -75,6 +75,11 @@ void manifest_init(plugin_manifest_t* manifest);
 // Load a plugin manifest from a JSON file
 bool manifest_load_from_file(const char* path, plugin_manifest_t* manifest);
 
+// Load every plugin a JSON manifest describes, up to max_manifests: the
+// "plugin" object followed by the entries of a "plugins" array, all sharing
+// the file's extensions and parameters. Returns the number loaded.
+int manifest_load_bundle_from_file(const char* path, plugin_manifest_t* manifests, int max_manifests);
+
 // Convert a manifest to a CLAP plugin descriptor
 clap_plugin_descriptor_t* manifest_to_descriptor(const plugin_manifest_t* manifest);
 
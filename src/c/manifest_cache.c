@@ -0,0 +1,154 @@
+#include "manifest_cache.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#ifdef __APPLE__
+    #define CLAPGO_STAT_MTIME_NS(st) ((int64_t)(st).st_mtimespec.tv_sec * 1000000000 + (st).st_mtimespec.tv_nsec)
+#else
+    #define CLAPGO_STAT_MTIME_NS(st) ((int64_t)(st).st_mtim.tv_sec * 1000000000 + (st).st_mtim.tv_nsec)
+#endif
+
+#define FNV64_OFFSET_BASIS 14695981039346656037ull
+#define FNV64_PRIME 1099511628211ull
+
+static uint64_t fnv1a_update(uint64_t hash, const uint8_t* bytes, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= FNV64_PRIME;
+    }
+    return hash;
+}
+
+uint64_t manifest_cache_hash(const void* data, size_t size) {
+    return fnv1a_update(FNV64_OFFSET_BASIS, (const uint8_t*)data, size);
+}
+
+// Range check for a region of count items of size bytes at offset
+static bool cache_region_valid(size_t file_size, uint32_t offset, uint32_t count, uint32_t size) {
+    uint64_t end = (uint64_t)offset + (uint64_t)count * size;
+    return end <= file_size && (offset % 4) == 0;
+}
+
+// Validate the layout so every later read stays inside the mapping
+static bool cache_layout_valid(clapgo_manifest_cache_t* cache) {
+    const clapgo_manifest_cache_header_t* h = (const clapgo_manifest_cache_header_t*)cache->data;
+
+    if (cache->size < sizeof(*h) ||
+        memcmp(h->magic, CLAPGO_MANIFEST_CACHE_MAGIC, sizeof(CLAPGO_MANIFEST_CACHE_MAGIC)) != 0 ||
+        h->version != CLAPGO_MANIFEST_CACHE_VERSION ||
+        h->byte_order != CLAPGO_MANIFEST_CACHE_BYTE_ORDER ||
+        h->header_size != sizeof(*h) ||
+        h->entry_size != sizeof(clapgo_manifest_cache_entry_t)) {
+        return false;
+    }
+
+    if (!cache_region_valid(cache->size, h->entries_offset, h->entry_count, h->entry_size) ||
+        !cache_region_valid(cache->size, h->features_offset, h->feature_count, sizeof(uint32_t)) ||
+        (uint64_t)h->strings_offset + h->strings_size > cache->size ||
+        h->strings_size == 0) {
+        return false;
+    }
+
+    // A terminated table means any in-range offset is a terminated string
+    const char* strings = (const char*)cache->data + h->strings_offset;
+    if (strings[h->strings_size - 1] != '\0') {
+        return false;
+    }
+
+    const clapgo_manifest_cache_entry_t* entries =
+        (const clapgo_manifest_cache_entry_t*)(cache->data + h->entries_offset);
+    const uint32_t* features = (const uint32_t*)(cache->data + h->features_offset);
+
+    for (uint32_t i = 0; i < h->entry_count; i++) {
+        const clapgo_manifest_cache_entry_t* e = &entries[i];
+        const uint32_t fields[] = {
+            e->id, e->name, e->vendor, e->version,
+            e->description, e->url, e->manual_url, e->support_url,
+        };
+        for (size_t f = 0; f < sizeof(fields) / sizeof(fields[0]); f++) {
+            if (fields[f] >= h->strings_size) return false;
+        }
+        if (strings[e->id] == '\0') return false;
+        if ((uint64_t)e->features_index + e->features_count > h->feature_count) return false;
+    }
+    for (uint32_t i = 0; i < h->feature_count; i++) {
+        if (features[i] >= h->strings_size) return false;
+    }
+
+    cache->header = h;
+    cache->entries = entries;
+    cache->features = features;
+    cache->strings = strings;
+    return true;
+}
+
+// The cache is fresh when the JSON has the recorded size and either the
+// recorded mtime or, after a copy that did not preserve it, the same hash
+static bool cache_source_matches(const clapgo_manifest_cache_header_t* h, const char* json_path) {
+    if (!json_path) return true;
+
+    struct stat st;
+    if (stat(json_path, &st) != 0) {
+        // Bundles may ship the cache alone
+        return true;
+    }
+    if ((uint64_t)st.st_size != h->source_size) return false;
+    if (h->source_mtime_ns != 0 && CLAPGO_STAT_MTIME_NS(st) == h->source_mtime_ns) return true;
+
+    FILE* file = fopen(json_path, "rb");
+    if (!file) return false;
+
+    uint8_t buffer[4096];
+    uint64_t hash = FNV64_OFFSET_BASIS;
+    size_t n;
+    while ((n = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        hash = fnv1a_update(hash, buffer, n);
+    }
+    bool read_ok = !ferror(file);
+    fclose(file);
+    return read_ok && hash == h->source_hash;
+}
+
+bool manifest_cache_open(const char* cache_path, const char* json_path, clapgo_manifest_cache_t* cache) {
+    memset(cache, 0, sizeof(*cache));
+
+    int fd = open(cache_path, O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        close(fd);
+        return false;
+    }
+
+    void* data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) return false;
+
+    cache->data = (const uint8_t*)data;
+    cache->size = (size_t)st.st_size;
+
+    if (!cache_layout_valid(cache)) {
+        fprintf(stderr, "Warning: Ignoring malformed manifest cache %s\n", cache_path);
+        manifest_cache_close(cache);
+        return false;
+    }
+    if (!cache_source_matches(cache->header, json_path)) {
+        // Stale after an edit to the JSON; the caller falls back to it
+        manifest_cache_close(cache);
+        return false;
+    }
+    return true;
+}
+
+void manifest_cache_close(clapgo_manifest_cache_t* cache) {
+    if (cache->data) {
+        munmap((void*)cache->data, cache->size);
+    }
+    memset(cache, 0, sizeof(*cache));
+}
@@ -0,0 +1,90 @@
+#ifndef CLAPGO_MANIFEST_CACHE_H
+#define CLAPGO_MANIFEST_CACHE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Precompiled manifest cache, written next to the JSON manifest by
+// generate-manifest so a host scan can map the plugin descriptors with a
+// single mmap instead of parsing JSON. The JSON stays authoritative: the
+// cache records the size, mtime and FNV-1a hash of the JSON it was compiled
+// from and is ignored once they no longer match. A bundle may ship the
+// cache without its JSON.
+//
+// Layout, little-endian: a clapgo_manifest_cache_header_t, entry_count
+// clapgo_manifest_cache_entry_t records, feature_count uint32_t string
+// offsets and finally the NUL-terminated string table. The Go writer lives
+// in pkg/manifest/cache.go; keep the two in step.
+
+#define CLAPGO_MANIFEST_CACHE_MAGIC "CLGOMFC"
+#define CLAPGO_MANIFEST_CACHE_VERSION 1
+#define CLAPGO_MANIFEST_CACHE_BYTE_ORDER 0x01020304u
+#define CLAPGO_MANIFEST_CACHE_EXT ".manifest.bin"
+
+typedef struct clapgo_manifest_cache_header {
+    char magic[8];              // CLAPGO_MANIFEST_CACHE_MAGIC, NUL padded
+    uint32_t version;           // CLAPGO_MANIFEST_CACHE_VERSION
+    uint32_t byte_order;        // CLAPGO_MANIFEST_CACHE_BYTE_ORDER as written
+    uint32_t header_size;       // sizeof(clapgo_manifest_cache_header_t)
+    uint32_t entry_size;        // sizeof(clapgo_manifest_cache_entry_t)
+    uint32_t entry_count;
+    uint32_t entries_offset;
+    uint32_t feature_count;
+    uint32_t features_offset;
+    uint32_t strings_offset;
+    uint32_t strings_size;
+    uint64_t source_size;       // size of the JSON compiled from
+    int64_t source_mtime_ns;    // its modification time, 0 when unknown
+    uint64_t source_hash;       // FNV-1a 64 of its contents
+} clapgo_manifest_cache_header_t;
+
+// One plugin; every string field is an offset into the string table
+typedef struct clapgo_manifest_cache_entry {
+    uint32_t id;
+    uint32_t name;
+    uint32_t vendor;
+    uint32_t version;
+    uint32_t description;
+    uint32_t url;
+    uint32_t manual_url;
+    uint32_t support_url;
+    uint32_t features_index;    // first feature in the features array
+    uint32_t features_count;
+} clapgo_manifest_cache_entry_t;
+
+_Static_assert(sizeof(clapgo_manifest_cache_header_t) == 72, "manifest cache header layout changed");
+_Static_assert(sizeof(clapgo_manifest_cache_entry_t) == 40, "manifest cache entry layout changed");
+
+// A mapped and validated cache
+typedef struct clapgo_manifest_cache {
+    const uint8_t* data;
+    size_t size;
+    const clapgo_manifest_cache_header_t* header;
+    const clapgo_manifest_cache_entry_t* entries;
+    const uint32_t* features;
+    const char* strings;
+} clapgo_manifest_cache_t;
+
+// Map the cache at cache_path and validate it against the JSON manifest at
+// json_path. Returns false, leaving cache closed, when the cache is missing,
+// malformed or stale. A NULL or missing json_path skips the staleness check.
+bool manifest_cache_open(const char* cache_path, const char* json_path, clapgo_manifest_cache_t* cache);
+
+// Unmap the cache; descriptors built from it must be freed first
+void manifest_cache_close(clapgo_manifest_cache_t* cache);
+
+// Number of plugins in an open cache
+static inline uint32_t manifest_cache_count(const clapgo_manifest_cache_t* cache) {
+    return cache->header ? cache->header->entry_count : 0;
+}
+
+// String at offset in the cache's string table
+static inline const char* manifest_cache_string(const clapgo_manifest_cache_t* cache, uint32_t offset) {
+    return cache->strings + offset;
+}
+
+// FNV-1a 64 hash, as recorded in source_hash
+uint64_t manifest_cache_hash(const void* data, size_t size);
+
+#endif // CLAPGO_MANIFEST_CACHE_H
@@ -39,7 +39,7 @@ const CLAP_EXPORT clap_plugin_entry_t clap_entry = {
 static uint32_t clapgo_factory_get_plugin_count(const clap_plugin_factory_t *factory) {
     uint32_t count = clapgo_get_plugin_count();
     
-    FILE* log = fopen("/tmp/clapgo_factory_calls.log", "a");
+    FILE* log = CLAPGO_DEBUG_FILE("/tmp/clapgo_factory_calls.log");
     if (log) {
         fprintf(log, "[%ld] clapgo_factory_get_plugin_count() called, returning %u\n", time(NULL), count);
         fflush(log);
@@ -53,7 +53,7 @@ static const clap_plugin_descriptor_t *clapgo_factory_get_plugin_descriptor(
     const clap_plugin_factory_t *factory, uint32_t index) {
     const clap_plugin_descriptor_t *desc = clapgo_get_plugin_descriptor(index);
     
-    FILE* log = fopen("/tmp/clapgo_factory_calls.log", "a");
+    FILE* log = CLAPGO_DEBUG_FILE("/tmp/clapgo_factory_calls.log");
     if (log) {
         fprintf(log, "[%ld] clapgo_factory_get_plugin_descriptor() called with index %u\n", time(NULL), index);
         if (desc) {
@@ -70,7 +70,7 @@ static const clap_plugin_descriptor_t *clapgo_factory_get_plugin_descriptor(
 
 static const clap_plugin_t *clapgo_factory_create_plugin(
     const clap_plugin_factory_t *factory, const clap_host_t *host, const char *plugin_id) {
-    FILE* log = fopen("/tmp/clapgo_factory_calls.log", "a");
+    FILE* log = CLAPGO_DEBUG_FILE("/tmp/clapgo_factory_calls.log");
     if (log) {
         fprintf(log, "[%ld] clapgo_factory_create_plugin() called\n", time(NULL));
         fprintf(log, "  plugin_id: %s\n", plugin_id ? plugin_id : "NULL");
@@ -81,7 +81,7 @@ static const clap_plugin_t *clapgo_factory_create_plugin(
     
     const clap_plugin_t *plugin = clapgo_create_plugin(host, plugin_id);
     
-    log = fopen("/tmp/clapgo_factory_calls.log", "a");
+    log = CLAPGO_DEBUG_FILE("/tmp/clapgo_factory_calls.log");
     if (log) {
         fprintf(log, "  plugin created: %p\n", plugin);
         fflush(log);
@@ -93,9 +93,9 @@ static const clap_plugin_t *clapgo_factory_create_plugin(
 
 // Plugin entry point implementation
 static bool clapgo_entry_init(const char *plugin_path) {
-    printf("[ClapGo] Entry init called with path: %s\n", plugin_path ? plugin_path : "NULL");
+    CLAPGO_DEBUG("[ClapGo] Entry init called with path: %s\n", plugin_path ? plugin_path : "NULL");
     
-    FILE* log = fopen("/tmp/clapgo_factory_calls.log", "a");
+    FILE* log = CLAPGO_DEBUG_FILE("/tmp/clapgo_factory_calls.log");
     if (log) {
         fprintf(log, "[%ld] clapgo_entry_init() called with path: %s\n", 
                 time(NULL), plugin_path ? plugin_path : "NULL");
@@ -107,9 +107,9 @@ static bool clapgo_entry_init(const char *plugin_path) {
 }
 
 static void clapgo_entry_deinit(void) {
-    printf("[ClapGo] Entry deinit called\n");
+    CLAPGO_DEBUG("[ClapGo] Entry deinit called\n");
     
-    FILE* log = fopen("/tmp/clapgo_factory_calls.log", "a");
+    FILE* log = CLAPGO_DEBUG_FILE("/tmp/clapgo_factory_calls.log");
     if (log) {
         fprintf(log, "[%ld] clapgo_entry_deinit() called\n", time(NULL));
         fflush(log);
@@ -121,14 +121,14 @@ static void clapgo_entry_deinit(void) {
 
 static const void *clapgo_entry_get_factory(const char *factory_id) {
     // Also log to file for debugging
-    FILE* log = fopen("/tmp/clapgo_factory_calls.log", "a");
+    FILE* log = CLAPGO_DEBUG_FILE("/tmp/clapgo_factory_calls.log");
     if (log) {
         fprintf(log, "[%ld] clapgo_entry_get_factory() called with factory_id: %s\n", 
                 time(NULL), factory_id ? factory_id : "NULL");
         fflush(log);
     }
     
-    printf("[PRESET_DEBUG] clapgo_entry_get_factory() called with factory_id: %s\n", factory_id ? factory_id : "NULL");
+    CLAPGO_DEBUG("[PRESET_DEBUG] clapgo_entry_get_factory() called with factory_id: %s\n", factory_id ? factory_id : "NULL");
     
     if (!factory_id) {
         if (log) {
@@ -139,7 +139,7 @@ static const void *clapgo_entry_get_factory(const char *factory_id) {
     }
     
     if (strcmp(factory_id, CLAP_PLUGIN_FACTORY_ID) == 0) {
-        printf("[PRESET_DEBUG] Returning plugin factory\n");
+        CLAPGO_DEBUG("[PRESET_DEBUG] Returning plugin factory\n");
         if (log) {
             fprintf(log, "  Returning plugin factory\n");
             fclose(log);
@@ -149,7 +149,7 @@ static const void *clapgo_entry_get_factory(const char *factory_id) {
     
     if (strcmp(factory_id, CLAP_PRESET_DISCOVERY_FACTORY_ID) == 0 ||
         strcmp(factory_id, CLAP_PRESET_DISCOVERY_FACTORY_ID_COMPAT) == 0) {
-        printf("[PRESET_DEBUG] Returning preset discovery factory\n");
+        CLAPGO_DEBUG("[PRESET_DEBUG] Returning preset discovery factory\n");
         if (log) {
             fprintf(log, "  Returning preset discovery factory for ID: %s\n", factory_id);
             fprintf(log, "  Factory address: %p\n", preset_discovery_get_factory());
@@ -159,7 +159,7 @@ static const void *clapgo_entry_get_factory(const char *factory_id) {
     }
     
     if (strcmp(factory_id, CLAP_PLUGIN_INVALIDATION_FACTORY_ID) == 0) {
-        printf("[INVALIDATION_DEBUG] Returning plugin invalidation factory\n");
+        CLAPGO_DEBUG("[INVALIDATION_DEBUG] Returning plugin invalidation factory\n");
         if (log) {
             fprintf(log, "  Returning plugin invalidation factory\n");
             fprintf(log, "  Factory address: %p\n", plugin_invalidation_get_factory());
@@ -169,7 +169,7 @@ static const void *clapgo_entry_get_factory(const char *factory_id) {
     }
     
     if (strcmp(factory_id, CLAP_PLUGIN_STATE_CONVERTER_FACTORY_ID) == 0) {
-        printf("[STATE_CONVERTER_DEBUG] Returning plugin state converter factory\n");
+        CLAPGO_DEBUG("[STATE_CONVERTER_DEBUG] Returning plugin state converter factory\n");
         if (log) {
             fprintf(log, "  Returning plugin state converter factory\n");
             fprintf(log, "  Factory address: %p\n", state_converter_get_factory());
@@ -178,7 +178,7 @@ static const void *clapgo_entry_get_factory(const char *factory_id) {
         return state_converter_get_factory();
     }
     
-    printf("[PRESET_DEBUG] Unknown factory_id '%s', returning NULL\n", factory_id);
+    CLAPGO_DEBUG("[PRESET_DEBUG] Unknown factory_id '%s', returning NULL\n", factory_id);
     if (log) {
         fprintf(log, "  Unknown factory_id '%s', returning NULL\n", factory_id);
         fprintf(log, "  Supported factories:\n");
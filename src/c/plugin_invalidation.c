@@ -1,5 +1,6 @@
 #include "plugin_invalidation.h"
 #include "bridge.h"
+#include "preset_index.h"
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
@@ -18,6 +19,35 @@ static char source_globs[MAX_INVALIDATION_SOURCES][64];
 static uint32_t invalidation_source_count = 0;
 static bool sources_initialized = false;
 
+// External manifest data from bridge.c
+extern manifest_plugin_entry_t manifest_plugins[MAX_PLUGIN_MANIFESTS];
+extern int manifest_plugin_count;
+
+// Add a watched location unless it is already listed
+static void add_invalidation_source(const char* directory, const char* glob, bool recursive) {
+    for (uint32_t i = 0; i < invalidation_source_count; i++) {
+        if (strcmp(source_directories[i], directory) == 0 && strcmp(source_globs[i], glob) == 0) {
+            return;
+        }
+    }
+    if (invalidation_source_count >= MAX_INVALIDATION_SOURCES) {
+        return;
+    }
+    
+    snprintf(source_directories[invalidation_source_count], 
+            sizeof(source_directories[invalidation_source_count]),
+            "%s", directory);
+    snprintf(source_globs[invalidation_source_count],
+            sizeof(source_globs[invalidation_source_count]),
+            "%s", glob);
+    
+    invalidation_sources[invalidation_source_count].directory = source_directories[invalidation_source_count];
+    invalidation_sources[invalidation_source_count].filename_glob = source_globs[invalidation_source_count];
+    invalidation_sources[invalidation_source_count].recursive_scan = recursive;
+    
+    invalidation_source_count++;
+}
+
 // Initialize invalidation sources based on plugin locations
 static void initialize_invalidation_sources() {
     if (sources_initialized) {
@@ -26,21 +56,25 @@ static void initialize_invalidation_sources() {
     
     invalidation_source_count = 0;
     
-    // Add ~/.clap directory for user plugins
     const char* home = getenv("HOME");
     if (home) {
-        snprintf(source_directories[invalidation_source_count], 
-                sizeof(source_directories[invalidation_source_count]),
-                "%s/.clap", home);
-        snprintf(source_globs[invalidation_source_count],
-                sizeof(source_globs[invalidation_source_count]),
-                "*.json");
-        
-        invalidation_sources[invalidation_source_count].directory = source_directories[invalidation_source_count];
-        invalidation_sources[invalidation_source_count].filename_glob = source_globs[invalidation_source_count];
-        invalidation_sources[invalidation_source_count].recursive_scan = true;
-        
-        invalidation_source_count++;
+        // Each plugin's manifest directory, its preset files and the
+        // index of them. The index is only rewritten by a crawl, so the
+        // presets themselves are what tells the host a crawl is due.
+        for (int i = 0; i < manifest_plugin_count; i++) {
+            const char* plugin_id = manifest_plugins[i].manifest.plugin.id;
+            const char* simple_name = strrchr(plugin_id, '.');
+            simple_name = simple_name ? simple_name + 1 : plugin_id;
+            if (!*simple_name) continue;
+            
+            char path[512];
+            snprintf(path, sizeof(path), "%s/.clap/%s", home, simple_name);
+            add_invalidation_source(path, "*.json", false);
+            
+            snprintf(path, sizeof(path), "%s/.clap/%s/presets", home, simple_name);
+            add_invalidation_source(path, "*.json", true);
+            add_invalidation_source(path, PRESET_INDEX_FILENAME, false);
+        }
     }
     
     // Add plugin development directory if it exists
@@ -49,18 +83,7 @@ static void initialize_invalidation_sources() {
         snprintf(dev_path, sizeof(dev_path), "%s/Documents/code/clapgo/examples", home);
         struct stat st;
         if (stat(dev_path, &st) == 0 && S_ISDIR(st.st_mode)) {
-            snprintf(source_directories[invalidation_source_count], 
-                    sizeof(source_directories[invalidation_source_count]),
-                    "%s", dev_path);
-            snprintf(source_globs[invalidation_source_count],
-                    sizeof(source_globs[invalidation_source_count]),
-                    "*.json");
-            
-            invalidation_sources[invalidation_source_count].directory = source_directories[invalidation_source_count];
-            invalidation_sources[invalidation_source_count].filename_glob = source_globs[invalidation_source_count];
-            invalidation_sources[invalidation_source_count].recursive_scan = true;
-            
-            invalidation_source_count++;
+            add_invalidation_source(dev_path, "*.json", true);
         }
     }
     
@@ -10,7 +10,10 @@
 #include <signal.h>
 #include <unistd.h>
 
-// Debug logging to file
+// Debug logging to file, compiled out unless CLAPGO_DEBUG_LOG is defined
+// like the bridge's. Release builds neither open the log nor install the
+// crash handlers, which would replace the host's own.
+#ifdef CLAPGO_DEBUG_LOG
 static FILE* debug_log = NULL;
 static bool signal_handlers_installed = false;
 
@@ -59,6 +62,9 @@ static void debug_init() {
     printf(__VA_ARGS__); \
     printf("\n"); \
 } while(0)
+#else
+#define DEBUG_LOG(...) ((void)0)
+#endif
 
 // Forward declarations
 static bool provider_init(const clap_preset_discovery_provider_t* provider);
@@ -180,6 +186,11 @@ static bool provider_init(const clap_preset_discovery_provider_t* provider) {
         return false;
     }
     
+    // Load the index before the host starts asking for metadata
+    if (!data->index) {
+        data->index = preset_index_open(preset_path);
+    }
+    
     clap_preset_discovery_location_t location = {
         .flags = CLAP_PRESET_DISCOVERY_IS_FACTORY_CONTENT,  // Changed from USER_CONTENT
         .name = "Factory Presets",
@@ -203,6 +214,14 @@ static void provider_destroy(const clap_preset_discovery_provider_t* provider) {
     DEBUG_LOG("provider_destroy() called: provider=%p", provider);
     if (provider) {
         if (provider->provider_data) {
+            provider_data_t* data = (provider_data_t*)provider->provider_data;
+            if (data->index) {
+                // The crawl is over; keep what was parsed for the next one
+                if (!preset_index_save(data->index)) {
+                    DEBUG_LOG("Could not write preset index");
+                }
+                preset_index_close(data->index);
+            }
             DEBUG_LOG("Freeing provider data");
             free((void*)provider->provider_data);
         }
@@ -211,100 +230,44 @@ static void provider_destroy(const clap_preset_discovery_provider_t* provider) {
     }
 }
 
-static bool provider_get_metadata(
-    const clap_preset_discovery_provider_t* provider,
-    uint32_t location_kind,
-    const char* location,
-    const clap_preset_discovery_metadata_receiver_t* receiver) {
-    
-    DEBUG_LOG("provider_get_metadata() called with location: %s", location ? location : "NULL");
-    
-    if (!provider || !provider->provider_data || !location || !receiver) {
-        DEBUG_LOG("provider_get_metadata() NULL parameter: provider=%p, provider_data=%p, location=%p, receiver=%p",
-                 provider, provider ? provider->provider_data : NULL, location, receiver);
-        return false;
-    }
-    
-    provider_data_t* data = (provider_data_t*)provider->provider_data;
-    DEBUG_LOG("Processing preset file for plugin: %s", data->plugin_id);
-    
-    // Check if file exists and is readable
-    FILE* test_file = fopen(location, "r");
-    if (!test_file) {
-        DEBUG_LOG("Cannot open preset file: %s", location);
-        return false;
-    }
-    fclose(test_file);
-    
-    // Parse JSON file
-    struct json_object* root = json_object_from_file(location);
-    if (!root) {
-        DEBUG_LOG("Failed to parse JSON file: %s", location);
-        return false;
-    }
-    
-    DEBUG_LOG("Successfully parsed JSON file: %s", location);
+// Collect the metadata of a parsed preset; strings borrow from root.
+// Returns false when the preset has no name.
+static bool preset_parse_metadata(struct json_object* root, preset_metadata_t* metadata) {
+    memset(metadata, 0, sizeof(*metadata));
     
     // Extract name (required)
-    struct json_object* name_obj;
-    if (!json_object_object_get_ex(root, "name", &name_obj)) {
+    struct json_object* obj;
+    if (!json_object_object_get_ex(root, "name", &obj)) {
         DEBUG_LOG("No 'name' field found in JSON");
-        json_object_put(root);
         return false;
     }
+    metadata->name = json_object_get_string(obj);
     
-    const char* preset_name = json_object_get_string(name_obj);
-    DEBUG_LOG("Found preset name: %s", preset_name);
-    
-    DEBUG_LOG("Calling receiver->begin_preset() with name: %s", preset_name);
-    if (!receiver->begin_preset(receiver, preset_name, NULL)) {
-        DEBUG_LOG("receiver->begin_preset() failed");
-        json_object_put(root);
-        return false;
-    }
-    DEBUG_LOG("receiver->begin_preset() succeeded");
-    
-    // Add plugin ID (from manifest or JSON)
-    struct json_object* plugin_ids_obj;
-    if (json_object_object_get_ex(root, "plugin_ids", &plugin_ids_obj) && 
-        json_object_is_type(plugin_ids_obj, json_type_array)) {
-        // Use plugin IDs from preset
-        int count = json_object_array_length(plugin_ids_obj);
-        for (int i = 0; i < count; i++) {
-            struct json_object* id_obj = json_object_array_get_idx(plugin_ids_obj, i);
+    // Plugin IDs; the manifest plugin ID is used when there are none
+    if (json_object_object_get_ex(root, "plugin_ids", &obj) && 
+        json_object_is_type(obj, json_type_array)) {
+        int count = json_object_array_length(obj);
+        for (int i = 0; i < count && metadata->plugin_id_count < PRESET_INDEX_MAX_LIST; i++) {
+            struct json_object* id_obj = json_object_array_get_idx(obj, i);
             if (id_obj) {
-                clap_universal_plugin_id_t plugin_id = {
-                    .abi = "clap",
-                    .id = json_object_get_string(id_obj)
-                };
-                receiver->add_plugin_id(receiver, &plugin_id);
+                metadata->plugin_ids[metadata->plugin_id_count++] = json_object_get_string(id_obj);
             }
         }
-    } else {
-        // Fallback to manifest plugin ID
-        clap_universal_plugin_id_t plugin_id = {
-            .abi = "clap",
-            .id = data->plugin_id
-        };
-        receiver->add_plugin_id(receiver, &plugin_id);
     }
     
-    // Extract ALL other metadata from JSON (no hardcoding)
-    struct json_object* obj;
-    
     // Description
     if (json_object_object_get_ex(root, "description", &obj)) {
-        receiver->set_description(receiver, json_object_get_string(obj));
+        metadata->description = json_object_get_string(obj);
     }
     
     // Creators
     if (json_object_object_get_ex(root, "creators", &obj) && 
         json_object_is_type(obj, json_type_array)) {
         int count = json_object_array_length(obj);
-        for (int i = 0; i < count; i++) {
+        for (int i = 0; i < count && metadata->creator_count < PRESET_INDEX_MAX_LIST; i++) {
             struct json_object* creator = json_object_array_get_idx(obj, i);
             if (creator) {
-                receiver->add_creator(receiver, json_object_get_string(creator));
+                metadata->creators[metadata->creator_count++] = json_object_get_string(creator);
             }
         }
     }
@@ -313,37 +276,141 @@ static bool provider_get_metadata(
     if (json_object_object_get_ex(root, "features", &obj) && 
         json_object_is_type(obj, json_type_array)) {
         int count = json_object_array_length(obj);
-        for (int i = 0; i < count; i++) {
+        for (int i = 0; i < count && metadata->feature_count < PRESET_INDEX_MAX_LIST; i++) {
             struct json_object* feature = json_object_array_get_idx(obj, i);
             if (feature) {
-                receiver->add_feature(receiver, json_object_get_string(feature));
+                metadata->features[metadata->feature_count++] = json_object_get_string(feature);
             }
         }
     }
     
     // Flags
-    uint32_t flags = CLAP_PRESET_DISCOVERY_IS_USER_CONTENT;
+    metadata->flags = CLAP_PRESET_DISCOVERY_IS_USER_CONTENT;
     if (json_object_object_get_ex(root, "is_favorite", &obj)) {
         if (json_object_get_boolean(obj)) {
-            flags |= CLAP_PRESET_DISCOVERY_IS_FAVORITE;
+            metadata->flags |= CLAP_PRESET_DISCOVERY_IS_FAVORITE;
         }
     }
-    receiver->set_flags(receiver, flags);
     
-    // Set soundpack ID only if present in JSON
+    // Soundpack ID only if present in JSON
     if (json_object_object_get_ex(root, "soundpack_id", &obj)) {
         const char* soundpack_id = json_object_get_string(obj);
-        if (soundpack_id && *soundpack_id && receiver->set_soundpack_id) {
-            receiver->set_soundpack_id(receiver, soundpack_id);
+        if (soundpack_id && *soundpack_id) {
+            metadata->soundpack_id = soundpack_id;
         }
     }
     
-    DEBUG_LOG("provider_get_metadata() completed successfully for preset: %s", preset_name);
+    return true;
+}
+
+// Report one preset's metadata to the host
+static bool preset_emit_metadata(
+    const provider_data_t* data,
+    const preset_metadata_t* metadata,
+    const clap_preset_discovery_metadata_receiver_t* receiver) {
+    
+    DEBUG_LOG("Calling receiver->begin_preset() with name: %s", metadata->name);
+    if (!receiver->begin_preset(receiver, metadata->name, NULL)) {
+        DEBUG_LOG("receiver->begin_preset() failed");
+        return false;
+    }
+    
+    if (metadata->plugin_id_count > 0) {
+        for (uint32_t i = 0; i < metadata->plugin_id_count; i++) {
+            clap_universal_plugin_id_t plugin_id = {
+                .abi = "clap",
+                .id = metadata->plugin_ids[i]
+            };
+            receiver->add_plugin_id(receiver, &plugin_id);
+        }
+    } else {
+        // Fallback to manifest plugin ID
+        clap_universal_plugin_id_t plugin_id = {
+            .abi = "clap",
+            .id = data->plugin_id
+        };
+        receiver->add_plugin_id(receiver, &plugin_id);
+    }
     
-    json_object_put(root);
+    if (metadata->description) {
+        receiver->set_description(receiver, metadata->description);
+    }
+    for (uint32_t i = 0; i < metadata->creator_count; i++) {
+        receiver->add_creator(receiver, metadata->creators[i]);
+    }
+    for (uint32_t i = 0; i < metadata->feature_count; i++) {
+        receiver->add_feature(receiver, metadata->features[i]);
+    }
+    receiver->set_flags(receiver, metadata->flags);
+    if (metadata->soundpack_id && receiver->set_soundpack_id) {
+        receiver->set_soundpack_id(receiver, metadata->soundpack_id);
+    }
     return true;
 }
 
+static bool provider_get_metadata(
+    const clap_preset_discovery_provider_t* provider,
+    uint32_t location_kind,
+    const char* location,
+    const clap_preset_discovery_metadata_receiver_t* receiver) {
+    
+    DEBUG_LOG("provider_get_metadata() called with location: %s", location ? location : "NULL");
+    
+    if (!provider || !provider->provider_data || !location || !receiver) {
+        DEBUG_LOG("provider_get_metadata() NULL parameter: provider=%p, provider_data=%p, location=%p, receiver=%p",
+                 provider, provider ? provider->provider_data : NULL, location, receiver);
+        return false;
+    }
+    
+    provider_data_t* data = (provider_data_t*)provider->provider_data;
+    DEBUG_LOG("Processing preset file for plugin: %s", data->plugin_id);
+    
+    struct stat st;
+    if (stat(location, &st) != 0 || !S_ISREG(st.st_mode)) {
+        DEBUG_LOG("Cannot stat preset file: %s", location);
+        return false;
+    }
+    
+    // Unchanged presets are answered from the index without touching the file
+    preset_metadata_t metadata;
+    preset_index_result_t cached = data->index
+        ? preset_index_lookup(data->index, location, &st, &metadata)
+        : PRESET_INDEX_MISS;
+    if (cached == PRESET_INDEX_INVALID) {
+        DEBUG_LOG("Index marks preset file as invalid: %s", location);
+        return false;
+    }
+    
+    struct json_object* root = NULL;
+    if (cached == PRESET_INDEX_MISS) {
+        // Check if file exists and is readable
+        FILE* test_file = fopen(location, "r");
+        if (!test_file) {
+            DEBUG_LOG("Cannot open preset file: %s", location);
+            return false;
+        }
+        fclose(test_file);
+        
+        root = json_object_from_file(location);
+        bool parsed = root && preset_parse_metadata(root, &metadata);
+        if (data->index) {
+            preset_index_store(data->index, location, &st, parsed ? &metadata : NULL);
+        }
+        if (!parsed) {
+            DEBUG_LOG("Failed to parse preset file: %s", location);
+            if (root) json_object_put(root);
+            return false;
+        }
+        DEBUG_LOG("Successfully parsed JSON file: %s", location);
+    }
+    
+    bool result = preset_emit_metadata(data, &metadata, receiver);
+    DEBUG_LOG("provider_get_metadata() %s for preset: %s", result ? "completed" : "failed", metadata.name);
+    
+    if (root) json_object_put(root);
+    return result;
+}
+
 static const void* provider_get_extension(
     const clap_preset_discovery_provider_t* provider,
     const char* extension_id) {
@@ -3,6 +3,7 @@
 
 #include <clap/clap.h>
 #include <clap/factory/preset-discovery.h>
+#include "preset_index.h"
 
 // Provider data structure for storing plugin information
 typedef struct {
@@ -10,6 +11,7 @@ typedef struct {
     char plugin_name[256];      // From manifest
     char vendor[256];           // From manifest
     const clap_preset_discovery_indexer_t* indexer;
+    preset_index_t* index;      // Index of the declared location, NULL before init
 } provider_data_t;
 
 // Get the preset discovery factory
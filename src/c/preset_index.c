@@ -0,0 +1,411 @@
+#include "preset_index.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#ifdef __APPLE__
+    #define PRESET_STAT_MTIME_NS(st) ((int64_t)(st)->st_mtimespec.tv_sec * 1000000000 + (st)->st_mtimespec.tv_nsec)
+#else
+    #define PRESET_STAT_MTIME_NS(st) ((int64_t)(st)->st_mtim.tv_sec * 1000000000 + (st)->st_mtim.tv_nsec)
+#endif
+
+// File layout, native byte order since the index never leaves the machine:
+// an 8 byte magic, uint32 version, uint32 byte order marker, uint32 entry
+// count, then per entry uint32 key size, int64 mtime_ns, uint64 size, uint32
+// flags, three uint16 list counts, uint32 data size, the key and the data.
+// The data is every string NUL-terminated in a fixed order: name,
+// description, soundpack_id, then the plugin_ids, creators and features.
+#define PRESET_INDEX_MAGIC "CLGOPIX"
+#define PRESET_INDEX_VERSION 1
+#define PRESET_INDEX_BYTE_ORDER 0x01020304u
+#define PRESET_INDEX_HEADER_SIZE 20
+#define PRESET_INDEX_RECORD_SIZE 34
+
+// Flag stored for a file that holds no usable preset; outside the range of
+// the CLAP_PRESET_DISCOVERY_* flags
+#define PRESET_INDEX_FLAG_INVALID 0x80000000u
+
+#define FNV64_OFFSET_BASIS 14695981039346656037ull
+#define FNV64_PRIME 1099511628211ull
+
+#define SLOT_EMPTY UINT32_MAX
+
+typedef struct preset_index_entry {
+    char* key;              // path relative to the directory; data follows it
+    char* data;
+    uint32_t data_size;
+    uint64_t hash;
+    int64_t mtime_ns;
+    uint64_t size;
+    uint32_t flags;
+    uint16_t counts[3];     // plugin_ids, creators, features
+    bool seen;              // looked up or stored during this crawl
+    bool gone;              // file missing when the index was saved
+} preset_index_entry_t;
+
+struct preset_index {
+    char directory[512];
+    char file_path[1024];
+
+    preset_index_entry_t* entries;
+    uint32_t count;
+    uint32_t capacity;
+
+    // Open addressing table of indices into entries
+    uint32_t* slots;
+    uint32_t slot_count;    // power of two, at least twice count
+
+    bool dirty;
+};
+
+static uint64_t key_hash(const char* key) {
+    uint64_t hash = FNV64_OFFSET_BASIS;
+    for (const unsigned char* p = (const unsigned char*)key; *p; p++) {
+        hash ^= *p;
+        hash *= FNV64_PRIME;
+    }
+    return hash;
+}
+
+// Presets inside the directory are keyed relative to it, so the index
+// survives the library being moved
+static const char* index_key(const preset_index_t* index, const char* path) {
+    size_t len = strlen(index->directory);
+    if (strncmp(path, index->directory, len) == 0 && path[len] == '/') {
+        return path + len + 1;
+    }
+    return path;
+}
+
+static bool index_rehash(preset_index_t* index, uint32_t slot_count) {
+    uint32_t* slots = malloc(sizeof(uint32_t) * slot_count);
+    if (!slots) return false;
+    memset(slots, 0xff, sizeof(uint32_t) * slot_count);
+
+    for (uint32_t i = 0; i < index->count; i++) {
+        uint32_t slot = (uint32_t)index->entries[i].hash & (slot_count - 1);
+        while (slots[slot] != SLOT_EMPTY) {
+            slot = (slot + 1) & (slot_count - 1);
+        }
+        slots[slot] = i;
+    }
+
+    free(index->slots);
+    index->slots = slots;
+    index->slot_count = slot_count;
+    return true;
+}
+
+static preset_index_entry_t* index_find(const preset_index_t* index, const char* key, uint64_t hash) {
+    if (index->slot_count == 0) return NULL;
+
+    uint32_t slot = (uint32_t)hash & (index->slot_count - 1);
+    while (index->slots[slot] != SLOT_EMPTY) {
+        preset_index_entry_t* entry = &index->entries[index->slots[slot]];
+        if (entry->hash == hash && strcmp(entry->key, key) == 0) {
+            return entry;
+        }
+        slot = (slot + 1) & (index->slot_count - 1);
+    }
+    return NULL;
+}
+
+// Append an entry that is not yet in the table, taking ownership of key
+static preset_index_entry_t* index_append(preset_index_t* index, const preset_index_entry_t* entry) {
+    if (index->count == index->capacity) {
+        uint32_t capacity = index->capacity ? index->capacity * 2 : 64;
+        preset_index_entry_t* entries = realloc(index->entries, sizeof(*entries) * capacity);
+        if (!entries) return NULL;
+        index->entries = entries;
+        index->capacity = capacity;
+    }
+    if ((index->count + 1) * 2 > index->slot_count) {
+        uint32_t slot_count = index->slot_count ? index->slot_count * 2 : 128;
+        if (!index_rehash(index, slot_count)) return NULL;
+    }
+
+    uint32_t i = index->count++;
+    index->entries[i] = *entry;
+
+    uint32_t slot = (uint32_t)entry->hash & (index->slot_count - 1);
+    while (index->slots[slot] != SLOT_EMPTY) {
+        slot = (slot + 1) & (index->slot_count - 1);
+    }
+    index->slots[slot] = i;
+    return &index->entries[i];
+}
+
+// Check that data holds the number of strings the counts promise
+static bool entry_data_valid(const preset_index_entry_t* entry) {
+    for (int i = 0; i < 3; i++) {
+        if (entry->counts[i] > PRESET_INDEX_MAX_LIST) return false;
+    }
+    uint32_t expected = 3u + entry->counts[0] + entry->counts[1] + entry->counts[2];
+    uint32_t found = 0;
+    for (uint32_t i = 0; i < entry->data_size; i++) {
+        if (entry->data[i] == '\0') found++;
+    }
+    return found == expected && (entry->data_size == 0 || entry->data[entry->data_size - 1] == '\0');
+}
+
+// Parse the whole index file, read with a single fread. Loading stops at
+// the first record that fails a check; the crawl re-parses whatever was lost.
+static void index_load(preset_index_t* index) {
+    FILE* file = fopen(index->file_path, "rb");
+    if (!file) return;
+
+    uint8_t* buffer = NULL;
+    long file_size = 0;
+    if (fseek(file, 0, SEEK_END) == 0 && (file_size = ftell(file)) >= PRESET_INDEX_HEADER_SIZE &&
+        fseek(file, 0, SEEK_SET) == 0) {
+        buffer = malloc((size_t)file_size);
+        if (buffer && fread(buffer, 1, (size_t)file_size, file) != (size_t)file_size) {
+            free(buffer);
+            buffer = NULL;
+        }
+    }
+    fclose(file);
+    if (!buffer) return;
+
+    size_t size = (size_t)file_size;
+    uint32_t version, byte_order, count;
+    memcpy(&version, buffer + 8, 4);
+    memcpy(&byte_order, buffer + 12, 4);
+    memcpy(&count, buffer + 16, 4);
+
+    if (memcmp(buffer, PRESET_INDEX_MAGIC, sizeof(PRESET_INDEX_MAGIC)) != 0 ||
+        version != PRESET_INDEX_VERSION || byte_order != PRESET_INDEX_BYTE_ORDER) {
+        free(buffer);
+        return;
+    }
+
+    size_t offset = PRESET_INDEX_HEADER_SIZE;
+    for (uint32_t i = 0; i < count; i++) {
+        if (size - offset < PRESET_INDEX_RECORD_SIZE) break;
+
+        const uint8_t* record = buffer + offset;
+        preset_index_entry_t entry = {0};
+        uint32_t key_size;
+        memcpy(&key_size, record, 4);
+        memcpy(&entry.mtime_ns, record + 4, 8);
+        memcpy(&entry.size, record + 12, 8);
+        memcpy(&entry.flags, record + 20, 4);
+        memcpy(entry.counts, record + 24, 6);
+        memcpy(&entry.data_size, record + 30, 4);
+        offset += PRESET_INDEX_RECORD_SIZE;
+
+        if (key_size == 0 || (uint64_t)key_size + entry.data_size > size - offset) break;
+
+        entry.key = malloc((size_t)key_size + 1 + entry.data_size);
+        if (!entry.key) break;
+        memcpy(entry.key, buffer + offset, key_size);
+        entry.key[key_size] = '\0';
+        entry.data = entry.key + key_size + 1;
+        memcpy(entry.data, buffer + offset + key_size, entry.data_size);
+        offset += (size_t)key_size + entry.data_size;
+
+        entry.hash = key_hash(entry.key);
+        if (strlen(entry.key) != key_size || !entry_data_valid(&entry) ||
+            index_find(index, entry.key, entry.hash) || !index_append(index, &entry)) {
+            free(entry.key);
+            break;
+        }
+    }
+
+    free(buffer);
+}
+
+preset_index_t* preset_index_open(const char* directory) {
+    preset_index_t* index = calloc(1, sizeof(preset_index_t));
+    if (!index) return NULL;
+
+    snprintf(index->directory, sizeof(index->directory), "%s", directory);
+    snprintf(index->file_path, sizeof(index->file_path), "%s/%s", directory, PRESET_INDEX_FILENAME);
+
+    index_load(index);
+    return index;
+}
+
+static void entry_unpack(const preset_index_entry_t* entry, preset_metadata_t* out) {
+    memset(out, 0, sizeof(*out));
+    out->flags = entry->flags;
+
+    const char* p = entry->data;
+    out->name = p;
+    p += strlen(p) + 1;
+    out->description = *p ? p : NULL;
+    p += strlen(p) + 1;
+    out->soundpack_id = *p ? p : NULL;
+    p += strlen(p) + 1;
+
+    for (uint16_t i = 0; i < entry->counts[0] && i < PRESET_INDEX_MAX_LIST; i++, p += strlen(p) + 1) {
+        out->plugin_ids[out->plugin_id_count++] = p;
+    }
+    for (uint16_t i = 0; i < entry->counts[1] && i < PRESET_INDEX_MAX_LIST; i++, p += strlen(p) + 1) {
+        out->creators[out->creator_count++] = p;
+    }
+    for (uint16_t i = 0; i < entry->counts[2] && i < PRESET_INDEX_MAX_LIST; i++, p += strlen(p) + 1) {
+        out->features[out->feature_count++] = p;
+    }
+}
+
+preset_index_result_t preset_index_lookup(preset_index_t* index, const char* path,
+                                          const struct stat* st, preset_metadata_t* out) {
+    const char* key = index_key(index, path);
+    preset_index_entry_t* entry = index_find(index, key, key_hash(key));
+    if (entry) entry->seen = true;
+
+    if (!entry || entry->mtime_ns != PRESET_STAT_MTIME_NS(st) || entry->size != (uint64_t)st->st_size) {
+        return PRESET_INDEX_MISS;
+    }
+    if (entry->flags & PRESET_INDEX_FLAG_INVALID) {
+        return PRESET_INDEX_INVALID;
+    }
+
+    entry_unpack(entry, out);
+    return PRESET_INDEX_HIT;
+}
+
+static size_t packed_size(const char* s) {
+    return (s ? strlen(s) : 0) + 1;
+}
+
+static char* pack_string(char* p, const char* s) {
+    size_t len = s ? strlen(s) : 0;
+    if (len) memcpy(p, s, len);
+    p[len] = '\0';
+    return p + len + 1;
+}
+
+void preset_index_store(preset_index_t* index, const char* path, const struct stat* st,
+                        const preset_metadata_t* metadata) {
+    const char* key = index_key(index, path);
+    size_t key_size = strlen(key);
+
+    preset_metadata_t invalid = {.name = "", .flags = PRESET_INDEX_FLAG_INVALID};
+    const preset_metadata_t* md = metadata ? metadata : &invalid;
+
+    uint32_t plugin_id_count = md->plugin_id_count < PRESET_INDEX_MAX_LIST ? md->plugin_id_count : PRESET_INDEX_MAX_LIST;
+    uint32_t creator_count = md->creator_count < PRESET_INDEX_MAX_LIST ? md->creator_count : PRESET_INDEX_MAX_LIST;
+    uint32_t feature_count = md->feature_count < PRESET_INDEX_MAX_LIST ? md->feature_count : PRESET_INDEX_MAX_LIST;
+
+    size_t data_size = packed_size(md->name) + packed_size(md->description) + packed_size(md->soundpack_id);
+    for (uint32_t i = 0; i < plugin_id_count; i++) data_size += packed_size(md->plugin_ids[i]);
+    for (uint32_t i = 0; i < creator_count; i++) data_size += packed_size(md->creators[i]);
+    for (uint32_t i = 0; i < feature_count; i++) data_size += packed_size(md->features[i]);
+
+    preset_index_entry_t entry = {0};
+    entry.key = malloc(key_size + 1 + data_size);
+    if (!entry.key) return;
+    memcpy(entry.key, key, key_size + 1);
+    entry.data = entry.key + key_size + 1;
+    entry.data_size = (uint32_t)data_size;
+    entry.hash = key_hash(entry.key);
+    entry.mtime_ns = PRESET_STAT_MTIME_NS(st);
+    entry.size = (uint64_t)st->st_size;
+    entry.flags = md->flags;
+    entry.counts[0] = (uint16_t)plugin_id_count;
+    entry.counts[1] = (uint16_t)creator_count;
+    entry.counts[2] = (uint16_t)feature_count;
+    entry.seen = true;
+
+    char* p = entry.data;
+    p = pack_string(p, md->name);
+    p = pack_string(p, md->description);
+    p = pack_string(p, md->soundpack_id);
+    for (uint32_t i = 0; i < plugin_id_count; i++) p = pack_string(p, md->plugin_ids[i]);
+    for (uint32_t i = 0; i < creator_count; i++) p = pack_string(p, md->creators[i]);
+    for (uint32_t i = 0; i < feature_count; i++) p = pack_string(p, md->features[i]);
+
+    preset_index_entry_t* existing = index_find(index, entry.key, entry.hash);
+    if (existing) {
+        free(existing->key);
+        *existing = entry;
+    } else if (!index_append(index, &entry)) {
+        free(entry.key);
+        return;
+    }
+    index->dirty = true;
+}
+
+// Whether the preset behind an entry still exists
+static bool entry_exists(const preset_index_t* index, const preset_index_entry_t* entry) {
+    char path[2048];
+    struct stat st;
+    if (entry->key[0] == '/') {
+        return stat(entry->key, &st) == 0;
+    }
+    snprintf(path, sizeof(path), "%s/%s", index->directory, entry->key);
+    return stat(path, &st) == 0;
+}
+
+bool preset_index_save(preset_index_t* index) {
+    // Entries the crawl reached exist; the rest are checked on disk, and
+    // any that are gone make the index stale even if nothing was stored
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < index->count; i++) {
+        preset_index_entry_t* entry = &index->entries[i];
+        entry->gone = !entry->seen && !entry_exists(index, entry);
+        if (entry->gone) {
+            index->dirty = true;
+        } else {
+            count++;
+        }
+    }
+    if (!index->dirty) return true;
+
+    // Written beside the index and renamed over it, so a crawl never reads
+    // a torn file
+    char temp_path[1100];
+    snprintf(temp_path, sizeof(temp_path), "%s.%ld.tmp", index->file_path, (long)getpid());
+
+    FILE* file = fopen(temp_path, "wb");
+    if (!file) return false;
+
+    uint8_t header[PRESET_INDEX_HEADER_SIZE] = {0};
+    uint32_t version = PRESET_INDEX_VERSION;
+    uint32_t byte_order = PRESET_INDEX_BYTE_ORDER;
+    memcpy(header, PRESET_INDEX_MAGIC, sizeof(PRESET_INDEX_MAGIC));
+    memcpy(header + 8, &version, 4);
+    memcpy(header + 12, &byte_order, 4);
+    memcpy(header + 16, &count, 4);
+    bool ok = fwrite(header, 1, sizeof(header), file) == sizeof(header);
+
+    for (uint32_t i = 0; ok && i < index->count; i++) {
+        const preset_index_entry_t* entry = &index->entries[i];
+        if (entry->gone) continue;
+
+        uint8_t record[PRESET_INDEX_RECORD_SIZE];
+        uint32_t key_size = (uint32_t)strlen(entry->key);
+        memcpy(record, &key_size, 4);
+        memcpy(record + 4, &entry->mtime_ns, 8);
+        memcpy(record + 12, &entry->size, 8);
+        memcpy(record + 20, &entry->flags, 4);
+        memcpy(record + 24, entry->counts, 6);
+        memcpy(record + 30, &entry->data_size, 4);
+
+        ok = fwrite(record, 1, sizeof(record), file) == sizeof(record) &&
+             fwrite(entry->key, 1, key_size, file) == key_size &&
+             fwrite(entry->data, 1, entry->data_size, file) == entry->data_size;
+    }
+    if (fclose(file) != 0) ok = false;
+
+    if (!ok || rename(temp_path, index->file_path) != 0) {
+        unlink(temp_path);
+        return false;
+    }
+
+    index->dirty = false;
+    return true;
+}
+
+void preset_index_close(preset_index_t* index) {
+    if (!index) return;
+    for (uint32_t i = 0; i < index->count; i++) {
+        free(index->entries[i].key);
+    }
+    free(index->entries);
+    free(index->slots);
+    free(index);
+}
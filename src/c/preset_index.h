@@ -0,0 +1,66 @@
+#ifndef CLAPGO_PRESET_INDEX_H
+#define CLAPGO_PRESET_INDEX_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <sys/stat.h>
+
+// Per-location preset index, so a host crawl only parses the preset files
+// that changed since the last one. Each preset directory gets an index file
+// holding, for every preset seen, its path, mtime and size and the metadata
+// the discovery provider reports. The index is read in one sequential pass
+// when the provider starts and rewritten atomically when it is destroyed,
+// only if a preset was added, edited or removed since.
+
+#define PRESET_INDEX_FILENAME ".clapgo-preset-index"
+
+// Most entries kept per metadata list; the rest are dropped
+#define PRESET_INDEX_MAX_LIST 32
+
+// Metadata for one preset. Strings are borrowed: from the parsed preset
+// when storing, from the index when reading back.
+typedef struct preset_metadata {
+    const char* name;
+    const char* description;    // NULL when absent
+    const char* soundpack_id;   // NULL when absent
+    uint32_t flags;             // CLAP_PRESET_DISCOVERY_* flags
+
+    const char* plugin_ids[PRESET_INDEX_MAX_LIST];
+    uint32_t plugin_id_count;
+    const char* creators[PRESET_INDEX_MAX_LIST];
+    uint32_t creator_count;
+    const char* features[PRESET_INDEX_MAX_LIST];
+    uint32_t feature_count;
+} preset_metadata_t;
+
+typedef enum preset_index_result {
+    PRESET_INDEX_MISS,      // unknown or changed; parse the file
+    PRESET_INDEX_HIT,       // metadata is current
+    PRESET_INDEX_INVALID,   // known to hold no usable preset
+} preset_index_result_t;
+
+typedef struct preset_index preset_index_t;
+
+// Load the index of directory, or start an empty one when it is missing or
+// unreadable. Returns NULL only when out of memory.
+preset_index_t* preset_index_open(const char* directory);
+
+// Look up the preset at path, whose current stat is st. On a hit, out
+// borrows strings owned by the index until the entry is next stored.
+preset_index_result_t preset_index_lookup(preset_index_t* index, const char* path,
+                                          const struct stat* st, preset_metadata_t* out);
+
+// Record metadata parsed from the preset at path; NULL records that the
+// file holds no usable preset. The strings are copied.
+void preset_index_store(preset_index_t* index, const char* path, const struct stat* st,
+                        const preset_metadata_t* metadata);
+
+// Rewrite the index file if anything was stored since it was opened or an
+// entry's file is gone, dropping those entries. Returns false when it could not be
+// written, which only costs the next crawl a re-parse.
+bool preset_index_save(preset_index_t* index);
+
+// Free the index without saving
+void preset_index_close(preset_index_t* index);
+
+#endif // CLAPGO_PRESET_INDEX_H
@@ -0,0 +1,25 @@
+#ifndef CLAPGO_RUNTIME_STATS_H
+#define CLAPGO_RUNTIME_STATS_H
+
+#include <stdint.h>
+
+// Go runtime counters exported by every ClapGo plugin library, so offline
+// tools such as the benchmark host can measure allocations and GC pauses
+// across a run. Reading them stops the world briefly; never call it from
+// the audio thread.
+
+#define CLAPGO_RUNTIME_STATS_SYMBOL "ClapGo_RuntimeStats"
+
+typedef struct clapgo_runtime_stats {
+    uint64_t mallocs;           // heap objects allocated, cumulative
+    uint64_t frees;             // heap objects freed, cumulative
+    uint64_t total_alloc_bytes; // bytes allocated, cumulative
+    uint64_t heap_alloc_bytes;  // bytes currently live on the heap
+    uint32_t num_gc;            // completed GC cycles
+    uint64_t pause_total_ns;    // stop-the-world pause time, cumulative
+    uint64_t pause_max_ns;      // longest pause among cycles after since_gc
+} clapgo_runtime_stats_t;
+
+typedef void (*clapgo_runtime_stats_fn)(uint32_t since_gc, clapgo_runtime_stats_t* out);
+
+#endif // CLAPGO_RUNTIME_STATS_H
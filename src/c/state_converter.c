@@ -223,6 +223,370 @@ static void converter_destroy(clap_plugin_state_converter_t* converter) {
     }
 }
 
+// State formats, matching pkg/state/binary.go. Binary states are
+// converted field by field; JSON states are converted and written back as
+// binary, which every clapgo plugin loads. Anything else is a
+// plugin-specific format and is copied unchanged.
+#define STATE_BINARY_MAGIC "CGST"
+#define STATE_BINARY_FORMAT 1
+#define STATE_BINARY_PREAMBLE 12
+#define STATE_MAX_SIZE (16u << 20)
+#define STATE_CUSTOM_DATA_CHUNK "clapgo.custom_data"
+
+// Host streams are read and written in large chunks, never per field
+#define STATE_STREAM_CHUNK (64 * 1024)
+
+typedef struct {
+    uint8_t* data;
+    size_t size;
+    size_t capacity;
+    bool failed;
+} state_buffer_t;
+
+typedef struct {
+    const uint8_t* p;
+    size_t left;
+    bool failed;
+} state_cursor_t;
+
+static void set_error(char* error_buffer, size_t error_buffer_size, const char* message) {
+    if (error_buffer && error_buffer_size > 0) {
+        snprintf(error_buffer, error_buffer_size, "%s", message);
+    }
+}
+
+static void buf_reserve(state_buffer_t* buf, size_t n) {
+    if (buf->failed || buf->size + n <= buf->capacity) {
+        return;
+    }
+    size_t capacity = buf->capacity ? buf->capacity : 4096;
+    while (capacity < buf->size + n) {
+        capacity *= 2;
+    }
+    uint8_t* grown = realloc(buf->data, capacity);
+    if (!grown) {
+        buf->failed = true;
+        return;
+    }
+    buf->data = grown;
+    buf->capacity = capacity;
+}
+
+static void buf_append(state_buffer_t* buf, const void* bytes, size_t n) {
+    if (n == 0) {
+        return;
+    }
+    buf_reserve(buf, n);
+    if (buf->failed) {
+        return;
+    }
+    memcpy(buf->data + buf->size, bytes, n);
+    buf->size += n;
+}
+
+static void buf_u16(state_buffer_t* buf, uint16_t v) {
+    uint8_t b[2] = { (uint8_t)v, (uint8_t)(v >> 8) };
+    buf_append(buf, b, sizeof(b));
+}
+
+static void buf_u32(state_buffer_t* buf, uint32_t v) {
+    uint8_t b[4];
+    for (int i = 0; i < 4; i++) {
+        b[i] = (uint8_t)(v >> (8 * i));
+    }
+    buf_append(buf, b, sizeof(b));
+}
+
+static void buf_u64(state_buffer_t* buf, uint64_t v) {
+    uint8_t b[8];
+    for (int i = 0; i < 8; i++) {
+        b[i] = (uint8_t)(v >> (8 * i));
+    }
+    buf_append(buf, b, sizeof(b));
+}
+
+static void buf_str16(state_buffer_t* buf, const char* s, size_t n) {
+    if (n > UINT16_MAX) {
+        buf->failed = true;
+        return;
+    }
+    buf_u16(buf, (uint16_t)n);
+    buf_append(buf, s, n);
+}
+
+static void buf_chunk(state_buffer_t* buf, const char* id, const void* data, size_t n) {
+    if (n > UINT32_MAX) {
+        buf->failed = true;
+        return;
+    }
+    buf_str16(buf, id, strlen(id));
+    buf_u32(buf, (uint32_t)n);
+    buf_append(buf, data, n);
+}
+
+// Write the preamble with a zero length, to be patched by buf_end_state
+static void buf_begin_state(state_buffer_t* buf) {
+    buf_append(buf, STATE_BINARY_MAGIC, 4);
+    buf_u16(buf, STATE_BINARY_FORMAT);
+    buf_u16(buf, 0);
+    buf_u32(buf, 0);
+}
+
+static bool buf_end_state(state_buffer_t* buf) {
+    if (buf->failed || buf->size - STATE_BINARY_PREAMBLE > STATE_MAX_SIZE) {
+        return false;
+    }
+    uint32_t body = (uint32_t)(buf->size - STATE_BINARY_PREAMBLE);
+    for (int i = 0; i < 4; i++) {
+        buf->data[8 + i] = (uint8_t)(body >> (8 * i));
+    }
+    return true;
+}
+
+static const uint8_t* cur_bytes(state_cursor_t* cur, size_t n) {
+    if (cur->failed || n > cur->left) {
+        cur->failed = true;
+        return NULL;
+    }
+    const uint8_t* p = cur->p;
+    cur->p += n;
+    cur->left -= n;
+    return p;
+}
+
+static uint64_t cur_uint(state_cursor_t* cur, size_t n) {
+    const uint8_t* p = cur_bytes(cur, n);
+    uint64_t v = 0;
+    if (p) {
+        for (size_t i = 0; i < n; i++) {
+            v |= (uint64_t)p[i] << (8 * i);
+        }
+    }
+    return v;
+}
+
+static const char* cur_str16(state_cursor_t* cur, size_t* n) {
+    *n = (size_t)cur_uint(cur, 2);
+    return (const char*)cur_bytes(cur, *n);
+}
+
+static double bits_to_double(uint64_t bits) {
+    double v;
+    memcpy(&v, &bits, sizeof(v));
+    return v;
+}
+
+static uint64_t double_to_bits(double v) {
+    uint64_t bits;
+    memcpy(&bits, &v, sizeof(bits));
+    return bits;
+}
+
+// Read the whole source stream straight into the buffer, NUL-terminated so
+// JSON can be parsed in place. Fails past STATE_MAX_SIZE plus the preamble.
+static bool read_source(const clap_istream_t* src, state_buffer_t* in) {
+    for (;;) {
+        buf_reserve(in, STATE_STREAM_CHUNK + 1);
+        if (in->failed) {
+            return false;
+        }
+        int64_t n = src->read(src, in->data + in->size, STATE_STREAM_CHUNK);
+        if (n < 0) {
+            return false;
+        }
+        if (n == 0) {
+            break;
+        }
+        in->size += (size_t)n;
+        if (in->size > STATE_MAX_SIZE + STATE_BINARY_PREAMBLE) {
+            return false;
+        }
+    }
+    in->data[in->size] = '\0';
+    return true;
+}
+
+static bool write_all(const clap_ostream_t* dst, const uint8_t* data, size_t size) {
+    while (size > 0) {
+        int64_t n = dst->write(dst, data, size);
+        if (n <= 0) {
+            return false;
+        }
+        data += n;
+        size -= (size_t)n;
+    }
+    return true;
+}
+
+static void convert_param(clap_plugin_state_converter_t* converter, state_buffer_t* out,
+                          clap_id id, double value, const char* name, size_t name_len) {
+    clap_id dst_id = id;
+    double dst_value = value;
+    converter_convert_plain_value(converter, id, value, &dst_id, &dst_value);
+    buf_u32(out, dst_id);
+    buf_u64(out, double_to_bits(dst_value));
+    buf_str16(out, name, name_len);
+}
+
+static bool convert_binary_state(clap_plugin_state_converter_t* converter, const converter_data_t* data,
+                                 const uint8_t* in, size_t in_size, state_buffer_t* out) {
+    state_cursor_t cur = { in, in_size, false };
+    cur_bytes(&cur, 4);
+    uint16_t format = (uint16_t)cur_uint(&cur, 2);
+    cur_uint(&cur, 2);
+    uint32_t body = (uint32_t)cur_uint(&cur, 4);
+    if (cur.failed || format > STATE_BINARY_FORMAT || body > cur.left || body > STATE_MAX_SIZE) {
+        return false;
+    }
+    cur.left = body;
+
+    size_t n;
+    const char* s;
+    buf_begin_state(out);
+    buf_u32(out, (uint32_t)cur_uint(&cur, 4));  // version
+    buf_u64(out, cur_uint(&cur, 8));            // saved_at
+    cur_str16(&cur, &n);                        // plugin_id, replaced
+    buf_str16(out, data->dst_plugin_id, strlen(data->dst_plugin_id));
+    s = cur_str16(&cur, &n);                    // plugin_name
+    buf_str16(out, s, n);
+    s = cur_str16(&cur, &n);                    // format_type
+    buf_str16(out, s, n);
+
+    uint32_t count = (uint32_t)cur_uint(&cur, 4);
+    buf_u32(out, count);
+    for (uint32_t i = 0; i < count && !cur.failed; i++) {
+        clap_id id = (clap_id)cur_uint(&cur, 4);
+        double value = bits_to_double(cur_uint(&cur, 8));
+        s = cur_str16(&cur, &n);
+        convert_param(converter, out, id, value, s, n);
+    }
+
+    // Chunks are opaque, so they are copied as they are
+    count = (uint32_t)cur_uint(&cur, 4);
+    buf_u32(out, count);
+    for (uint32_t i = 0; i < count && !cur.failed; i++) {
+        s = cur_str16(&cur, &n);
+        size_t size = (size_t)cur_uint(&cur, 4);
+        const uint8_t* chunk = cur_bytes(&cur, size);
+        if (!cur.failed) {
+            buf_str16(out, s, n);
+            buf_u32(out, (uint32_t)size);
+            buf_append(out, chunk, size);
+        }
+    }
+
+    return !cur.failed && buf_end_state(out);
+}
+
+// Decode standard base64, as encoding/json writes []byte
+static bool base64_decode(const char* in, size_t len, state_buffer_t* out) {
+    uint32_t acc = 0;
+    int bits = 0;
+    for (size_t i = 0; i < len && in[i] != '='; i++) {
+        char c = in[i];
+        int v;
+        if (c >= 'A' && c <= 'Z') v = c - 'A';
+        else if (c >= 'a' && c <= 'z') v = c - 'a' + 26;
+        else if (c >= '0' && c <= '9') v = c - '0' + 52;
+        else if (c == '+') v = 62;
+        else if (c == '/') v = 63;
+        else return false;
+
+        acc = (acc << 6) | (uint32_t)v;
+        bits += 6;
+        if (bits >= 8) {
+            bits -= 8;
+            uint8_t b = (uint8_t)(acc >> bits);
+            buf_append(out, &b, 1);
+        }
+    }
+    return !out->failed;
+}
+
+static void json_str16(state_buffer_t* out, struct json_object* parent, const char* key) {
+    struct json_object* obj;
+    if (json_object_object_get_ex(parent, key, &obj) && json_object_is_type(obj, json_type_string)) {
+        buf_str16(out, json_object_get_string(obj), (size_t)json_object_get_string_len(obj));
+    } else {
+        buf_str16(out, "", 0);
+    }
+}
+
+static bool convert_json_state(clap_plugin_state_converter_t* converter, const converter_data_t* data,
+                               const char* in, state_buffer_t* out) {
+    struct json_object* root = json_tokener_parse(in);
+    if (!root) {
+        return false;
+    }
+
+    struct json_object* header;
+    struct json_object* obj;
+    if (!json_object_object_get_ex(root, "header", &header) ||
+        !json_object_is_type(header, json_type_object)) {
+        json_object_put(root);
+        return false;
+    }
+
+    buf_begin_state(out);
+    buf_u32(out, json_object_object_get_ex(header, "version", &obj) ?
+                 (uint32_t)json_object_get_int64(obj) : 0);
+    buf_u64(out, json_object_object_get_ex(header, "saved_at", &obj) ?
+                 (uint64_t)json_object_get_int64(obj) : 0);
+    buf_str16(out, data->dst_plugin_id, strlen(data->dst_plugin_id));
+    json_str16(out, header, "plugin_name");
+    json_str16(out, header, "format_type");
+
+    struct json_object* params = NULL;
+    json_object_object_get_ex(root, "parameters", &params);
+    size_t count = params && json_object_is_type(params, json_type_array) ?
+                   json_object_array_length(params) : 0;
+    buf_u32(out, (uint32_t)count);
+    for (size_t i = 0; i < count; i++) {
+        struct json_object* param = json_object_array_get_idx(params, i);
+        clap_id id = json_object_object_get_ex(param, "id", &obj) ? (clap_id)json_object_get_int64(obj) : 0;
+        double value = json_object_object_get_ex(param, "value", &obj) ? json_object_get_double(obj) : 0.0;
+        const char* name = "";
+        size_t name_len = 0;
+        if (json_object_object_get_ex(param, "name", &obj) && json_object_is_type(obj, json_type_string)) {
+            name = json_object_get_string(obj);
+            name_len = (size_t)json_object_get_string_len(obj);
+        }
+        convert_param(converter, out, id, value, name, name_len);
+    }
+
+    struct json_object* custom = NULL;
+    bool has_custom = json_object_object_get_ex(root, "custom_data", &custom) &&
+                      json_object_is_type(custom, json_type_object);
+    struct json_object* chunks = NULL;
+    json_object_object_get_ex(root, "chunks", &chunks);
+    count = chunks && json_object_is_type(chunks, json_type_array) ?
+            json_object_array_length(chunks) : 0;
+
+    buf_u32(out, (uint32_t)(count + (has_custom ? 1 : 0)));
+    bool ok = true;
+    for (size_t i = 0; i < count && ok; i++) {
+        struct json_object* chunk = json_object_array_get_idx(chunks, i);
+        struct json_object* id;
+        state_buffer_t decoded = { 0 };
+        if (!json_object_object_get_ex(chunk, "id", &id) || !json_object_is_type(id, json_type_string)) {
+            ok = false;
+        } else if (json_object_object_get_ex(chunk, "data", &obj) && json_object_is_type(obj, json_type_string)) {
+            ok = base64_decode(json_object_get_string(obj), (size_t)json_object_get_string_len(obj), &decoded);
+        }
+        if (ok) {
+            buf_chunk(out, json_object_get_string(id), decoded.data, decoded.size);
+        }
+        free(decoded.data);
+    }
+    if (ok && has_custom) {
+        const char* text = json_object_to_json_string_ext(custom, JSON_C_TO_STRING_PLAIN);
+        buf_chunk(out, STATE_CUSTOM_DATA_CHUNK, text, strlen(text));
+    }
+
+    json_object_put(root);
+    return ok && buf_end_state(out);
+}
+
 static bool converter_convert_state(clap_plugin_state_converter_t* converter,
                                   const clap_istream_t* src,
                                   const clap_ostream_t* dst,
@@ -230,34 +594,50 @@ static bool converter_convert_state(clap_plugin_state_converter_t* converter,
                                   size_t error_buffer_size) {
     
     if (!converter || !src || !dst) {
-        if (error_buffer && error_buffer_size > 0) {
-            snprintf(error_buffer, error_buffer_size, "Invalid parameters");
-        }
+        set_error(error_buffer, error_buffer_size, "Invalid parameters");
         return false;
     }
     
     converter_data_t* data = (converter_data_t*)converter->converter_data;
     
-    // TODO: Implement actual state conversion logic
-    // For now, this is a placeholder that would need to:
-    // 1. Read the source state from the input stream
-    // 2. Parse and convert the state data
-    // 3. Write the converted state to the output stream
+    state_buffer_t in = { 0 };
+    if (!read_source(src, &in)) {
+        free(in.data);
+        set_error(error_buffer, error_buffer_size, "Failed to read source state");
+        return false;
+    }
     
-    // Example: Just copy the state as-is (not a real conversion)
-    uint8_t buffer[1024];
-    int64_t bytes_read;
+    // Skip leading whitespace to recognize JSON
+    size_t start = 0;
+    while (start < in.size && (in.data[start] == ' ' || in.data[start] == '\t' ||
+                               in.data[start] == '\r' || in.data[start] == '\n')) {
+        start++;
+    }
     
-    while ((bytes_read = src->read(src, buffer, sizeof(buffer))) > 0) {
-        if (dst->write(dst, buffer, bytes_read) != bytes_read) {
-            if (error_buffer && error_buffer_size > 0) {
-                snprintf(error_buffer, error_buffer_size, "Failed to write converted state");
-            }
-            return false;
-        }
+    state_buffer_t out = { 0 };
+    bool converted = false;
+    bool ok;
+    if (in.size >= 4 && memcmp(in.data, STATE_BINARY_MAGIC, 4) == 0) {
+        converted = convert_binary_state(converter, data, in.data, in.size, &out);
+        ok = converted;
+    } else if (start < in.size && in.data[start] == '{') {
+        converted = convert_json_state(converter, data, (const char*)in.data, &out);
+        ok = converted;
+    } else {
+        // Plugin-specific format: nothing to convert
+        ok = true;
     }
     
-    return true;
+    if (!ok) {
+        set_error(error_buffer, error_buffer_size, "Malformed source state");
+    } else if (converted ? !write_all(dst, out.data, out.size) : !write_all(dst, in.data, in.size)) {
+        set_error(error_buffer, error_buffer_size, "Failed to write converted state");
+        ok = false;
+    }
+    
+    free(in.data);
+    free(out.data);
+    return ok;
 }
 
 static bool converter_convert_normalized_value(clap_plugin_state_converter_t* converter,
@@ -0,0 +1,87 @@
+#ifndef CLAPGO_TELEMETRY_H
+#define CLAPGO_TELEMETRY_H
+
+#include <stdint.h>
+
+// Meter, scope and voice snapshots from the audio thread to a GUI.
+//
+// A plugin publishes frames into a triple buffer in C memory, which the GUI
+// reads in place at its own frame rate, without calling into Go. The writer
+// and the reader each own one frame and swap it for the shared middle one
+// with a single atomic exchange, so neither side ever waits for the other
+// or copies a frame. A reader that falls behind skips frames, with nothing
+// lost: peak and RMS cover every block since the frame it last took.
+//
+// The writer is pkg/audio's Telemetry; bridges get the block for an
+// instance from clapgo_plugin_get_telemetry. It lives from plugin init to
+// destroy, so a GUI must stop reading before the plugin is destroyed, as
+// CLAP's gui destroy already guarantees.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CLAPGO_TELEMETRY_VERSION 1
+
+// Channels metered; a plugin with more reports the first ones
+#define CLAPGO_TELEMETRY_CHANNELS 8
+
+// Points per channel in the scope window
+#define CLAPGO_TELEMETRY_SCOPE_SIZE 512
+
+// Bits in the sounding-key map, one per MIDI key
+#define CLAPGO_TELEMETRY_KEYS 128
+
+// state holds the middle frame's index and whether it is newer than the
+// reader's
+#define CLAPGO_TELEMETRY_INDEX_MASK 0x3u
+#define CLAPGO_TELEMETRY_FRESH 0x4u
+
+typedef struct clapgo_telemetry_frame {
+    uint64_t sequence;         // publish count; 0 means nothing published yet
+    int64_t steady_time;       // steady time of the last block, -1 if unknown
+    uint32_t frame_count;      // audio frames peak and rms cover
+    uint32_t channel_count;    // valid entries in peak, rms and scope
+    float peak[CLAPGO_TELEMETRY_CHANNELS]; // largest |sample|, linear
+    float rms[CLAPGO_TELEMETRY_CHANNELS];  // RMS level, linear
+    uint32_t scope_count;      // valid points in each scope row, oldest first
+    uint32_t scope_decimation; // audio frames per scope point
+    float scope[CLAPGO_TELEMETRY_CHANNELS][CLAPGO_TELEMETRY_SCOPE_SIZE];
+    uint32_t active_voices;
+    uint32_t keys[CLAPGO_TELEMETRY_KEYS / 32]; // bit k % 32 of word k / 32 set while key k sounds
+} clapgo_telemetry_frame_t;
+
+typedef struct clapgo_telemetry {
+    uint32_t version;  // CLAPGO_TELEMETRY_VERSION
+    uint32_t state;    // accessed atomically only
+    uint64_t consumed; // sequence of the reader's frame; accessed atomically only
+    clapgo_telemetry_frame_t frames[3];
+} clapgo_telemetry_t;
+
+// The reader's side of the triple buffer: one per GUI, not shared
+typedef struct clapgo_telemetry_reader {
+    uint32_t front;
+} clapgo_telemetry_reader_t;
+
+// The writer starts on frame 0 and the middle is frame 1
+#define CLAPGO_TELEMETRY_READER_INIT {2}
+
+// Returns the newest published frame, taking it from the writer first when
+// there is one. The frame stays valid and unchanged until the next call
+// with the same reader. Its sequence is 0 until the first publish.
+static inline const clapgo_telemetry_frame_t* clapgo_telemetry_read(clapgo_telemetry_t* telemetry,
+                                                                     clapgo_telemetry_reader_t* reader) {
+    if (__atomic_load_n(&telemetry->state, __ATOMIC_ACQUIRE) & CLAPGO_TELEMETRY_FRESH) {
+        uint32_t previous = __atomic_exchange_n(&telemetry->state, reader->front, __ATOMIC_ACQ_REL);
+        reader->front = previous & CLAPGO_TELEMETRY_INDEX_MASK;
+        __atomic_store_n(&telemetry->consumed, telemetry->frames[reader->front].sequence,
+                         __ATOMIC_RELEASE);
+    }
+    return &telemetry->frames[reader->front];
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CLAPGO_TELEMETRY_H